@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/AsyncIO.hpp>
+#include <Core/Async/MPMC.hpp>
+#include <Core/Async/Thread.hpp>
+#include <Core/Debug/Test.hpp>
+
+#include <errno.h>
+
+#if MACH_OS == MACH_OS_LINUX
+	#include <Core/Async/Linux/IOUring.hpp>
+#endif
+
+namespace Mach::Core {
+	void IOBatch::wait() const {
+		while (true) {
+			const usize pending = m_pending.load(Order::Acquire);
+			if (pending == 0) {
+				return;
+			}
+			m_pending.wait(pending, Order::Acquire);
+		}
+	}
+
+	void AsyncIO::begin(IOBatch const& batch) {
+		MACH_ASSERT(!batch.m_submitted.load(Order::Relaxed), "IOBatch was already submitted");
+		for (IORequest& request : batch.m_requests) {
+			request.batch = &batch;
+			request.result = 0;
+		}
+		batch.m_submitted.store(true, Order::Release);
+	}
+
+	void AsyncIO::complete(IORequest& request, isize result) {
+		request.result = result;
+
+		IOBatch const& batch = *request.batch;
+		if (batch.m_pending.fetch_sub(1, Order::AcqRel) == 1) {
+			batch.m_pending.notify_all();
+		}
+	}
+
+	// Fallback used when the platform has no completion based IO. A handful of threads pull requests off a queue and
+	// issue blocking positional reads and writes, so the submitting fiber is still free to run other jobs.
+	class ThreadPoolIO final : public AsyncIO {
+	public:
+		explicit ThreadPoolIO(CreateInfo const& info) : m_thread_count(info.thread_count) {
+			u32 capacity = 2;
+			while (capacity < info.queue_depth) {
+				capacity <<= 1;
+			}
+			m_queue = MPMC<IORequest*>::create(capacity);
+		}
+
+		ThreadPoolIO(ThreadPoolIO&& move) = default;
+
+		// Threads capture this so they can only be started once the service is at its final address
+		void start() {
+			m_threads.reserve(m_thread_count);
+			for (u32 index = 0; index < m_thread_count; index += 1) {
+				m_threads.push(Thread::spawn([this]() { worker_main(); }));
+			}
+		}
+
+		void submit(IOBatch const& batch) const final {
+			begin(batch);
+			for (IORequest& request : batch.requests()) {
+				// Run the request inline when the queue is saturated instead of dropping it
+				if (!m_queue.push(&request)) {
+					complete(request, perform(request));
+				}
+			}
+
+			const auto unused = m_signal.fetch_add(1, Order::Release);
+			MACH_UNUSED(unused);
+			m_signal.notify_all();
+		}
+
+		~ThreadPoolIO() final {
+			m_running.store(false, Order::Release);
+			const auto unused = m_signal.fetch_add(1, Order::Release);
+			MACH_UNUSED(unused);
+			m_signal.notify_all();
+
+			for (auto& thread : m_threads) {
+				thread.unsafe_get_mut().join();
+			}
+		}
+
+	private:
+		static isize perform(IORequest const& request) {
+			usize amount = 0;
+			switch (request.kind) {
+			case IORequest::Kind::Read:
+				amount = request.file->read_at(request.offset, request.bytes);
+				break;
+			case IORequest::Kind::Write:
+				amount = request.file->write_at(request.offset, static_cast<Slice<u8 const>>(request.bytes));
+				break;
+			}
+			// Posix files return -1 and leave the reason in errno, which requests report as a negative error code
+			const auto result = static_cast<isize>(amount);
+			if (result < 0) {
+				return -static_cast<isize>(errno);
+			}
+			return result;
+		}
+
+		void worker_main() const {
+			while (true) {
+				// Read the signal before checking the queue so a submit that lands in between wakes us back up
+				const u32 signal = m_signal.load(Order::Acquire);
+
+				auto request = m_queue.pop();
+				if (request.is_set()) {
+					IORequest& mut_request = *request.unwrap();
+					complete(mut_request, perform(mut_request));
+					continue;
+				}
+
+				if (!m_running.load(Order::Acquire)) {
+					break;
+				}
+				m_signal.wait(signal, Order::Acquire);
+			}
+		}
+
+		u32 m_thread_count;
+		MPMC<IORequest*> m_queue;
+		Array<Mach::SharedPtr<Thread>> m_threads;
+		Atomic<u32> m_signal{ 0 };
+		Atomic<bool> m_running{ true };
+	};
+
+	UniquePtr<AsyncIO> AsyncIO::create(CreateInfo const& info) {
+#if MACH_OS == MACH_OS_LINUX
+		// io_uring can be missing on old kernels or blocked by seccomp so always be ready to fall back
+		auto ring = IOUring::create(info.queue_depth);
+		if (ring.is_set()) {
+			return ring.unwrap();
+		}
+#endif
+
+		auto pool = UniquePtr<ThreadPoolIO>::create(info);
+		pool->start();
+		return pool;
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/TempDirectory.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	// Batches are polled rather than waited on through a Scheduler, so this runs on any thread
+	void check_async_io(AsyncIO const& io) {
+		auto temp = TempDirectory::create();
+		MACH_REQUIRE(temp.is_set());
+		const auto path = temp.as_const_ref().unwrap().join(u8"async.bin"_sv);
+
+		auto maybe_file = File::open(path, OpenFlags::Read | OpenFlags::Write | OpenFlags::Create);
+		MACH_REQUIRE(maybe_file.is_set());
+		const File file = maybe_file.unwrap();
+
+		static constexpr usize block_size = 4096;
+		Array<u8> written;
+		for (usize index = 0; index < block_size * 2; index += 1) {
+			written.push(static_cast<u8>(index * 31 + 7));
+		}
+
+		IORequest writes[] = {
+			IORequest::write(file, 0, Slice<u8 const>{ written.begin(), block_size }),
+			IORequest::write(file, block_size, Slice<u8 const>{ written.begin() + block_size, block_size }),
+		};
+		{
+			const IOBatch batch{ Slice<IORequest>{ writes, 2 } };
+			MACH_CHECK(batch.status() == Task::Status::NotStarted);
+			io.submit(batch);
+			while (batch.status() != Task::Status::Complete) {
+				Thread::yield_now();
+			}
+		}
+		MACH_CHECK(writes[0].result == static_cast<isize>(block_size));
+		MACH_CHECK(writes[1].result == static_cast<isize>(block_size));
+
+		// Read back out of order, with the last request running past the end of the file
+		Array<u8> read;
+		read.set_len(block_size * 2 + 100);
+		IORequest reads[] = {
+			IORequest::read(file, block_size, Slice<u8>{ read.begin() + block_size, block_size + 100 }),
+			IORequest::read(file, 0, Slice<u8>{ read.begin(), block_size }),
+		};
+		const IOBatch batch{ Slice<IORequest>{ reads, 2 } };
+		io.submit(batch);
+		batch.wait();
+		MACH_CHECK(batch.status() == Task::Status::Complete);
+		MACH_CHECK(reads[0].result == static_cast<isize>(block_size));
+		MACH_CHECK(reads[1].result == static_cast<isize>(block_size));
+
+		bool matches = true;
+		for (usize index = 0; index < written.len(); index += 1) {
+			matches &= read[index] == written[index];
+		}
+		MACH_CHECK(matches);
+
+		// Failures still complete the batch and come back as a negative result
+		auto write_only = File::open(path, OpenFlags::Write);
+		MACH_REQUIRE(write_only.is_set());
+		IORequest failing = IORequest::read(write_only.as_const_ref().unwrap(), 0, Slice<u8>{ read.begin(), 16 });
+		const IOBatch failing_batch{ Slice<IORequest>{ &failing, 1 } };
+		io.submit(failing_batch);
+		failing_batch.wait();
+		MACH_CHECK(failing_batch.status() == Task::Status::Complete);
+		MACH_CHECK(failing.result < 0);
+	#if MACH_OS == MACH_OS_LINUX || MACH_OS == MACH_OS_MACOS
+		MACH_CHECK(failing.result == -EBADF);
+	#endif
+	}
+
+	MACH_TEST_CASE("AsyncIO") {
+		MACH_SUBCASE("platform backend") {
+			const auto io = AsyncIO::create();
+			check_async_io(*io);
+		}
+
+		MACH_SUBCASE("thread pool") {
+			auto pool = UniquePtr<ThreadPoolIO>::create(AsyncIO::CreateInfo{});
+			pool->start();
+			check_async_io(*pool);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Scheduler.hpp>
+#include <Core/Containers/Slice.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+#include <Core/FileSystem/File.hpp>
+
+namespace Mach::Core {
+	class IOBatch;
+
+	struct IORequest {
+		enum class Kind : u8 { Read, Write };
+
+		MACH_NO_DISCARD static IORequest read(File const& file, u64 offset, Slice<u8> bytes) {
+			return IORequest{ .file = &file, .kind = Kind::Read, .offset = offset, .bytes = bytes };
+		}
+		MACH_NO_DISCARD static IORequest write(File const& file, u64 offset, Slice<u8 const> bytes) {
+			const Slice<u8> mut_bytes{ const_cast<u8*>(bytes.begin()), bytes.len() };
+			return IORequest{ .file = &file, .kind = Kind::Write, .offset = offset, .bytes = mut_bytes };
+		}
+
+		File const* file;
+		Kind kind;
+		u64 offset;
+		Slice<u8> bytes;
+
+		// Amount of bytes transferred or a negative error code. Only valid once the owning batch is complete.
+		isize result = 0;
+		// Filled in by AsyncIO::submit
+		IOBatch const* batch = nullptr;
+	};
+
+	// A group of requests submitted together. The batch is a Task so a fiber can suspend on it through
+	// Scheduler::wait_for while the IO is in flight. Both the batch and its requests must outlive the IO.
+	class IOBatch final : public Task {
+	public:
+		explicit IOBatch(Slice<IORequest> requests) : m_requests(requests), m_pending(requests.len()) {}
+
+		MACH_NO_COPY(IOBatch);
+		MACH_NO_MOVE(IOBatch);
+
+		~IOBatch() final {
+			MACH_ASSERT(
+				!m_submitted.load(Order::Relaxed) || m_pending.load(Order::Acquire) == 0,
+				"IOBatch destroyed while IO is still in flight");
+		}
+
+		MACH_NO_DISCARD Status status() const final {
+			if (!m_submitted.load(Order::Acquire)) return Status::NotStarted;
+			return m_pending.load(Order::Acquire) == 0 ? Status::Complete : Status::InProgress;
+		}
+
+		// Blocks the calling thread until every request has completed. Prefer Scheduler::wait_for on worker fibers.
+		void wait() const;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<IORequest> requests() const { return m_requests; }
+
+	private:
+		friend class AsyncIO;
+
+		Slice<IORequest> m_requests;
+		Atomic<usize> m_pending;
+		Atomic<bool> m_submitted{ false };
+	};
+
+	// Service that overlaps file IO with other work. Uses io_uring on Linux when the kernel supports it and falls back
+	// to a small pool of threads issuing positional reads and writes everywhere else.
+	class AsyncIO {
+	public:
+		struct CreateInfo {
+			// Amount of submission queue entries for io_uring
+			u32 queue_depth = 256;
+			// Amount of threads used by the blocking fallback
+			u32 thread_count = 2;
+		};
+		MACH_NO_DISCARD static UniquePtr<AsyncIO> create(CreateInfo const& info);
+		MACH_NO_DISCARD static UniquePtr<AsyncIO> create() { return create(CreateInfo{}); }
+
+		// Queues every request in the batch. Returns immediately, completion is observed through the batch.
+		virtual void submit(IOBatch const& batch) const = 0;
+
+		// Pins the given buffers with the kernel so requests that fall inside them skip the per-request mapping.
+		// Returns false if the backend has no notion of registered buffers.
+		virtual bool register_buffers(Slice<Slice<u8> const> buffers) {
+			MACH_UNUSED(buffers);
+			return false;
+		}
+
+		// Submits the batch and suspends the calling fiber until it completes
+		MACH_ALWAYS_INLINE void submit_and_wait(Scheduler const& scheduler, IOBatch const& batch) const {
+			submit(batch);
+			scheduler.wait_for(batch);
+		}
+
+		virtual ~AsyncIO() {}
+
+	protected:
+		static void begin(IOBatch const& batch);
+		static void complete(IORequest& request, isize result);
+	};
+} // namespace Mach::Core
@@ -0,0 +1,134 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/ConcurrentHashMap.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("ConcurrentHashMap") {
+		MACH_SUBCASE("insert find remove") {
+			const ConcurrentHashMap<u32, u32> map;
+			MACH_CHECK(!map.find(1).is_set());
+			MACH_CHECK(!map.insert(1, 10).is_set());
+			MACH_CHECK(!map.insert(2, 20).is_set());
+			MACH_CHECK(map.len() == 2);
+			MACH_CHECK(map.find(1).unwrap() == 10);
+
+			const auto previous = map.insert(1, 11);
+			MACH_CHECK(previous.unwrap() == 10);
+			MACH_CHECK(map.find(1).unwrap() == 11);
+			MACH_CHECK(map.len() == 2);
+
+			MACH_CHECK(map.remove(2).unwrap() == 20);
+			MACH_CHECK(!map.remove(2).is_set());
+			MACH_CHECK(!map.find(2).is_set());
+			MACH_CHECK(map.len() == 1);
+		}
+
+		MACH_SUBCASE("keys spread over shards") {
+			const ConcurrentHashMap<u32, u32> map;
+			for (u32 i = 0; i < 256; i += 1) {
+				map.insert(i, i * 2);
+			}
+			bool all_found = true;
+			for (u32 i = 0; i < 256; i += 1) {
+				all_found &= map.find(i).unwrap_or(0) == i * 2;
+			}
+			MACH_CHECK(all_found);
+			MACH_CHECK(map.len() == 256);
+		}
+
+		MACH_SUBCASE("find_or_insert_with builds each value once") {
+			static constexpr u32 thread_count = 4;
+			static constexpr u32 key_count = 64;
+
+			const ConcurrentHashMap<u32, u32> map;
+			Atomic<u32> built{ 0 };
+			Atomic<u32> wrong{ 0 };
+
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < thread_count; index += 1) {
+				threads.push(Thread::spawn([&map, &built, &wrong, index] {
+					// Every thread walks all keys, starting at a different one so they collide in different orders
+					for (u32 i = 0; i < key_count * 4; i += 1) {
+						const u32 key = (i + index * 17) % key_count;
+						const u32 value = map.find_or_insert_with(key, [&built, key] {
+							const auto unused = built.fetch_add(1);
+							MACH_UNUSED(unused);
+							return key + 1000;
+						});
+						if (value != key + 1000) {
+							const auto unused = wrong.fetch_add(1);
+							MACH_UNUSED(unused);
+						}
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+
+			MACH_CHECK(built.load() == key_count);
+			MACH_CHECK(wrong.load() == 0);
+			MACH_CHECK(map.len() == key_count);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	static constexpr Mach::u32 bench_thread_count = 4;
+	static constexpr Mach::u32 bench_per_thread = 4096;
+	static constexpr Mach::u32 bench_key_count = 256;
+
+	template <typename F>
+	void bench_threads(Mach::Core::Bencher& bencher, F f) {
+		using namespace Mach::Core;
+
+		bencher.set_items(bench_thread_count * bench_per_thread);
+		bencher.iter([&f] {
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < bench_thread_count; index += 1) {
+				threads.push(Thread::spawn([&f, index] {
+					for (u32 i = 0; i < bench_per_thread; i += 1) {
+						f((i * 7 + index) % bench_key_count);
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+		});
+	}
+} // namespace
+
+MACH_BENCHMARK("ConcurrentHashMap find_or_insert_with 4 threads") {
+	using namespace Mach::Core;
+
+	const ConcurrentHashMap<u32, u32> map;
+	bench_threads(bencher, [&map](u32 key) {
+		const u32 value = map.find_or_insert_with(key, [key] { return key; });
+		MACH_UNUSED(value);
+	});
+}
+
+MACH_BENCHMARK("SpinlockMutex<HashMap> find or insert 4 threads") {
+	using namespace Mach::Core;
+
+	const SpinlockMutex<HashMap<u32, u32>> map{ HashMap<u32, u32>{} };
+	bench_threads(bencher, [&map](u32 key) {
+		auto locked = map.lock();
+		if (!locked->find(key).is_set()) {
+			locked->insert(key, key);
+		}
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
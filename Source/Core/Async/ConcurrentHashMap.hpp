@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Mutex.hpp>
+#include <Core/Containers/HashMap.hpp>
+
+#include <bit>
+
+namespace Mach::Core {
+	/**
+	 * HashMap that can be shared between threads. Keys are spread over ShardCount independent maps, each behind its own
+	 * RwLock, so threads working on different keys rarely touch the same lock and lookups of the same key only take it
+	 * shared.
+	 *
+	 * Values are handed out by copy since a reference would outlive the lock. Store SharedPtr or handles for anything
+	 * expensive to copy.
+	 */
+	template <typename Key, typename Value, usize ShardCount = 16>
+		requires Copyable<Key> && EqualityComparable<Key>
+	class ConcurrentHashMap {
+		static_assert(ShardCount >= 2 && (ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of 2");
+
+	public:
+		ConcurrentHashMap() = default;
+		MACH_NO_COPY(ConcurrentHashMap);
+		MACH_NO_MOVE(ConcurrentHashMap);
+
+		// Locks every shard in turn, so the result may already be stale if other threads are inserting
+		MACH_NO_DISCARD usize len() const {
+			usize result = 0;
+			for (auto const& shard : m_shards) {
+				result += shard.map.read()->len();
+			}
+			return result;
+		}
+
+		// Inserts value under key, replacing and returning the value that was there before
+		Option<Value> insert(const Key& key, Value&& value) const
+			requires Movable<Value>
+		{
+			auto map = shard_for(key).write();
+			auto previous = map->remove(key);
+			map->insert(key, Mach::forward<Value>(value));
+			return previous;
+		}
+
+		Option<Value> remove(const Key& key) const { return shard_for(key).write()->remove(key); }
+
+		MACH_NO_DISCARD Option<Value> find(const Key& key) const
+			requires Copyable<Value>
+		{
+			auto map = shard_for(key).read();
+			auto found = map->find(key);
+			if (!found.is_set()) {
+				return nullopt;
+			}
+			return found.unwrap();
+		}
+
+		/**
+		 * Returns the value under key, calling make to create and insert it if there is none. When several threads race
+		 * on the same missing key exactly one of them calls make and the rest get its result.
+		 *
+		 * make runs while holding the key's shard for writing, which blocks every other key in that shard until it
+		 * returns. Keep it short or have it return a handle to work that finishes elsewhere.
+		 */
+		template <typename F>
+		Value find_or_insert_with(const Key& key, F&& make) const
+			requires Copyable<Value>
+		{
+			auto const& shard = shard_for(key);
+			{
+				auto map = shard.read();
+				auto found = map->find(key);
+				if (found.is_set()) {
+					return found.unwrap();
+				}
+			}
+
+			auto map = shard.write();
+
+			// Another thread may have inserted it between us dropping the read lock and taking the write lock
+			auto found = map->find(key);
+			if (found.is_set()) {
+				return found.unwrap();
+			}
+
+			Value value = make();
+			map->insert(key, value);
+			return value;
+		}
+
+	private:
+		struct Shard {
+			RwLock<HashMap<Key, Value>> map{ HashMap<Key, Value>{} };
+		};
+
+		RwLock<HashMap<Key, Value>> const& shard_for(const Key& key) const {
+			FNV1Hasher hasher{};
+			hash(hasher, key);
+
+			// Shards take the top bits of a Fibonacci hash. HashMap buckets by the same hash modulo its size, so sharding
+			// on the raw hash would leave most of each shard's buckets empty.
+			static constexpr u32 shard_bits = std::countr_zero(ShardCount);
+			const u64 mixed = hasher.finish() * 0x9E3779B97F4A7C15ULL;
+			return m_shards[mixed >> (64 - shard_bits)].map;
+		}
+
+		Shard m_shards[ShardCount];
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::ConcurrentHashMap;
+} // namespace Mach
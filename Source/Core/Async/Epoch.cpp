@@ -0,0 +1,293 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/Epoch.hpp>
+
+#include <Core/Async/Thread.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+namespace Mach::Core {
+	static constexpr u64 epoch_pinned = 1;
+
+	EpochDomain::~EpochDomain() {
+		for (auto& participant : m_participants) {
+			MACH_ASSERT(participant.pin_depth == 0, "EpochDomain destroyed while a participant is pinned");
+			for (auto& bag : participant.bags) {
+				for (const auto& deferred : bag.deferred) {
+					deferred.f(deferred.context, deferred.ptr);
+				}
+			}
+		}
+	}
+
+	void EpochDomain::init(u32 participant_count) {
+		m_participants = UniquePtr<Participant[]>::create(participant_count);
+	}
+
+	EpochGuard EpochDomain::pin(u32 index) const {
+		MACH_ASSERT(index < m_participants.len(), "Participant index is out of range");
+		Participant& p = participant(index);
+		p.pin_depth += 1;
+		if (p.pin_depth == 1) {
+			const u64 epoch = m_epoch.load(Order::Relaxed);
+			p.state.store(epoch << 1 | epoch_pinned, Order::Relaxed);
+
+			// Publishes the pin before any shared node is read. Pairs with the fence in try_advance.
+			atomic_fence(Order::SeqCst);
+
+			p.pin_count += 1;
+			if (p.pin_count % advance_interval == 0) {
+				try_advance();
+			}
+			run_expired(p, m_epoch.load(Order::Acquire));
+		}
+		return EpochGuard(*this, index);
+	}
+
+	void EpochDomain::unpin(u32 index) const {
+		Participant& p = participant(index);
+		MACH_ASSERT(p.pin_depth > 0);
+		p.pin_depth -= 1;
+		if (p.pin_depth == 0) {
+			p.state.store(p.state.load(Order::Relaxed) & ~epoch_pinned, Order::Release);
+		}
+	}
+
+	void EpochDomain::collect(u32 index) const {
+		MACH_ASSERT(index < m_participants.len(), "Participant index is out of range");
+		Participant& p = participant(index);
+
+		// Advancing writes the shared epoch, so participants with nothing waiting on it leave it alone
+		bool has_deferred = false;
+		for (const auto& bag : p.bags) {
+			has_deferred |= !bag.deferred.is_empty();
+		}
+		if (!has_deferred) {
+			return;
+		}
+
+		try_advance();
+		run_expired(p, m_epoch.load(Order::Acquire));
+	}
+
+	void EpochDomain::defer(u32 index, Deferred deferred) const {
+		Participant& p = participant(index);
+		MACH_ASSERT(p.pin_depth > 0, "Can only defer while pinned");
+
+		const u64 epoch = p.state.load(Order::Relaxed) >> 1;
+		Bag& bag = p.bags[epoch % 3];
+		if (bag.epoch != epoch) {
+			// The bag was last filled three or more epochs ago, which is always old enough to run
+			run_expired(p, m_epoch.load(Order::Acquire));
+			bag.epoch = epoch;
+		}
+		bag.deferred.push(deferred);
+
+		if (bag.deferred.len() % advance_interval == 0) {
+			try_advance();
+		}
+	}
+
+	void EpochDomain::try_advance() const {
+		const u64 epoch = m_epoch.load(Order::Relaxed);
+		atomic_fence(Order::SeqCst);
+
+		// Only moves on once every pinned participant has seen the current epoch. Acquire pairs with the Release in
+		// unpin, so reads a participant made before unpinning happen before anything deferred runs.
+		for (const auto& p : m_participants) {
+			const u64 state = p.state.load(Order::Acquire);
+			if ((state & epoch_pinned) != 0 && state >> 1 != epoch) {
+				return;
+			}
+		}
+
+		const auto unused = m_epoch.compare_exchange_strong(epoch, epoch + 1, Order::Release);
+		MACH_UNUSED(unused);
+	}
+
+	void EpochDomain::run_expired(Participant& p, u64 epoch) const {
+		for (auto& bag : p.bags) {
+			if (bag.deferred.is_empty() || bag.epoch + 3 > epoch) {
+				continue;
+			}
+
+			// Taken out first so a deferred call that defers again lands in a fresh bag
+			const Array<Deferred> expired = Mach::move(bag.deferred);
+			for (const auto& deferred : expired) {
+				deferred.f(deferred.context, deferred.ptr);
+			}
+		}
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	struct EpochCounted {
+		Atomic<u32>& destroyed;
+		u64 magic = 0xDEADBEEF;
+
+		~EpochCounted() {
+			magic = 0;
+			const auto unused = destroyed.fetch_add(1, Order::Relaxed);
+			MACH_UNUSED(unused);
+		}
+	};
+
+	EpochCounted* create_counted(Atomic<u32>& destroyed) {
+		auto memory = Memory::alloc(Memory::Layout::single<EpochCounted>());
+		return Memory::emplace<EpochCounted>(*memory, destroyed);
+	}
+
+	MACH_TEST_CASE("EpochDomain") {
+		MACH_SUBCASE("waits for pinned participants") {
+			Atomic<u32> destroyed{ 0 };
+			EpochDomain domain;
+			domain.init(2);
+
+			{
+				const auto reader = domain.pin(1);
+				{
+					const auto writer = domain.pin(0);
+					writer.retire(create_counted(destroyed));
+				}
+
+				// The reader pinned before the retire, so the epoch can not move far enough while it stays pinned
+				for (u32 i = 0; i < 10; i += 1) {
+					domain.collect(0);
+				}
+				MACH_CHECK(destroyed.load() == 0);
+			}
+
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+			}
+			MACH_CHECK(destroyed.load() == 1);
+		}
+
+		MACH_SUBCASE("collecting without garbage leaves the epoch alone") {
+			Atomic<u32> destroyed{ 0 };
+			EpochDomain domain;
+			domain.init(2);
+
+			const u64 start = domain.epoch();
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+				domain.collect(1);
+			}
+			MACH_CHECK(domain.epoch() == start);
+
+			{
+				const auto guard = domain.pin(0);
+				guard.retire(create_counted(destroyed));
+			}
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+			}
+			MACH_CHECK(destroyed.load() == 1);
+			MACH_CHECK(domain.epoch() > start);
+
+			// Everything deferred has run, so the epoch stays put again
+			const u64 drained = domain.epoch();
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+			}
+			MACH_CHECK(domain.epoch() == drained);
+		}
+
+		MACH_SUBCASE("guards nest") {
+			Atomic<u32> destroyed{ 0 };
+			EpochDomain domain;
+			domain.init(1);
+
+			{
+				const auto outer = domain.pin(0);
+				{
+					const auto inner = domain.pin(0);
+					inner.retire(create_counted(destroyed));
+				}
+				for (u32 i = 0; i < 10; i += 1) {
+					domain.collect(0);
+				}
+			}
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+			}
+			MACH_CHECK(destroyed.load() == 1);
+		}
+
+		MACH_SUBCASE("runs what is left when destroyed") {
+			Atomic<u32> destroyed{ 0 };
+			{
+				EpochDomain domain;
+				domain.init(1);
+				const auto guard = domain.pin(0);
+				guard.retire(create_counted(destroyed));
+				guard.retire(create_counted(destroyed));
+			}
+			MACH_CHECK(destroyed.load() == 2);
+		}
+
+		MACH_SUBCASE("readers never see freed nodes") {
+			static constexpr u32 thread_count = 4;
+			static constexpr u32 iterations = 20000;
+
+			Atomic<u32> destroyed{ 0 };
+			EpochDomain domain;
+			domain.init(thread_count);
+			Atomic<EpochCounted*> shared{ create_counted(destroyed) };
+			Atomic<u32> bad_reads{ 0 };
+
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < thread_count; index += 1) {
+				threads.push(Thread::spawn([&, index] {
+					for (u32 i = 0; i < iterations; i += 1) {
+						const auto guard = domain.pin(index);
+						EpochCounted* const current = shared.load(Order::Acquire);
+						if (current->magic != 0xDEADBEEF) {
+							const auto unused = bad_reads.fetch_add(1, Order::Relaxed);
+							MACH_UNUSED(unused);
+						}
+
+						// Every so often swap in a fresh node and retire the old one
+						if (i % 8 == index % 8) {
+							EpochCounted* const replaced = shared.exchange(create_counted(destroyed), Order::AcqRel);
+							guard.retire(replaced);
+						}
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+
+			MACH_CHECK(bad_reads.load() == 0);
+			const auto guard = domain.pin(0);
+			guard.retire(shared.load());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("EpochDomain pin") {
+	using namespace Mach::Core;
+
+	EpochDomain domain;
+	domain.init(4);
+	bencher.set_items(1024);
+	bencher.iter([&domain] {
+		u32 sum = 0;
+		for (u32 i = 0; i < 1024; i += 1) {
+			const auto guard = domain.pin(0);
+			sum += guard.participant();
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
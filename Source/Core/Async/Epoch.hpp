@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Atomic.hpp>
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+
+namespace Mach::Core {
+	class EpochDomain;
+
+	using EpochDeferFn = void (*)(void* context, void* ptr);
+
+	/**
+	 * Keeps its participant pinned to the current epoch for as long as it lives. Anything read from a lock free
+	 * structure while a guard is alive stays valid until the guard is dropped, even if another thread removes it.
+	 *
+	 * Guards nest. A guard must not be held across Scheduler::wait_for, as the fiber may resume on another worker.
+	 */
+	class EpochGuard {
+	public:
+		MACH_NO_COPY(EpochGuard);
+		EpochGuard(EpochGuard&& move) noexcept : m_domain(move.m_domain), m_participant(move.m_participant) {
+			move.m_domain = nullptr;
+		}
+		EpochGuard& operator=(EpochGuard&& move) = delete;
+		~EpochGuard();
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 participant() const { return m_participant; }
+
+		/**
+		 * Calls f(context, ptr) once no participant that is pinned now can still be reading ptr. ptr must already be
+		 * unreachable for anyone who pins from here on.
+		 */
+		void defer(EpochDeferFn f, void* context, void* ptr) const;
+
+		// Destroys value and frees its memory once it is safe to. value must have been allocated with Memory::alloc.
+		template <typename T>
+		void retire(T* value) const {
+			defer(
+				[](void*, void* ptr) {
+					static_cast<T*>(ptr)->~T();
+					Memory::free(ptr);
+				},
+				nullptr,
+				value);
+		}
+
+	private:
+		friend class EpochDomain;
+
+		EpochGuard(EpochDomain const& domain, u32 participant) : m_domain(&domain), m_participant(participant) {}
+
+		EpochDomain const* m_domain;
+		u32 m_participant;
+	};
+
+	/**
+	 * Epoch based memory reclamation. Each thread works through its own participant and pins it while it reads
+	 * shared nodes. Removed nodes are deferred rather than freed, and the global epoch only moves forward once every
+	 * pinned participant has seen the current one. Two steps after a node is removed, every participant that could
+	 * have read it has unpinned and it is safe to free.
+	 *
+	 * Participants are not thread safe themselves. Each one must only be used from one thread at a time, which is what
+	 * Scheduler does by giving every worker its own.
+	 *
+	 * Source: Keir Fraser, Practical lock-freedom, and crossbeam-epoch
+	 * https://github.com/crossbeam-rs/crossbeam/tree/master/crossbeam-epoch
+	 */
+	class EpochDomain {
+	public:
+		explicit EpochDomain() = default;
+
+		MACH_NO_COPY(EpochDomain);
+		MACH_NO_MOVE(EpochDomain);
+
+		// Runs everything still deferred. No participant may be pinned.
+		~EpochDomain();
+
+		void init(u32 participant_count);
+
+		MACH_NO_DISCARD EpochGuard pin(u32 participant) const;
+
+		// Tries to move the epoch forward and runs whatever participant deferred that has become safe to run. Does
+		// nothing if participant has nothing deferred, so idle loops can call it without contending on the epoch.
+		void collect(u32 participant) const;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u64 epoch() const { return m_epoch.load(Order::Relaxed); }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 participant_count() const {
+			return static_cast<u32>(m_participants.len());
+		}
+
+	private:
+		friend class EpochGuard;
+
+		struct Deferred {
+			EpochDeferFn f;
+			void* context;
+			void* ptr;
+		};
+
+		/**
+		 * Calls deferred while pinned at epoch. The global epoch may already have been one ahead at the time, so they
+		 * only run once it reaches epoch + 3. Each bag is reused every third epoch.
+		 */
+		struct Bag {
+			u64 epoch = 0;
+			Array<Deferred> deferred;
+		};
+
+		// Padded rather than aligned, as Memory::alloc does not honour alignment past malloc's
+		struct Participant {
+			u8 front_padding[MACH_CACHE_LINE_SIZE] = {};
+			// Epoch shifted up by one with the lowest bit set while pinned. The only field other participants read.
+			Atomic<u64> state{ 0 };
+			u8 back_padding[MACH_CACHE_LINE_SIZE] = {};
+
+			u32 pin_depth = 0;
+			u32 pin_count = 0;
+			Bag bags[3];
+		};
+
+		// Pins every this many times try to advance the epoch, so one that never collects still lets it move
+		static constexpr u32 advance_interval = 64;
+
+		MACH_ALWAYS_INLINE Participant& participant(u32 index) const {
+			return const_cast<Participant&>(m_participants[index]);
+		}
+
+		void unpin(u32 participant) const;
+		void defer(u32 participant, Deferred deferred) const;
+		void try_advance() const;
+		void run_expired(Participant& participant, u64 epoch) const;
+
+		UniquePtr<Participant[]> m_participants;
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<u64> m_epoch{ 0 };
+	};
+
+	MACH_ALWAYS_INLINE inline EpochGuard::~EpochGuard() {
+		if (m_domain != nullptr) {
+			m_domain->unpin(m_participant);
+		}
+	}
+
+	MACH_ALWAYS_INLINE inline void EpochGuard::defer(EpochDeferFn f, void* context, void* ptr) const {
+		m_domain->defer(m_participant, EpochDomain::Deferred{ .f = f, .context = context, .ptr = ptr });
+	}
+} // namespace Mach::Core
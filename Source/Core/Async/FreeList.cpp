@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/FreeList.hpp>
+
+#include <Core/Async/Thread.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("FreeList") {
+		MACH_SUBCASE("reuses nodes once they are safe") {
+			// The domain is declared last so it is destroyed first, while the pool it pushes back into is alive
+			FreeList<u64> pool;
+			EpochDomain domain;
+			domain.init(1);
+
+			u64* first;
+			u64* second;
+			{
+				const auto guard = domain.pin(0);
+				first = pool.create(guard, 7u);
+				MACH_CHECK(*first == 7);
+				pool.destroy(guard, first);
+
+				// Still deferred, so a new value gets a new node
+				second = pool.create(guard, 8u);
+				MACH_CHECK(second != first);
+				pool.destroy(guard, second);
+			}
+
+			for (u32 i = 0; i < 10; i += 1) {
+				domain.collect(0);
+			}
+
+			const auto guard = domain.pin(0);
+			u64* const reused = pool.create(guard, 9u);
+			MACH_CHECK((reused == first || reused == second));
+			MACH_CHECK(*reused == 9);
+			pool.destroy(guard, reused);
+		}
+
+		MACH_SUBCASE("values are never handed out twice") {
+			static constexpr u32 thread_count = 4;
+			static constexpr u32 iterations = 20000;
+			static constexpr u32 held = 8;
+
+			struct Owned {
+				u32 owner;
+				u32 sequence;
+			};
+
+			FreeList<Owned> pool;
+			pool.reserve(16);
+			EpochDomain domain;
+			domain.init(thread_count);
+			Atomic<u32> conflicts{ 0 };
+
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < thread_count; index += 1) {
+				threads.push(Thread::spawn([&, index] {
+					Owned* values[held] = {};
+					for (u32 i = 0; i < iterations; i += 1) {
+						const auto guard = domain.pin(index);
+						Owned*& slot = values[i % held];
+						if (slot != nullptr) {
+							// Another thread writing to the same node would have changed it
+							if (slot->owner != index || slot->sequence != i - held) {
+								const auto unused = conflicts.fetch_add(1, Order::Relaxed);
+								MACH_UNUSED(unused);
+							}
+							pool.destroy(guard, slot);
+						}
+						slot = pool.create(guard, Owned{ .owner = index, .sequence = i });
+					}
+
+					const auto guard = domain.pin(index);
+					for (Owned* value : values) {
+						pool.destroy(guard, value);
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+
+			MACH_CHECK(conflicts.load() == 0);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("FreeList create destroy") {
+	using namespace Mach::Core;
+
+	static FreeList<u64> pool;
+	static EpochDomain domain;
+	static bool initialized = false;
+	if (!initialized) {
+		initialized = true;
+		domain.init(1);
+		pool.reserve(1024);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([] {
+		const auto guard = domain.pin(0);
+		u64 sum = 0;
+		for (u64 i = 0; i < 1024; i += 1) {
+			u64* const value = pool.create(guard, i);
+			sum += *value;
+			pool.destroy(guard, value);
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Epoch.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Lock free pool of T kept on a Treiber stack. Creating a value pops a node off the stack, or allocates one when
+	 * it is empty, so a pool that has warmed up stops going to the allocator.
+	 *
+	 * Destroyed values go through the EpochDomain first. The node is only destroyed and pushed back once every
+	 * participant that could still be reading it has unpinned, which keeps readers of structures built from these nodes
+	 * safe and rules out ABA on the stack, as no node can return to it while a pop that saw it is still running.
+	 *
+	 * Nodes waiting in the domain point back at the pool, so the domain must be collected or destroyed before the pool.
+	 *
+	 * Source: R. Kent Treiber, Systems Programming: Coping with Parallelism
+	 */
+	template <typename T>
+	class FreeList {
+		// The value comes first so a T* is also a pointer to its node
+		struct Node {
+			alignas(T) u8 value[sizeof(T)];
+			Atomic<Node*> next{ nullptr };
+		};
+
+	public:
+		explicit FreeList() = default;
+
+		MACH_NO_COPY(FreeList);
+		MACH_NO_MOVE(FreeList);
+
+		~FreeList() {
+			MACH_ASSERT(m_pending.load(Order::Acquire) == 0, "FreeList destroyed with values still in its EpochDomain");
+			Node* node = m_head.load(Order::Acquire);
+			while (node != nullptr) {
+				Node* const next = node->next.load(Order::Relaxed);
+				node->~Node();
+				Memory::free(node);
+				node = next;
+			}
+		}
+
+		// Allocates count nodes up front so the first count creates do not have to
+		void reserve(usize count) const {
+			for (usize index = 0; index < count; index += 1) {
+				push(allocate_node());
+			}
+		}
+
+		// The guard must stay alive until the pop is done, which is what keeps a node from being reused under it
+		template <typename... Args>
+		MACH_NO_DISCARD T* create(EpochGuard const& guard, Args&&... args) const {
+			MACH_UNUSED(guard);
+			Node* node = pop();
+			if (node == nullptr) {
+				node = allocate_node();
+			}
+			return Memory::emplace<T>(node->value, Mach::forward<Args>(args)...);
+		}
+
+		/**
+		 * Destroys value and returns its node to the pool once no pinned participant can still be reading it. value
+		 * must have come from create on this pool and already be unreachable for anyone who pins from here on.
+		 */
+		void destroy(EpochGuard const& guard, T* value) const {
+			const auto unused = m_pending.fetch_add(1, Order::Relaxed);
+			MACH_UNUSED(unused);
+			guard.defer(&FreeList::recycle, const_cast<FreeList*>(this), value);
+		}
+
+	private:
+		static void recycle(void* context, void* ptr) {
+			FreeList const* const pool = static_cast<FreeList const*>(context);
+			static_cast<T*>(ptr)->~T();
+			pool->push(reinterpret_cast<Node*>(ptr));
+			const auto unused = pool->m_pending.fetch_sub(1, Order::Release);
+			MACH_UNUSED(unused);
+		}
+
+		static Node* allocate_node() {
+			auto memory = Memory::alloc(Memory::Layout::single<Node>());
+			return Memory::emplace<Node>(*memory);
+		}
+
+		void push(Node* node) const {
+			Node* head = m_head.load(Order::Relaxed);
+			while (true) {
+				node->next.store(head, Order::Relaxed);
+				if (m_head.compare_exchange_weak(head, node, Order::Release).is_set()) {
+					return;
+				}
+				head = m_head.load(Order::Relaxed);
+			}
+		}
+
+		Node* pop() const {
+			Node* head = m_head.load(Order::Acquire);
+			while (head != nullptr) {
+				// Nodes are never freed while the pool is alive, so reading next is safe even if head was just taken
+				Node* const next = head->next.load(Order::Relaxed);
+				if (m_head.compare_exchange_weak(head, next, Order::Acquire).is_set()) {
+					return head;
+				}
+				head = m_head.load(Order::Acquire);
+			}
+			return nullptr;
+		}
+
+		Atomic<Node*> m_head{ nullptr };
+		Atomic<usize> m_pending{ 0 };
+	};
+} // namespace Mach::Core
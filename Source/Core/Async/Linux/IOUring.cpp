@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/Linux/IOUring.hpp>
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace Mach::Core {
+	// User data of the nop used to wake the reaper thread on shutdown. Requests always have a non null address.
+	static constexpr u64 wake_user_data = 0;
+
+	static int io_uring_setup(u32 entries, io_uring_params* params) {
+		return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+	}
+
+	static int io_uring_enter(int fd, u32 to_submit, u32 min_complete, u32 flags) {
+		return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+	}
+
+	static int io_uring_register(int fd, u32 opcode, void const* arg, u32 nr_args) {
+		return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+	}
+
+	template <typename T>
+	static T* ring_offset(void* ring, u32 offset) {
+		return reinterpret_cast<T*>(static_cast<u8*>(ring) + offset);
+	}
+
+	Option<UniquePtr<IOUring>> IOUring::create(u32 queue_depth) {
+		io_uring_params params = {};
+		const int fd = io_uring_setup(queue_depth, &params);
+		if (fd < 0) {
+			return nullopt;
+		}
+
+		Ring ring;
+		ring.fd = fd;
+		ring.sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+		ring.cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		// Newer kernels map both rings with a single mmap
+		const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if (single_mmap) {
+			const usize size = ring.sq_ring_size > ring.cq_ring_size ? ring.sq_ring_size : ring.cq_ring_size;
+			ring.sq_ring_size = size;
+			ring.cq_ring_size = size;
+		}
+
+		const int prot = PROT_READ | PROT_WRITE;
+		const int flags = MAP_SHARED | MAP_POPULATE;
+		ring.sq_ring = ::mmap(nullptr, ring.sq_ring_size, prot, flags, fd, IORING_OFF_SQ_RING);
+		if (ring.sq_ring == MAP_FAILED) {
+			::close(fd);
+			return nullopt;
+		}
+
+		if (single_mmap) {
+			ring.cq_ring = ring.sq_ring;
+		} else {
+			ring.cq_ring = ::mmap(nullptr, ring.cq_ring_size, prot, flags, fd, IORING_OFF_CQ_RING);
+			if (ring.cq_ring == MAP_FAILED) {
+				::munmap(ring.sq_ring, ring.sq_ring_size);
+				::close(fd);
+				return nullopt;
+			}
+		}
+
+		ring.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = ::mmap(nullptr, ring.sqes_size, prot, flags, fd, IORING_OFF_SQES);
+		if (sqes == MAP_FAILED) {
+			if (!single_mmap) ::munmap(ring.cq_ring, ring.cq_ring_size);
+			::munmap(ring.sq_ring, ring.sq_ring_size);
+			::close(fd);
+			return nullopt;
+		}
+		ring.sqes = static_cast<io_uring_sqe*>(sqes);
+
+		ring.sq_head = ring_offset<u32>(ring.sq_ring, params.sq_off.head);
+		ring.sq_tail = ring_offset<u32>(ring.sq_ring, params.sq_off.tail);
+		ring.sq_mask = *ring_offset<u32>(ring.sq_ring, params.sq_off.ring_mask);
+		ring.sq_entries = *ring_offset<u32>(ring.sq_ring, params.sq_off.ring_entries);
+		ring.sq_array = ring_offset<u32>(ring.sq_ring, params.sq_off.array);
+
+		ring.cq_head = ring_offset<u32>(ring.cq_ring, params.cq_off.head);
+		ring.cq_tail = ring_offset<u32>(ring.cq_ring, params.cq_off.tail);
+		ring.cq_mask = *ring_offset<u32>(ring.cq_ring, params.cq_off.ring_mask);
+		ring.cqes = ring_offset<io_uring_cqe>(ring.cq_ring, params.cq_off.cqes);
+
+		IOUring service{ ring };
+		auto result = UniquePtr<IOUring>::create(Mach::move(service));
+		result->start();
+		return result;
+	}
+
+	IOUring::IOUring(IOUring&& move) noexcept
+		: m_ring(move.m_ring)
+		, m_submitter(Mach::move(move.m_submitter))
+		, m_reaper(Mach::move(move.m_reaper)) {
+		MACH_ASSERT(!m_reaper.is_valid(), "Can not move an IOUring once started");
+		move.m_ring = Ring{};
+	}
+
+	void IOUring::start() {
+		m_reaper = Thread::spawn([this]() { reaper_main(); }, Thread::SpawnInfo{ .name = u8"IOUring Reaper"_sv });
+	}
+
+	void IOUring::submit(IOBatch const& batch) const {
+		begin(batch);
+
+		auto submitter = m_submitter.lock();
+		for (IORequest& request : batch.requests()) {
+			// sqe.len is 32 bits, so a larger request would be cut short and still look like it succeeded
+			MACH_ASSERT(request.bytes.len() <= NumericLimits<u32>::max(), "IORequest is too large for io_uring");
+			if (request.bytes.len() > NumericLimits<u32>::max()) {
+				complete(request, -EINVAL);
+				continue;
+			}
+			push(*submitter, &request);
+		}
+
+		const u32 tail = *m_ring.sq_tail;
+		const u32 head = __atomic_load_n(m_ring.sq_head, __ATOMIC_ACQUIRE);
+		const bool submitted = flush(tail - head);
+		MACH_UNUSED(submitted);
+	}
+
+	bool IOUring::register_buffers(Slice<Slice<u8> const> buffers) {
+		Array<iovec> iovecs;
+		iovecs.reserve(buffers.len());
+		for (Slice<u8> const& buffer : buffers) {
+			iovecs.push(iovec{ .iov_base = buffer.begin(), .iov_len = buffer.len() });
+		}
+
+		auto submitter = m_submitter.lock();
+		if (submitter->buffers.len() > 0) {
+			const int result = io_uring_register(m_ring.fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+			MACH_UNUSED(result);
+			submitter->buffers.reset();
+		}
+
+		const int result =
+			io_uring_register(m_ring.fd, IORING_REGISTER_BUFFERS, iovecs.begin(), static_cast<u32>(iovecs.len()));
+		if (result < 0) {
+			return false;
+		}
+
+		for (Slice<u8> const& buffer : buffers) {
+			submitter->buffers.push(buffer);
+		}
+		return true;
+	}
+
+	IOUring::~IOUring() {
+		if (m_ring.fd == -1) {
+			return;
+		}
+
+		if (m_reaper.is_valid()) {
+			m_running.store(false, Order::Release);
+			{
+				auto submitter = m_submitter.lock();
+				push_nop();
+				const bool woken = flush(1);
+				MACH_ASSERT(woken, "Failed to wake the IOUring reaper");
+			}
+			m_reaper.unsafe_get_mut().join();
+		}
+
+		::munmap(m_ring.sqes, m_ring.sqes_size);
+		if (m_ring.cq_ring != m_ring.sq_ring) {
+			::munmap(m_ring.cq_ring, m_ring.cq_ring_size);
+		}
+		::munmap(m_ring.sq_ring, m_ring.sq_ring_size);
+		::close(m_ring.fd);
+		m_ring.fd = -1;
+	}
+
+	void IOUring::push(Submitter const& submitter, IORequest* request) const {
+		const u32 tail = *m_ring.sq_tail;
+		const u32 head = __atomic_load_n(m_ring.sq_head, __ATOMIC_ACQUIRE);
+		if (tail - head == m_ring.sq_entries) {
+			flush(tail - head);
+		}
+
+		// Use the fixed variants when the request lives entirely inside a registered buffer
+		Option<u16> buffer_index = nullopt;
+		for (usize index = 0; index < submitter.buffers.len(); index += 1) {
+			Slice<u8> const& buffer = submitter.buffers[index];
+			if (request->bytes.begin() >= buffer.begin() && request->bytes.end() <= buffer.end()) {
+				buffer_index = static_cast<u16>(index);
+				break;
+			}
+		}
+
+		const u32 index = tail & m_ring.sq_mask;
+		io_uring_sqe& sqe = m_ring.sqes[index];
+		Memory::set(&sqe, 0, sizeof(sqe));
+
+		const bool is_read = request->kind == IORequest::Kind::Read;
+		if (buffer_index.is_set()) {
+			sqe.opcode = is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+			sqe.buf_index = buffer_index.unwrap();
+		} else {
+			sqe.opcode = is_read ? IORING_OP_READ : IORING_OP_WRITE;
+		}
+		sqe.fd = request->file->fd();
+		sqe.addr = reinterpret_cast<u64>(request->bytes.begin());
+		sqe.len = static_cast<u32>(request->bytes.len());
+		sqe.off = request->offset;
+		sqe.user_data = reinterpret_cast<u64>(request);
+
+		m_ring.sq_array[index] = index;
+		__atomic_store_n(m_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	void IOUring::push_nop() const {
+		const u32 tail = *m_ring.sq_tail;
+		const u32 head = __atomic_load_n(m_ring.sq_head, __ATOMIC_ACQUIRE);
+		if (tail - head == m_ring.sq_entries) {
+			flush(tail - head);
+		}
+
+		const u32 index = tail & m_ring.sq_mask;
+		io_uring_sqe& sqe = m_ring.sqes[index];
+		Memory::set(&sqe, 0, sizeof(sqe));
+		sqe.opcode = IORING_OP_NOP;
+		sqe.user_data = wake_user_data;
+
+		m_ring.sq_array[index] = index;
+		__atomic_store_n(m_ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	bool IOUring::flush(u32 to_submit) const {
+		while (to_submit > 0) {
+			const int result = io_uring_enter(m_ring.fd, to_submit, 0, 0);
+			if (result < 0) {
+				// EBUSY means the completion ring is backed up. Give the reaper a chance to drain it.
+				if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+					::sched_yield();
+					continue;
+				}
+				fail_unsubmitted(-static_cast<isize>(errno));
+				return false;
+			}
+			to_submit -= static_cast<u32>(result);
+		}
+		return true;
+	}
+
+	void IOUring::fail_unsubmitted(isize result) const {
+		// Without SQPOLL the kernel only looks at the tail inside io_uring_enter, which we are serialized with, so
+		// everything between its head and our tail is still ours to take back
+		const u32 head = __atomic_load_n(m_ring.sq_head, __ATOMIC_ACQUIRE);
+		const u32 tail = *m_ring.sq_tail;
+		__atomic_store_n(m_ring.sq_tail, head, __ATOMIC_RELEASE);
+
+		for (u32 position = head; position != tail; position += 1) {
+			io_uring_sqe const& sqe = m_ring.sqes[m_ring.sq_array[position & m_ring.sq_mask]];
+			if (sqe.user_data != wake_user_data) {
+				complete(*reinterpret_cast<IORequest*>(sqe.user_data), result);
+			}
+		}
+	}
+
+	void IOUring::reaper_main() const {
+		while (true) {
+			u32 head = *m_ring.cq_head;
+			const u32 tail = __atomic_load_n(m_ring.cq_tail, __ATOMIC_ACQUIRE);
+			if (head == tail) {
+				const int result = io_uring_enter(m_ring.fd, 0, 1, IORING_ENTER_GETEVENTS);
+				MACH_UNUSED(result);
+				continue;
+			}
+
+			bool woken = false;
+			for (; head != tail; head += 1) {
+				io_uring_cqe const& cqe = m_ring.cqes[head & m_ring.cq_mask];
+				if (cqe.user_data == wake_user_data) {
+					woken = true;
+					continue;
+				}
+				complete(*reinterpret_cast<IORequest*>(cqe.user_data), static_cast<isize>(cqe.res));
+			}
+			__atomic_store_n(m_ring.cq_head, head, __ATOMIC_RELEASE);
+
+			if (woken && !m_running.load(Order::Acquire)) {
+				break;
+			}
+		}
+	}
+} // namespace Mach::Core
@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/AsyncIO.hpp>
+#include <Core/Async/Mutex.hpp>
+#include <Core/Async/Thread.hpp>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace Mach::Core {
+	// AsyncIO backend talking to io_uring directly through its syscalls. Requests are pushed onto the submission ring
+	// under a lock and a dedicated thread blocks on the completion ring, resolving requests as the kernel finishes them.
+	class IOUring final : public AsyncIO {
+	public:
+		MACH_NO_DISCARD static Option<UniquePtr<IOUring>> create(u32 queue_depth);
+
+		IOUring(IOUring&& move) noexcept;
+		IOUring& operator=(IOUring&&) = delete;
+		MACH_NO_COPY(IOUring);
+
+		void submit(IOBatch const& batch) const final;
+		bool register_buffers(Slice<Slice<u8> const> buffers) final;
+
+		~IOUring() final;
+
+	private:
+		struct Ring {
+			int fd = -1;
+
+			void* sq_ring = nullptr;
+			usize sq_ring_size = 0;
+			u32* sq_head = nullptr;
+			u32* sq_tail = nullptr;
+			u32 sq_mask = 0;
+			u32 sq_entries = 0;
+			u32* sq_array = nullptr;
+
+			io_uring_sqe* sqes = nullptr;
+			usize sqes_size = 0;
+
+			void* cq_ring = nullptr;
+			usize cq_ring_size = 0;
+			u32* cq_head = nullptr;
+			u32* cq_tail = nullptr;
+			u32 cq_mask = 0;
+			io_uring_cqe* cqes = nullptr;
+		};
+
+		struct Submitter {
+			// Registered buffers in the order they were handed to the kernel
+			Array<Slice<u8>> buffers;
+		};
+
+		explicit IOUring(Ring const& ring) : m_ring(ring), m_submitter(Submitter{}) {}
+
+		void start();
+		void reaper_main() const;
+
+		// Pushes a single sqe and flushes to the kernel if the ring is full. Must hold the submitter lock.
+		void push(Submitter const& submitter, IORequest* request) const;
+		void push_nop() const;
+		// Hands entries to the kernel. If it refuses them, every entry it has not consumed is taken back and its
+		// request completed with the error, so no request is left without a completion. Returns false in that case.
+		bool flush(u32 to_submit) const;
+		void fail_unsubmitted(isize result) const;
+
+		Ring m_ring;
+		SpinlockMutex<Submitter> m_submitter;
+		Mach::SharedPtr<Thread> m_reaper;
+		Atomic<bool> m_running{ true };
+	};
+} // namespace Mach::Core
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/MPMC.hpp>
+#include <Core/Debug/Benchmark.hpp>
+
+#if MACH_ENABLE_BENCHMARK
+	#include <Core/Async/Thread.hpp>
+
+MACH_BENCHMARK("MPMC push pop") {
+	using namespace Mach::Core;
+
+	const auto queue = MPMC<u64>::create(1024);
+	bencher.set_items(512);
+	bencher.iter([&queue] {
+		for (u64 i = 0; i < 512; i += 1) {
+			const bool pushed = queue.push(i);
+			MACH_UNUSED(pushed);
+		}
+		u64 sum = 0;
+		for (u64 i = 0; i < 512; i += 1) {
+			sum += queue.pop().unwrap_or(0);
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("MPMC contended 4 threads") {
+	using namespace Mach::Core;
+
+	static constexpr u32 thread_count = 4;
+	static constexpr u64 per_thread = 4096;
+
+	const auto queue = MPMC<u64>::create(1024);
+	bencher.set_items(thread_count * per_thread);
+	bencher.iter([&queue] {
+		// Every thread pushes and pops the same amount so none of them can be starved forever
+		Array<Mach::SharedPtr<Thread>> threads;
+		for (u32 index = 0; index < thread_count; index += 1) {
+			threads.push(Thread::spawn([&queue] {
+				for (u64 i = 0; i < per_thread; i += 1) {
+					while (!queue.push(i)) {}
+					while (!queue.pop().is_set()) {}
+				}
+			}));
+		}
+		for (auto& thread : threads) {
+			thread.unsafe_get_mut().join();
+		}
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -0,0 +1,390 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/Mutex.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+namespace Mach::Core {
+	// How many times the adaptive locks retry before parking. Roughly the cost of a futex round trip.
+	static constexpr u32 spin_limit = 128;
+
+	// Pauses per ticket ahead of us in RawSpinlock
+	static constexpr u32 pauses_per_ticket = 32;
+
+	void RawSpinlock::lock_slow(u32 ticket) const {
+		u32 last_serving = m_serving.load(Order::Acquire);
+		u32 stalled = 0;
+		while (true) {
+			const u32 serving = m_serving.load(Order::Acquire);
+			if (serving == ticket) {
+				return;
+			}
+
+			// A line that stops moving usually means the holder or the next in line was preempted, which with more
+			// threads than cores lasts a whole time slice. Give ours up so they can run.
+			stalled = serving == last_serving ? stalled + 1 : 0;
+			last_serving = serving;
+			if (stalled >= spin_limit) {
+				stalled = 0;
+				Thread::yield_now();
+				continue;
+			}
+
+			// Waiters further back in line check less often so the holder and the next in line own the cache line
+			const u32 ahead = ticket - serving;
+			for (u32 i = 0; i < ahead * pauses_per_ticket; i += 1) {
+				spin_loop_hint();
+			}
+		}
+	}
+
+	void RawMutex::lock_slow() const {
+		for (u32 spin = 0; spin < spin_limit; spin += 1) {
+			// Only try when it looks free so waiters do not keep pulling the cache line away from the holder
+			if (m_state.load(Order::Relaxed) == Unlocked &&
+				m_state.compare_exchange_weak(Unlocked, Locked, Order::Acquire).is_set()) {
+				return;
+			}
+			spin_loop_hint();
+		}
+
+		// Taking the lock as Contended is conservative. We can not know if other threads are still parked, so the next
+		// unlock has to wake one just in case.
+		while (m_state.exchange(Contended, Order::Acquire) != Unlocked) {
+			m_state.wait(Contended, Order::Relaxed);
+		}
+	}
+
+	void RawFiberMutex::lock_slow() const {
+		for (u32 spin = 0; spin < spin_limit; spin += 1) {
+			spin_loop_hint();
+			if (try_lock()) {
+				return;
+			}
+		}
+
+		class UnlockedTask final : public Task {
+		public:
+			explicit UnlockedTask(RawFiberMutex const& mutex) : m_mutex(mutex) {}
+
+			MACH_NO_DISCARD Status status() const final {
+				return m_mutex.m_locked.load(Order::Relaxed) ? Status::InProgress : Status::Complete;
+			}
+
+		private:
+			RawFiberMutex const& m_mutex;
+		};
+
+		// Another fiber may grab the lock between being resumed and trying again, in which case we go back to sleep
+		const UnlockedTask task{ *this };
+		while (!try_lock()) {
+			m_scheduler->wait_for(task);
+		}
+	}
+
+	void RawRwLock::lock_shared_slow() const {
+		u32 spins = 0;
+		while (true) {
+			const u32 state = m_state.load(Order::Relaxed);
+			if ((state & (Writer | WaitingWriterMask)) == 0) {
+				MACH_ASSERT((state & ReaderMask) != ReaderMask, "Too many readers holding RawRwLock");
+				if (m_state.compare_exchange_weak(state, state + 1, Order::Acquire).is_set()) {
+					return;
+				}
+				continue;
+			}
+
+			if (spins < spin_limit) {
+				spins += 1;
+				spin_loop_hint();
+				continue;
+			}
+			park(state);
+		}
+	}
+
+	void RawRwLock::lock_slow() const {
+		u32 spins = 0;
+		bool waiting = false;
+		while (true) {
+			const u32 state = m_state.load(Order::Relaxed);
+			if ((state & (Writer | ReaderMask)) == 0) {
+				const u32 desired = (waiting ? state - WaitingWriter : state) | Writer;
+				if (m_state.compare_exchange_weak(state, desired, Order::Acquire).is_set()) {
+					return;
+				}
+				continue;
+			}
+
+			// Announce ourselves so new readers hold off until we have had our turn
+			if (!waiting) {
+				const auto unused = m_state.fetch_add(WaitingWriter, Order::Relaxed);
+				MACH_UNUSED(unused);
+				waiting = true;
+				continue;
+			}
+
+			if (spins < spin_limit) {
+				spins += 1;
+				spin_loop_hint();
+				continue;
+			}
+			park(state);
+		}
+	}
+
+	void RawRwLock::park(u32 state) const {
+		if ((state & Parked) == 0 && !m_state.compare_exchange_weak(state, state | Parked, Order::Relaxed).is_set()) {
+			// The state moved on while we were deciding to sleep, so look at it again
+			return;
+		}
+		m_state.wait(state | Parked, Order::Relaxed);
+	}
+
+	void RawRwLock::wake_all() const {
+		// Everyone wakes up and re-checks. Whoever still can not get the lock sets Parked again before sleeping.
+		const auto unused = m_state.fetch_and(~Parked, Order::Relaxed);
+		MACH_UNUSED(unused);
+		m_state.notify_all();
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	// Runs f on thread_count threads at once and waits for all of them
+	template <typename F>
+	void run_threads(u32 thread_count, F f) {
+		Array<Mach::SharedPtr<Thread>> threads;
+		for (u32 index = 0; index < thread_count; index += 1) {
+			threads.push(Thread::spawn([&f, index] { f(index); }));
+		}
+		for (auto& thread : threads) {
+			thread.unsafe_get_mut().join();
+		}
+	}
+
+	template <typename M>
+	void check_mutex() {
+		MACH_SUBCASE("try_lock") {
+			const M mutex{ 5 };
+			{
+				auto guard = mutex.lock();
+				MACH_CHECK(*guard == 5);
+				*guard = 6;
+				MACH_CHECK(!mutex.try_lock().is_set());
+			}
+			auto guard = mutex.try_lock();
+			MACH_REQUIRE(guard.is_set());
+			MACH_CHECK(*guard.as_ref().unwrap() == 6);
+		}
+
+		MACH_SUBCASE("contended") {
+			const M mutex{ 0 };
+			run_threads(4, [&mutex](u32) {
+				for (u32 i = 0; i < 20000; i += 1) {
+					*mutex.lock() += 1;
+				}
+			});
+			MACH_CHECK(*mutex.lock() == 80000);
+		}
+	}
+
+	MACH_TEST_CASE("SpinlockMutex") { check_mutex<SpinlockMutex<u32>>(); }
+
+	MACH_TEST_CASE("Mutex") { check_mutex<Mutex<u32>>(); }
+
+	MACH_TEST_CASE("FiberMutex") {
+		MACH_SUBCASE("uncontended") {
+			// The uncontended path never touches the Scheduler
+			Scheduler scheduler;
+			const FiberMutex<u32> mutex{ 5, scheduler };
+			{
+				auto guard = mutex.lock();
+				*guard = 6;
+				MACH_CHECK(!mutex.try_lock().is_set());
+			}
+			MACH_CHECK(*mutex.lock() == 6);
+		}
+
+		MACH_SUBCASE("contended") {
+			class CountTask final : public Task {
+			public:
+				explicit CountTask(u32 target) : m_target(target) {}
+
+				MACH_NO_DISCARD Status status() const final {
+					return count.load(Order::Acquire) >= m_target ? Status::Complete : Status::InProgress;
+				}
+
+				Atomic<u32> count{ 0 };
+
+			private:
+				u32 m_target;
+			};
+
+			// A single worker keeps the Scheduler from leaving threads behind. Jobs only run while this thread waits.
+			// Every job and this thread may be waiting at once, plus a fiber to run the worker loop.
+			static constexpr u32 job_count = 8;
+			Scheduler scheduler;
+			scheduler.init({
+				.thread_count = 1,
+				.fiber_count = 16,
+				.waiting_count = 16,
+			});
+
+			// The first job holds the lock until every other job has arrived, so each of them parks on it
+			const FiberMutex<u32> mutex{ 0, scheduler };
+			const CountTask arrived{ job_count };
+			const CountTask finished{ job_count };
+			for (u32 index = 0; index < job_count; index += 1) {
+				scheduler.enqueue([&] {
+					const auto unused = arrived.count.fetch_add(1, Order::AcqRel);
+					MACH_UNUSED(unused);
+					{
+						auto guard = mutex.lock();
+						scheduler.wait_for(arrived);
+						*guard += 1;
+					}
+					for (u32 i = 0; i < 1000; i += 1) {
+						*mutex.lock() += 1;
+					}
+					const auto done = finished.count.fetch_add(1, Order::AcqRel);
+					MACH_UNUSED(done);
+				});
+			}
+			scheduler.wait_for(finished);
+			MACH_CHECK(*mutex.lock() == job_count * 1001);
+		}
+	}
+
+	MACH_TEST_CASE("RwLock") {
+		MACH_SUBCASE("shared readers") {
+			const RwLock<u32> lock{ 5 };
+			auto a = lock.read();
+			auto b = lock.try_read();
+			MACH_REQUIRE(b.is_set());
+			MACH_CHECK(*a == 5);
+			MACH_CHECK(!lock.try_write().is_set());
+		}
+
+		MACH_SUBCASE("exclusive writer") {
+			const RwLock<u32> lock{ 5 };
+			auto writer = lock.write();
+			*writer = 6;
+			MACH_CHECK(!lock.try_read().is_set());
+			MACH_CHECK(!lock.try_write().is_set());
+		}
+
+		MACH_SUBCASE("writers are preferred") {
+			const RwLock<u32> lock{ 0 };
+			Atomic<bool> written{ false };
+			auto reader = Option<RwLock<u32>::ReadGuard>{ lock.read() };
+
+			auto writer = Thread::spawn([&] {
+				*lock.write() = 1;
+				written.store(true);
+			});
+
+			// Once the writer is queued new readers have to wait, even though only a reader holds the lock
+			const auto start = Instant::now();
+			while (lock.try_read().is_set() && start.elapsed() < Duration::from_secs(5)) {
+				Thread::sleep(Duration::from_millis(1));
+			}
+			MACH_CHECK(!lock.try_read().is_set());
+			MACH_CHECK(!written.load());
+
+			reader = nullopt;
+			writer.unsafe_get_mut().join();
+			MACH_CHECK(written.load());
+			MACH_CHECK(*lock.read() == 1);
+		}
+
+		MACH_SUBCASE("contended") {
+			struct Pair {
+				u32 a = 0;
+				u32 b = 0;
+			};
+			const RwLock<Pair> lock{ Pair{} };
+			Atomic<u32> torn{ 0 };
+			run_threads(4, [&](u32 index) {
+				for (u32 i = 0; i < 10000; i += 1) {
+					if (index == 0 || i % 8 == 0) {
+						auto pair = lock.write();
+						pair->a += 1;
+						pair->b += 1;
+					} else {
+						auto pair = lock.read();
+						if (pair->a != pair->b) {
+							const auto unused = torn.fetch_add(1);
+							MACH_UNUSED(unused);
+						}
+					}
+				}
+			});
+			MACH_CHECK(torn.load() == 0);
+			MACH_CHECK(lock.read()->a == 10000 + 3 * 1250);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	template <typename M>
+	void bench_contended(Mach::Core::Bencher& bencher) {
+		using namespace Mach::Core;
+
+		static constexpr u32 thread_count = 4;
+		static constexpr u32 per_thread = 4096;
+
+		const M mutex{ 0 };
+		bencher.set_items(thread_count * per_thread);
+		bencher.iter([&mutex] {
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < thread_count; index += 1) {
+				threads.push(Thread::spawn([&mutex] {
+					for (u32 i = 0; i < per_thread; i += 1) {
+						*mutex.lock() += 1;
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+		});
+	}
+} // namespace
+
+MACH_BENCHMARK("SpinlockMutex uncontended") {
+	using namespace Mach::Core;
+
+	const SpinlockMutex<u64> mutex{ 0 };
+	bencher.set_items(1024);
+	bencher.iter([&mutex] {
+		for (u32 i = 0; i < 1024; i += 1) {
+			*mutex.lock() += 1;
+		}
+	});
+}
+
+MACH_BENCHMARK("Mutex uncontended") {
+	using namespace Mach::Core;
+
+	const Mutex<u64> mutex{ 0 };
+	bencher.set_items(1024);
+	bencher.iter([&mutex] {
+		for (u32 i = 0; i < 1024; i += 1) {
+			*mutex.lock() += 1;
+		}
+	});
+}
+
+MACH_BENCHMARK("SpinlockMutex contended 4 threads") { bench_contended<Mach::SpinlockMutex<Mach::u64>>(bencher); }
+
+MACH_BENCHMARK("Mutex contended 4 threads") { bench_contended<Mach::Mutex<Mach::u64>>(bencher); }
+#endif // MACH_ENABLE_BENCHMARK
@@ -10,43 +10,276 @@
 #include <Core/Atomic.hpp>
 
 namespace Mach::Core {
-	template <Movable T>
-	class SpinlockMutex {
+	/**
+	 * Fair ticket lock. Waiters spin with a pause in proportion to how far back in line they are, and the two counters
+	 * sit on their own cache lines so taking a ticket does not slow down the holder's unlock.
+	 *
+	 * Only for very short critical sections. Anything that can block or take long should use RawMutex.
+	 */
+	class RawSpinlock {
+	public:
+		MACH_ALWAYS_INLINE void lock() const {
+			const u32 ticket = m_next.fetch_add(1, Order::Relaxed);
+			if (m_serving.load(Order::Acquire) != ticket) {
+				lock_slow(ticket);
+			}
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool try_lock() const {
+			const u32 serving = m_serving.load(Order::Relaxed);
+			return m_next.compare_exchange_strong(serving, serving + 1, Order::Acquire).is_set();
+		}
+
+		MACH_ALWAYS_INLINE void unlock() const {
+			// Only the holder writes m_serving, so this does not need a read-modify-write
+			m_serving.store(m_serving.load(Order::Relaxed) + 1, Order::Release);
+		}
+
+	private:
+		void lock_slow(u32 ticket) const;
+
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<u32> m_next{ 0 };
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<u32> m_serving{ 0 };
+	};
+
+	/**
+	 * Mutex that spins for a short while and then parks the thread on a futex (WaitOnAddress on Windows) until it is
+	 * woken by unlock. Uncontended lock and unlock are a single atomic each.
+	 */
+	class RawMutex {
 	public:
-		explicit SpinlockMutex(T&& value) : m_value(Mach::forward<T>(value)) {}
+		MACH_ALWAYS_INLINE void lock() const {
+			if (!m_state.compare_exchange_strong(Unlocked, Locked, Order::Acquire).is_set()) {
+				lock_slow();
+			}
+		}
 
-		class Guard {
-		public:
-			MACH_ALWAYS_INLINE explicit operator T*() const { return &value(); }
-			MACH_ALWAYS_INLINE explicit operator T&() const { return value(); }
-			MACH_ALWAYS_INLINE T* operator->() const { return &value(); }
-			MACH_ALWAYS_INLINE T& operator*() const { return value(); }
-			~Guard() {
-				const auto unused = m_owner.m_start.fetch_add(1);
-				MACH_UNUSED(unused);
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool try_lock() const {
+			return m_state.compare_exchange_strong(Unlocked, Locked, Order::Acquire).is_set();
+		}
+
+		MACH_ALWAYS_INLINE void unlock() const {
+			if (m_state.exchange(Unlocked, Order::Release) == Contended) {
+				m_state.notify_one();
 			}
+		}
 
-		private:
-			explicit Guard(SpinlockMutex const& owner) : m_owner(owner) {}
-			MACH_NO_DISCARD MACH_ALWAYS_INLINE T& value() const { return const_cast<T&>(m_owner.m_value); }
+	private:
+		void lock_slow() const;
+
+		// Contended means there may be parked threads, so unlock has to wake one
+		static constexpr u32 Unlocked = 0;
+		static constexpr u32 Locked = 1;
+		static constexpr u32 Contended = 2;
 
-			friend class SpinlockMutex<T>;
+		Atomic<u32> m_state{ Unlocked };
+	};
 
-			SpinlockMutex const& m_owner;
-		};
+	/**
+	 * Mutex for code running on Scheduler fibers. Instead of blocking the thread, a contended lock suspends the calling
+	 * fiber through Scheduler::wait_for so the worker keeps running other jobs until the lock is released.
+	 *
+	 * lock may only be called from a fiber owned by scheduler. The guard is not tied to a thread, so a fiber may resume
+	 * on a different worker while it holds the lock.
+	 */
+	class RawFiberMutex {
+	public:
+		explicit RawFiberMutex(Scheduler const& scheduler) : m_scheduler(&scheduler) {}
+
+		MACH_ALWAYS_INLINE void lock() const {
+			if (!try_lock()) {
+				lock_slow();
+			}
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool try_lock() const {
+			return !m_locked.load(Order::Relaxed) && !m_locked.exchange(true, Order::Acquire);
+		}
+
+		// Waiting fibers are picked up by the workers polling their tasks, so there is nothing to wake here
+		MACH_ALWAYS_INLINE void unlock() const { m_locked.store(false, Order::Release); }
+
+	private:
+		void lock_slow() const;
+
+		Scheduler const* m_scheduler;
+		Atomic<bool> m_locked{ false };
+	};
+
+	/**
+	 * Reader-writer lock that prefers writers. Once a writer is waiting new readers queue up behind it, so a steady
+	 * stream of readers can not starve writers. Spins briefly and then parks like RawMutex.
+	 */
+	class RawRwLock {
+	public:
+		MACH_ALWAYS_INLINE void lock_shared() const {
+			const u32 state = m_state.load(Order::Relaxed);
+			if ((state & (Writer | WaitingWriterMask)) != 0 ||
+				!m_state.compare_exchange_weak(state, state + 1, Order::Acquire).is_set()) {
+				lock_shared_slow();
+			}
+		}
+
+		MACH_NO_DISCARD bool try_lock_shared() const {
+			const u32 state = m_state.load(Order::Relaxed);
+			return (state & (Writer | WaitingWriterMask)) == 0 &&
+				   m_state.compare_exchange_strong(state, state + 1, Order::Acquire).is_set();
+		}
+
+		MACH_ALWAYS_INLINE void unlock_shared() const {
+			const u32 previous = m_state.fetch_sub(1, Order::Release);
+			if ((previous & ReaderMask) == 1 && (previous & Parked) != 0) {
+				wake_all();
+			}
+		}
+
+		MACH_ALWAYS_INLINE void lock() const {
+			if (!m_state.compare_exchange_strong(0, Writer, Order::Acquire).is_set()) {
+				lock_slow();
+			}
+		}
+
+		MACH_NO_DISCARD bool try_lock() const {
+			const u32 state = m_state.load(Order::Relaxed);
+			return (state & (Writer | ReaderMask)) == 0 &&
+				   m_state.compare_exchange_strong(state, state | Writer, Order::Acquire).is_set();
+		}
+
+		MACH_ALWAYS_INLINE void unlock() const {
+			const u32 previous = m_state.fetch_and(~Writer, Order::Release);
+			if ((previous & Parked) != 0) {
+				wake_all();
+			}
+		}
+
+	private:
+		void lock_shared_slow() const;
+		void lock_slow() const;
+		void wake_all() const;
+		void park(u32 state) const;
+
+		// Bits 0 to 15 count the readers holding the lock, bits 16 to 29 the writers waiting for it
+		static constexpr u32 ReaderMask = 0xFFFF;
+		static constexpr u32 WaitingWriter = 1u << 16;
+		static constexpr u32 WaitingWriterMask = 0x3FFFu << 16;
+		// Set by anyone about to sleep on m_state so unlock knows it has to wake them
+		static constexpr u32 Parked = 1u << 30;
+		static constexpr u32 Writer = 1u << 31;
+
+		Atomic<u32> m_state{ 0 };
+	};
+
+	// Keeps a lock held until it goes out of scope and gives access to the value the lock protects
+	template <typename Lock, typename T, bool shared = false>
+	class LockGuard {
+	public:
+		explicit LockGuard(Lock const& lock, T& value) : m_lock(&lock), m_value(&value) {}
+
+		MACH_NO_COPY(LockGuard);
+		LockGuard(LockGuard&& move) : m_lock(move.m_lock), m_value(move.m_value) { move.m_lock = nullptr; }
+		LockGuard& operator=(LockGuard&&) = delete;
+
+		MACH_ALWAYS_INLINE explicit operator T*() const { return m_value; }
+		MACH_ALWAYS_INLINE explicit operator T&() const { return *m_value; }
+		MACH_ALWAYS_INLINE T* operator->() const { return m_value; }
+		MACH_ALWAYS_INLINE T& operator*() const { return *m_value; }
+
+		~LockGuard() {
+			if (m_lock == nullptr) {
+				return;
+			}
+			if constexpr (shared) {
+				m_lock->unlock_shared();
+			} else {
+				m_lock->unlock();
+			}
+		}
+
+	private:
+		Lock const* m_lock;
+		T* m_value;
+	};
+
+	// Owns a value that can only be reached by holding Lock. The value lives on its own cache line so writes to it do
+	// not disturb threads spinning on the lock.
+	template <typename Lock, Movable T>
+	class BasicMutex {
+	public:
+		using Guard = LockGuard<Lock, T>;
+
+		template <typename... Args>
+		explicit BasicMutex(T&& value, Args&&... lock_args)
+			: m_lock(Mach::forward<Args>(lock_args)...)
+			, m_value(Mach::forward<T>(value)) {}
 
 		MACH_NO_DISCARD Guard lock() const {
-			const auto end = m_end.fetch_add(1);
-			while (end != m_start.load()) {
+			m_lock.lock();
+			return Guard(m_lock, const_cast<T&>(m_value));
+		}
+
+		MACH_NO_DISCARD Option<Guard> try_lock() const {
+			if (!m_lock.try_lock()) {
+				return nullopt;
 			}
-			return Guard(*this);
+			return Guard(m_lock, const_cast<T&>(m_value));
 		}
 
 	private:
-		friend class Guard;
+		Lock m_lock;
+		alignas(MACH_CACHE_LINE_SIZE) alignas(T) T m_value;
+	};
+
+	template <Movable T>
+	using SpinlockMutex = BasicMutex<RawSpinlock, T>;
+
+	template <Movable T>
+	using Mutex = BasicMutex<RawMutex, T>;
+
+	// Constructed from the value and the Scheduler whose fibers will lock it
+	template <Movable T>
+	using FiberMutex = BasicMutex<RawFiberMutex, T>;
+
+	template <Movable T>
+	class RwLock {
+	public:
+		using ReadGuard = LockGuard<RawRwLock, T const, true>;
+		using WriteGuard = LockGuard<RawRwLock, T>;
+
+		explicit RwLock(T&& value) : m_value(Mach::forward<T>(value)) {}
 
-		T m_value;
-		Atomic<u64> m_start{ 0 };
-		Atomic<u64> m_end{ 0 };
+		MACH_NO_DISCARD ReadGuard read() const {
+			m_lock.lock_shared();
+			return ReadGuard(m_lock, m_value);
+		}
+
+		MACH_NO_DISCARD Option<ReadGuard> try_read() const {
+			if (!m_lock.try_lock_shared()) {
+				return nullopt;
+			}
+			return ReadGuard(m_lock, m_value);
+		}
+
+		MACH_NO_DISCARD WriteGuard write() const {
+			m_lock.lock();
+			return WriteGuard(m_lock, const_cast<T&>(m_value));
+		}
+
+		MACH_NO_DISCARD Option<WriteGuard> try_write() const {
+			if (!m_lock.try_lock()) {
+				return nullopt;
+			}
+			return WriteGuard(m_lock, const_cast<T&>(m_value));
+		}
+
+	private:
+		RawRwLock m_lock;
+		alignas(MACH_CACHE_LINE_SIZE) alignas(T) T m_value;
 	};
 } // namespace Mach::Core
+
+namespace Mach {
+	using Core::FiberMutex;
+	using Core::Mutex;
+	using Core::RwLock;
+	using Core::SpinlockMutex;
+} // namespace Mach
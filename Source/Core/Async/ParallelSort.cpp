@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/ParallelSort.hpp>
+
+#include <Core/Debug/Benchmark.hpp>
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	using namespace Mach::Core;
+
+	constexpr usize parallel_sort_bench_len = 1024 * 1024;
+
+	// Shaped like a draw call keyed by pipeline, then material
+	struct BenchDraw {
+		u64 key;
+		u32 index;
+	};
+
+	// The Scheduler can not be shut down, so a single instance is shared with the rest of the run. Filter benchmarks
+	// to keep its workers from disturbing others.
+	Scheduler const& parallel_sort_scheduler() {
+		static Scheduler scheduler;
+		static bool initialized = false;
+		if (!initialized) {
+			initialized = true;
+			scheduler.init({
+				.thread_count = 4,
+				.fiber_count = 64,
+				.waiting_count = 64,
+			});
+		}
+		return scheduler;
+	}
+
+	Array<BenchDraw> parallel_sort_bench_input() {
+		Array<BenchDraw> result;
+		result.reserve(parallel_sort_bench_len);
+		u64 state = 0x9E3779B97F4A7C15ULL;
+		for (usize index = 0; index < parallel_sort_bench_len; index += 1) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			result.push(BenchDraw{ .key = state, .index = static_cast<u32>(index) });
+		}
+		return result;
+	}
+
+	// Every iteration copies the shuffled input back first, which is included in the time
+	template <typename F>
+	void parallel_sort_bench(Bencher& bencher, F&& f) {
+		Scheduler const& scheduler = parallel_sort_scheduler();
+		const Array<BenchDraw> input = parallel_sort_bench_input();
+		Array<BenchDraw> draws = input;
+		bencher.set_items(parallel_sort_bench_len);
+		bencher.iter([&] {
+			Memory::copy(draws.begin(), input.begin(), parallel_sort_bench_len * sizeof(BenchDraw));
+			f(scheduler, draws.as_slice());
+			return draws[0].index;
+		});
+	}
+} // namespace
+
+MACH_BENCHMARK("parallel_sort 1M draws") {
+	parallel_sort_bench(bencher, [](Scheduler const& scheduler, Slice<BenchDraw> draws) {
+		parallel_sort_by(scheduler, draws, [](BenchDraw const& a, BenchDraw const& b) { return a.key < b.key; });
+	});
+}
+
+MACH_BENCHMARK("parallel_radix_sort 1M draws") {
+	parallel_sort_bench(bencher, [](Scheduler const& scheduler, Slice<BenchDraw> draws) {
+		parallel_radix_sort_by_key(scheduler, draws, [](BenchDraw const& draw) { return draw.key; });
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/Test.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	struct SortItem {
+		u32 key;
+		u32 index;
+	};
+
+	// Keys repeat a lot so stability is visible. Each of the low three bytes varies and the top one never does.
+	Array<SortItem> sort_items(usize len) {
+		Array<SortItem> result;
+		result.reserve(len);
+		u32 state = 0x2545F491;
+		for (usize index = 0; index < len; index += 1) {
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			const u32 key = (state % 5) | ((state / 5 % 7) << 8) | ((state / 35 % 11) << 16);
+			result.push(SortItem{ .key = key, .index = static_cast<u32>(index) });
+		}
+		return result;
+	}
+
+	// Returns true if items is ordered by key, and by index within equal keys when stable, and holds every index once
+	bool is_sorted_items(Array<SortItem> const& items, bool stable) {
+		Array<bool> seen;
+		seen.set_len(items.len());
+		for (usize index = 0; index < items.len(); index += 1) {
+			SortItem const& item = items[index];
+			if (item.index >= items.len() || seen[item.index]) {
+				return false;
+			}
+			seen[item.index] = true;
+
+			if (index > 0) {
+				SortItem const& previous = items[index - 1];
+				if (previous.key > item.key || (stable && previous.key == item.key && previous.index > item.index)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Lengths that reach the subtle parts of the parallel sorts:
+	 * - One below the parallel threshold, which sorts on the calling fiber.
+	 * - Just above it, which gives three runs. The last one has no partner in the first merge round.
+	 * - Six runs, which take three merge rounds, so the result is copied back out of scratch.
+	 * - Past parallel_sort_max_chunks chunks of parallel_sort_grain. The runs then no longer line up with the merge
+	 *   jobs' output ranges, which cross from one pair of runs into the next.
+	 */
+	constexpr usize sort_test_lens[] = {
+		parallel_sort_grain * 2 - 1,
+		parallel_sort_grain * 2 + 1,
+		parallel_sort_grain * 5 + 7,
+		parallel_sort_grain * parallel_sort_max_chunks + 12345,
+	};
+
+	MACH_TEST_CASE("parallel_sort") {
+		// A single worker keeps the Scheduler from leaving threads behind. Every range after the first runs while this
+		// thread waits for them.
+		Scheduler scheduler;
+		scheduler.init({
+			.thread_count = 1,
+			.fiber_count = 4,
+			.waiting_count = 4,
+		});
+
+		MACH_SUBCASE("parallel_sort_by") {
+			for (const usize len : sort_test_lens) {
+				MACH_CAPTURE(len);
+				Array<SortItem> items = sort_items(len);
+				parallel_sort_by(scheduler, items.as_slice(), [](SortItem const& a, SortItem const& b) {
+					return a.key < b.key;
+				});
+				MACH_CHECK(is_sorted_items(items, false));
+			}
+		}
+
+		MACH_SUBCASE("parallel_radix_sort_by_key is stable") {
+			// Three of the four passes move values, so the result is also copied back out of scratch
+			for (const usize len : sort_test_lens) {
+				MACH_CAPTURE(len);
+				Array<SortItem> items = sort_items(len);
+				parallel_radix_sort_by_key(scheduler, items.as_slice(), [](SortItem const& item) { return item.key; });
+				MACH_CHECK(is_sorted_items(items, true));
+			}
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
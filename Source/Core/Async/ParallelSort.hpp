@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Scheduler.hpp>
+#include <Core/Containers/Array.hpp>
+#include <Core/Sort.hpp>
+
+namespace Mach::Core {
+	// Elements each job works on at least. Below twice this the parallel sorts run on the calling fiber.
+	inline constexpr usize parallel_sort_grain = 16 * 1024;
+
+	// Upper bound on how many chunks a slice is split into, which bounds the histogram memory radix sort needs
+	inline constexpr usize parallel_sort_max_chunks = 64;
+
+	MACH_ALWAYS_INLINE inline usize parallel_sort_chunk_len(usize len) {
+		const usize spread = (len + parallel_sort_max_chunks - 1) / parallel_sort_max_chunks;
+		return spread > parallel_sort_grain ? spread : parallel_sort_grain;
+	}
+
+	/**
+	 * Finds how many elements of the sorted run a come before the element at diagonal in the merge of a and b. Ties
+	 * go to a, so merging the pieces either side of the split independently gives the same result as a stable merge.
+	 */
+	template <typename T, typename Less>
+	usize parallel_sort_split(T const* a, usize a_len, T const* b, usize b_len, usize diagonal, Less& less) {
+		usize low = diagonal > b_len ? diagonal - b_len : 0;
+		usize high = diagonal < a_len ? diagonal : a_len;
+		while (low < high) {
+			const usize a_count = low + (high - low) / 2;
+			const usize b_count = diagonal - a_count;
+			if (!less(b[b_count - 1], a[a_count])) {
+				low = a_count + 1;
+			} else {
+				high = a_count;
+			}
+		}
+		return low;
+	}
+
+	struct ParallelSortPair {
+		usize start;
+		usize middle;
+		usize end;
+	};
+
+	/**
+	 * Sorts slice in place across the scheduler's workers. Chunks are sorted with sort_by in parallel, then merged in
+	 * rounds where every round splits its output evenly between jobs, so the last merge is as parallel as the first.
+	 * Not stable. Allocates scratch space for all of slice.
+	 *
+	 * less is called from several workers at once. Must be called from a fiber the scheduler owns.
+	 */
+	template <typename T, typename Less>
+		requires SortLess<Less, T>
+	void parallel_sort_by(Scheduler const& scheduler, Slice<T> slice, Less&& less) {
+		const usize len = slice.len();
+		if (len < parallel_sort_grain * 2) {
+			sort_by(slice, less);
+			return;
+		}
+
+		const usize chunk_len = parallel_sort_chunk_len(len);
+		scheduler.parallel_for(len, chunk_len, [&](usize start, usize end) {
+			sort_by(Slice<T>{ slice.begin() + start, end - start }, less);
+		});
+
+		// Runs are merged back and forth between slice and scratch. Whichever one holds the values has them constructed,
+		// the other is left uninitialized.
+		auto memory = Memory::alloc(Memory::Layout::array<T>(len));
+		T* from = slice.begin();
+		T* to = static_cast<T*>(*memory);
+
+		// Where each job's output range splits the runs it merges. Found before any job starts moving values, as a
+		// job's search can reach values a neighbouring job is merging.
+		Array<usize> splits;
+		splits.set_len(len / parallel_sort_grain + 1);
+
+		for (usize width = chunk_len; width < len; width *= 2) {
+			// Each pair of runs is merged into the output range they cover
+			auto pair_of = [&](usize position) {
+				const usize pair_start = position / (width * 2) * (width * 2);
+				const usize middle = pair_start + width < len ? pair_start + width : len;
+				const usize pair_end = middle + width < len ? middle + width : len;
+				return ParallelSortPair{ .start = pair_start, .middle = middle, .end = pair_end };
+			};
+
+			for (usize index = 0; index < splits.len(); index += 1) {
+				const usize position = index * parallel_sort_grain < len ? index * parallel_sort_grain : len;
+				const auto pair = pair_of(position);
+				splits[index] = parallel_sort_split(from + pair.start,
+													pair.middle - pair.start,
+													from + pair.middle,
+													pair.end - pair.middle,
+													position - pair.start,
+													less);
+			}
+
+			scheduler.parallel_for(len, parallel_sort_grain, [&](usize start, usize end) {
+				// The output range may cover the end of one pair of runs and the start of the next
+				while (start < end) {
+					const auto pair = pair_of(start);
+					const usize piece_end = end < pair.end ? end : pair.end;
+
+					T* const a = from + pair.start;
+					T* const b = from + pair.middle;
+					usize a_index = start == pair.start ? 0 : splits[start / parallel_sort_grain];
+					usize b_index = start - pair.start - a_index;
+					const usize a_end = piece_end == pair.end ? pair.middle - pair.start
+															  : splits[piece_end / parallel_sort_grain];
+					const usize b_end = piece_end - pair.start - a_end;
+
+					T* out = to + start;
+					while (a_index < a_end && b_index < b_end) {
+						T* source;
+						if (less(b[b_index], a[a_index])) {
+							source = b + b_index;
+							b_index += 1;
+						} else {
+							source = a + a_index;
+							a_index += 1;
+						}
+						Memory::emplace<T>(out, Mach::move(*source));
+						source->~T();
+						out += 1;
+					}
+					for (; a_index < a_end; a_index += 1, out += 1) {
+						Memory::emplace<T>(out, Mach::move(a[a_index]));
+						a[a_index].~T();
+					}
+					for (; b_index < b_end; b_index += 1, out += 1) {
+						Memory::emplace<T>(out, Mach::move(b[b_index]));
+						b[b_index].~T();
+					}
+
+					start = piece_end;
+				}
+			});
+
+			T* const temp = from;
+			from = to;
+			to = temp;
+		}
+
+		// An odd number of rounds leaves the result in scratch
+		if (from != slice.begin()) {
+			scheduler.parallel_for(len, parallel_sort_grain, [&](usize start, usize end) {
+				for (usize index = start; index < end; index += 1) {
+					Memory::emplace<T>(slice.begin() + index, Mach::move(from[index]));
+					from[index].~T();
+				}
+			});
+		}
+		Memory::free(memory);
+	}
+
+	template <typename T>
+	void parallel_sort(Scheduler const& scheduler, Slice<T> slice) {
+		parallel_sort_by(scheduler, slice, [](T const& a, T const& b) { return a < b; });
+	}
+
+	/**
+	 * Parallel version of radix_sort_by_key. Every pass counts digits per chunk in parallel, works out where each
+	 * chunk's share of every digit goes, then scatters all chunks at once. Chunks keep their order within a digit so
+	 * the sort stays stable.
+	 *
+	 * key is called from several workers at once. Must be called from a fiber the scheduler owns.
+	 */
+	template <typename T, typename F>
+		requires RadixKeyOf<F, T>
+	void parallel_radix_sort_by_key(Scheduler const& scheduler, Slice<T> slice, F&& key) {
+		static_assert(is_trivially_copyable<T>, "radix sort copies elements as bytes");
+		using K = RemoveCvref<InvokeResult<F&, T const&>>;
+		static constexpr usize passes = sizeof(K);
+
+		const usize len = slice.len();
+		if (len < parallel_sort_grain * 2) {
+			radix_sort_by_key(slice, key);
+			return;
+		}
+
+		const usize chunk_len = parallel_sort_chunk_len(len);
+		const usize chunk_count = (len + chunk_len - 1) / chunk_len;
+
+		// One row of 256 counts per chunk, reused by every pass
+		Array<usize> counts;
+		counts.set_len(chunk_count * 256);
+
+		// Count every pass's digits up front to find the passes that would not move anything
+		Array<usize> pass_counts;
+		pass_counts.set_len(chunk_count * passes * 256);
+		scheduler.parallel_for(chunk_count, 1, [&](usize chunk, usize) {
+			usize* const local = pass_counts.begin() + chunk * passes * 256;
+			Memory::set(local, 0, passes * 256 * sizeof(usize));
+			const usize end = (chunk + 1) * chunk_len < len ? (chunk + 1) * chunk_len : len;
+			for (usize index = chunk * chunk_len; index < end; index += 1) {
+				const auto bits = radix_bits<K>(key(slice[index]));
+				for (usize pass = 0; pass < passes; pass += 1) {
+					local[pass * 256 + radix_digit<K>(bits, pass)] += 1;
+				}
+			}
+		});
+
+		auto memory = Memory::alloc(Memory::Layout::array<T>(len));
+		T* from = slice.begin();
+		T* to = static_cast<T*>(*memory);
+		bool moved = false;
+
+		const auto first_bits = radix_bits<K>(key(*from));
+		for (usize pass = 0; pass < passes; pass += 1) {
+			const u8 first_digit = radix_digit<K>(first_bits, pass);
+			usize same = 0;
+			for (usize chunk = 0; chunk < chunk_count; chunk += 1) {
+				same += pass_counts[(chunk * passes + pass) * 256 + first_digit];
+			}
+			if (same == len) {
+				continue;
+			}
+
+			// The counts taken up front only describe each chunk until values start moving between chunks
+			if (!moved) {
+				for (usize chunk = 0; chunk < chunk_count; chunk += 1) {
+					Memory::copy(counts.begin() + chunk * 256,
+								 pass_counts.begin() + (chunk * passes + pass) * 256,
+								 256 * sizeof(usize));
+				}
+			} else {
+				scheduler.parallel_for(chunk_count, 1, [&](usize chunk, usize) {
+					usize* const local = counts.begin() + chunk * 256;
+					Memory::set(local, 0, 256 * sizeof(usize));
+					const usize end = (chunk + 1) * chunk_len < len ? (chunk + 1) * chunk_len : len;
+					for (usize index = chunk * chunk_len; index < end; index += 1) {
+						local[radix_digit<K>(radix_bits<K>(key(from[index])), pass)] += 1;
+					}
+				});
+			}
+
+			// Turn counts into where each chunk writes its first value of every digit, ordered by digit then chunk
+			usize total = 0;
+			for (usize digit = 0; digit < 256; digit += 1) {
+				for (usize chunk = 0; chunk < chunk_count; chunk += 1) {
+					const usize count = counts[chunk * 256 + digit];
+					counts[chunk * 256 + digit] = total;
+					total += count;
+				}
+			}
+
+			scheduler.parallel_for(chunk_count, 1, [&](usize chunk, usize) {
+				usize* const offsets = counts.begin() + chunk * 256;
+				const usize end = (chunk + 1) * chunk_len < len ? (chunk + 1) * chunk_len : len;
+				for (usize index = chunk * chunk_len; index < end; index += 1) {
+					const u8 digit = radix_digit<K>(radix_bits<K>(key(from[index])), pass);
+					to[offsets[digit]] = from[index];
+					offsets[digit] += 1;
+				}
+			});
+			moved = true;
+
+			T* const temp = from;
+			from = to;
+			to = temp;
+		}
+
+		// An odd number of passes leaves the result in scratch
+		if (from != slice.begin()) {
+			Memory::copy(slice.begin(), from, len * sizeof(T));
+		}
+		Memory::free(memory);
+	}
+
+	template <RadixKey T>
+	void parallel_radix_sort(Scheduler const& scheduler, Slice<T> slice) {
+		parallel_radix_sort_by_key(scheduler, slice, [](T value) { return value; });
+	}
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::parallel_radix_sort;
+	using Core::parallel_radix_sort_by_key;
+	using Core::parallel_sort;
+	using Core::parallel_sort_by;
+} // namespace Mach
@@ -6,29 +6,87 @@
 
 #include <Core/Async/Posix/Thread.hpp>
 #include <Core/Debug/Log.hpp>
+#include <Core/Math/Math.hpp>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#if MACH_OS == MACH_OS_LINUX
+	#include <sys/resource.h>
+	#include <sys/syscall.h>
+#elif MACH_OS == MACH_OS_MACOS
+	#include <sys/sysctl.h>
+#endif
 
 namespace Mach::Core {
 	thread_local Option<Mach::SharedPtr<Thread>> g_current_thread = nullopt;
 
+	static i64 current_native_id() {
+#if MACH_OS == MACH_OS_LINUX
+		return static_cast<i64>(::syscall(SYS_gettid));
+#else
+		return 0;
+#endif
+	}
+
 	Thread const& Thread::current() {
 		if (!g_current_thread.is_set()) {
-			PosixThread thread{ pthread_self() };
+			PosixThread thread{ pthread_self(), current_native_id() };
 			g_current_thread = Mach::SharedPtr<PosixThread>::create(Mach::move(thread));
 		}
 		return *g_current_thread.as_ref().unwrap();
 	}
 
+	void Thread::sleep(Duration duration) {
+		timespec remaining{
+			.tv_sec = static_cast<time_t>(duration.as_secs()),
+			.tv_nsec = static_cast<long>(duration.subsec_nanos()),
+		};
+		while (::nanosleep(&remaining, &remaining) != 0 && errno == EINTR) {
+		}
+	}
+
+	void Thread::yield_now() { ::sched_yield(); }
+
+#if MACH_OS == MACH_OS_MACOS
+	static constexpr usize max_thread_name_len = 63;
+#else
+	static constexpr usize max_thread_name_len = 15;
+#endif
+
 	struct ThreadArg {
 		Thread::Function f;
 		Mach::SharedPtr<PosixThread> thread;
+		Thread::Priority priority;
+		char name[max_thread_name_len + 1];
 	};
 	static void* posix_thread_main(void* arg) {
 		auto* param = static_cast<ThreadArg*>(arg);
 		g_current_thread = param->thread;
 
-		// Spinlock until the thread is ready to execute. We have to wait until the m_thread value has been set in the
-		// thread
-		while (!param->thread->is_ready()) {
+		// Names and priorities are applied by the thread to itself. macOS can only name the calling thread, and Linux
+		// sets priorities through the kernel thread id, which is only known from inside the thread.
+		param->thread->set_native_id(current_native_id());
+		if (param->name[0] != 0) {
+#if MACH_OS == MACH_OS_MACOS
+			pthread_setname_np(param->name);
+#else
+			pthread_setname_np(pthread_self(), param->name);
+#endif
+		}
+
+		// We have to wait until the m_thread value has been set by spawn, and until resume if started suspended
+		param->thread->wait_until_ready();
+
+		// macOS sets priorities through m_thread, so this has to come after spawn has published it
+		if (param->priority != Thread::Priority::Normal) {
+			const bool priority_set = param->thread->set_priority(param->priority);
+			MACH_UNUSED(priority_set);
 		}
 
 		(param->f)();
@@ -40,24 +98,57 @@ namespace Mach::Core {
 	}
 
 	Mach::SharedPtr<Thread> Thread::spawn(Function&& f, SpawnInfo const& info) {
-		// TODO: Figure out how to use the data from info
-		MACH_UNUSED(info);
-
-		auto result = Mach::SharedPtr<PosixThread>::create(nullptr);
+		auto result = Mach::SharedPtr<PosixThread>::create(pthread_t{});
 		auto& mut_result = result.unsafe_get_mut();
 
 		auto param = Memory::alloc(Memory::Layout::single<ThreadArg>());
-		Memory::emplace<ThreadArg>(param, ThreadArg{ .f = Mach::forward<Function>(f), .thread = result });
+		Memory::emplace<ThreadArg>(
+			param,
+			ThreadArg{ .f = Mach::forward<Function>(f), .thread = result, .priority = info.priority, .name = {} });
+
+		if (info.name.is_set()) {
+			// Truncate on a character boundary so the OS never sees half of a UTF-8 sequence
+			const auto name = info.name.as_const_ref().unwrap();
+			usize len = name.len() < max_thread_name_len ? name.len() : max_thread_name_len;
+			if (len < name.len()) {
+				while (len > 0 && ((*name)[len] & 0xC0) == 0x80) {
+					len -= 1;
+				}
+			}
+			auto* arg = static_cast<ThreadArg*>(*param);
+			Memory::copy(arg->name, *name, len);
+			arg->name[len] = 0;
+		}
+
+		pthread_attr_t attributes;
+		pthread_attr_init(&attributes);
+		if (info.stack_size.is_set()) {
+			// Stacks must be at least PTHREAD_STACK_MIN and macOS also wants a multiple of the page size
+			const usize page_size = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+			usize stack_size = info.stack_size.unwrap();
+			stack_size = Math::max(stack_size, static_cast<usize>(PTHREAD_STACK_MIN));
+			stack_size = (stack_size + page_size - 1) / page_size * page_size;
+			const int stack_result = pthread_attr_setstacksize(&attributes, stack_size);
+			MACH_ASSERT(stack_result == 0, "Invalid thread stack size");
+		}
 
 		pthread_t thread;
-		const int create_result = pthread_create(&thread, nullptr, posix_thread_main, param);
+		const int create_result = pthread_create(&thread, &attributes, posix_thread_main, param);
+		pthread_attr_destroy(&attributes);
 		// TODO: Error handling
 		MACH_UNUSED(create_result);
 
 		mut_result.m_thread = thread;
 
-		// Mark the thread as ready so it can execute.
-		result->m_ready.store(true);
+		if (info.affinity.is_set()) {
+			const bool affinity_set = result->set_affinity(info.affinity.as_const_ref().unwrap());
+			MACH_UNUSED(affinity_set);
+		}
+
+		// Mark the thread as ready so it can execute
+		if (!info.start_suspended) {
+			result->mark_ready();
+		}
 
 		return result;
 	}
@@ -66,20 +157,304 @@ namespace Mach::Core {
 		const int result = pthread_join(m_thread, nullptr);
 		// TODO: Error handling
 		MACH_UNUSED(result);
-		m_thread = nullptr;
+		m_thread = pthread_t{};
 	}
 
 	void PosixThread::detach() {
 		const int result = pthread_detach(m_thread);
 		MACH_UNUSED(result);
-		m_thread = nullptr;
+		m_thread = pthread_t{};
 	}
 
 	Thread::Id PosixThread::id() const { return (Thread::Id)m_thread; }
 
+	void PosixThread::resume() const { mark_ready(); }
+
+	void PosixThread::mark_ready() const {
+		pthread_mutex_lock(&m_ready_mutex);
+		m_ready.store(true);
+		pthread_cond_broadcast(&m_ready_condition);
+		pthread_mutex_unlock(&m_ready_mutex);
+	}
+
+	void PosixThread::wait_until_ready() const {
+		if (is_ready()) {
+			return;
+		}
+		pthread_mutex_lock(&m_ready_mutex);
+		while (!is_ready()) {
+			pthread_cond_wait(&m_ready_condition, &m_ready_mutex);
+		}
+		pthread_mutex_unlock(&m_ready_mutex);
+	}
+
+	bool PosixThread::set_affinity(CpuSet const& cores) const {
+#if MACH_OS == MACH_OS_LINUX
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (usize core = 0; core < CpuSet::max_cores && core < CPU_SETSIZE; core += 1) {
+			if (cores.contains(core)) {
+				CPU_SET(core, &set);
+			}
+		}
+		return pthread_setaffinity_np(m_thread, sizeof(set), &set) == 0;
+#else
+		// macOS only takes affinity tags as hints, so there is no way to honor an exact set
+		MACH_UNUSED(cores);
+		return false;
+#endif
+	}
+
+	bool PosixThread::set_priority(Priority priority) const {
+		const i32 level = static_cast<i32>(priority) - static_cast<i32>(Priority::Normal);
+#if MACH_OS == MACH_OS_LINUX
+		// SCHED_OTHER threads all have a static priority of 0 on Linux, but each thread has its own nice value
+		i64 native_id = m_native_id.load();
+		while (native_id == 0) {
+			Thread::yield_now();
+			native_id = m_native_id.load();
+		}
+		static constexpr int nice_values[] = { 19, 10, 0, -10, -20 };
+		return ::setpriority(PRIO_PROCESS, static_cast<id_t>(native_id), nice_values[level + 2]) == 0;
+#else
+		const int min = sched_get_priority_min(SCHED_OTHER);
+		const int max = sched_get_priority_max(SCHED_OTHER);
+		sched_param param{};
+		param.sched_priority = min + (max - min) * (level + 2) / 4;
+		return pthread_setschedparam(m_thread, SCHED_OTHER, &param) == 0;
+#endif
+	}
+
 	PosixThread::~PosixThread() {
-		if (m_thread != nullptr) {
+		if (m_thread != pthread_t{}) {
 			// join();
 		}
+		pthread_cond_destroy(&m_ready_condition);
+		pthread_mutex_destroy(&m_ready_mutex);
+	}
+
+	// Records the physical core that logical core belongs to, adding it if this is the first of its siblings
+	static void add_logical_core(
+		CpuTopology& topology,
+		Array<u64>& core_keys,
+		usize logical,
+		u64 core_key,
+		u32 package,
+		u32 l3_domain) {
+		for (usize i = 0; i < core_keys.len(); i += 1) {
+			if (core_keys[i] == core_key) {
+				topology.physical_cores[i].logical.insert(logical);
+				return;
+			}
+		}
+		core_keys.push(core_key);
+		topology.physical_cores.push(
+			CpuTopology::PhysicalCore{ .logical = CpuSet::single(logical), .package = package, .l3_domain = l3_domain });
+	}
+
+	// Maps sparse ids like package numbers onto 0, 1, 2, ... in the order they are first seen
+	static u32 dense_index(Array<u64>& seen, u64 id) {
+		for (usize i = 0; i < seen.len(); i += 1) {
+			if (seen[i] == id) {
+				return static_cast<u32>(i);
+			}
+		}
+		return static_cast<u32>(seen.push(id));
+	}
+
+#if MACH_OS == MACH_OS_LINUX
+	// Reads a small sysfs file as a null terminated string
+	static bool read_sysfs(char const* path, char* buffer, usize size) {
+		const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return false;
+		}
+		const ssize_t read = ::read(fd, buffer, size - 1);
+		::close(fd);
+		if (read < 0) {
+			return false;
+		}
+		buffer[read] = 0;
+		return true;
+	}
+
+	static Option<u64> read_sysfs_number(char const* path) {
+		char buffer[32];
+		if (!read_sysfs(path, buffer, sizeof(buffer))) {
+			return nullopt;
+		}
+		return static_cast<u64>(::strtoull(buffer, nullptr, 10));
+	}
+
+	// Parses the kernel's cpu list format, e.g. "0-3,8-11"
+	static Option<CpuSet> read_sysfs_cpu_list(char const* path) {
+		char buffer[4096];
+		if (!read_sysfs(path, buffer, sizeof(buffer))) {
+			return nullopt;
+		}
+
+		CpuSet result;
+		char* cursor = buffer;
+		while (*cursor >= '0' && *cursor <= '9') {
+			const usize first = static_cast<usize>(::strtoul(cursor, &cursor, 10));
+			usize last = first;
+			if (*cursor == '-') {
+				last = static_cast<usize>(::strtoul(cursor + 1, &cursor, 10));
+			}
+			for (usize core = first; core <= last && core < CpuSet::max_cores; core += 1) {
+				result.insert(core);
+			}
+			if (*cursor == ',') {
+				cursor += 1;
+			}
+		}
+		return result;
+	}
+
+	static CpuTopology query_topology() {
+		CpuTopology result;
+		Array<u64> core_keys;
+		Array<u64> packages;
+		Array<u64> l3_domains;
+
+		char path[128];
+		const usize configured = static_cast<usize>(::sysconf(_SC_NPROCESSORS_CONF));
+		for (usize logical = 0; logical < configured && logical < CpuSet::max_cores; logical += 1) {
+			// cpu0 usually has no online file because it cannot be taken offline
+			::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/online", logical);
+			if (read_sysfs_number(path).unwrap_or(1) == 0) {
+				continue;
+			}
+
+			::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/core_id", logical);
+			const auto core_id = read_sysfs_number(path);
+			if (!core_id.is_set()) {
+				continue;
+			}
+			::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/topology/physical_package_id", logical);
+			const u64 package_id = read_sysfs_number(path).unwrap_or(0);
+
+			// Identify the L3 by the lowest logical core sharing it. Machines without one get one domain per package.
+			u64 l3_key = package_id << 32;
+			for (u32 index = 0; index < 8; index += 1) {
+				::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%zu/cache/index%u/level", logical, index);
+				const auto level = read_sysfs_number(path);
+				if (!level.is_set()) {
+					break;
+				}
+				if (level.unwrap() != 3) {
+					continue;
+				}
+				::snprintf(
+					path,
+					sizeof(path),
+					"/sys/devices/system/cpu/cpu%zu/cache/index%u/shared_cpu_list",
+					logical,
+					index);
+				const auto shared = read_sysfs_cpu_list(path);
+				if (shared.is_set()) {
+					for (usize core = 0; core < CpuSet::max_cores; core += 1) {
+						if (shared.as_const_ref().unwrap().contains(core)) {
+							l3_key = (u64{ 1 } << 63) | core;
+							break;
+						}
+					}
+				}
+				break;
+			}
+
+			result.logical_core_count += 1;
+			add_logical_core(
+				result,
+				core_keys,
+				logical,
+				(package_id << 32) | core_id.unwrap(),
+				dense_index(packages, package_id),
+				dense_index(l3_domains, l3_key));
+		}
+
+		if (result.physical_cores.is_empty()) {
+			return result;
+		}
+		result.package_count = static_cast<u32>(packages.len());
+		result.l3_domain_count = static_cast<u32>(l3_domains.len());
+
+		// Node ids can have gaps, so walk the possible range and skip nodes that do not exist
+		const auto possible_nodes = read_sysfs_cpu_list("/sys/devices/system/node/possible");
+		u32 numa_node_count = 0;
+		for (usize node = 0; possible_nodes.is_set() && node < CpuSet::max_cores; node += 1) {
+			if (!possible_nodes.as_const_ref().unwrap().contains(node)) {
+				continue;
+			}
+			::snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+			const auto cpus = read_sysfs_cpu_list(path);
+			if (!cpus.is_set() || cpus.as_const_ref().unwrap().is_empty()) {
+				continue;
+			}
+			for (auto& core : result.physical_cores) {
+				for (usize logical = 0; logical < CpuSet::max_cores; logical += 1) {
+					if (core.logical.contains(logical)) {
+						if (cpus.as_const_ref().unwrap().contains(logical)) {
+							core.numa_node = numa_node_count;
+						}
+						break;
+					}
+				}
+			}
+			numa_node_count += 1;
+		}
+		result.numa_node_count = numa_node_count > 0 ? numa_node_count : 1;
+
+		return result;
+	}
+#elif MACH_OS == MACH_OS_MACOS
+	static CpuTopology query_topology() {
+		CpuTopology result;
+
+		int physical = 0;
+		int logical = 0;
+		usize size = sizeof(int);
+		if (::sysctlbyname("hw.physicalcpu", &physical, &size, nullptr, 0) != 0 || physical <= 0) {
+			return result;
+		}
+		size = sizeof(int);
+		if (::sysctlbyname("hw.logicalcpu", &logical, &size, nullptr, 0) != 0 || logical < physical) {
+			logical = physical;
+		}
+
+		// macOS does not say which logical cores are siblings. Intel Macs number them consecutively.
+		Array<u64> core_keys;
+		const usize per_core = static_cast<usize>(logical / physical);
+		for (usize index = 0; index < static_cast<usize>(logical) && index < CpuSet::max_cores; index += 1) {
+			add_logical_core(result, core_keys, index, index / per_core, 0, 0);
+		}
+		result.logical_core_count = static_cast<u32>(logical);
+		result.package_count = 1;
+		result.l3_domain_count = 1;
+		result.numa_node_count = 1;
+		return result;
+	}
+#endif
+
+	CpuTopology const& CpuTopology::get() {
+		static const CpuTopology topology = [] {
+			CpuTopology result = query_topology();
+			if (result.physical_cores.is_empty()) {
+				// Without topology information treat every online logical core as its own physical core
+				result = CpuTopology{};
+				Array<u64> core_keys;
+				const long online = ::sysconf(_SC_NPROCESSORS_ONLN);
+				const usize count = online > 0 ? static_cast<usize>(online) : 1;
+				for (usize index = 0; index < count && index < CpuSet::max_cores; index += 1) {
+					add_logical_core(result, core_keys, index, index, 0, 0);
+				}
+				result.logical_core_count = static_cast<u32>(result.physical_cores.len());
+				result.package_count = 1;
+				result.l3_domain_count = 1;
+				result.numa_node_count = 1;
+			}
+			return result;
+		}();
+		return topology;
 	}
 } // namespace Mach::Core
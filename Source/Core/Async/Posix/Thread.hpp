@@ -13,16 +13,19 @@
 namespace Mach::Core {
 	class PosixThread final : public Thread {
 	public:
-		explicit PosixThread(pthread_t thread) : m_thread(thread) {}
+		explicit PosixThread(pthread_t thread, i64 native_id = 0) : m_thread(thread), m_native_id(native_id) {}
 		PosixThread(const PosixThread&) = delete;
 		PosixThread& operator=(const PosixThread&) = delete;
-		PosixThread(PosixThread&& move) : m_thread(move.m_thread) { move.m_thread = nullptr; }
+		PosixThread(PosixThread&& move) : m_thread(move.m_thread), m_native_id(move.m_native_id.load()) {
+			move.m_thread = pthread_t{};
+		}
 		PosixThread& operator=(PosixThread&& move) {
 			auto to_destroy = Mach::move(*this);
 			MACH_UNUSED(to_destroy);
 
 			m_thread = move.m_thread;
-			move.m_thread = nullptr;
+			m_native_id.store(move.m_native_id.load());
+			move.m_thread = pthread_t{};
 
 			return *this;
 		}
@@ -30,12 +33,27 @@ namespace Mach::Core {
 		void join() final;
 		void detach() final;
 		Id id() const final;
+		void resume() const final;
+		bool set_affinity(CpuSet const& cores) const final;
+		bool set_priority(Priority priority) const final;
 		~PosixThread() final;
 		MACH_ALWAYS_INLINE bool is_ready() const { return m_ready.load(); }
 
+		// Blocks until the thread has been marked ready by spawn or resume
+		void wait_until_ready() const;
+		// Called by the thread itself once it starts running
+		MACH_ALWAYS_INLINE void set_native_id(i64 native_id) const { m_native_id.store(native_id); }
+
 	private:
 		friend class Thread;
+		void mark_ready() const;
+
 		pthread_t m_thread;
+		// Kernel thread id on Linux, which is what per thread priorities are set through. Written by the thread itself
+		// before it waits to be ready, so it is 0 until the thread has started.
+		Atomic<i64> m_native_id{ 0 };
 		Atomic<bool> m_ready{ false };
+		mutable pthread_mutex_t m_ready_mutex = PTHREAD_MUTEX_INITIALIZER;
+		mutable pthread_cond_t m_ready_condition = PTHREAD_COND_INITIALIZER;
 	};
 } // namespace Mach::Core
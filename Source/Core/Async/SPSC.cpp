@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/SPSC.hpp>
+#include <Core/Async/Thread.hpp>
+#include <Core/Containers/String.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("SPSC") {
+		MACH_SUBCASE("push and pop") {
+			const auto queue = SPSC<u32>::create(4);
+			MACH_CHECK(!queue.pop().is_set());
+			for (u32 i = 0; i < 4; i += 1) {
+				MACH_CHECK(queue.push(i));
+			}
+			MACH_CHECK(!queue.push(4));
+			for (u32 i = 0; i < 4; i += 1) {
+				MACH_CHECK(queue.pop().unwrap() == i);
+			}
+			MACH_CHECK(!queue.pop().is_set());
+		}
+
+		MACH_SUBCASE("batches wrap around") {
+			const auto queue = SPSC<u32>::create(8);
+			u32 values[6] = { 0, 1, 2, 3, 4, 5 };
+			u32 out[6] = {};
+			MACH_CHECK(queue.push_n(Slice<u32>{ values, 6 }) == 6);
+			MACH_CHECK(queue.pop_n(Slice<u32>{ out, 4 }) == 4);
+			MACH_CHECK(out[3] == 3);
+
+			// Only 6 of the 8 slots are free now, and they straddle the end of the buffer
+			MACH_CHECK(queue.push_n(Slice<u32>{ values, 6 }) == 6);
+			MACH_CHECK(queue.push_n(Slice<u32>{ values, 6 }) == 0);
+			MACH_CHECK(queue.pop_n(Slice<u32>{ out, 6 }) == 6);
+			MACH_CHECK(out[0] == 4);
+			MACH_CHECK(out[1] == 5);
+			MACH_CHECK(out[2] == 0);
+			MACH_CHECK(out[5] == 3);
+			MACH_CHECK(queue.pop_n(Slice<u32>{ out, 6 }) == 2);
+		}
+
+		MACH_SUBCASE("drops remaining values") {
+			const auto queue = SPSC<String>::create(4);
+			MACH_CHECK(queue.push(String::from(u8"left behind"_sv)));
+			MACH_CHECK(queue.push(String::from(u8"also left behind"_sv)));
+			const auto popped = queue.pop();
+			MACH_CHECK(popped.as_const_ref().unwrap() == u8"left behind"_sv);
+		}
+
+		MACH_SUBCASE("producer and consumer threads") {
+			static constexpr u64 count = 100000;
+			const auto queue = SPSC<u64>::create(64);
+
+			auto producer = Thread::spawn([&queue] {
+				for (u64 i = 0; i < count; i += 1) {
+					while (!queue.push(i)) {
+						Thread::yield_now();
+					}
+				}
+			});
+
+			u64 expected = 0;
+			bool in_order = true;
+			while (expected < count) {
+				auto value = queue.pop();
+				if (!value.is_set()) {
+					Thread::yield_now();
+					continue;
+				}
+				in_order &= value.unwrap() == expected;
+				expected += 1;
+			}
+			producer.unsafe_get_mut().join();
+			MACH_CHECK(in_order);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("SPSC push pop") {
+	using namespace Mach::Core;
+
+	const auto queue = SPSC<u64>::create(1024);
+	bencher.set_items(512);
+	bencher.iter([&queue] {
+		for (u64 i = 0; i < 512; i += 1) {
+			const bool pushed = queue.push(i);
+			MACH_UNUSED(pushed);
+		}
+		u64 sum = 0;
+		for (u64 i = 0; i < 512; i += 1) {
+			sum += queue.pop().unwrap_or(0);
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("SPSC producer to consumer thread") {
+	using namespace Mach::Core;
+
+	static constexpr u64 count = 16384;
+
+	const auto queue = SPSC<u64>::create(1024);
+	bencher.set_items(count);
+	bencher.iter([&queue] {
+		auto producer = Thread::spawn([&queue] {
+			for (u64 i = 0; i < count; i += 1) {
+				while (!queue.push(i)) {
+					Thread::yield_now();
+				}
+			}
+		});
+		u64 sum = 0;
+		for (u64 popped = 0; popped < count;) {
+			const auto value = queue.pop();
+			if (!value.is_set()) {
+				Thread::yield_now();
+				continue;
+			}
+			sum += value.as_const_ref().unwrap();
+			popped += 1;
+		}
+		producer.unsafe_get_mut().join();
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
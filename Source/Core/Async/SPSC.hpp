@@ -0,0 +1,141 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Atomic.hpp>
+#include <Core/Containers/Slice.hpp>
+#include <Core/Math/Math.hpp>
+#include <Core/Memory.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Bounded single producer single consumer ring buffer. push and pop are wait-free: each is a handful of loads and
+	 * one release store, and they only touch the other side's index when the ring looks full or empty.
+	 *
+	 * Exactly one thread may push and exactly one thread may pop at a time. Use MPMC or UnboundedMPMC otherwise.
+	 */
+	template <Movable T>
+	class SPSC {
+	public:
+		explicit SPSC() = default;
+
+		static SPSC create(u32 capacity) {
+			// Verify that size is a power of 2
+			MACH_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+
+			auto ptr = Memory::alloc(Memory::Layout::array<T>(capacity));
+			return SPSC(static_cast<T*>(*ptr), capacity);
+		}
+		SPSC(const SPSC&) = delete;
+		SPSC& operator=(const SPSC&) = delete;
+
+		SPSC(SPSC&& move) noexcept { *this = Mach::move(move); }
+		SPSC& operator=(SPSC&& move) noexcept {
+			this->~SPSC();
+
+			m_buffer = move.m_buffer;
+			m_buffer_mask = move.m_buffer_mask;
+			m_head.store(move.m_head.load(Order::Relaxed), Order::Relaxed);
+			m_tail.store(move.m_tail.load(Order::Relaxed), Order::Relaxed);
+			m_cached_head = move.m_cached_head;
+			m_cached_tail = move.m_cached_tail;
+
+			move.m_buffer = nullptr;
+			move.m_buffer_mask = 0;
+			return *this;
+		}
+
+		~SPSC() {
+			if (m_buffer) {
+				const usize tail = m_tail.load(Order::Relaxed);
+				for (usize index = m_head.load(Order::Relaxed); index != tail; index += 1) {
+					m_buffer[index & m_buffer_mask].~T();
+				}
+				Memory::free(m_buffer);
+				m_buffer = nullptr;
+			}
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize capacity() const { return m_buffer_mask + 1; }
+
+		// Producer only
+		bool push(const T& t) const
+			requires Copyable<T>
+		{
+			T copy = t;
+			return push(Mach::move(copy));
+		}
+
+		// Producer only. Returns false if the ring is full.
+		bool push(T&& t) const { return push_n(Slice<T>(t)) == 1; }
+
+		// Producer only. Moves as many values from the front of values as fit and returns how many that was.
+		usize push_n(Slice<T> values) const {
+			const usize tail = m_tail.load(Order::Relaxed);
+			usize free = capacity() - (tail - m_cached_head);
+			if (free < values.len()) {
+				m_cached_head = m_head.load(Order::Acquire);
+				free = capacity() - (tail - m_cached_head);
+			}
+
+			const usize count = Math::min(free, values.len());
+			for (usize i = 0; i < count; i += 1) {
+				Memory::emplace<T>(&m_buffer[(tail + i) & m_buffer_mask], Mach::move(values[i]));
+			}
+			m_tail.store(tail + count, Order::Release);
+			return count;
+		}
+
+		// Consumer only
+		MACH_NO_DISCARD Option<T> pop() const {
+			const usize head = m_head.load(Order::Relaxed);
+			if (head == m_cached_tail) {
+				m_cached_tail = m_tail.load(Order::Acquire);
+				if (head == m_cached_tail) {
+					return nullopt;
+				}
+			}
+
+			T* const value = &m_buffer[head & m_buffer_mask];
+			Option<T> result = Mach::move(*value);
+			value->~T();
+			m_head.store(head + 1, Order::Release);
+			return result;
+		}
+
+		// Consumer only. Moves up to out.len() values into out and returns how many were moved.
+		MACH_NO_DISCARD usize pop_n(Slice<T> out) const {
+			const usize head = m_head.load(Order::Relaxed);
+			usize available = m_cached_tail - head;
+			if (available < out.len()) {
+				m_cached_tail = m_tail.load(Order::Acquire);
+				available = m_cached_tail - head;
+			}
+
+			const usize count = Math::min(available, out.len());
+			for (usize i = 0; i < count; i += 1) {
+				T* const value = &m_buffer[(head + i) & m_buffer_mask];
+				out[i] = Mach::move(*value);
+				value->~T();
+			}
+			m_head.store(head + count, Order::Release);
+			return count;
+		}
+
+	private:
+		SPSC(T* buffer, u32 size) : m_buffer(buffer), m_buffer_mask(size - 1) {}
+
+		T* m_buffer = nullptr;
+		usize m_buffer_mask = 0;
+
+		// Each side owns a cache line: the index it publishes plus its last look at the other side's index
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<usize> m_head{ 0 };
+		mutable usize m_cached_tail = 0;
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<usize> m_tail{ 0 };
+		mutable usize m_cached_head = 0;
+	};
+} // namespace Mach::Core
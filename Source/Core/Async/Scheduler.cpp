@@ -6,18 +6,23 @@
 
 #include <Core/Async/Scheduler.hpp>
 
+#include <Core/Containers/String.hpp>
+#include <Core/Debug/Benchmark.hpp>
 #include <Core/Debug/Log.hpp>
 
 namespace Mach::Core {
 	thread_local Option<u32> g_fiber_index = nullopt;
+	// Fibers move between threads, so the epoch participant follows the thread rather than the fiber
+	thread_local Option<u32> g_worker_index = nullopt;
 
 	void Scheduler::init(InitInfo const& create_info) {
 		m_fiber_controller.dormant_fibers = MPMC<u32>::create(create_info.fiber_count);
 		m_task_tracker.waiting_task = UniquePtr<WaitingTask[]>::create(create_info.waiting_count);
 		m_task_tracker.vacant_waiting_task = MPMC<u32>::create(create_info.waiting_count);
-		m_work_queue.high_priority = MPMC<Job>::create(create_info.high_priority_count);
-		m_work_queue.normal_priority = MPMC<Job>::create(create_info.normal_priority_count);
-		m_work_queue.low_priority = MPMC<Job>::create(create_info.low_priority_count);
+		m_work_queue.high_priority = UnboundedMPMC<Job>::create();
+		m_work_queue.normal_priority = UnboundedMPMC<Job>::create();
+		m_work_queue.low_priority = UnboundedMPMC<Job>::create();
+		m_epoch.init(create_info.thread_count);
 
 		for (u32 index = 0; index < create_info.waiting_count; index += 1) {
 			m_task_tracker.vacant_waiting_task.push(index);
@@ -33,26 +38,95 @@ namespace Mach::Core {
 			m_fiber_controller.dormant_fibers.push(index);
 		}
 
+		auto affinity = [&create_info](u32 index) -> Option<CpuSet> {
+			if (!create_info.pin_to_physical_cores) {
+				return nullopt;
+			}
+			const auto& cores = CpuTopology::get().physical_cores;
+			return cores[index % cores.len()].logical;
+		};
+
 		m_thread_controller.threads.reserve(create_info.thread_count);
 		m_thread_controller.threads.push(Thread::current().to_shared());
+		if (create_info.pin_to_physical_cores) {
+			const bool pinned = Thread::current().set_affinity(affinity(0).unwrap());
+			MACH_UNUSED(pinned);
+		}
 		for (u32 index = 1; index < create_info.thread_count; index += 1) {
-			auto thread = Thread::spawn([index, this]() {
-				{
-					m_fiber_controller.fibers[index] = Fiber::current().to_shared();
-					g_fiber_index = index;
-					m_thread_controller.ready_count.fetch_add(1, Order::AcqRel);
-				}
-				worker_main(index);
-			});
+			const auto name = String::format(u8"Worker {}"_sv, index);
+			auto thread = Thread::spawn(
+				[index, this]() {
+					{
+						m_fiber_controller.fibers[index] = Fiber::current().to_shared();
+						g_fiber_index = index;
+						g_worker_index = index;
+						Profiler::switch_fiber(index);
+						m_thread_controller.ready_count.fetch_add(1, Order::AcqRel);
+					}
+					worker_main(index);
+				},
+				Thread::SpawnInfo{ .name = static_cast<StringView>(name), .affinity = affinity(index) });
 			m_thread_controller.threads.push(Mach::move(thread));
 		}
 
 		g_fiber_index = 0;
+		g_worker_index = 0;
+		Profiler::switch_fiber(0);
 		m_thread_controller.ready_count.fetch_add(1, Order::AcqRel);
 	}
 
+	class ParallelForTask final : public Task {
+	public:
+		explicit ParallelForTask(usize ranges) : m_remaining(ranges) {}
+
+		MACH_NO_DISCARD Status status() const final {
+			return m_remaining.load(Order::Acquire) == 0 ? Status::Complete : Status::InProgress;
+		}
+
+		void complete_one() const {
+			const auto unused = m_remaining.fetch_sub(1, Order::AcqRel);
+			MACH_UNUSED(unused);
+		}
+
+	private:
+		Atomic<usize> m_remaining;
+	};
+
+	void Scheduler::parallel_for(usize count, usize batch_size, FunctionRef<void(usize start, usize end)> f) const {
+		MACH_ASSERT(batch_size > 0);
+		if (count == 0) {
+			return;
+		}
+
+		const usize ranges = (count + batch_size - 1) / batch_size;
+		if (ranges == 1) {
+			f(0, count);
+			return;
+		}
+
+		// Both live on this fiber's stack, which is safe as it does not return until every range is done
+		const ParallelForTask task{ ranges };
+		for (usize range = 1; range < ranges; range += 1) {
+			const usize start = range * batch_size;
+			const usize end = count - start < batch_size ? count : start + batch_size;
+			m_work_queue.normal_priority.push([&task, &f, start, end]() {
+				f(start, end);
+				task.complete_one();
+			});
+		}
+
+		f(0, batch_size);
+		task.complete_one();
+
+		if (task.status() != Task::Status::Complete) {
+			wait_for(task);
+		}
+	}
+
 	bool Scheduler::wait_until(Duration const& duration, Task const& task) const {
 		MACH_UNUSED(duration);
+		// Covers the time this fiber is suspended
+		MACH_PROFILE_SCOPE("Scheduler::wait_until");
 
 		while (true) {
 			for (auto& waiting : m_task_tracker.waiting_task) {
@@ -72,6 +146,7 @@ namespace Mach::Core {
 					waiting.state.store(WaitingTask::State::Filled);
 
 					g_fiber_index = available_fiber.unwrap();
+					Profiler::switch_fiber(available_fiber.unwrap());
 					m_fiber_controller.fibers[available_fiber.unwrap()]->switch_to();
 					return true;
 				}
@@ -84,6 +159,11 @@ namespace Mach::Core {
 		return m_thread_controller.threads.len() == m_thread_controller.ready_count.load(Order::Acquire);
 	}
 
+	EpochGuard Scheduler::pin() const {
+		MACH_ASSERT(g_worker_index.is_set(), "Scheduler::pin called from a thread that is not a worker");
+		return m_epoch.pin(g_worker_index.unwrap());
+	}
+
 	void Scheduler::worker_main(u32 fiber_index) const {
 		while (!is_running()) {
 			// Do nothing as we're initializing the Scheduler
@@ -93,6 +173,7 @@ namespace Mach::Core {
 			auto job = m_work_queue.high_priority.pop();
 			if (job.is_set()) {
 				auto f = job.unwrap();
+				MACH_PROFILE_SCOPE("Scheduler::job (high)");
 				f();
 				continue;
 			}
@@ -119,6 +200,7 @@ namespace Mach::Core {
 					m_task_tracker.vacant_waiting_task.push(index);
 					m_fiber_controller.dormant_fibers.push(fiber_index);
 					g_fiber_index = inner_fiber_index;
+					Profiler::switch_fiber(inner_fiber_index);
 					m_fiber_controller.fibers[inner_fiber_index]->switch_to();
 					resumed_work = true;
 					break;
@@ -133,6 +215,7 @@ namespace Mach::Core {
 			job = m_work_queue.normal_priority.pop();
 			if (job.is_set()) {
 				auto f = job.unwrap();
+				MACH_PROFILE_SCOPE("Scheduler::job (normal)");
 				f();
 				continue;
 			}
@@ -140,9 +223,110 @@ namespace Mach::Core {
 			job = m_work_queue.low_priority.pop();
 			if (job.is_set()) {
 				auto f = job.unwrap();
+				MACH_PROFILE_SCOPE("Scheduler::job (low)");
 				f();
 				continue;
 			}
+
+			// Nothing to run, so use the time to free what jobs on this worker retired. Returns straight away if
+			// there is nothing, which keeps idle workers from writing the shared epoch on every spin.
+			m_epoch.collect(g_worker_index.unwrap());
 		}
 	}
 } // namespace Mach::Core
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Scheduler throughput") {
+	using namespace Mach::Core;
+
+	class CountdownTask final : public Task {
+	public:
+		MACH_NO_DISCARD Status status() const final {
+			return remaining.load(Order::Acquire) == 0 ? Status::Complete : Status::InProgress;
+		}
+		Atomic<u32> remaining{ 0 };
+	};
+
+	// The Scheduler can not be shut down, so a single instance is shared and its workers keep polling for the rest of
+	// the run. Filter benchmarks to keep them from disturbing others.
+	static Scheduler scheduler;
+	static bool initialized = false;
+	if (!initialized) {
+		initialized = true;
+		scheduler.init({
+			.thread_count = 4,
+			.fiber_count = 64,
+			.waiting_count = 64,
+		});
+	}
+
+	static constexpr u32 job_count = 256;
+	bencher.set_items(job_count);
+	bencher.iter([] {
+		CountdownTask task;
+		task.remaining.store(job_count, Order::Release);
+		for (u32 i = 0; i < job_count; i += 1) {
+			scheduler.enqueue([&task] {
+				const auto unused = task.remaining.fetch_sub(1, Order::AcqRel);
+				MACH_UNUSED(unused);
+			});
+		}
+		scheduler.wait_for(task);
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/Test.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("Scheduler::parallel_for") {
+		// A single worker keeps the Scheduler from leaving threads behind. Every range after the first runs while this
+		// thread waits for them.
+		Scheduler scheduler;
+		scheduler.init({
+			.thread_count = 1,
+			.fiber_count = 4,
+			.waiting_count = 4,
+		});
+
+		// Returns true if every index in [0, count) was visited exactly once by ranges no longer than batch_size
+		auto visits_once = [&scheduler](usize count, usize batch_size) {
+			Array<u32> visits;
+			visits.set_len(count);
+			bool ranges_valid = true;
+			scheduler.parallel_for(count, batch_size, [&](usize start, usize end) {
+				if (start >= end || end > count || end - start > batch_size) {
+					ranges_valid = false;
+					return;
+				}
+				for (usize index = start; index < end; index += 1) {
+					visits[index] += 1;
+				}
+			});
+
+			for (u32 visit : visits) {
+				if (visit != 1) {
+					return false;
+				}
+			}
+			return ranges_valid;
+		};
+
+		MACH_CHECK(visits_once(100, 10));
+		// The last range is shorter than the rest
+		MACH_CHECK(visits_once(1000, 64));
+		MACH_CHECK(visits_once(7, 3));
+		// A single range runs on the calling fiber without waiting
+		MACH_CHECK(visits_once(64, 64));
+		MACH_CHECK(visits_once(5, 1000));
+		MACH_CHECK(visits_once(1, 1));
+
+		usize calls = 0;
+		scheduler.parallel_for(0, 16, [&calls](usize, usize) { calls += 1; });
+		MACH_CHECK(calls == 0);
+	}
+}
+#endif // MACH_ENABLE_TEST
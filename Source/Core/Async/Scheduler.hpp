@@ -6,13 +6,16 @@
 
 #pragma once
 
+#include <Core/Async/Epoch.hpp>
 #include <Core/Async/Fiber.hpp>
 #include <Core/Async/MPMC.hpp>
 #include <Core/Async/Thread.hpp>
+#include <Core/Async/UnboundedMPMC.hpp>
 #include <Core/Containers/Array.hpp>
 #include <Core/Containers/Function.hpp>
 #include <Core/Containers/SharedPtr.hpp>
 #include <Core/Containers/UniquePtr.hpp>
+#include <Core/Debug/Profiler.hpp>
 #include <Core/Time.hpp>
 
 namespace Mach::Core {
@@ -38,9 +41,9 @@ namespace Mach::Core {
 			u32 fiber_count;
 			u32 waiting_count;
 
-			u32 high_priority_count = 256;
-			u32 normal_priority_count = 512;
-			u32 low_priority_count = 1024;
+			// Restricts each worker, including the calling thread, to the logical cores of one physical core so workers
+			// never share a core with each other. Workers wrap around if there are more of them than physical cores.
+			bool pin_to_physical_cores = false;
 		};
 		void init(InitInfo const& create_info);
 
@@ -50,10 +53,18 @@ namespace Mach::Core {
 		void enqueue(Job&& job) const { return enqueue(Priority::Normal, Mach::forward<Function<void()>>(job)); }
 
 		void enqueue(Priority priority, Job&& job) const {
-			auto& queue = m_work_queue.get(priority);
-			queue.push(Mach::move(job));
+			MACH_PROFILE_MARK("Scheduler::enqueue");
+			m_work_queue.get(priority).push(Mach::move(job));
 		}
 
+		/**
+		 * Splits [0, count) into ranges of at most batch_size and calls f once per range across the workers. The
+		 * calling fiber runs the first range itself and then waits for the rest, so f may be called concurrently but
+		 * never after this returns. Must be called from a fiber of this Scheduler, which includes the thread that
+		 * called init.
+		 */
+		void parallel_for(usize count, usize batch_size, FunctionRef<void(usize start, usize end)> f) const;
+
 		MACH_NO_DISCARD bool wait_until(Duration const& duration, Task const& task) const;
 		MACH_ALWAYS_INLINE void wait_for(Task const& task) const {
 			// Not infinite but 584.9 billion years seems like enough time
@@ -63,6 +74,13 @@ namespace Mach::Core {
 
 		bool is_running() const;
 
+		/**
+		 * Pins the calling worker's participant in the scheduler's EpochDomain. Nodes of lock free structures shared
+		 * between jobs can be retired through the guard, and idle workers collect them. Must be called from a worker.
+		 */
+		MACH_NO_DISCARD EpochGuard pin() const;
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE EpochDomain const& epoch_domain() const { return m_epoch; }
+
 	private:
 		struct ThreadController {
 			Array<Mach::SharedPtr<Thread>> threads;
@@ -93,12 +111,13 @@ namespace Mach::Core {
 			MPMC<u32> dormant_fibers;
 		};
 
+		// Unbounded so bursts of jobs are never dropped
 		struct WorkQueue {
-			MPMC<Job> high_priority;
-			MPMC<Job> normal_priority;
-			MPMC<Job> low_priority;
+			UnboundedMPMC<Job> high_priority;
+			UnboundedMPMC<Job> normal_priority;
+			UnboundedMPMC<Job> low_priority;
 
-			MACH_ALWAYS_INLINE MPMC<Job> const& get(Priority priority) const {
+			MACH_ALWAYS_INLINE UnboundedMPMC<Job> const& get(Priority priority) const {
 				switch (priority) {
 				case Priority::Low:
 					return low_priority;
@@ -122,5 +141,6 @@ namespace Mach::Core {
 		FiberController m_fiber_controller;
 		TaskTracker m_task_tracker;
 		WorkQueue m_work_queue;
+		EpochDomain m_epoch;
 	};
 } // namespace Mach::Core
@@ -5,7 +5,136 @@
  */
 
 #include <Core/Async/Thread.hpp>
+#include <Core/Debug/Test.hpp>
 
 namespace Mach::Core {
 	Mach::SharedPtr<Thread> Thread::spawn(Function&& f) { return Thread::spawn(Mach::forward<Function>(f), {}); }
 } // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#if MACH_OS == MACH_OS_WINDOWS
+		#include <Core/Windows.hpp>
+	#elif MACH_OS == MACH_OS_LINUX
+		#include <pthread.h>
+		#include <sched.h>
+	#endif
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	// Affinity of the calling thread as reported by the OS. macOS can not bind threads to cores, so there is none.
+	Option<CpuSet> current_affinity() {
+	#if MACH_OS == MACH_OS_LINUX
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+			return nullopt;
+		}
+		CpuSet result;
+		for (usize core = 0; core < CpuSet::max_cores && core < CPU_SETSIZE; core += 1) {
+			if (CPU_ISSET(core, &set)) {
+				result.insert(core);
+			}
+		}
+		return result;
+	#elif MACH_OS == MACH_OS_WINDOWS
+		GROUP_AFFINITY affinity{};
+		if (!GetThreadGroupAffinity(GetCurrentThread(), &affinity)) {
+			return nullopt;
+		}
+		CpuSet result;
+		for (usize bit = 0; bit < 64; bit += 1) {
+			if ((affinity.Mask & (KAFFINITY{ 1 } << bit)) != 0) {
+				result.insert(affinity.Group * 64 + bit);
+			}
+		}
+		return result;
+	#else
+		return nullopt;
+	#endif
+	}
+
+	MACH_TEST_CASE("CpuSet") {
+		CpuSet set;
+		MACH_CHECK(set.is_empty());
+
+		set.insert(0);
+		set.insert(65);
+		set.insert(CpuSet::max_cores - 1);
+		MACH_CHECK(set.len() == 3);
+		MACH_CHECK(set.contains(65));
+		MACH_CHECK(!set.contains(64));
+		MACH_CHECK(!set.contains(CpuSet::max_cores));
+
+		set.insert(CpuSet::single(64));
+		MACH_CHECK(set.contains(64));
+		MACH_CHECK(CpuSet::single(3) == CpuSet::single(3));
+		MACH_CHECK(!(CpuSet::single(3) == CpuSet::single(4)));
+	}
+
+	MACH_TEST_CASE("CpuTopology") {
+		const auto& topology = CpuTopology::get();
+		MACH_CHECK(!topology.physical_cores.is_empty());
+		MACH_CHECK(topology.physical_cores.len() <= topology.logical_core_count);
+		MACH_CHECK(topology.package_count >= 1);
+		MACH_CHECK(topology.l3_domain_count >= 1);
+		MACH_CHECK(topology.numa_node_count >= 1);
+
+		// Every logical core belongs to exactly one physical core
+		CpuSet seen;
+		usize logical_count = 0;
+		for (const auto& core : topology.physical_cores) {
+			MACH_CHECK(!core.logical.is_empty());
+			MACH_CHECK(core.package < topology.package_count);
+			MACH_CHECK(core.l3_domain < topology.l3_domain_count);
+			MACH_CHECK(core.numa_node < topology.numa_node_count);
+			for (usize logical = 0; logical < CpuSet::max_cores; logical += 1) {
+				if (core.logical.contains(logical)) {
+					MACH_CHECK(!seen.contains(logical));
+					seen.insert(logical);
+				}
+			}
+			logical_count += core.logical.len();
+		}
+		MACH_CHECK(logical_count == topology.logical_core_count);
+	}
+
+	MACH_TEST_CASE("Thread") {
+		MACH_SUBCASE("start_suspended") {
+			Atomic<u32> runs{ 0 };
+			auto thread = Thread::spawn(
+				[&runs] {
+					const auto unused = runs.fetch_add(1);
+					MACH_UNUSED(unused);
+				},
+				Thread::SpawnInfo{ .name = u8"Suspended Worker Name"_sv, .stack_size = 256 * 1024, .start_suspended = true });
+
+			Thread::sleep(Duration::from_millis(10));
+			MACH_CHECK(runs.load() == 0);
+
+			thread->resume();
+			thread.unsafe_get_mut().join();
+			MACH_CHECK(runs.load() == 1);
+		}
+
+		MACH_SUBCASE("affinity and priority") {
+			const auto& core = CpuTopology::get().physical_cores[0];
+			Atomic<bool> applied{ false };
+			Option<CpuSet> affinity = nullopt;
+			auto thread = Thread::spawn(
+				[&applied, &affinity] {
+					affinity = current_affinity();
+					// Lowering priority never needs permissions
+					applied.store(Thread::current().set_priority(Thread::Priority::Lowest));
+				},
+				Thread::SpawnInfo{ .affinity = core.logical, .priority = Thread::Priority::Low });
+			thread.unsafe_get_mut().join();
+			MACH_CHECK(applied.load());
+	#if MACH_OS == MACH_OS_LINUX || MACH_OS == MACH_OS_WINDOWS
+			MACH_REQUIRE(affinity.is_set());
+			MACH_CHECK(affinity.unwrap() == core.logical);
+	#endif
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -6,22 +6,117 @@
 
 #pragma once
 
+#include <Core/Containers/Array.hpp>
 #include <Core/Containers/Function.hpp>
 #include <Core/Containers/SharedPtr.hpp>
 #include <Core/Containers/StringView.hpp>
+#include <Core/Time.hpp>
+
+#include <bit>
 
 namespace Mach::Core {
+	// Set of logical cores, indexed the same way the OS numbers them
+	class CpuSet {
+	public:
+		static constexpr usize max_cores = 1024;
+
+		constexpr CpuSet() = default;
+
+		MACH_NO_DISCARD static constexpr CpuSet single(usize core) {
+			CpuSet result;
+			result.insert(core);
+			return result;
+		}
+
+		MACH_ALWAYS_INLINE constexpr void insert(usize core) {
+			MACH_ASSERT(core < max_cores, "Core index is out of range of CpuSet");
+			m_words[core / 64] |= u64{ 1 } << (core % 64);
+		}
+
+		MACH_ALWAYS_INLINE constexpr void insert(CpuSet const& other) {
+			for (usize i = 0; i < word_count; i += 1) {
+				m_words[i] |= other.m_words[i];
+			}
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr bool contains(usize core) const {
+			if (core >= max_cores) {
+				return false;
+			}
+			return (m_words[core / 64] & (u64{ 1 } << (core % 64))) != 0;
+		}
+
+		MACH_NO_DISCARD constexpr usize len() const {
+			usize result = 0;
+			for (const u64 word : m_words) {
+				result += static_cast<usize>(std::popcount(word));
+			}
+			return result;
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr bool is_empty() const { return len() == 0; }
+
+		MACH_NO_DISCARD constexpr bool operator==(CpuSet const& rhs) const {
+			for (usize i = 0; i < word_count; i += 1) {
+				if (m_words[i] != rhs.m_words[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	private:
+		static constexpr usize word_count = max_cores / 64;
+		u64 m_words[word_count] = {};
+	};
+
+	/**
+	 * Layout of the logical cores the OS exposes. Logical cores that share a physical core (SMT siblings) share its
+	 * execution units, so work that wants one thread per core should pin to PhysicalCore::logical rather than to every
+	 * logical core.
+	 */
+	struct CpuTopology {
+		struct PhysicalCore {
+			CpuSet logical;
+			u32 package = 0;
+			u32 l3_domain = 0;
+			u32 numa_node = 0;
+		};
+
+		u32 logical_core_count = 0;
+		u32 package_count = 0;
+		u32 l3_domain_count = 0;
+		u32 numa_node_count = 0;
+		Array<PhysicalCore> physical_cores;
+
+		// Queried from the OS on first use and cached for the life of the process
+		MACH_NO_DISCARD static CpuTopology const& get();
+	};
+
 	class Thread : public Mach::SharedPtrFromThis<Thread> {
 	public:
 		using Function = Function<void()>;
+
+		// Relative scheduling priority. What each level maps to is OS specific, and raising a thread above Normal may
+		// need elevated permissions.
+		enum class Priority : u8 { Lowest, Low, Normal, High, Highest };
+
 		struct SpawnInfo {
+			// Shown in debuggers and profilers. Truncated to 15 bytes on Linux.
 			Option<StringView> name = nullopt;
 			Option<usize> stack_size = nullopt;
+			Option<CpuSet> affinity = nullopt;
+			Priority priority = Priority::Normal;
+			// The thread will not run f until resume is called
 			bool start_suspended = false;
 		};
 		static Mach::SharedPtr<Thread> spawn(Function&& f, const SpawnInfo& info);
 		static Mach::SharedPtr<Thread> spawn(Function&& f);
 		static Thread const& current();
+		// Blocks the calling thread for at least duration
+		static void sleep(Duration duration);
+		// Gives the rest of the calling thread's time slice to any other thread that is ready to run
+		static void yield_now();
 
 		using Id = u64;
 
@@ -29,6 +124,19 @@ namespace Mach::Core {
 		virtual void detach() = 0;
 		virtual Id id() const = 0;
 
+		// Lets a thread spawned with start_suspended run. Does nothing for threads that are already running.
+		virtual void resume() const = 0;
+
+		// Restricts the thread to the given logical cores. Returns false if the OS rejected the set.
+		virtual bool set_affinity(CpuSet const& cores) const = 0;
+		// Returns false if the OS rejected the priority, usually because raising it needs elevated permissions
+		virtual bool set_priority(Priority priority) const = 0;
+
 		virtual ~Thread() {}
 	};
 } // namespace Mach::Core
+
+namespace Mach {
+	using Core::CpuSet;
+	using Core::CpuTopology;
+} // namespace Mach
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/UnboundedMPMC.hpp>
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/String.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("UnboundedMPMC") {
+		MACH_SUBCASE("first in first out across blocks") {
+			const auto queue = UnboundedMPMC<u32>::create();
+			MACH_CHECK(queue.is_empty());
+			MACH_CHECK(!queue.pop().is_set());
+
+			for (u32 i = 0; i < 1000; i += 1) {
+				queue.push(i);
+			}
+			MACH_CHECK(!queue.is_empty());
+			bool in_order = true;
+			for (u32 i = 0; i < 1000; i += 1) {
+				in_order &= queue.pop().unwrap() == i;
+			}
+			MACH_CHECK(in_order);
+			MACH_CHECK(queue.is_empty());
+			MACH_CHECK(!queue.pop().is_set());
+		}
+
+		MACH_SUBCASE("batches") {
+			const auto queue = UnboundedMPMC<u32>::create();
+			u32 values[100];
+			for (u32 i = 0; i < 100; i += 1) {
+				values[i] = i;
+			}
+			queue.push_n(Slice<u32>{ values, 100 });
+
+			u32 out[100] = {};
+			usize popped = 0;
+			bool in_order = true;
+			while (popped < 100) {
+				const usize count = queue.pop_n(Slice<u32>{ out, 40 });
+				MACH_REQUIRE(count > 0);
+				for (usize i = 0; i < count; i += 1) {
+					in_order &= out[i] == popped + i;
+				}
+				popped += count;
+			}
+			MACH_CHECK(in_order);
+			MACH_CHECK(queue.pop_n(Slice<u32>{ out, 40 }) == 0);
+		}
+
+		MACH_SUBCASE("drops remaining values") {
+			const auto queue = UnboundedMPMC<String>::create();
+			for (u32 i = 0; i < 100; i += 1) {
+				queue.push(String::format(u8"value {}"_sv, i));
+			}
+			const auto popped = queue.pop();
+			MACH_CHECK(popped.as_const_ref().unwrap() == u8"value 0"_sv);
+		}
+
+		MACH_SUBCASE("producers and consumers") {
+			static constexpr u32 producer_count = 4;
+			static constexpr u32 consumer_count = 4;
+			static constexpr u64 per_producer = 20000;
+
+			const auto queue = UnboundedMPMC<u64>::create();
+			Atomic<u64> sum{ 0 };
+			Atomic<u64> popped{ 0 };
+
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < producer_count; index += 1) {
+				threads.push(Thread::spawn([&queue, index] {
+					u64 batch[8];
+					for (u64 i = 0; i < per_producer; i += 8) {
+						for (u64 j = 0; j < 8; j += 1) {
+							batch[j] = index * per_producer + i + j + 1;
+						}
+						queue.push_n(Slice<u64>{ batch, 8 });
+					}
+				}));
+			}
+			for (u32 index = 0; index < consumer_count; index += 1) {
+				threads.push(Thread::spawn([&queue, &sum, &popped, index] {
+					u64 out[5];
+					while (popped.load() < producer_count * per_producer) {
+						// Mix single and batch pops
+						usize count = 0;
+						if (index % 2 == 0) {
+							count = queue.pop_n(Slice<u64>{ out, 5 });
+						} else if (auto value = queue.pop(); value.is_set()) {
+							out[0] = value.unwrap();
+							count = 1;
+						}
+						if (count == 0) {
+							Thread::yield_now();
+							continue;
+						}
+						for (usize i = 0; i < count; i += 1) {
+							const auto unused = sum.fetch_add(out[i]);
+							MACH_UNUSED(unused);
+						}
+						const auto unused = popped.fetch_add(count);
+						MACH_UNUSED(unused);
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+
+			const u64 total = producer_count * per_producer;
+			MACH_CHECK(popped.load() == total);
+			MACH_CHECK(sum.load() == total * (total + 1) / 2);
+			MACH_CHECK(queue.is_empty());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("UnboundedMPMC push pop") {
+	using namespace Mach::Core;
+
+	const auto queue = UnboundedMPMC<u64>::create();
+	bencher.set_items(512);
+	bencher.iter([&queue] {
+		for (u64 i = 0; i < 512; i += 1) {
+			queue.push(i);
+		}
+		u64 sum = 0;
+		for (u64 i = 0; i < 512; i += 1) {
+			sum += queue.pop().unwrap_or(0);
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("UnboundedMPMC push_n pop_n") {
+	using namespace Mach::Core;
+
+	const auto queue = UnboundedMPMC<u64>::create();
+	u64 values[16] = {};
+	bencher.set_items(512);
+	bencher.iter([&] {
+		for (u64 i = 0; i < 512; i += 16) {
+			queue.push_n(Slice<u64>{ values, 16 });
+		}
+		u64 out[16];
+		usize popped = 0;
+		while (popped < 512) {
+			popped += queue.pop_n(Slice<u64>{ out, 16 });
+		}
+		return popped;
+	});
+}
+
+MACH_BENCHMARK("UnboundedMPMC contended 4 threads") {
+	using namespace Mach::Core;
+
+	static constexpr u32 thread_count = 4;
+	static constexpr u64 per_thread = 4096;
+
+	const auto queue = UnboundedMPMC<u64>::create();
+	bencher.set_items(thread_count * per_thread);
+	bencher.iter([&queue] {
+		Array<Mach::SharedPtr<Thread>> threads;
+		for (u32 index = 0; index < thread_count; index += 1) {
+			threads.push(Thread::spawn([&queue] {
+				for (u64 i = 0; i < per_thread; i += 1) {
+					queue.push(i);
+					while (!queue.pop().is_set()) {}
+				}
+			}));
+		}
+		for (auto& thread : threads) {
+			thread.unsafe_get_mut().join();
+		}
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
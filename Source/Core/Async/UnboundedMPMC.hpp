@@ -0,0 +1,329 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Thread.hpp>
+#include <Core/Atomic.hpp>
+#include <Core/Containers/Slice.hpp>
+#include <Core/Math/Math.hpp>
+#include <Core/Memory.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Multi producer multi consumer queue that never fills up. Values are stored in fixed size blocks that are linked
+	 * together as the queue grows and freed by the consumer that empties them, so push only allocates once per block.
+	 *
+	 * Source: crossbeam's SegQueue
+	 * https://github.com/crossbeam-rs/crossbeam/blob/master/crossbeam-queue/src/seg_queue.rs
+	 */
+	template <Movable T>
+	class UnboundedMPMC {
+		// Positions count in laps of Lap slots, where the last slot of every lap marks the jump to the next block. The
+		// lowest bit of the head index records whether the head block already has a successor.
+		static constexpr usize Lap = 32;
+		static constexpr usize BlockCapacity = Lap - 1;
+		static constexpr usize Shift = 1;
+		static constexpr usize HasNext = 1;
+
+		// Slot state bits
+		static constexpr u32 Written = 1;
+		static constexpr u32 Read = 2;
+		static constexpr u32 Destroy = 4;
+
+		struct Slot {
+			alignas(T) u8 value[sizeof(T)];
+			Atomic<u32> state{ 0 };
+
+			void wait_written() const {
+				for (u32 spin = 0; (state.load(Order::Acquire) & Written) == 0; spin += 1) {
+					backoff(spin);
+				}
+			}
+		};
+
+		struct Block {
+			Atomic<Block*> next{ nullptr };
+			Slot slots[BlockCapacity];
+
+			Block* wait_next() const {
+				for (u32 spin = 0;; spin += 1) {
+					Block* const result = next.load(Order::Acquire);
+					if (result != nullptr) {
+						return result;
+					}
+					backoff(spin);
+				}
+			}
+		};
+
+		struct alignas(MACH_CACHE_LINE_SIZE) Position {
+			Atomic<usize> index{ 0 };
+			Atomic<Block*> block{ nullptr };
+		};
+
+	public:
+		static UnboundedMPMC create() {
+			UnboundedMPMC result;
+			Block* const block = allocate_block();
+			result.m_head.block.store(block, Order::Relaxed);
+			result.m_tail.block.store(block, Order::Relaxed);
+			return result;
+		}
+
+		explicit UnboundedMPMC() = default;
+		UnboundedMPMC(const UnboundedMPMC&) = delete;
+		UnboundedMPMC& operator=(const UnboundedMPMC&) = delete;
+
+		UnboundedMPMC(UnboundedMPMC&& move) noexcept { *this = Mach::move(move); }
+		UnboundedMPMC& operator=(UnboundedMPMC&& move) noexcept {
+			this->~UnboundedMPMC();
+			m_head.index.store(move.m_head.index.load(Order::Relaxed), Order::Relaxed);
+			m_head.block.store(move.m_head.block.exchange(nullptr, Order::Relaxed), Order::Relaxed);
+			m_tail.index.store(move.m_tail.index.load(Order::Relaxed), Order::Relaxed);
+			m_tail.block.store(move.m_tail.block.exchange(nullptr, Order::Relaxed), Order::Relaxed);
+			return *this;
+		}
+
+		~UnboundedMPMC() {
+			Block* block = m_head.block.load(Order::Relaxed);
+			if (block == nullptr) {
+				return;
+			}
+
+			// Drop everything between head and tail, freeing blocks as we walk off their end
+			usize head = m_head.index.load(Order::Relaxed) & ~((usize{ 1 } << Shift) - 1);
+			const usize tail = m_tail.index.load(Order::Relaxed) & ~((usize{ 1 } << Shift) - 1);
+			while (head != tail) {
+				const usize offset = (head >> Shift) % Lap;
+				if (offset < BlockCapacity) {
+					reinterpret_cast<T*>(block->slots[offset].value)->~T();
+				} else {
+					Block* const next = block->next.load(Order::Relaxed);
+					free_block(block);
+					block = next;
+				}
+				head += usize{ 1 } << Shift;
+			}
+			free_block(block);
+			m_head.block.store(nullptr, Order::Relaxed);
+			m_tail.block.store(nullptr, Order::Relaxed);
+		}
+
+		void push(const T& t) const
+			requires Copyable<T>
+		{
+			T copy = t;
+			push(Mach::move(copy));
+		}
+
+		void push(T&& t) const { push_n(Slice<T>(t)); }
+
+		// Moves every value in values to the back of the queue. Runs of values that land in the same block are
+		// claimed with a single atomic operation.
+		void push_n(Slice<T> values) const {
+			usize pushed = 0;
+			while (pushed < values.len()) {
+				auto [block, offset, count] = claim_push(values.len() - pushed);
+				for (usize i = 0; i < count; i += 1) {
+					Slot& slot = block->slots[offset + i];
+					Memory::emplace<T>(slot.value, Mach::move(values[pushed + i]));
+					const auto unused = slot.state.fetch_or(Written, Order::Release);
+					MACH_UNUSED(unused);
+				}
+				pushed += count;
+			}
+		}
+
+		MACH_NO_DISCARD Option<T> pop() const {
+			auto claimed = claim_pop(1);
+			if (claimed.count == 0) {
+				return nullopt;
+			}
+			Slot& slot = claimed.block->slots[claimed.offset];
+			slot.wait_written();
+			T* const value = reinterpret_cast<T*>(slot.value);
+			Option<T> result = Mach::move(*value);
+			value->~T();
+			release_slot(claimed.block, claimed.offset);
+			return result;
+		}
+
+		// Moves up to out.len() values from the front of the queue into out and returns how many were moved. May
+		// return fewer than are in the queue, as a single call never crosses from one block into the next.
+		MACH_NO_DISCARD usize pop_n(Slice<T> out) const {
+			if (out.len() == 0) {
+				return 0;
+			}
+			auto claimed = claim_pop(out.len());
+			for (usize i = 0; i < claimed.count; i += 1) {
+				Slot& slot = claimed.block->slots[claimed.offset + i];
+				slot.wait_written();
+				T* const value = reinterpret_cast<T*>(slot.value);
+				out[i] = Mach::move(*value);
+				value->~T();
+				release_slot(claimed.block, claimed.offset + i);
+			}
+			return claimed.count;
+		}
+
+		MACH_NO_DISCARD bool is_empty() const {
+			const usize head = m_head.index.load(Order::SeqCst);
+			const usize tail = m_tail.index.load(Order::SeqCst);
+			return (head >> Shift) == (tail >> Shift);
+		}
+
+	private:
+		struct Claim {
+			Block* block;
+			usize offset;
+			usize count;
+		};
+
+		// Spins first, then gives up the time slice so a preempted producer or consumer can finish
+		static void backoff(u32 spin) {
+			if (spin < 64) {
+				spin_loop_hint();
+			} else {
+				Thread::yield_now();
+			}
+		}
+
+		static Block* allocate_block() {
+			auto memory = Memory::alloc(Memory::Layout::single<Block>());
+			Block* const block = static_cast<Block*>(*memory);
+			Memory::emplace<Block>(block);
+			return block;
+		}
+
+		static void free_block(Block* block) {
+			block->~Block();
+			Memory::free(block);
+		}
+
+		// Frees block once every slot from start onwards has been read. A slot that is still being read is marked
+		// Destroy instead, and its reader carries on from there once it is done.
+		static void destroy_block(Block* block, usize start) {
+			// The last slot's reader is the one that starts destruction, so it never needs marking
+			for (usize i = start; i < BlockCapacity - 1; i += 1) {
+				Slot& slot = block->slots[i];
+				if ((slot.state.load(Order::Acquire) & Read) == 0 &&
+					(slot.state.fetch_or(Destroy, Order::AcqRel) & Read) == 0) {
+					return;
+				}
+			}
+			free_block(block);
+		}
+
+		static void release_slot(Block* block, usize offset) {
+			if (offset + 1 == BlockCapacity) {
+				destroy_block(block, 0);
+			} else if ((block->slots[offset].state.fetch_or(Read, Order::AcqRel) & Destroy) != 0) {
+				destroy_block(block, offset + 1);
+			}
+		}
+
+		// Reserves up to count consecutive slots at the tail, all in one block
+		Claim claim_push(usize count) const {
+			usize tail = m_tail.index.load(Order::Acquire);
+			Block* block = m_tail.block.load(Order::Acquire);
+			Block* next_block = nullptr;
+
+			for (u32 spin = 0;; spin += 1) {
+				const usize offset = (tail >> Shift) % Lap;
+
+				// Someone is installing the next block, wait for them
+				if (offset == BlockCapacity) {
+					backoff(spin);
+					tail = m_tail.index.load(Order::Acquire);
+					block = m_tail.block.load(Order::Acquire);
+					continue;
+				}
+
+				const usize claimed = Math::min(count, BlockCapacity - offset);
+				const bool fills_block = offset + claimed == BlockCapacity;
+
+				// Allocate ahead of time so other producers spend as little time as possible waiting for it
+				if (fills_block && next_block == nullptr) {
+					next_block = allocate_block();
+				}
+
+				const usize new_tail = tail + (claimed << Shift);
+				if (m_tail.index.compare_exchange_weak(tail, new_tail, Order::SeqCst).is_set()) {
+					if (fills_block) {
+						m_tail.block.store(next_block, Order::Release);
+						m_tail.index.store(new_tail + (usize{ 1 } << Shift), Order::Release);
+						block->next.store(next_block, Order::Release);
+					} else if (next_block != nullptr) {
+						free_block(next_block);
+					}
+					return Claim{ .block = block, .offset = offset, .count = claimed };
+				}
+
+				tail = m_tail.index.load(Order::Acquire);
+				block = m_tail.block.load(Order::Acquire);
+				spin_loop_hint();
+			}
+		}
+
+		// Reserves up to count consecutive filled or filling slots at the head, all in one block. count is 0 if the
+		// queue is empty.
+		Claim claim_pop(usize count) const {
+			usize head = m_head.index.load(Order::Acquire);
+			Block* block = m_head.block.load(Order::Acquire);
+
+			for (u32 spin = 0;; spin += 1) {
+				const usize offset = (head >> Shift) % Lap;
+
+				// Someone is moving the head to the next block, wait for them
+				if (offset == BlockCapacity) {
+					backoff(spin);
+					head = m_head.index.load(Order::Acquire);
+					block = m_head.block.load(Order::Acquire);
+					continue;
+				}
+
+				usize claimed = Math::min(count, BlockCapacity - offset);
+				usize new_head = head;
+				if ((head & HasNext) == 0) {
+					atomic_fence(Order::SeqCst);
+					const usize tail = m_tail.index.load(Order::Relaxed);
+					if ((head >> Shift) == (tail >> Shift)) {
+						return Claim{ .block = block, .offset = offset, .count = 0 };
+					}
+
+					if ((head >> Shift) / Lap != (tail >> Shift) / Lap) {
+						// The tail has moved on to a later block, so everything left in this one is ours to take
+						new_head |= HasNext;
+					} else {
+						claimed = Math::min(claimed, (tail >> Shift) - (head >> Shift));
+					}
+				}
+				new_head += claimed << Shift;
+
+				if (m_head.index.compare_exchange_weak(head, new_head, Order::SeqCst).is_set()) {
+					if (offset + claimed == BlockCapacity) {
+						Block* const next = block->wait_next();
+						usize next_index = (new_head & ~HasNext) + (usize{ 1 } << Shift);
+						if (next->next.load(Order::Relaxed) != nullptr) {
+							next_index |= HasNext;
+						}
+						m_head.block.store(next, Order::Release);
+						m_head.index.store(next_index, Order::Release);
+					}
+					return Claim{ .block = block, .offset = offset, .count = claimed };
+				}
+
+				head = m_head.index.load(Order::Acquire);
+				block = m_head.block.load(Order::Acquire);
+				spin_loop_hint();
+			}
+		}
+
+		Position m_head;
+		Position m_tail;
+	};
+} // namespace Mach::Core
@@ -6,6 +6,7 @@
 
 #include <Core/Async/Win32/Thread.hpp>
 
+#include <Core/Containers/WString.hpp>
 #include <Core/Memory.hpp>
 
 namespace Mach::Core {
@@ -19,6 +20,14 @@ namespace Mach::Core {
 		return *g_current_thread.as_ref().unwrap();
 	}
 
+	void Thread::sleep(Duration duration) {
+		// Round up so short sleeps are not skipped entirely
+		const u64 millis = duration.as_millis() + (duration.subsec_nanos() % nanos_per_milli != 0 ? 1 : 0);
+		::Sleep(static_cast<DWORD>(millis));
+	}
+
+	void Thread::yield_now() { ::SwitchToThread(); }
+
 	static DWORD WINAPI ThreadProc(_In_ LPVOID lpParameter) {
 		auto* param = static_cast<Thread::Function*>(lpParameter);
 		(*param)();
@@ -28,20 +37,39 @@ namespace Mach::Core {
 	}
 
 	Mach::SharedPtr<Thread> Thread::spawn(Function&& f, const SpawnInfo& info) {
-		DWORD flags = 0;
-		if (info.start_suspended) {
-			flags |= CREATE_SUSPENDED;
-		}
-
 		auto param = Memory::alloc(Memory::Layout::single<Thread::Function>());
 		Memory::emplace<Thread::Function>(param, Mach::move(f));
 
 		auto stack_size = info.stack_size.unwrap_or(0);
 
+		// Always start suspended so the name, affinity and priority are in place before f runs
 		DWORD id;
-		const HANDLE thread = ::CreateThread(nullptr, stack_size, &ThreadProc, static_cast<LPVOID>(param), flags, &id);
+		const HANDLE thread = ::CreateThread(
+			nullptr,
+			stack_size,
+			&ThreadProc,
+			static_cast<LPVOID>(param),
+			CREATE_SUSPENDED,
+			&id);
+
+		auto result = Mach::SharedPtr<Win32Thread>::create(thread, id);
+		if (info.name.is_set()) {
+			const auto name = WString::from(info.name.as_const_ref().unwrap());
+			::SetThreadDescription(thread, *name);
+		}
+		if (info.affinity.is_set()) {
+			const bool affinity_set = result->set_affinity(info.affinity.as_const_ref().unwrap());
+			MACH_UNUSED(affinity_set);
+		}
+		if (info.priority != Priority::Normal) {
+			const bool priority_set = result->set_priority(info.priority);
+			MACH_UNUSED(priority_set);
+		}
+		if (!info.start_suspended) {
+			result->resume();
+		}
 
-		return Mach::SharedPtr<Win32Thread>::create(thread, id);
+		return result;
 	}
 
 	void Win32Thread::join() {
@@ -56,9 +84,154 @@ namespace Mach::Core {
 
 	Thread::Id Win32Thread::id() const { return static_cast<Thread::Id>(m_id); }
 
+	void Win32Thread::resume() const {
+		const DWORD previous_count = ::ResumeThread(m_thread);
+		MACH_UNUSED(previous_count);
+	}
+
+	bool Win32Thread::set_affinity(CpuSet const& cores) const {
+		// A thread can only be bound to cores in one processor group, so use the group of the lowest core in the set
+		for (usize group = 0; group < CpuSet::max_cores / 64; group += 1) {
+			KAFFINITY mask = 0;
+			for (usize bit = 0; bit < 64; bit += 1) {
+				if (cores.contains(group * 64 + bit)) {
+					mask |= KAFFINITY{ 1 } << bit;
+				}
+			}
+			if (mask != 0) {
+				GROUP_AFFINITY affinity{};
+				affinity.Mask = mask;
+				affinity.Group = static_cast<WORD>(group);
+				return ::SetThreadGroupAffinity(m_thread, &affinity, nullptr) != 0;
+			}
+		}
+		return false;
+	}
+
+	bool Win32Thread::set_priority(Priority priority) const {
+		static constexpr int priorities[] = {
+			THREAD_PRIORITY_LOWEST,		  THREAD_PRIORITY_BELOW_NORMAL, THREAD_PRIORITY_NORMAL,
+			THREAD_PRIORITY_ABOVE_NORMAL, THREAD_PRIORITY_HIGHEST,
+		};
+		return ::SetThreadPriority(m_thread, priorities[static_cast<usize>(priority)]) != 0;
+	}
+
 	Win32Thread::~Win32Thread() {
 		if (m_thread != nullptr) {
 			join();
 		}
 	}
+
+	// Logical core indices are numbered group by group, 64 per processor group
+	static CpuSet to_cpu_set(GROUP_AFFINITY const& affinity) {
+		CpuSet result;
+		for (usize bit = 0; bit < 64; bit += 1) {
+			if ((affinity.Mask & (KAFFINITY{ 1 } << bit)) != 0) {
+				result.insert(static_cast<usize>(affinity.Group) * 64 + bit);
+			}
+		}
+		return result;
+	}
+
+	// Index of the set in sets that contains the lowest logical core of core, or 0 if none do
+	static u32 find_domain(Array<CpuSet> const& sets, CpuSet const& core) {
+		for (usize logical = 0; logical < CpuSet::max_cores; logical += 1) {
+			if (!core.contains(logical)) {
+				continue;
+			}
+			for (usize i = 0; i < sets.len(); i += 1) {
+				if (sets[i].contains(logical)) {
+					return static_cast<u32>(i);
+				}
+			}
+			break;
+		}
+		return 0;
+	}
+
+	static CpuTopology query_topology() {
+		CpuTopology result;
+
+		DWORD size = 0;
+		::GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+		if (size == 0) {
+			return result;
+		}
+		auto buffer = Memory::alloc(Memory::Layout{ size, alignof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX) });
+		auto* bytes = static_cast<u8*>(*buffer);
+		if (!::GetLogicalProcessorInformationEx(
+				RelationAll,
+				reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(bytes),
+				&size)) {
+			Memory::free(buffer);
+			return result;
+		}
+
+		Array<CpuSet> packages;
+		Array<CpuSet> l3_domains;
+		Array<CpuSet> numa_nodes;
+		for (DWORD offset = 0; offset < size;) {
+			const auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>(bytes + offset);
+			switch (info->Relationship) {
+			case RelationProcessorCore: {
+				CpuSet logical;
+				for (WORD group = 0; group < info->Processor.GroupCount; group += 1) {
+					logical.insert(to_cpu_set(info->Processor.GroupMask[group]));
+				}
+				result.logical_core_count += static_cast<u32>(logical.len());
+				result.physical_cores.push(CpuTopology::PhysicalCore{ .logical = logical });
+			} break;
+			case RelationProcessorPackage: {
+				CpuSet logical;
+				for (WORD group = 0; group < info->Processor.GroupCount; group += 1) {
+					logical.insert(to_cpu_set(info->Processor.GroupMask[group]));
+				}
+				packages.push(logical);
+			} break;
+			case RelationCache:
+				if (info->Cache.Level == 3) {
+					l3_domains.push(to_cpu_set(info->Cache.GroupMask));
+				}
+				break;
+			case RelationNumaNode:
+				numa_nodes.push(to_cpu_set(info->NumaNode.GroupMask));
+				break;
+			default:
+				break;
+			}
+			offset += info->Size;
+		}
+		Memory::free(buffer);
+
+		for (auto& core : result.physical_cores) {
+			core.package = find_domain(packages, core.logical);
+			// Machines without an L3 get one domain per package
+			core.l3_domain = l3_domains.is_empty() ? core.package : find_domain(l3_domains, core.logical);
+			core.numa_node = find_domain(numa_nodes, core.logical);
+		}
+		result.package_count = packages.is_empty() ? 1 : static_cast<u32>(packages.len());
+		result.l3_domain_count = l3_domains.is_empty() ? result.package_count : static_cast<u32>(l3_domains.len());
+		result.numa_node_count = numa_nodes.is_empty() ? 1 : static_cast<u32>(numa_nodes.len());
+		return result;
+	}
+
+	CpuTopology const& CpuTopology::get() {
+		static const CpuTopology topology = [] {
+			CpuTopology result = query_topology();
+			if (result.physical_cores.is_empty()) {
+				// Without topology information treat every logical core as its own physical core
+				result = CpuTopology{};
+				const DWORD count = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+				for (usize index = 0; index < count && index < CpuSet::max_cores; index += 1) {
+					result.physical_cores.push(CpuTopology::PhysicalCore{ .logical = CpuSet::single(index) });
+				}
+				result.logical_core_count = static_cast<u32>(result.physical_cores.len());
+				result.package_count = 1;
+				result.l3_domain_count = 1;
+				result.numa_node_count = 1;
+			}
+			return result;
+		}();
+		return topology;
+	}
 } // namespace Mach::Core
@@ -29,6 +29,9 @@ namespace Mach::Core {
 		void join() final;
 		void detach() final;
 		Id id() const final;
+		void resume() const final;
+		bool set_affinity(CpuSet const& cores) const final;
+		bool set_priority(Priority priority) const final;
 		~Win32Thread() final;
 		// ~Thread interface
 
@@ -9,6 +9,12 @@
 #include <Core/Containers/Option.hpp>
 #include <atomic>
 
+#if MACH_CPU == MACH_CPU_X86
+	#include <emmintrin.h>
+#elif MACH_COMPILER == MACH_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
 namespace Mach::Core {
 	enum class Order : u8 { Relaxed, Release, Acquire, AcqRel, SeqCst };
 
@@ -76,6 +82,14 @@ namespace Mach::Core {
 			return m_atomic.fetch_xor(arg, to_std(order));
 		}
 
+		// Blocks the calling thread until the value no longer equals old. Backed by a futex (or the platform
+		// equivalent) so the thread is parked by the OS instead of spinning.
+		MACH_ALWAYS_INLINE void wait(T old, Order order = Order::SeqCst) const noexcept {
+			m_atomic.wait(old, to_std(order));
+		}
+		MACH_ALWAYS_INLINE void notify_one() const noexcept { m_atomic.notify_one(); }
+		MACH_ALWAYS_INLINE void notify_all() const noexcept { m_atomic.notify_all(); }
+
 	private:
 		MACH_ALWAYS_INLINE std::memory_order to_std(Order order) const {
 			static const std::memory_order convert[] = { std::memory_order_relaxed,
@@ -89,4 +103,24 @@ namespace Mach::Core {
 		mutable std::atomic<T> m_atomic;
 	};
 
+	MACH_ALWAYS_INLINE inline void atomic_fence(Order order) {
+		static const std::memory_order convert[] = { std::memory_order_relaxed,
+													 std::memory_order_release,
+													 std::memory_order_acquire,
+													 std::memory_order_acq_rel,
+													 std::memory_order_seq_cst };
+		std::atomic_thread_fence(convert[(u8)order]);
+	}
+
+	// Tells the CPU the caller is busy waiting. This saves power and hands execution resources to the other hardware
+	// thread on the same core, which is often the one holding what we are waiting for.
+	MACH_ALWAYS_INLINE inline void spin_loop_hint() {
+#if MACH_CPU == MACH_CPU_X86
+		_mm_pause();
+#elif MACH_COMPILER == MACH_COMPILER_MSVC
+		__yield();
+#else
+		__asm__ __volatile__("yield");
+#endif
+	}
 } // namespace Mach::Core
@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Compression/LZ4.hpp>
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Debug/Test.hpp>
+#include <Core/Memory.hpp>
+
+namespace Mach::Core::LZ4 {
+	static constexpr usize min_match = 4;
+	// The last match must start at least 12 bytes before the end and the last 5 bytes are always literals
+	static constexpr usize match_safe_distance = 12;
+	static constexpr usize last_literals = 5;
+	static constexpr usize max_offset = 65535;
+	static constexpr u32 hash_log = 12;
+
+	MACH_ALWAYS_INLINE static u32 read_u32(const u8* ptr) {
+		u32 result;
+		Memory::copy(&result, ptr, sizeof(result));
+		return result;
+	}
+
+	MACH_ALWAYS_INLINE static u32 hash(u32 sequence) { return (sequence * 2654435761U) >> (32 - hash_log); }
+
+	MACH_ALWAYS_INLINE static u8* write_length(u8* op, usize len) {
+		while (len >= 255) {
+			*op++ = 255;
+			len -= 255;
+		}
+		*op++ = static_cast<u8>(len);
+		return op;
+	}
+
+	static u8* write_sequence(u8* op, const u8* literals, usize literal_len, usize offset, usize match_len) {
+		u8* const token = op++;
+		const usize match_code = match_len - min_match;
+
+		*token = static_cast<u8>((literal_len >= 15 ? 15 : literal_len) << 4);
+		if (literal_len >= 15) {
+			op = write_length(op, literal_len - 15);
+		}
+		if (literal_len > 0) {
+			Memory::copy(op, literals, literal_len);
+			op += literal_len;
+		}
+
+		// The final sequence is literals only
+		if (match_len == 0) {
+			return op;
+		}
+
+		*op++ = static_cast<u8>(offset);
+		*op++ = static_cast<u8>(offset >> 8);
+
+		*token |= static_cast<u8>(match_code >= 15 ? 15 : match_code);
+		if (match_code >= 15) {
+			op = write_length(op, match_code - 15);
+		}
+		return op;
+	}
+
+	usize compress(Slice<u8 const> src, Slice<u8> dst) {
+		MACH_ASSERT(dst.len() >= compress_bound(src.len()), "LZ4 destination is smaller than compress_bound");
+
+		const u8* const base = src.begin();
+		const u8* const end = src.end();
+		u8* op = dst.begin();
+
+		const u8* anchor = base;
+		if (src.len() > match_safe_distance) {
+			// Positions relative to base. Zero doubles as the empty slot since a match is always verified.
+			u32 table[1 << hash_log] = {};
+
+			const u8* const match_limit = end - match_safe_distance;
+			const u8* const extend_limit = end - last_literals;
+
+			const u8* ip = base + 1;
+			while (ip <= match_limit) {
+				const u32 sequence = read_u32(ip);
+				const u32 h = hash(sequence);
+				const u8* match = base + table[h];
+				table[h] = static_cast<u32>(ip - base);
+
+				if (match >= ip || static_cast<usize>(ip - match) > max_offset || read_u32(match) != sequence) {
+					ip += 1;
+					continue;
+				}
+
+				// Grow the match backwards into pending literals
+				while (ip > anchor && match > base && ip[-1] == match[-1]) {
+					ip -= 1;
+					match -= 1;
+				}
+
+				usize match_len = min_match;
+				while (ip + match_len < extend_limit && ip[match_len] == match[match_len]) {
+					match_len += 1;
+				}
+
+				op = write_sequence(
+					op,
+					anchor,
+					static_cast<usize>(ip - anchor),
+					static_cast<usize>(ip - match),
+					match_len);
+
+				ip += match_len;
+				anchor = ip;
+
+				// Seed the table with the tail of the match to catch back to back repeats
+				if (ip <= match_limit) {
+					table[hash(read_u32(ip - 2))] = static_cast<u32>(ip - 2 - base);
+				}
+			}
+		}
+
+		op = write_sequence(op, anchor, static_cast<usize>(end - anchor), 0, 0);
+		return static_cast<usize>(op - dst.begin());
+	}
+
+	Option<usize> decompress(Slice<u8 const> src, Slice<u8> dst) {
+		const u8* ip = src.begin();
+		const u8* const ip_end = src.end();
+		u8* op = dst.begin();
+		u8* const op_end = dst.end();
+
+		while (ip < ip_end) {
+			const u8 token = *ip++;
+
+			usize literal_len = token >> 4;
+			if (literal_len == 15) {
+				u8 extra = 255;
+				while (extra == 255) {
+					if (ip >= ip_end) return nullopt;
+					extra = *ip++;
+					literal_len += extra;
+				}
+			}
+
+			if (literal_len > static_cast<usize>(ip_end - ip) || literal_len > static_cast<usize>(op_end - op)) {
+				return nullopt;
+			}
+			if (literal_len > 0) {
+				Memory::copy(op, ip, literal_len);
+				ip += literal_len;
+				op += literal_len;
+			}
+
+			// The block ends right after the last literals
+			if (ip == ip_end) {
+				break;
+			}
+
+			if (ip_end - ip < 2) return nullopt;
+			const usize offset = static_cast<usize>(ip[0]) | (static_cast<usize>(ip[1]) << 8);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<usize>(op - dst.begin())) {
+				return nullopt;
+			}
+
+			usize match_len = token & 15;
+			if (match_len == 15) {
+				u8 extra = 255;
+				while (extra == 255) {
+					if (ip >= ip_end) return nullopt;
+					extra = *ip++;
+					match_len += extra;
+				}
+			}
+			match_len += min_match;
+
+			if (match_len > static_cast<usize>(op_end - op)) {
+				return nullopt;
+			}
+
+			// Matches may overlap the bytes they produce so copy forwards one at a time when they are close
+			const u8* match = op - offset;
+			if (offset >= match_len) {
+				Memory::copy(op, match, match_len);
+				op += match_len;
+			} else {
+				for (usize index = 0; index < match_len; index += 1) {
+					*op++ = *match++;
+				}
+			}
+		}
+
+		return static_cast<usize>(op - dst.begin());
+	}
+} // namespace Mach::Core::LZ4
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	static bool round_trip(Slice<u8 const> src) {
+		Array<u8> compressed;
+		compressed.set_len(LZ4::compress_bound(src.len()));
+		const usize compressed_len = LZ4::compress(src, compressed.as_slice());
+
+		Array<u8> decompressed;
+		decompressed.set_len(src.len() + 1);
+		const auto result = LZ4::decompress(Slice<u8 const>{ compressed.begin(), compressed_len }, decompressed.as_slice());
+		if (!result.is_set() || result.unwrap() != src.len()) {
+			return false;
+		}
+		for (usize index = 0; index < src.len(); index += 1) {
+			if (decompressed[index] != src[index]) return false;
+		}
+		return true;
+	}
+
+	MACH_TEST_CASE("LZ4") {
+		MACH_SUBCASE("empty and tiny inputs") {
+			MACH_CHECK(round_trip(Slice<u8 const>{}));
+			const u8 tiny[] = { 1, 2, 3 };
+			MACH_CHECK(round_trip(Slice<u8 const>{ tiny, 3 }));
+		}
+
+		MACH_SUBCASE("repetitive input compresses") {
+			Array<u8> src;
+			for (usize index = 0; index < 100000; index += 1) {
+				src.push(static_cast<u8>("machina "[index % 8]));
+			}
+
+			Array<u8> compressed;
+			compressed.set_len(LZ4::compress_bound(src.len()));
+			const usize compressed_len = LZ4::compress(src.as_const_slice(), compressed.as_slice());
+			MACH_CHECK(compressed_len < src.len() / 50);
+			MACH_CHECK(round_trip(src.as_const_slice()));
+		}
+
+		MACH_SUBCASE("incompressible input") {
+			Array<u8> src;
+			u32 state = 0x12345678;
+			for (usize index = 0; index < 70000; index += 1) {
+				state = state * 1664525 + 1013904223;
+				src.push(static_cast<u8>(state >> 24));
+			}
+			MACH_CHECK(round_trip(src.as_const_slice()));
+		}
+
+		MACH_SUBCASE("mixed input") {
+			Array<u8> src;
+			u32 state = 7;
+			for (usize index = 0; index < 200000; index += 1) {
+				state = state * 1664525 + 1013904223;
+				src.push((state >> 28) < 4 ? static_cast<u8>(state >> 16) : static_cast<u8>(index / 64));
+			}
+			MACH_CHECK(round_trip(src.as_const_slice()));
+		}
+
+		MACH_SUBCASE("known block") {
+			// 32 times 'a' as produced by the reference compressor
+			const u8 block[] = { 0x1F, 'a', 0x01, 0x00, 0x07, 0x50, 'a', 'a', 'a', 'a', 'a' };
+			u8 out[32];
+			const auto result = LZ4::decompress(Slice<u8 const>{ block, sizeof(block) }, Slice<u8>{ out, sizeof(out) });
+			MACH_CHECK(result.is_set());
+			MACH_CHECK(result.unwrap() == 32);
+			bool all_a = true;
+			for (u8 c : out) {
+				all_a &= c == 'a';
+			}
+			MACH_CHECK(all_a);
+		}
+
+		MACH_SUBCASE("malformed input is rejected") {
+			const u8 bad_offset[] = { 0x10, 'a', 0x05, 0x00 };
+			u8 out[64];
+			MACH_CHECK(!LZ4::decompress(Slice<u8 const>{ bad_offset, sizeof(bad_offset) }, Slice<u8>{ out, sizeof(out) })
+							.is_set());
+
+			const u8 truncated[] = { 0xF0, 0xFF };
+			MACH_CHECK(!LZ4::decompress(Slice<u8 const>{ truncated, sizeof(truncated) }, Slice<u8>{ out, sizeof(out) })
+							.is_set());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,29 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Option.hpp>
+#include <Core/Containers/Slice.hpp>
+
+/**
+ * LZ4 block format codec.
+ *
+ * Output is compatible with the reference implementation so data can be produced or inspected with the stock lz4
+ * tools. The compressor is the single pass greedy variant, which is the one worth having at load time.
+ * https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ */
+namespace Mach::Core::LZ4 {
+	// Worst case size of compressing len bytes
+	MACH_NO_DISCARD constexpr usize compress_bound(usize len) { return len + len / 255 + 16; }
+
+	// Compresses src into dst and returns the amount of bytes written. dst must hold at least compress_bound bytes.
+	usize compress(Slice<u8 const> src, Slice<u8> dst);
+
+	// Decompresses src into dst and returns the amount of bytes written. Returns nullopt if src is malformed or would
+	// not fit into dst. Never reads or writes out of bounds.
+	MACH_NO_DISCARD Option<usize> decompress(Slice<u8 const> src, Slice<u8> dst);
+} // namespace Mach::Core::LZ4
@@ -0,0 +1,596 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Compression/LZ4.hpp>
+#include <Core/Compression/Stream.hpp>
+#include <Core/Debug/Test.hpp>
+
+namespace Mach::Core {
+	static constexpr u32 frame_magic = 0x184D2204;
+	static constexpr u32 skippable_magic = 0x184D2A50;
+	static constexpr u32 skippable_mask = 0xFFFFFFF0;
+	// High bit of a block header marks a block that is stored uncompressed
+	static constexpr u32 block_stored_flag = 0x80000000;
+
+	static constexpr u8 flag_version = 0x40;
+	static constexpr u8 flag_version_mask = 0xC0;
+	static constexpr u8 flag_block_independence = 0x20;
+	static constexpr u8 flag_block_checksum = 0x10;
+	static constexpr u8 flag_content_size = 0x08;
+	static constexpr u8 flag_content_checksum = 0x04;
+	static constexpr u8 flag_reserved = 0x02;
+	static constexpr u8 flag_dictionary = 0x01;
+
+	static constexpr usize block_max_of(LZ4BlockSize size) {
+		return static_cast<usize>(1) << (8 + 2 * static_cast<u8>(size));
+	}
+
+	static u32 read_u32_le(const u8* ptr) {
+		return static_cast<u32>(ptr[0]) | (static_cast<u32>(ptr[1]) << 8) | (static_cast<u32>(ptr[2]) << 16) |
+			   (static_cast<u32>(ptr[3]) << 24);
+	}
+
+	static void write_u32_le(u8* ptr, u32 value) {
+		ptr[0] = static_cast<u8>(value);
+		ptr[1] = static_cast<u8>(value >> 8);
+		ptr[2] = static_cast<u8>(value >> 16);
+		ptr[3] = static_cast<u8>(value >> 24);
+	}
+
+	// Readers may return short counts before the end so keep going until full or nothing is left
+	static bool read_exact(Reader& reader, Slice<u8> bytes) {
+		usize total = 0;
+		while (total < bytes.len()) {
+			const usize amount = reader.read(Slice<u8>{ bytes.begin() + total, bytes.len() - total });
+			if (amount == 0) {
+				return false;
+			}
+			total += amount;
+		}
+		return true;
+	}
+
+	static u32 xxh32(Slice<u8 const> bytes) {
+		XXH32Hasher hasher;
+		hasher.write(bytes);
+		return static_cast<u32>(hasher.finish());
+	}
+
+	struct DecompressReader::State {
+		enum class Prefetch : u8 { Idle, Queued, Running, Done };
+		enum class Result : u8 { Data, End, Failed };
+
+		struct Block {
+			Array<u8> compressed;
+			Array<u8> decompressed;
+			// Points into either buffer depending on whether the block was stored
+			Slice<u8 const> bytes;
+			usize cursor = 0;
+			Result result = Result::Data;
+		};
+
+		Reader* source;
+
+		bool header_read = false;
+		bool finished = false;
+		bool failed = false;
+
+		usize block_max = 0;
+		bool block_checksum = false;
+		bool content_checksum = false;
+		Option<u64> content_size = nullopt;
+
+		// Only touched while loading a block, which never happens on two threads at once
+		XXH32Hasher content;
+		u64 produced = 0;
+
+		Block blocks[2];
+		usize current = 0;
+
+		Atomic<Prefetch> prefetch{ Prefetch::Idle };
+		usize prefetch_index = 0;
+
+		bool read_header() {
+			u8 magic_bytes[4];
+			while (true) {
+				if (!read_exact(*source, Slice<u8>{ magic_bytes, sizeof(magic_bytes) })) {
+					return false;
+				}
+				const u32 magic = read_u32_le(magic_bytes);
+				if (magic == frame_magic) {
+					break;
+				}
+				if ((magic & skippable_mask) != skippable_magic) {
+					return false;
+				}
+
+				// Skippable frames carry user data we have no use for
+				u8 size_bytes[4];
+				if (!read_exact(*source, Slice<u8>{ size_bytes, sizeof(size_bytes) })) {
+					return false;
+				}
+				u8 scratch[256];
+				usize remaining = read_u32_le(size_bytes);
+				while (remaining > 0) {
+					const usize amount = remaining < sizeof(scratch) ? remaining : sizeof(scratch);
+					if (!read_exact(*source, Slice<u8>{ scratch, amount })) {
+						return false;
+					}
+					remaining -= amount;
+				}
+			}
+
+			// FLG, BD, an optional content size and the header checksum
+			u8 descriptor[2 + 8 + 1];
+			if (!read_exact(*source, Slice<u8>{ descriptor, 2 })) {
+				return false;
+			}
+			const u8 flags = descriptor[0];
+			const u8 block_descriptor = descriptor[1];
+			if ((flags & flag_version_mask) != flag_version || (flags & flag_reserved) != 0) {
+				return false;
+			}
+			if ((flags & flag_block_independence) == 0 || (flags & flag_dictionary) != 0) {
+				return false;
+			}
+
+			const u8 block_size = (block_descriptor >> 4) & 0x7;
+			if ((block_descriptor & 0x8F) != 0 || block_size < static_cast<u8>(LZ4BlockSize::KiB64)) {
+				return false;
+			}
+
+			usize descriptor_len = 2;
+			if ((flags & flag_content_size) != 0) {
+				if (!read_exact(*source, Slice<u8>{ descriptor + descriptor_len, 8 })) {
+					return false;
+				}
+				const u64 low = read_u32_le(descriptor + descriptor_len);
+				const u64 high = read_u32_le(descriptor + descriptor_len + 4);
+				content_size = low | (high << 32);
+				descriptor_len += 8;
+			}
+
+			u8 header_checksum;
+			if (!read_exact(*source, Slice<u8>{ &header_checksum, 1 })) {
+				return false;
+			}
+			const u32 expected = (xxh32(Slice<u8 const>{ descriptor, descriptor_len }) >> 8) & 0xFF;
+			if (header_checksum != expected) {
+				return false;
+			}
+
+			block_max = block_max_of(static_cast<LZ4BlockSize>(block_size));
+			block_checksum = (flags & flag_block_checksum) != 0;
+			content_checksum = (flags & flag_content_checksum) != 0;
+			for (Block& block : blocks) {
+				block.compressed.set_len_uninitialized(block_max);
+				block.decompressed.set_len_uninitialized(block_max);
+			}
+
+			header_read = true;
+			return true;
+		}
+
+		Result load(Block& block) {
+			block.bytes = Slice<u8 const>{};
+			block.cursor = 0;
+
+			u8 header_bytes[4];
+			if (!read_exact(*source, Slice<u8>{ header_bytes, sizeof(header_bytes) })) {
+				return Result::Failed;
+			}
+			const u32 header = read_u32_le(header_bytes);
+
+			// End mark
+			if (header == 0) {
+				if (content_checksum) {
+					u8 checksum[4];
+					if (!read_exact(*source, Slice<u8>{ checksum, sizeof(checksum) })) {
+						return Result::Failed;
+					}
+					if (read_u32_le(checksum) != static_cast<u32>(content.finish())) {
+						return Result::Failed;
+					}
+				}
+				if (content_size.is_set() && content_size.as_const_ref().unwrap() != produced) {
+					return Result::Failed;
+				}
+				return Result::End;
+			}
+
+			const usize len = header & ~block_stored_flag;
+			if (len > block_max) {
+				return Result::Failed;
+			}
+			const Slice<u8> compressed{ block.compressed.begin(), len };
+			if (!read_exact(*source, compressed)) {
+				return Result::Failed;
+			}
+
+			if (block_checksum) {
+				u8 checksum[4];
+				if (!read_exact(*source, Slice<u8>{ checksum, sizeof(checksum) })) {
+					return Result::Failed;
+				}
+				if (read_u32_le(checksum) != xxh32(static_cast<Slice<u8 const>>(compressed))) {
+					return Result::Failed;
+				}
+			}
+
+			if ((header & block_stored_flag) != 0) {
+				block.bytes = static_cast<Slice<u8 const>>(compressed);
+			} else {
+				const auto src = static_cast<Slice<u8 const>>(compressed);
+				auto decompressed = LZ4::decompress(src, block.decompressed.as_slice());
+				if (!decompressed.is_set()) {
+					return Result::Failed;
+				}
+				block.bytes = Slice<u8 const>{ block.decompressed.begin(), decompressed.unwrap() };
+			}
+
+			if (content_checksum) {
+				content.write(block.bytes);
+			}
+			produced += block.bytes.len();
+			return Result::Data;
+		}
+
+		void run_prefetch() {
+			if (!prefetch.compare_exchange_strong(Prefetch::Queued, Prefetch::Running, Order::AcqRel).is_set()) {
+				// The reader took the work over or was destroyed before we got here
+				return;
+			}
+			Block& block = blocks[prefetch_index];
+			block.result = load(block);
+			prefetch.store(Prefetch::Done, Order::Release);
+			prefetch.notify_all();
+		}
+
+		void finish_prefetch() {
+			// Never block on a job that has not started. It may be queued behind the caller on the same thread.
+			if (prefetch.compare_exchange_strong(Prefetch::Queued, Prefetch::Running, Order::AcqRel).is_set()) {
+				Block& block = blocks[prefetch_index];
+				block.result = load(block);
+				prefetch.store(Prefetch::Idle, Order::Relaxed);
+				return;
+			}
+
+			while (true) {
+				const Prefetch state = prefetch.load(Order::Acquire);
+				if (state == Prefetch::Done) {
+					break;
+				}
+				prefetch.wait(state, Order::Acquire);
+			}
+			prefetch.store(Prefetch::Idle, Order::Relaxed);
+		}
+	};
+
+	DecompressReader::DecompressReader(Reader& source, Scheduler const* scheduler)
+		: m_state(Mach::SharedPtr<State>::create(State{ .source = &source }))
+		, m_scheduler(scheduler) {}
+
+	DecompressReader::~DecompressReader() {
+		State& state = m_state.unsafe_get_mut();
+		if (state.prefetch.load(Order::Acquire) != State::Prefetch::Idle) {
+			// Either cancels a queued job or waits for a running one so the source is no longer in use
+			state.finish_prefetch();
+		}
+	}
+
+	usize DecompressReader::read(Slice<u8> bytes) {
+		State& state = m_state.unsafe_get_mut();
+		if (!state.header_read && !state.failed) {
+			if (!state.read_header()) {
+				state.failed = true;
+			}
+		}
+
+		usize written = 0;
+		while (written < bytes.len() && !state.failed) {
+			State::Block& block = state.blocks[state.current];
+			const usize remaining = block.bytes.len() - block.cursor;
+			if (remaining > 0) {
+				const usize wanted = bytes.len() - written;
+				const usize amount = wanted < remaining ? wanted : remaining;
+				Memory::copy(bytes.begin() + written, block.bytes.begin() + block.cursor, amount);
+				block.cursor += amount;
+				written += amount;
+				continue;
+			}
+
+			if (state.finished) {
+				break;
+			}
+			advance(state);
+		}
+		return written;
+	}
+
+	bool DecompressReader::has_failed() const { return m_state->failed; }
+
+	void DecompressReader::advance(State& state) {
+		const usize next = state.current ^ 1;
+		State::Block& block = state.blocks[next];
+		if (state.prefetch.load(Order::Acquire) != State::Prefetch::Idle) {
+			state.finish_prefetch();
+		} else {
+			block.result = state.load(block);
+		}
+		state.current = next;
+
+		switch (block.result) {
+		case State::Result::Data:
+			break;
+		case State::Result::End:
+			state.finished = true;
+			return;
+		case State::Result::Failed:
+			state.failed = true;
+			return;
+		}
+
+		// The other block was fully consumed so it is free to load into while the caller works on this one
+		if (m_scheduler != nullptr) {
+			state.prefetch_index = next ^ 1;
+			state.prefetch.store(State::Prefetch::Queued, Order::Release);
+			m_scheduler->enqueue([shared = m_state]() { shared.unsafe_get_mut().run_prefetch(); });
+		}
+	}
+
+	CompressWriter::CompressWriter(Writer& dest, Options const& options)
+		: m_dest(dest)
+		, m_options(options)
+		, m_block_max(block_max_of(options.block_size)) {
+		m_block.reserve(m_block_max);
+		m_compressed.set_len_uninitialized(LZ4::compress_bound(m_block_max));
+	}
+
+	CompressWriter::~CompressWriter() { finish(); }
+
+	usize CompressWriter::write(Slice<u8 const> bytes) {
+		MACH_ASSERT(!m_finished, "Can not write to a finished CompressWriter");
+		if (!m_started) {
+			write_header();
+		}
+
+		usize consumed = 0;
+		while (consumed < bytes.len()) {
+			const usize start = m_block.len();
+			const usize space = m_block_max - start;
+			const usize wanted = bytes.len() - consumed;
+			const usize amount = wanted < space ? wanted : space;
+
+			m_block.set_len_uninitialized(start + amount);
+			Memory::copy(m_block.begin() + start, bytes.begin() + consumed, amount);
+			consumed += amount;
+
+			if (m_block.len() == m_block_max) {
+				flush_block();
+			}
+		}
+		return consumed;
+	}
+
+	void CompressWriter::finish() {
+		if (m_finished) {
+			return;
+		}
+		if (!m_started) {
+			write_header();
+		}
+		flush_block();
+
+		u8 end[8];
+		write_u32_le(end, 0);
+		usize end_len = 4;
+		if (m_options.content_checksum) {
+			write_u32_le(end + 4, static_cast<u32>(m_content.finish()));
+			end_len += 4;
+		}
+		m_dest.write(Slice<u8 const>{ end, end_len });
+
+		m_finished = true;
+	}
+
+	void CompressWriter::write_header() {
+		u8 flags = flag_version | flag_block_independence;
+		if (m_options.block_checksum) flags |= flag_block_checksum;
+		if (m_options.content_checksum) flags |= flag_content_checksum;
+		const u8 block_descriptor = static_cast<u8>(static_cast<u8>(m_options.block_size) << 4);
+
+		u8 header[7];
+		write_u32_le(header, frame_magic);
+		header[4] = flags;
+		header[5] = block_descriptor;
+		header[6] = static_cast<u8>((xxh32(Slice<u8 const>{ header + 4, 2 }) >> 8) & 0xFF);
+		m_dest.write(Slice<u8 const>{ header, sizeof(header) });
+
+		m_started = true;
+	}
+
+	void CompressWriter::flush_block() {
+		if (m_block.len() == 0) {
+			return;
+		}
+
+		const Slice<u8 const> block = m_block.as_const_slice();
+		if (m_options.content_checksum) {
+			m_content.write(block);
+		}
+
+		const usize compressed_len = LZ4::compress(block, m_compressed.as_slice());
+		const bool store = compressed_len >= block.len();
+		const Slice<u8 const> payload = store ? block : Slice<u8 const>{ m_compressed.begin(), compressed_len };
+
+		u8 header[4];
+		write_u32_le(header, static_cast<u32>(payload.len()) | (store ? block_stored_flag : 0));
+		m_dest.write(Slice<u8 const>{ header, sizeof(header) });
+		m_dest.write(payload);
+
+		if (m_options.block_checksum) {
+			u8 checksum[4];
+			write_u32_le(checksum, xxh32(payload));
+			m_dest.write(Slice<u8 const>{ checksum, sizeof(checksum) });
+		}
+
+		m_block.reset();
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("LZ4 frame") {
+		// Runs every job queued so far on a single worker Scheduler by waiting for one queued behind them
+		auto run_queued = [](Scheduler const& scheduler) {
+			class FlushTask final : public Task {
+			public:
+				MACH_NO_DISCARD Status status() const final {
+					return done.load(Order::Acquire) ? Status::Complete : Status::InProgress;
+				}
+				Atomic<bool> done{ false };
+			};
+			const FlushTask task;
+			scheduler.enqueue([&task] { task.done.store(true, Order::Release); });
+			scheduler.wait_for(task);
+		};
+		// With run_jobs every prefetch job finishes before its block is needed, otherwise the reader takes them over
+		auto decompress_all = [&run_queued](
+								  Slice<u8 const> frame,
+								  Array<u8>& out,
+								  Scheduler const* scheduler = nullptr,
+								  bool run_jobs = false) {
+			SliceReader source{ frame };
+			DecompressReader reader{ source, scheduler };
+			u8 chunk[777];
+			while (true) {
+				const usize amount = reader.read(Slice<u8>{ chunk, sizeof(chunk) });
+				if (amount == 0) break;
+				ArrayWriter{ out }.write(Slice<u8 const>{ chunk, amount });
+				if (run_jobs) run_queued(*scheduler);
+			}
+			return !reader.has_failed();
+		};
+		auto equal = [](Slice<u8 const> a, const void* b) {
+			for (usize index = 0; index < a.len(); index += 1) {
+				if (a[index] != static_cast<const u8*>(b)[index]) return false;
+			}
+			return true;
+		};
+
+		MACH_SUBCASE("reference frame") {
+			// printf "hello hello hello hello hello!" | lz4 -c
+			const u8 frame[] = {
+				0x04, 0x22, 0x4d, 0x18, 0x64, 0x40, 0xa7, 0x10, 0x00, 0x00, 0x00, 0x6f, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x20,
+				0x06, 0x00, 0x00, 0x50, 0x65, 0x6c, 0x6c, 0x6f, 0x21, 0x00, 0x00, 0x00, 0x00, 0x6d, 0x22, 0x3a, 0x74,
+			};
+			const char expected[] = "hello hello hello hello hello!";
+
+			Array<u8> out;
+			MACH_CHECK(decompress_all(Slice<u8 const>{ frame, sizeof(frame) }, out));
+			MACH_REQUIRE(out.len() == sizeof(expected) - 1);
+			MACH_CHECK(equal(out.as_const_slice(), expected));
+		}
+
+		auto make_input = [] {
+			Array<u8> input;
+			u32 state = 7;
+			for (usize index = 0; index < 300000; index += 1) {
+				state = state * 1664525 + 1013904223;
+				// Mostly text with runs of noise so both stored and compressed blocks show up
+				const bool noisy = (index / 70000) % 2 == 1;
+				input.push(noisy ? static_cast<u8>(state >> 24) : static_cast<u8>("abcdefgh"[(state >> 28) & 0x7]));
+			}
+			return input;
+		};
+
+		MACH_SUBCASE("round trip") {
+			const Array<u8> input = make_input();
+
+			for (const bool block_checksum : { false, true }) {
+				Array<u8> frame;
+				ArrayWriter frame_writer{ frame };
+				{
+					CompressWriter writer{ frame_writer, CompressWriter::Options{ .block_checksum = block_checksum } };
+					writer.write(Slice<u8 const>{ input.begin(), 1000 });
+					writer.write(Slice<u8 const>{ input.begin() + 1000, input.len() - 1000 });
+				}
+				MACH_CHECK(frame.len() < input.len());
+
+				Array<u8> out;
+				MACH_CHECK(decompress_all(frame.as_const_slice(), out));
+				MACH_REQUIRE(out.len() == input.len());
+				MACH_CHECK(equal(out.as_const_slice(), input.begin()));
+			}
+		}
+
+		MACH_SUBCASE("prefetch on a scheduler") {
+			// A single worker keeps the Scheduler from leaving threads behind. Jobs only run while this thread waits.
+			Scheduler scheduler;
+			scheduler.init({
+				.thread_count = 1,
+				.fiber_count = 4,
+				.waiting_count = 4,
+			});
+
+			const Array<u8> input = make_input();
+			Array<u8> frame;
+			ArrayWriter frame_writer{ frame };
+			CompressWriter{ frame_writer }.write(input.as_const_slice());
+
+			for (const bool run_jobs : { false, true }) {
+				Array<u8> out;
+				MACH_CHECK(decompress_all(frame.as_const_slice(), out, &scheduler, run_jobs));
+				MACH_REQUIRE(out.len() == input.len());
+				MACH_CHECK(equal(out.as_const_slice(), input.begin()));
+			}
+
+			// Dropping the reader with a job queued takes the job over, which then finds nothing left to do
+			{
+				SliceReader source{ frame.as_const_slice() };
+				DecompressReader reader{ source, &scheduler };
+				u8 chunk[64];
+				MACH_CHECK(reader.read(Slice<u8>{ chunk, sizeof(chunk) }) == sizeof(chunk));
+				MACH_CHECK(equal(Slice<u8 const>{ chunk, sizeof(chunk) }, input.begin()));
+			}
+			run_queued(scheduler);
+		}
+
+		MACH_SUBCASE("empty") {
+			Array<u8> frame;
+			ArrayWriter frame_writer{ frame };
+			CompressWriter{ frame_writer }.finish();
+
+			Array<u8> out;
+			MACH_CHECK(decompress_all(frame.as_const_slice(), out));
+			MACH_CHECK(out.len() == 0);
+		}
+
+		MACH_SUBCASE("corruption") {
+			const u8 input[] = { 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8 };
+			Array<u8> frame;
+			ArrayWriter frame_writer{ frame };
+			CompressWriter{ frame_writer }.write(Slice<u8 const>{ input, sizeof(input) });
+
+			Array<u8> out;
+			Array<u8> bad_checksum = frame;
+			bad_checksum[bad_checksum.len() - 1] ^= 0xFF;
+			MACH_CHECK(!decompress_all(bad_checksum.as_const_slice(), out));
+
+			Array<u8> bad_magic = frame;
+			bad_magic[0] = 0;
+			MACH_CHECK(!decompress_all(bad_magic.as_const_slice(), out));
+
+			Array<u8> truncated = frame;
+			truncated.set_len(truncated.len() - 6);
+			MACH_CHECK(!decompress_all(truncated.as_const_slice(), out));
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Scheduler.hpp>
+#include <Core/Hash.hpp>
+#include <Core/IO/Reader.hpp>
+#include <Core/IO/Writer.hpp>
+
+/**
+ * Streaming compression using the LZ4 frame format, so streams can be produced and inspected with the stock lz4 tools.
+ * https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md
+ */
+namespace Mach::Core {
+	// Maximum amount of uncompressed bytes in a single frame block
+	enum class LZ4BlockSize : u8 { KiB64 = 4, KiB256 = 5, MiB1 = 6, MiB4 = 7 };
+
+	/**
+	 * Decompresses an LZ4 frame read from another Reader.
+	 *
+	 * Blocks are decompressed one at a time into reusable buffers. When given a Scheduler the next block is read and
+	 * decompressed on a job while the caller consumes the current one, and taken over by the caller if the job has not
+	 * started by the time it is needed. Frames using linked blocks or a dictionary are not supported and fail.
+	 */
+	class DecompressReader final : public Reader {
+	public:
+		// The source must outlive the reader. The scheduler is optional and only used for prefetching.
+		explicit DecompressReader(Reader& source, Scheduler const* scheduler = nullptr);
+
+		MACH_NO_COPY(DecompressReader);
+		MACH_NO_MOVE(DecompressReader);
+		~DecompressReader() final;
+
+		usize read(Slice<u8> bytes) final;
+
+		// True once malformed data, a checksum mismatch or an unsupported frame was hit. Reads return 0 from then on.
+		MACH_NO_DISCARD bool has_failed() const;
+
+	private:
+		struct State;
+
+		void advance(State& state);
+
+		// Shared with prefetch jobs so a job that is still queued when the reader goes away stays valid
+		Mach::SharedPtr<State> m_state;
+		Scheduler const* m_scheduler;
+	};
+
+	// Compresses everything written into an LZ4 frame. The frame is finished on destruction if finish was not called.
+	class CompressWriter final : public Writer {
+	public:
+		struct Options {
+			LZ4BlockSize block_size = LZ4BlockSize::KiB64;
+			bool block_checksum = false;
+			bool content_checksum = true;
+		};
+
+		explicit CompressWriter(Writer& dest, Options const& options);
+		explicit CompressWriter(Writer& dest) : CompressWriter(dest, Options{}) {}
+
+		MACH_NO_COPY(CompressWriter);
+		MACH_NO_MOVE(CompressWriter);
+		~CompressWriter() final;
+
+		usize write(Slice<u8 const> bytes) final;
+
+		// Compresses any buffered bytes and writes the end of the frame. Writing after finishing is not allowed.
+		void finish();
+
+	private:
+		void write_header();
+		void flush_block();
+
+		Writer& m_dest;
+		Options m_options;
+		usize m_block_max;
+		Array<u8> m_block;
+		Array<u8> m_compressed;
+		XXH32Hasher m_content;
+		bool m_started = false;
+		bool m_finished = false;
+	};
+} // namespace Mach::Core
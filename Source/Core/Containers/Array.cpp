@@ -5,6 +5,7 @@
  */
 
 #include <Core/Containers/Array.hpp>
+#include <Core/Debug/Benchmark.hpp>
 #include <Core/Debug/Test.hpp>
 
 #if MACH_ENABLE_TEST
@@ -136,6 +137,12 @@ MACH_TEST_SUITE("Containers") {
 			Array<int> arr;
 			arr.reserve(10);
 			MACH_CHECK(arr.cap() >= 10);
+
+			// Room is made on top of len, not on top of cap
+			const usize cap = arr.cap();
+			arr.push(1);
+			arr.reserve(cap - 1);
+			MACH_CHECK(arr.cap() == cap);
 		}
 
 		MACH_SUBCASE("move insert") {
@@ -399,5 +406,137 @@ MACH_TEST_SUITE("Containers") {
 			MACH_CHECK(arr.len() == 10);
 		}
 	}
+
+	MACH_TEST_CASE("Array<SmallAllocator>") {
+		MACH_SUBCASE("stays inline up to capacity") {
+			SmallArray<int, 4> arr;
+			MACH_CHECK(arr.cap() == 4);
+			const auto* inline_begin = arr.begin();
+			for (int i = 0; i < 4; i += 1) {
+				arr.push(i);
+			}
+			arr.reserve(0);
+			MACH_CHECK(arr.cap() == 4);
+			MACH_CHECK(arr.begin() == inline_begin);
+		}
+
+		MACH_SUBCASE("spills to the heap") {
+			SmallArray<int, 4> arr = { 1, 2, 3 };
+			const auto* inline_begin = arr.begin();
+			for (int i = 4; i <= 100; i += 1) {
+				arr.push(i);
+			}
+			MACH_CHECK(arr.len() == 100);
+			MACH_CHECK(arr.cap() >= 100);
+			MACH_CHECK(arr.begin() != inline_begin);
+			for (usize i = 0; i < arr.len(); i += 1) {
+				MACH_CHECK(arr[i] == static_cast<int>(i) + 1);
+			}
+		}
+
+		MACH_SUBCASE("copy") {
+			SmallArray<int, 4> small = { 1, 2 };
+			SmallArray<int, 4> large = { 1, 2, 3, 4, 5, 6 };
+
+			SmallArray<int, 4> small_copy{ small };
+			MACH_CHECK(small_copy.len() == 2);
+			MACH_CHECK(small_copy.cap() == 4);
+			MACH_CHECK(small_copy[1] == 2);
+
+			SmallArray<int, 4> large_copy;
+			large_copy = large;
+			MACH_CHECK(large_copy.len() == 6);
+			MACH_CHECK(large_copy[5] == 6);
+			MACH_CHECK(large_copy.begin() != large.begin());
+		}
+
+		MACH_SUBCASE("move") {
+			SmallArray<int, 4> small = { 1, 2 };
+			SmallArray<int, 4> small_moved{ Mach::move(small) };
+			MACH_CHECK(small.is_empty());
+			MACH_REQUIRE(small_moved.len() == 2);
+			MACH_CHECK(small_moved[1] == 2);
+
+			// A spilled array hands its heap allocation over and goes back to being inline
+			SmallArray<int, 4> large = { 1, 2, 3, 4, 5, 6 };
+			const auto* heap = large.begin();
+			SmallArray<int, 4> large_moved;
+			large_moved = Mach::move(large);
+			MACH_CHECK(large_moved.begin() == heap);
+			MACH_CHECK(large_moved[5] == 6);
+			MACH_CHECK(large.is_empty());
+			MACH_CHECK(large.cap() == 4);
+			large.push(7);
+			MACH_CHECK(large[0] == 7);
+		}
+
+		MACH_SUBCASE("owning elements") {
+			SmallArray<Array<int>, 2> arr;
+			for (int i = 0; i < 8; i += 1) {
+				Array<int> inner;
+				inner.push(i);
+				arr.push(Mach::move(inner));
+			}
+			MACH_REQUIRE(arr.len() == 8);
+			for (usize i = 0; i < arr.len(); i += 1) {
+				MACH_CHECK(arr[i][0] == static_cast<int>(i));
+			}
+		}
+	}
 }
 #endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Array::push") {
+	using namespace Mach::Core;
+
+	bencher.set_items(1024);
+	bencher.iter([] {
+		Array<u32> array;
+		for (u32 i = 0; i < 1024; i += 1) {
+			array.push(i);
+		}
+		return array.len();
+	});
+}
+
+MACH_BENCHMARK("Array::push reserved") {
+	using namespace Mach::Core;
+
+	bencher.set_items(1024);
+	bencher.iter([] {
+		Array<u32> array;
+		array.reserve(1024);
+		for (u32 i = 0; i < 1024; i += 1) {
+			array.push(i);
+		}
+		return array.len();
+	});
+}
+
+MACH_BENCHMARK("Array::push 8") {
+	using namespace Mach::Core;
+
+	bencher.set_items(8);
+	bencher.iter([] {
+		Array<u32> array;
+		for (u32 i = 0; i < 8; i += 1) {
+			array.push(i);
+		}
+		return array[7];
+	});
+}
+
+MACH_BENCHMARK("SmallArray::push 8") {
+	using namespace Mach::Core;
+
+	bencher.set_items(8);
+	bencher.iter([] {
+		SmallArray<u32, 8> array;
+		for (u32 i = 0; i < 8; i += 1) {
+			array.push(i);
+		}
+		return array[7];
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
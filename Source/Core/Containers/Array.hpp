@@ -76,6 +76,7 @@ namespace Mach::Core {
 		MACH_NO_DISCARD MACH_ALWAYS_INLINE Option<Element&> last();
 		MACH_NO_DISCARD MACH_ALWAYS_INLINE Option<Element const&> last() const;
 
+		// Makes room for at least amount more elements than len
 		MACH_ALWAYS_INLINE void reserve(usize amount)
 			requires allocator_supports_reserve;
 
@@ -159,7 +160,7 @@ namespace Mach::Core {
 		requires CopyConstructible<Element>
 		: m_len(copy.m_len) {
 		if constexpr (allocator_supports_reserve) {
-			reserve(m_len);
+			m_storage.reserve(m_len);
 		}
 		for (usize i = 0; i < m_len; ++i) {
 			Memory::emplace<Element>(m_storage.data() + i, copy[i]);
@@ -175,7 +176,7 @@ namespace Mach::Core {
 
 		m_len = copy.m_len;
 		if constexpr (allocator_supports_reserve) {
-			reserve(m_len);
+			m_storage.reserve(m_len);
 		}
 		for (usize i = 0; i < m_len; ++i) {
 			Memory::emplace<Element>(m_storage.data() + i, copy[i]);
@@ -192,7 +193,11 @@ namespace Mach::Core {
 
 	template <typename T, ArrayAllocator Allocator>
 	Array<T, Allocator>& Array<T, Allocator>::operator=(Array&& move) noexcept {
-		this->~Array();
+		// Only the elements are destroyed here. The storage releases its own memory when it is assigned to.
+		for (usize i = 0; i < m_len; ++i) {
+			Element& item = m_storage.data()[i];
+			item.~Element();
+		}
 
 		m_len = move.m_len;
 		move.m_len = 0;
@@ -262,7 +267,7 @@ namespace Mach::Core {
 	MACH_ALWAYS_INLINE void Array<T, Allocator>::reserve(usize amount)
 		requires allocator_supports_reserve
 	{
-		m_storage.reserve(amount);
+		m_storage.reserve(m_len + amount);
 	}
 
 	template <typename T, ArrayAllocator Allocator>
@@ -355,7 +360,7 @@ namespace Mach::Core {
 		// If not removed from the end of the vector copy entire array over
 		if (index < m_len - 1) {
 			auto* src = m_storage.data() + index;
-			Memory::move(src, src + 1, (len() - index) * sizeof(Element));
+			Memory::move(src, src + 1, (len() - index - 1) * sizeof(Element));
 		}
 
 		// Decrement length
@@ -452,7 +457,9 @@ namespace Mach::Core {
 				move.m_cap = 0;
 			}
 			Storage& operator=(Storage&& move) noexcept {
-				this->~Storage();
+				if (m_ptr) {
+					Memory::free(m_ptr);
+				}
 
 				m_ptr = move.m_ptr;
 				m_cap = move.m_cap;
@@ -470,11 +477,14 @@ namespace Mach::Core {
 				}
 			}
 
-			void reserve(usize amount) {
-				const auto desired = m_cap + amount;
+			// Grows to hold at least capacity elements
+			void reserve(usize capacity) {
+				if (capacity <= m_cap) {
+					return;
+				}
 				const auto old_cap = m_cap;
-				while (m_cap < desired) {
-					m_cap += desired >> 1;
+				while (m_cap < capacity) {
+					m_cap += capacity >> 1;
 					m_cap += 1;
 				}
 
@@ -534,10 +544,100 @@ namespace Mach::Core {
 	};
 	template <usize Count>
 	inline constexpr bool is_array_allocator<InlineAllocator<Count>> = true;
+
+	/**
+	 * Keeps up to Count elements inline like InlineAllocator, then moves them to the heap instead of panicking once the
+	 * Array outgrows that. Never moves back inline, so clearing a spilled Array keeps its heap capacity.
+	 */
+	template <usize Count>
+	struct SmallAllocator {
+		static inline constexpr bool supports_reserve = true;
+
+		template <typename T>
+		class Storage {
+		public:
+			Storage() = default;
+			Storage(const Storage& copy) noexcept = delete;
+			Storage& operator=(const Storage& copy) noexcept = delete;
+			Storage(Storage&& move) noexcept : m_ptr(move.m_ptr), m_cap(move.m_cap) {
+				if (m_ptr) {
+					move.m_ptr = nullptr;
+					move.m_cap = Count;
+				} else {
+					Memory::copy(m_bytes, move.m_bytes, sizeof(m_bytes));
+#if MACH_BUILD == MACH_BUILD_DEBUG
+					Memory::set(move.m_bytes, 0, sizeof(move.m_bytes));
+#endif
+				}
+			}
+			Storage& operator=(Storage&& move) noexcept {
+				if (m_ptr) {
+					Memory::free(m_ptr);
+				}
+
+				m_ptr = move.m_ptr;
+				m_cap = move.m_cap;
+				if (m_ptr) {
+					move.m_ptr = nullptr;
+					move.m_cap = Count;
+				} else {
+					Memory::copy(m_bytes, move.m_bytes, sizeof(m_bytes));
+#if MACH_BUILD == MACH_BUILD_DEBUG
+					Memory::set(move.m_bytes, 0, sizeof(move.m_bytes));
+#endif
+				}
+
+				return *this;
+			}
+			~Storage() {
+				if (m_ptr) {
+					Memory::free(m_ptr);
+					m_ptr = nullptr;
+					m_cap = Count;
+				}
+			}
+
+			// Grows to hold at least capacity elements, moving to the heap the first time that is more than Count
+			void reserve(usize capacity) {
+				if (capacity <= m_cap) {
+					return;
+				}
+				const auto old_cap = m_cap;
+				while (m_cap < capacity) {
+					m_cap += capacity >> 1;
+					m_cap += 1;
+				}
+
+				const auto new_ptr = Memory::alloc(Memory::Layout::array<T>(m_cap));
+				Memory::copy(new_ptr, data(), old_cap * sizeof(T));
+				if (m_ptr) {
+					Memory::free(m_ptr);
+				}
+				m_ptr = new_ptr.template as<T>();
+			}
+
+			MACH_ALWAYS_INLINE T* data() { return m_ptr ? m_ptr : reinterpret_cast<T*>(&m_bytes[0]); }
+			MACH_ALWAYS_INLINE const T* data() const { return m_ptr ? m_ptr : reinterpret_cast<const T*>(&m_bytes[0]); }
+			MACH_ALWAYS_INLINE usize cap() const { return m_cap; }
+
+		private:
+			// Null while the elements are inline
+			T* m_ptr = nullptr;
+			usize m_cap = Count;
+			alignas(T) u8 m_bytes[sizeof(T) * Count];
+		};
+	};
+	template <usize Count>
+	inline constexpr bool is_array_allocator<SmallAllocator<Count>> = true;
+
+	template <typename T, usize Count>
+	using SmallArray = Array<T, SmallAllocator<Count>>;
 } // namespace Mach::Core
 
 namespace Mach {
 	using Core::Array;
 	using Core::HeapAllocator;
 	using Core::InlineAllocator;
+	using Core::SmallAllocator;
+	using Core::SmallArray;
 } // namespace Mach
@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/BTreeMap.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach::Core;
+
+	// Walks the map in order and checks it matches the keys flagged in present
+	template <typename Value>
+	bool btree_matches(const BTreeMap<u32, Value>& map, const Array<bool>& present) {
+		usize count = 0;
+		u32 expected = 0;
+		for (const auto [key, value] : map) {
+			while (expected < present.len() && !present[expected]) {
+				expected += 1;
+			}
+			if (key != expected) {
+				return false;
+			}
+			expected += 1;
+			count += 1;
+		}
+		return count == map.len();
+	}
+
+	MACH_TEST_CASE("BTreeMap") {
+		MACH_SUBCASE("insert and find") {
+			BTreeMap<u32, u32> map;
+			MACH_CHECK(!map.find(1).is_set());
+
+			MACH_CHECK(!map.insert(2, 20).is_set());
+			MACH_CHECK(!map.insert(1, 10).is_set());
+			MACH_CHECK(map.len() == 2);
+			MACH_CHECK(map.find(1).unwrap() == 10);
+			MACH_CHECK(map.find(2).unwrap() == 20);
+			MACH_CHECK(!map.contains(3));
+
+			// Inserting over a key hands back the old value
+			MACH_CHECK(map.insert(1, 11).unwrap() == 10);
+			MACH_CHECK(map.len() == 2);
+			MACH_CHECK(map.find(1).unwrap() == 11);
+
+			map.find(2).unwrap() = 21;
+			MACH_CHECK(map.find(2).unwrap() == 21);
+		}
+
+		MACH_SUBCASE("iterates in key order") {
+			BTreeMap<u32, u32> map;
+			Array<bool> present;
+			present.set_len(10000);
+
+			// Multiplying by a number coprime with the length visits every key once out of order
+			for (u32 index = 0; index < 10000; index += 1) {
+				const u32 key = index * 7919 % 10000;
+				map.insert(key, key * 2);
+				present[key] = true;
+			}
+			MACH_CHECK(map.len() == 10000);
+			MACH_CHECK(btree_matches(map, present));
+
+			for (auto [key, value] : map) {
+				MACH_CHECK(value == key * 2);
+				value += 1;
+			}
+			MACH_CHECK(map.find(500).unwrap() == 1001);
+		}
+
+		MACH_SUBCASE("remove") {
+			BTreeMap<u32, u32> map;
+			Array<bool> present;
+			present.set_len(4000);
+
+			// xorshift so the order is the same on every run
+			u64 state = 0x9E3779B97F4A7C15ULL;
+			for (usize step = 0; step < 40000; step += 1) {
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				const u32 key = static_cast<u32>(state % 4000);
+
+				// Inserts are more likely in the first half and removes in the second, so the tree grows and shrinks
+				const bool insert = (state >> 32) % 3 < (step < 20000 ? 2u : 1u);
+				if (insert) {
+					MACH_CHECK(map.insert(key, key).is_set() == present[key]);
+					present[key] = true;
+				} else {
+					const auto removed = map.remove(key);
+					MACH_CHECK(removed.is_set() == present[key]);
+					present[key] = false;
+				}
+			}
+			MACH_CHECK(btree_matches(map, present));
+
+			for (u32 key = 0; key < 4000; key += 1) {
+				const auto removed = map.remove(key);
+				MACH_CHECK(removed.is_set() == present[key]);
+			}
+			MACH_CHECK(map.is_empty());
+			MACH_CHECK(map.begin() == map.end());
+		}
+
+		MACH_SUBCASE("range") {
+			BTreeMap<u32, u32> map;
+			for (u32 key = 0; key < 1000; key += 1) {
+				map.insert(key * 10, key);
+			}
+
+			// [95, 205) holds 100 through 200
+			u32 count = 0;
+			u32 expected = 100;
+			for (const auto [key, value] : map.range(95, 205)) {
+				MACH_CHECK(key == expected);
+				expected += 10;
+				count += 1;
+			}
+			MACH_CHECK(count == 11);
+
+			MACH_CHECK(map.range(100, 100).begin() == map.range(100, 100).end());
+			MACH_CHECK(map.lower_bound(9991) == map.end());
+			MACH_CHECK((*map.lower_bound(9981)).key == 9990);
+		}
+
+		MACH_SUBCASE("from_sorted") {
+			for (const usize len : { 0, 1, 31, 32, 33, 1000, 50000 }) {
+				Array<u32> keys;
+				Array<UniquePtr<u32>> values;
+				for (u32 index = 0; index < len; index += 1) {
+					keys.push(index * 2);
+					values.push(UniquePtr<u32>::create(index));
+				}
+
+				auto map = BTreeMap<u32, UniquePtr<u32>>::from_sorted(keys.as_const_slice(), values.as_slice());
+				MACH_CHECK(map.len() == len);
+
+				u32 expected = 0;
+				for (const auto [key, value] : map) {
+					MACH_CHECK(key == expected * 2);
+					MACH_CHECK(*value == expected);
+					expected += 1;
+				}
+				MACH_CHECK(expected == len);
+
+				// The bulk loaded tree must still take inserts and removes
+				map.insert(1, UniquePtr<u32>::create(1u));
+				for (u32 index = 0; index < len; index += 2) {
+					MACH_CHECK(map.remove(index * 2).is_set());
+				}
+				MACH_CHECK(map.len() == len - (len + 1) / 2 + 1);
+				MACH_CHECK(map.contains(1));
+			}
+		}
+
+		MACH_SUBCASE("owning values") {
+			BTreeMap<u32, UniquePtr<u32>> map;
+			for (u32 key = 0; key < 2000; key += 1) {
+				map.insert(key, UniquePtr<u32>::create(key));
+			}
+			for (u32 key = 0; key < 2000; key += 3) {
+				MACH_CHECK(*map.remove(key).unwrap() == key);
+			}
+
+			BTreeMap<u32, UniquePtr<u32>> moved = Mach::move(map);
+			MACH_CHECK(map.is_empty());
+			MACH_CHECK(*moved.find(1).unwrap() == 1);
+			MACH_CHECK(!moved.find(3).is_set());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("BTreeMap::insert") {
+	using namespace Mach::Core;
+
+	bencher.set_items(1024);
+	bencher.iter([] {
+		BTreeMap<u64, u64> map;
+		for (u64 i = 0; i < 1024; i += 1) {
+			map.insert(i, i);
+		}
+		return map.len();
+	});
+}
+
+MACH_BENCHMARK("BTreeMap::find") {
+	using namespace Mach::Core;
+
+	BTreeMap<u64, u64> map;
+	for (u64 i = 0; i < 1024; i += 1) {
+		map.insert(i * 7, i);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&map] {
+		u64 found = 0;
+		for (u64 i = 0; i < 1024; i += 1) {
+			// Every other lookup misses
+			found += map.find(i * 7 + (i & 1)).is_set() ? 1 : 0;
+		}
+		return found;
+	});
+}
+
+MACH_BENCHMARK("BTreeMap::range 1K of 64K") {
+	using namespace Mach::Core;
+
+	BTreeMap<u64, u64> map;
+	for (u64 i = 0; i < 64 * 1024; i += 1) {
+		map.insert(i, i);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&map] {
+		u64 sum = 0;
+		for (const auto [key, value] : map.range(30000, 31024)) {
+			sum += value;
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
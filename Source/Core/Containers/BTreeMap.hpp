@@ -0,0 +1,653 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+
+namespace Mach::Core {
+	// Bytes of entries a node aims to hold. Keys are stored apart from values so a key search only streams through a
+	// few cache lines of keys.
+	inline constexpr usize btree_node_bytes = 8 * MACH_CACHE_LINE_SIZE;
+
+	// Entries of entry_size bytes that fit in a node. Never fewer than 4 so splitting and merging always leave keys in
+	// both halves.
+	MACH_ALWAYS_INLINE constexpr usize btree_node_cap(usize entry_size) {
+		const usize cap = btree_node_bytes / entry_size;
+		return cap < 4 ? 4 : (cap > 64 ? 64 : cap);
+	}
+
+	/**
+	 * Number of keys that are less than key. Every key is compared without branching so compilers turn the loop into
+	 * SIMD compares for arithmetic keys, which beats a binary search at node sizes.
+	 */
+	template <typename Key>
+	MACH_ALWAYS_INLINE inline usize btree_count_less(Key const* keys, usize len, Key const& key) {
+		usize result = 0;
+		for (usize index = 0; index < len; index += 1) {
+			result += static_cast<usize>(keys[index] < key);
+		}
+		return result;
+	}
+
+	template <typename Key>
+	MACH_ALWAYS_INLINE inline usize btree_count_less_equal(Key const* keys, usize len, Key const& key) {
+		usize result = 0;
+		for (usize index = 0; index < len; index += 1) {
+			result += static_cast<usize>(!(key < keys[index]));
+		}
+		return result;
+	}
+
+	// Moves count items from src into uninitialized dst, leaving src uninitialized. The ranges may overlap.
+	template <typename T>
+	void btree_move(T* dst, T* src, usize count) {
+		if (dst < src) {
+			for (usize index = 0; index < count; index += 1) {
+				Memory::emplace<T>(dst + index, Mach::move(src[index]));
+				src[index].~T();
+			}
+		} else if (dst > src) {
+			for (usize index = count; index > 0; index -= 1) {
+				Memory::emplace<T>(dst + index - 1, Mach::move(src[index - 1]));
+				src[index - 1].~T();
+			}
+		}
+	}
+
+	template <typename T>
+	void btree_insert_at(T* items, usize len, usize index, T&& value) {
+		btree_move(items + index + 1, items + index, len - index);
+		Memory::emplace<T>(items + index, Mach::move(value));
+	}
+
+	template <typename T>
+	T btree_remove_at(T* items, usize len, usize index) {
+		T result = Mach::move(items[index]);
+		items[index].~T();
+		btree_move(items + index, items + index + 1, len - index - 1);
+		return result;
+	}
+
+	/**
+	 * Ordered map stored as a B+ tree. Values live only in the leaves, which are linked in key order, so iteration and
+	 * range queries walk leaves front to back without going back up the tree. Nodes are sized to a handful of cache
+	 * lines, keeping the tree shallow and each node's keys contiguous.
+	 *
+	 * Nodes are rebalanced on the way down during insert and remove so neither ever has to walk back up. Inserting or
+	 * removing invalidates every iterator.
+	 */
+	template <typename Key, typename Value>
+		requires Copyable<Key> && TotallyOrdered<Key> && Movable<Value>
+	class BTreeMap {
+		struct Node;
+		struct Leaf;
+		struct Inner;
+
+	public:
+		static constexpr usize leaf_cap = btree_node_cap(sizeof(Key) + sizeof(Value));
+		static constexpr usize inner_cap = btree_node_cap(sizeof(Key) + sizeof(void*));
+
+		struct Entry {
+			Key const& key;
+			Value& value;
+		};
+
+		struct ConstEntry {
+			Key const& key;
+			Value const& value;
+		};
+
+		// Walks entries in ascending key order
+		template <typename E>
+		class Iterator {
+		public:
+			MACH_ALWAYS_INLINE E operator*() const { return E{ m_leaf->keys()[m_index], m_leaf->values()[m_index] }; }
+
+			MACH_ALWAYS_INLINE Iterator& operator++() {
+				m_index += 1;
+				if (m_index == m_leaf->len) {
+					m_leaf = m_leaf->next;
+					m_index = 0;
+				}
+				return *this;
+			}
+
+			bool operator==(const Iterator& other) const = default;
+
+		private:
+			friend class BTreeMap;
+
+			Iterator(Leaf* leaf, usize index) : m_leaf(leaf), m_index(index) {}
+
+			Leaf* m_leaf = nullptr;
+			usize m_index = 0;
+		};
+
+		template <typename E>
+		class Range {
+		public:
+			MACH_ALWAYS_INLINE Iterator<E> begin() const { return m_begin; }
+			MACH_ALWAYS_INLINE Iterator<E> end() const { return m_end; }
+
+		private:
+			friend class BTreeMap;
+
+			Range(Iterator<E> begin, Iterator<E> end) : m_begin(begin), m_end(end) {}
+
+			Iterator<E> m_begin;
+			Iterator<E> m_end;
+		};
+
+		constexpr BTreeMap() = default;
+
+		/**
+		 * Builds the tree bottom up from keys in strictly ascending order, moving the values out of values. Faster than
+		 * inserting one at a time as every leaf is filled once and no node is ever split.
+		 */
+		static BTreeMap from_sorted(Slice<Key const> keys, Slice<Value> values) {
+			MACH_ASSERT(keys.len() == values.len(), "Every key needs a value");
+			for (usize index = 1; index < keys.len(); index += 1) {
+				MACH_ASSERT(keys[index - 1] < keys[index], "Keys must be sorted and unique");
+			}
+
+			BTreeMap result;
+			const usize count = keys.len();
+			if (count == 0) {
+				return result;
+			}
+
+			// Spread the entries evenly across the leaves so none is left nearly empty
+			Array<Node*> level;
+			Array<Key> firsts;
+			const usize leaf_count = (count + leaf_cap - 1) / leaf_cap;
+			Leaf* previous = nullptr;
+			for (usize node = 0, start = 0; node < leaf_count; node += 1) {
+				const usize end = count * (node + 1) / leaf_count;
+				Leaf* const leaf = create_leaf();
+				for (usize index = start; index < end; index += 1) {
+					Memory::emplace<Key>(leaf->keys() + index - start, keys[index]);
+					Memory::emplace<Value>(leaf->values() + index - start, Mach::move(values[index]));
+				}
+				leaf->len = static_cast<u16>(end - start);
+
+				if (previous != nullptr) {
+					previous->next = leaf;
+				}
+				previous = leaf;
+				level.push(leaf);
+				firsts.push(keys[start]);
+				start = end;
+			}
+
+			// Then build each level of inner nodes over the one below until a single root is left
+			while (level.len() > 1) {
+				Array<Node*> parents;
+				Array<Key> parent_firsts;
+				const usize children = level.len();
+				const usize node_count = (children + inner_cap) / (inner_cap + 1);
+				for (usize node = 0, start = 0; node < node_count; node += 1) {
+					const usize end = children * (node + 1) / node_count;
+					Inner* const inner = create_inner();
+					inner->children[0] = level[start];
+					for (usize child = start + 1; child < end; child += 1) {
+						Memory::emplace<Key>(inner->keys() + child - start - 1, firsts[child]);
+						inner->children[child - start] = level[child];
+					}
+					inner->len = static_cast<u16>(end - start - 1);
+
+					parents.push(inner);
+					parent_firsts.push(firsts[start]);
+					start = end;
+				}
+				level = Mach::move(parents);
+				firsts = Mach::move(parent_firsts);
+			}
+
+			result.m_root = level[0];
+			result.m_len = count;
+			return result;
+		}
+
+		MACH_NO_COPY(BTreeMap);
+
+		BTreeMap(BTreeMap&& move) noexcept : m_root(move.m_root), m_len(move.m_len) {
+			move.m_root = nullptr;
+			move.m_len = 0;
+		}
+		BTreeMap& operator=(BTreeMap&& move) noexcept {
+			if (this != &move) {
+				clear();
+				m_root = move.m_root;
+				m_len = move.m_len;
+				move.m_root = nullptr;
+				move.m_len = 0;
+			}
+			return *this;
+		}
+
+		~BTreeMap() { clear(); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_len; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_empty() const { return m_len == 0; }
+
+		// Inserts value at key, handing back the value it replaced if key was already present
+		Option<Value> insert(const Key& key, Value&& value) {
+			if (m_root == nullptr) {
+				m_root = create_leaf();
+			}
+
+			// A full root is split under a new root, the only way the tree grows taller
+			if (is_full(m_root)) {
+				Inner* const root = create_inner();
+				root->children[0] = m_root;
+				m_root = root;
+				split_child(root, 0);
+			}
+
+			Node* node = m_root;
+			while (!node->is_leaf) {
+				Inner* const inner = static_cast<Inner*>(node);
+				usize index = btree_count_less_equal(inner->keys(), inner->len, key);
+
+				// Split full children before entering them so a split always has room in its parent
+				if (is_full(inner->children[index])) {
+					split_child(inner, index);
+					if (!(key < inner->keys()[index])) {
+						index += 1;
+					}
+				}
+				node = inner->children[index];
+			}
+
+			Leaf* const leaf = static_cast<Leaf*>(node);
+			const usize index = btree_count_less(leaf->keys(), leaf->len, key);
+			if (index < leaf->len && !(key < leaf->keys()[index])) {
+				Value replaced = Mach::move(leaf->values()[index]);
+				leaf->values()[index] = Mach::move(value);
+				return replaced;
+			}
+
+			Key key_copy = key;
+			btree_insert_at(leaf->keys(), leaf->len, index, Mach::move(key_copy));
+			btree_insert_at(leaf->values(), leaf->len, index, Mach::move(value));
+			leaf->len += 1;
+			m_len += 1;
+			return nullopt;
+		}
+		Option<Value> insert(const Key& key, const Value& value)
+			requires CopyConstructible<Value>
+		{
+			Value copy = value;
+			return insert(key, Mach::move(copy));
+		}
+
+		Option<Value> remove(const Key& key) {
+			if (m_root == nullptr) {
+				return nullopt;
+			}
+
+			Node* node = m_root;
+			while (!node->is_leaf) {
+				Inner* const inner = static_cast<Inner*>(node);
+				usize index = btree_count_less_equal(inner->keys(), inner->len, key);
+
+				// Top up children at their minimum before entering them so removing never leaves a node too small
+				if (is_minimum(inner->children[index])) {
+					index = fix_child(inner, index);
+				}
+				node = inner->children[index];
+			}
+
+			Leaf* const leaf = static_cast<Leaf*>(node);
+			const usize index = btree_count_less(leaf->keys(), leaf->len, key);
+			Option<Value> result;
+			if (index < leaf->len && !(key < leaf->keys()[index])) {
+				const Key unused = btree_remove_at(leaf->keys(), leaf->len, index);
+				MACH_UNUSED(unused);
+				result = btree_remove_at(leaf->values(), leaf->len, index);
+				leaf->len -= 1;
+				m_len -= 1;
+			}
+
+			// Merging the root's last two children leaves it with one child, which becomes the root
+			if (!m_root->is_leaf && m_root->len == 0) {
+				Inner* const root = static_cast<Inner*>(m_root);
+				m_root = root->children[0];
+				root->~Inner();
+				Memory::free(root);
+			}
+			if (m_root->is_leaf && m_root->len == 0) {
+				free_node(m_root);
+				m_root = nullptr;
+			}
+
+			return result;
+		}
+
+		MACH_NO_DISCARD Option<Value&> find(const Key& key) {
+			Leaf* const leaf = find_leaf(key);
+			if (leaf == nullptr) {
+				return nullopt;
+			}
+			const usize index = btree_count_less(leaf->keys(), leaf->len, key);
+			if (index < leaf->len && !(key < leaf->keys()[index])) {
+				return leaf->values()[index];
+			}
+			return nullopt;
+		}
+
+		MACH_NO_DISCARD Option<Value const&> find(const Key& key) const {
+			Leaf* const leaf = find_leaf(key);
+			if (leaf == nullptr) {
+				return nullopt;
+			}
+			const usize index = btree_count_less(leaf->keys(), leaf->len, key);
+			if (index < leaf->len && !(key < leaf->keys()[index])) {
+				return leaf->values()[index];
+			}
+			return nullopt;
+		}
+
+		MACH_NO_DISCARD bool contains(const Key& key) const { return find(key).is_set(); }
+
+		void clear() {
+			if (m_root != nullptr) {
+				free_node(m_root);
+				m_root = nullptr;
+			}
+			m_len = 0;
+		}
+
+		MACH_ALWAYS_INLINE Iterator<Entry> begin() { return Iterator<Entry>(first_leaf(), 0); }
+		MACH_ALWAYS_INLINE Iterator<Entry> end() { return Iterator<Entry>(nullptr, 0); }
+		MACH_ALWAYS_INLINE Iterator<ConstEntry> begin() const { return Iterator<ConstEntry>(first_leaf(), 0); }
+		MACH_ALWAYS_INLINE Iterator<ConstEntry> end() const { return Iterator<ConstEntry>(nullptr, 0); }
+
+		// First entry whose key is not less than key
+		MACH_NO_DISCARD Iterator<Entry> lower_bound(const Key& key) { return lower_bound_of<Entry>(key); }
+		MACH_NO_DISCARD Iterator<ConstEntry> lower_bound(const Key& key) const {
+			return lower_bound_of<ConstEntry>(key);
+		}
+
+		// Entries with keys in [from, to) in ascending order
+		MACH_NO_DISCARD Range<Entry> range(const Key& from, const Key& to) {
+			MACH_ASSERT(!(to < from), "Range end must not come before its start");
+			return Range<Entry>(lower_bound_of<Entry>(from), lower_bound_of<Entry>(to));
+		}
+		MACH_NO_DISCARD Range<ConstEntry> range(const Key& from, const Key& to) const {
+			MACH_ASSERT(!(to < from), "Range end must not come before its start");
+			return Range<ConstEntry>(lower_bound_of<ConstEntry>(from), lower_bound_of<ConstEntry>(to));
+		}
+
+	private:
+		// Children at or below these are topped up from a sibling before a remove enters them
+		static constexpr usize leaf_min = leaf_cap / 2;
+		static constexpr usize inner_min = (inner_cap - 1) / 2;
+
+		struct Node {
+			u16 len = 0;
+			bool is_leaf;
+		};
+
+		struct Leaf : Node {
+			Leaf() : Node{ .is_leaf = true } {}
+
+			MACH_ALWAYS_INLINE Key* keys() { return reinterpret_cast<Key*>(key_bytes); }
+			MACH_ALWAYS_INLINE Value* values() { return reinterpret_cast<Value*>(value_bytes); }
+
+			Leaf* next = nullptr;
+			alignas(Key) u8 key_bytes[sizeof(Key) * leaf_cap];
+			alignas(Value) u8 value_bytes[sizeof(Value) * leaf_cap];
+		};
+
+		struct Inner : Node {
+			Inner() : Node{ .is_leaf = false } {}
+
+			MACH_ALWAYS_INLINE Key* keys() { return reinterpret_cast<Key*>(key_bytes); }
+
+			// children[i + 1] holds the keys at or above keys[i]
+			alignas(Key) u8 key_bytes[sizeof(Key) * inner_cap];
+			Node* children[inner_cap + 1];
+		};
+
+		static Leaf* create_leaf() {
+			auto memory = Memory::alloc(Memory::Layout::single<Leaf>());
+			return Memory::emplace<Leaf>(*memory);
+		}
+
+		static Inner* create_inner() {
+			auto memory = Memory::alloc(Memory::Layout::single<Inner>());
+			return Memory::emplace<Inner>(*memory);
+		}
+
+		static void free_node(Node* node) {
+			if (node->is_leaf) {
+				Leaf* const leaf = static_cast<Leaf*>(node);
+				for (usize index = 0; index < leaf->len; index += 1) {
+					leaf->keys()[index].~Key();
+					leaf->values()[index].~Value();
+				}
+				leaf->~Leaf();
+			} else {
+				Inner* const inner = static_cast<Inner*>(node);
+				for (usize index = 0; index < inner->len; index += 1) {
+					inner->keys()[index].~Key();
+				}
+				for (usize index = 0; index <= inner->len; index += 1) {
+					free_node(inner->children[index]);
+				}
+				inner->~Inner();
+			}
+			Memory::free(node);
+		}
+
+		MACH_ALWAYS_INLINE static bool is_full(Node const* node) {
+			return node->len == (node->is_leaf ? leaf_cap : inner_cap);
+		}
+
+		MACH_ALWAYS_INLINE static bool is_minimum(Node const* node) {
+			return node->len <= (node->is_leaf ? leaf_min : inner_min);
+		}
+
+		// Splits the full child at index in two, adding the key that separates them to parent
+		static void split_child(Inner* parent, usize index) {
+			Node* const child = parent->children[index];
+			Node* right;
+			Key separator = [&] {
+				if (child->is_leaf) {
+					Leaf* const left_leaf = static_cast<Leaf*>(child);
+					Leaf* const right_leaf = create_leaf();
+					const usize half = left_leaf->len / 2;
+					const usize moved = left_leaf->len - half;
+					btree_move(right_leaf->keys(), left_leaf->keys() + half, moved);
+					btree_move(right_leaf->values(), left_leaf->values() + half, moved);
+					left_leaf->len = static_cast<u16>(half);
+					right_leaf->len = static_cast<u16>(moved);
+
+					right_leaf->next = left_leaf->next;
+					left_leaf->next = right_leaf;
+					right = right_leaf;
+
+					// Leaves keep every key, so the separator is a copy of the right leaf's first
+					return right_leaf->keys()[0];
+				}
+
+				Inner* const left_inner = static_cast<Inner*>(child);
+				Inner* const right_inner = create_inner();
+				const usize middle = left_inner->len / 2;
+				const usize moved = left_inner->len - middle - 1;
+				btree_move(right_inner->keys(), left_inner->keys() + middle + 1, moved);
+				btree_move(right_inner->children, left_inner->children + middle + 1, moved + 1);
+				right_inner->len = static_cast<u16>(moved);
+				right = right_inner;
+
+				// The middle key moves up into the parent
+				Key middle_key = Mach::move(left_inner->keys()[middle]);
+				left_inner->keys()[middle].~Key();
+				left_inner->len = static_cast<u16>(middle);
+				return middle_key;
+			}();
+
+			btree_insert_at(parent->keys(), parent->len, index, Mach::move(separator));
+			btree_insert_at(parent->children, parent->len + 1, index + 1, Mach::move(right));
+			parent->len += 1;
+		}
+
+		/**
+		 * Brings the child at index above its minimum by borrowing an entry from a sibling, or merging with one when
+		 * both siblings are at their minimum too. Returns where the child ended up.
+		 */
+		static usize fix_child(Inner* parent, usize index) {
+			if (index > 0 && !is_minimum(parent->children[index - 1])) {
+				borrow_from_left(parent, index);
+				return index;
+			}
+			if (index < parent->len && !is_minimum(parent->children[index + 1])) {
+				borrow_from_right(parent, index);
+				return index;
+			}
+			if (index < parent->len) {
+				merge_children(parent, index);
+				return index;
+			}
+			merge_children(parent, index - 1);
+			return index - 1;
+		}
+
+		static void borrow_from_left(Inner* parent, usize index) {
+			Node* const child = parent->children[index];
+			Node* const left = parent->children[index - 1];
+			Key& separator = parent->keys()[index - 1];
+
+			if (child->is_leaf) {
+				Leaf* const child_leaf = static_cast<Leaf*>(child);
+				Leaf* const left_leaf = static_cast<Leaf*>(left);
+				const usize last = left_leaf->len - 1;
+				btree_insert_at(child_leaf->keys(),
+								child_leaf->len,
+								0,
+								btree_remove_at(left_leaf->keys(), last + 1, last));
+				btree_insert_at(child_leaf->values(),
+								child_leaf->len,
+								0,
+								btree_remove_at(left_leaf->values(), last + 1, last));
+				separator = child_leaf->keys()[0];
+			} else {
+				Inner* const child_inner = static_cast<Inner*>(child);
+				Inner* const left_inner = static_cast<Inner*>(left);
+				const usize last = left_inner->len - 1;
+				btree_insert_at(child_inner->keys(), child_inner->len, 0, Mach::move(separator));
+				btree_insert_at(child_inner->children,
+								child_inner->len + 1,
+								0,
+								btree_remove_at(left_inner->children, last + 2, last + 1));
+				separator = btree_remove_at(left_inner->keys(), last + 1, last);
+			}
+			child->len += 1;
+			left->len -= 1;
+		}
+
+		static void borrow_from_right(Inner* parent, usize index) {
+			Node* const child = parent->children[index];
+			Node* const right = parent->children[index + 1];
+			Key& separator = parent->keys()[index];
+
+			if (child->is_leaf) {
+				Leaf* const child_leaf = static_cast<Leaf*>(child);
+				Leaf* const right_leaf = static_cast<Leaf*>(right);
+				Memory::emplace<Key>(child_leaf->keys() + child_leaf->len,
+									 btree_remove_at(right_leaf->keys(), right_leaf->len, 0));
+				Memory::emplace<Value>(child_leaf->values() + child_leaf->len,
+									   btree_remove_at(right_leaf->values(), right_leaf->len, 0));
+				separator = right_leaf->keys()[0];
+			} else {
+				Inner* const child_inner = static_cast<Inner*>(child);
+				Inner* const right_inner = static_cast<Inner*>(right);
+				Memory::emplace<Key>(child_inner->keys() + child_inner->len, Mach::move(separator));
+				child_inner->children[child_inner->len + 1] =
+					btree_remove_at(right_inner->children, right_inner->len + 1, 0);
+				separator = btree_remove_at(right_inner->keys(), right_inner->len, 0);
+			}
+			child->len += 1;
+			right->len -= 1;
+		}
+
+		// Moves everything in the child after index into the child at index and drops the key between them
+		static void merge_children(Inner* parent, usize index) {
+			Node* const left = parent->children[index];
+			Node* const right = parent->children[index + 1];
+			Key separator = btree_remove_at(parent->keys(), parent->len, index);
+			const Node* const unused = btree_remove_at(parent->children, parent->len + 1, index + 1);
+			MACH_UNUSED(unused);
+			parent->len -= 1;
+
+			if (left->is_leaf) {
+				Leaf* const left_leaf = static_cast<Leaf*>(left);
+				Leaf* const right_leaf = static_cast<Leaf*>(right);
+				btree_move(left_leaf->keys() + left_leaf->len, right_leaf->keys(), right_leaf->len);
+				btree_move(left_leaf->values() + left_leaf->len, right_leaf->values(), right_leaf->len);
+				left_leaf->len += right_leaf->len;
+				left_leaf->next = right_leaf->next;
+				right_leaf->~Leaf();
+			} else {
+				Inner* const left_inner = static_cast<Inner*>(left);
+				Inner* const right_inner = static_cast<Inner*>(right);
+				Memory::emplace<Key>(left_inner->keys() + left_inner->len, Mach::move(separator));
+				btree_move(left_inner->keys() + left_inner->len + 1, right_inner->keys(), right_inner->len);
+				btree_move(left_inner->children + left_inner->len + 1, right_inner->children, right_inner->len + 1);
+				left_inner->len += right_inner->len + 1;
+				right_inner->~Inner();
+			}
+			Memory::free(right);
+		}
+
+		Leaf* first_leaf() const {
+			if (m_root == nullptr) {
+				return nullptr;
+			}
+			Node* node = m_root;
+			while (!node->is_leaf) {
+				node = static_cast<Inner*>(node)->children[0];
+			}
+			return static_cast<Leaf*>(node);
+		}
+
+		Leaf* find_leaf(const Key& key) const {
+			if (m_root == nullptr) {
+				return nullptr;
+			}
+			Node* node = m_root;
+			while (!node->is_leaf) {
+				Inner* const inner = static_cast<Inner*>(node);
+				node = inner->children[btree_count_less_equal(inner->keys(), inner->len, key)];
+			}
+			return static_cast<Leaf*>(node);
+		}
+
+		template <typename E>
+		Iterator<E> lower_bound_of(const Key& key) const {
+			Leaf* leaf = find_leaf(key);
+			if (leaf == nullptr) {
+				return Iterator<E>(nullptr, 0);
+			}
+
+			// Every key in the leaf may be smaller, in which case the next leaf starts with the answer
+			const usize index = btree_count_less(leaf->keys(), leaf->len, key);
+			if (index == leaf->len) {
+				return Iterator<E>(leaf->next, 0);
+			}
+			return Iterator<E>(leaf, index);
+		}
+
+		Node* m_root = nullptr;
+		usize m_len = 0;
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::BTreeMap;
+} // namespace Mach
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/BitArray.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach::Core;
+	MACH_TEST_CASE("BitArray") {
+		MACH_SUBCASE("set and clear") {
+			BitArray<> bits(130);
+			MACH_CHECK(bits.len() == 130);
+			MACH_CHECK(!bits.any());
+
+			bits.set(0);
+			bits.set(64);
+			bits.set(129);
+			MACH_CHECK(bits.get(0));
+			MACH_CHECK(!bits.get(1));
+			MACH_CHECK(bits.get(64));
+			MACH_CHECK(bits.get(129));
+			MACH_CHECK(bits.count_ones() == 3);
+
+			bits.clear(64);
+			bits.assign(1, true);
+			MACH_CHECK(!bits.get(64));
+			MACH_CHECK(bits.get(1));
+			MACH_CHECK(bits.count_ones() == 3);
+		}
+
+		MACH_SUBCASE("set_all keeps bits past len clear") {
+			BitArray<> bits(70);
+			bits.set_all();
+			MACH_CHECK(bits.count_ones() == 70);
+			MACH_CHECK(!bits.find_first_clear().is_set());
+
+			bits.set_len(65);
+			MACH_CHECK(bits.count_ones() == 65);
+			bits.set_len(200);
+			MACH_CHECK(bits.count_ones() == 65);
+			MACH_CHECK(bits.find_first_clear().unwrap() == 65);
+
+			bits.clear_all();
+			MACH_CHECK(!bits.any());
+		}
+
+		MACH_SUBCASE("scans") {
+			BitArray<> bits(1000);
+			MACH_CHECK(!bits.find_first_set().is_set());
+
+			bits.set(3);
+			bits.set(64);
+			bits.set(700);
+			bits.set(999);
+			MACH_CHECK(bits.find_first_set().unwrap() == 3);
+			MACH_CHECK(bits.find_next_set(3).unwrap() == 3);
+			MACH_CHECK(bits.find_next_set(4).unwrap() == 64);
+			MACH_CHECK(bits.find_next_set(65).unwrap() == 700);
+			MACH_CHECK(bits.find_next_set(701).unwrap() == 999);
+			MACH_CHECK(!bits.find_next_set(1000).is_set());
+			MACH_CHECK(bits.find_first_clear().unwrap() == 0);
+
+			Array<usize> visited;
+			bits.for_each_set([&](usize index) { visited.push(index); });
+			MACH_REQUIRE(visited.len() == 4);
+			MACH_CHECK(visited[0] == 3);
+			MACH_CHECK(visited[1] == 64);
+			MACH_CHECK(visited[2] == 700);
+			MACH_CHECK(visited[3] == 999);
+		}
+
+		MACH_SUBCASE("bulk operations") {
+			// An odd number of words so the scalar tail runs too
+			BitArray<> a(300);
+			BitArray<> b(300);
+			for (usize index = 0; index < 300; index += 1) {
+				a.assign(index, index % 2 == 0);
+				b.assign(index, index % 3 == 0);
+			}
+
+			BitArray<> both = a;
+			both.and_with(b);
+			BitArray<> either = a;
+			either.or_with(b);
+			BitArray<> only_a = a;
+			only_a.and_not_with(b);
+
+			for (usize index = 0; index < 300; index += 1) {
+				MACH_CHECK(both.get(index) == (index % 6 == 0));
+				MACH_CHECK(either.get(index) == (index % 2 == 0 || index % 3 == 0));
+				MACH_CHECK(only_a.get(index) == (index % 2 == 0 && index % 3 != 0));
+			}
+			MACH_CHECK(a.contains_all(both));
+			MACH_CHECK(!a.contains_all(b));
+		}
+
+		MACH_SUBCASE("small allocator") {
+			BitArray<SmallAllocator<2>> bits(128);
+			bits.set(127);
+			MACH_CHECK(bits.find_first_set().unwrap() == 127);
+		}
+
+		MACH_SUBCASE("count_ones") {
+			MACH_CHECK(Memory::count_ones(0xFFu) == 8);
+			MACH_CHECK(Memory::count_ones(~0ull) == 64);
+			MACH_CHECK(Memory::count_ones(static_cast<i16>(-1)) == 16);
+			MACH_CHECK(Memory::count_ones(static_cast<UTF8Char>(0xF0)) == 4);
+			MACH_CHECK(Memory::count_ones(static_cast<char16_t>(0xFFFF)) == 16);
+			MACH_CHECK(Memory::count_ones(static_cast<char32_t>(0x10FFFF)) == 17);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	using namespace Mach::Core;
+
+	// One bit in every 4096 set, roughly what a free list or dirty set looks like between frames
+	constexpr usize bit_bench_len = 1024 * 1024;
+	constexpr usize bit_bench_stride = 4096;
+} // namespace
+
+MACH_BENCHMARK("Array<bool> scan sparse 1M") {
+	Array<bool> bits;
+	bits.set_len(bit_bench_len);
+	for (usize index = 0; index < bit_bench_len; index += bit_bench_stride) {
+		bits[index] = true;
+	}
+
+	bencher.set_items(bit_bench_len);
+	bencher.iter([&] {
+		usize sum = 0;
+		for (usize index = 0; index < bit_bench_len; index += 1) {
+			if (bits[index]) {
+				sum += index;
+			}
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("BitArray scan sparse 1M") {
+	BitArray<> bits(bit_bench_len);
+	for (usize index = 0; index < bit_bench_len; index += bit_bench_stride) {
+		bits.set(index);
+	}
+
+	bencher.set_items(bit_bench_len);
+	bencher.iter([&] {
+		usize sum = 0;
+		bits.for_each_set([&](usize index) { sum += index; });
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("BitArray::and_with 1M") {
+	BitArray<> a(bit_bench_len);
+	BitArray<> b(bit_bench_len);
+	a.set_all();
+	b.set_all();
+
+	bencher.set_items(bit_bench_len);
+	bencher.iter([&] {
+		a.and_with(b);
+		return a.as_words()[0];
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Math/SIMD.hpp>
+
+#include <bit>
+
+namespace Mach::Core {
+	inline constexpr usize bits_per_word = 64;
+
+	MACH_ALWAYS_INLINE constexpr usize bit_word_count(usize bits) { return (bits + bits_per_word - 1) / bits_per_word; }
+
+	// Mask of the bits at or above bit within a word
+	MACH_ALWAYS_INLINE constexpr u64 bit_word_mask_from(usize bit) { return ~0ull << (bit % bits_per_word); }
+
+	/**
+	 * Index of the first set bit at or after from, scanning count words. Whole zero words are skipped and the bit
+	 * within a word is found with countr_zero, which compiles down to tzcnt or rbit and clz.
+	 */
+	MACH_ALWAYS_INLINE inline Option<usize> bit_words_find_next_set(u64 const* words, usize count, usize from) {
+		usize word = from / bits_per_word;
+		if (word >= count) {
+			return nullopt;
+		}
+
+		u64 bits = words[word] & bit_word_mask_from(from);
+		while (bits == 0) {
+			word += 1;
+			if (word == count) {
+				return nullopt;
+			}
+			bits = words[word];
+		}
+		return word * bits_per_word + static_cast<usize>(std::countr_zero(bits));
+	}
+
+	MACH_ALWAYS_INLINE inline usize bit_words_count_ones(u64 const* words, usize count) {
+		usize result = 0;
+		for (usize index = 0; index < count; index += 1) {
+			result += static_cast<usize>(std::popcount(words[index]));
+		}
+		return result;
+	}
+
+	// Applies op to dst and src two words at a time, then to the odd word left over
+	template <typename Op>
+	MACH_ALWAYS_INLINE inline void bit_words_apply(u64* dst, u64 const* src, usize count, Op op) {
+		usize index = 0;
+		for (; index + 2 <= count; index += 2) {
+			const auto a = Math::u64x2::load_unaligned(dst + index);
+			const auto b = Math::u64x2::load_unaligned(src + index);
+			op(a, b).store_unaligned(dst + index);
+		}
+		for (; index < count; index += 1) {
+			dst[index] = op(dst[index], src[index]);
+		}
+	}
+
+	MACH_ALWAYS_INLINE inline void bit_words_and(u64* dst, u64 const* src, usize count) {
+		bit_words_apply(dst, src, count, [](auto a, auto b) { return a & b; });
+	}
+
+	MACH_ALWAYS_INLINE inline void bit_words_or(u64* dst, u64 const* src, usize count) {
+		bit_words_apply(dst, src, count, [](auto a, auto b) { return a | b; });
+	}
+
+	MACH_ALWAYS_INLINE inline void bit_words_and_not(u64* dst, u64 const* src, usize count) {
+		bit_words_apply(dst, src, count, []<typename W>(W a, W b) {
+			if constexpr (is_same<W, u64>) {
+				return a & ~b;
+			} else {
+				return a.and_not(b);
+			}
+		});
+	}
+
+	/**
+	 * Fixed length array of bits packed into u64 words. Scans skip a whole word of clear bits at a time and bulk
+	 * operations work two words per instruction where SIMD is available.
+	 *
+	 * Bits past len are always kept clear so counts and scans never need to mask the last word.
+	 */
+	template <ArrayAllocator Allocator = HeapAllocator>
+	class BitArray {
+	public:
+		BitArray() = default;
+		explicit BitArray(usize len) { set_len(len); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_len; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_empty() const { return m_len == 0; }
+
+		// Grows with clear bits or drops the bits past len
+		void set_len(usize len) {
+			m_words.set_len(bit_word_count(len));
+			m_len = len;
+			clear_unused();
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool get(usize index) const {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			return (m_words[index / bits_per_word] >> (index % bits_per_word) & 1) != 0;
+		}
+
+		MACH_ALWAYS_INLINE void set(usize index) {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			m_words[index / bits_per_word] |= 1ull << (index % bits_per_word);
+		}
+
+		MACH_ALWAYS_INLINE void clear(usize index) {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			m_words[index / bits_per_word] &= ~(1ull << (index % bits_per_word));
+		}
+
+		MACH_ALWAYS_INLINE void assign(usize index, bool value) {
+			if (value) {
+				set(index);
+			} else {
+				clear(index);
+			}
+		}
+
+		void set_all() {
+			if (m_words.is_empty()) {
+				return;
+			}
+			Memory::set(m_words.begin(), 0xFF, m_words.len() * sizeof(u64));
+			clear_unused();
+		}
+
+		void clear_all() {
+			if (m_words.is_empty()) {
+				return;
+			}
+			Memory::set(m_words.begin(), 0, m_words.len() * sizeof(u64));
+		}
+
+		MACH_NO_DISCARD usize count_ones() const { return bit_words_count_ones(m_words.begin(), m_words.len()); }
+
+		MACH_NO_DISCARD bool any() const {
+			for (const u64 word : m_words) {
+				if (word != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Option<usize> find_first_set() const { return find_next_set(0); }
+
+		// First set bit at or after from
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Option<usize> find_next_set(usize from) const {
+			return bit_words_find_next_set(m_words.begin(), m_words.len(), from);
+		}
+
+		MACH_NO_DISCARD Option<usize> find_first_clear() const {
+			for (usize word = 0; word < m_words.len(); word += 1) {
+				const u64 clear = ~m_words[word];
+				if (clear != 0) {
+					const usize result = word * bits_per_word + static_cast<usize>(std::countr_zero(clear));
+					if (result < m_len) {
+						return result;
+					}
+				}
+			}
+			return nullopt;
+		}
+
+		// Calls f with the index of every set bit in ascending order. f must not change this array.
+		template <typename F>
+		void for_each_set(F&& f) const {
+			for (usize word = 0; word < m_words.len(); word += 1) {
+				u64 bits = m_words[word];
+				while (bits != 0) {
+					f(word * bits_per_word + static_cast<usize>(std::countr_zero(bits)));
+					bits &= bits - 1;
+				}
+			}
+		}
+
+		// Bulk operations require both arrays to have the same len
+		template <ArrayAllocator OtherAllocator>
+		void and_with(const BitArray<OtherAllocator>& other) {
+			MACH_ASSERT(m_len == other.len(), "BitArray length mismatch");
+			bit_words_and(m_words.begin(), other.as_words().begin(), m_words.len());
+		}
+
+		template <ArrayAllocator OtherAllocator>
+		void or_with(const BitArray<OtherAllocator>& other) {
+			MACH_ASSERT(m_len == other.len(), "BitArray length mismatch");
+			bit_words_or(m_words.begin(), other.as_words().begin(), m_words.len());
+		}
+
+		// Clears every bit that is set in other
+		template <ArrayAllocator OtherAllocator>
+		void and_not_with(const BitArray<OtherAllocator>& other) {
+			MACH_ASSERT(m_len == other.len(), "BitArray length mismatch");
+			bit_words_and_not(m_words.begin(), other.as_words().begin(), m_words.len());
+		}
+
+		// True when every bit set in other is also set in this
+		template <ArrayAllocator OtherAllocator>
+		MACH_NO_DISCARD bool contains_all(const BitArray<OtherAllocator>& other) const {
+			MACH_ASSERT(m_len == other.len(), "BitArray length mismatch");
+			const auto other_words = other.as_words();
+			for (usize word = 0; word < m_words.len(); word += 1) {
+				if ((other_words[word] & ~m_words[word]) != 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<u64 const> as_words() const { return m_words.as_const_slice(); }
+
+	private:
+		void clear_unused() {
+			if (m_len % bits_per_word != 0) {
+				m_words[m_words.len() - 1] &= ~bit_word_mask_from(m_len);
+			}
+		}
+
+		Array<u64, Allocator> m_words;
+		usize m_len = 0;
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::BitArray;
+} // namespace Mach
@@ -6,6 +6,7 @@
 
 #include <Core/Containers/Function.hpp>
 
+#include <Core/Debug/Benchmark.hpp>
 #include <Core/Debug/Test.hpp>
 
 #if MACH_ENABLE_TEST
@@ -61,3 +62,28 @@ MACH_TEST_SUITE("Containers") {
 	}
 }
 #endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Function::call") {
+	using namespace Mach::Core;
+
+	u64 captured = 3;
+	const Function<u64(u64)> f = [captured](u64 x) { return x * captured; };
+	u64 x = 1;
+	bencher.iter([&] {
+		do_not_optimize(x);
+		return f(x);
+	});
+}
+
+MACH_BENCHMARK("Function::create") {
+	using namespace Mach::Core;
+
+	u64 captured = 3;
+	bencher.iter([&] {
+		do_not_optimize(captured);
+		Function<u64(u64)> f = [captured](u64 x) { return x * captured; };
+		return f(1);
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -5,6 +5,7 @@
  */
 
 #include <Core/Containers/HashMap.hpp>
+#include <Core/Debug/Benchmark.hpp>
 #include <Core/Debug/Test.hpp>
 
 #if MACH_ENABLE_TEST
@@ -42,3 +43,37 @@ MACH_TEST_SUITE("Containers") {
 	}
 }
 #endif
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("HashMap::insert") {
+	using namespace Mach::Core;
+
+	bencher.set_items(1024);
+	bencher.iter([] {
+		HashMap<u64, u64> map;
+		for (u64 i = 0; i < 1024; i += 1) {
+			map.insert(i, i);
+		}
+		return map.len();
+	});
+}
+
+MACH_BENCHMARK("HashMap::find") {
+	using namespace Mach::Core;
+
+	HashMap<u64, u64> map;
+	for (u64 i = 0; i < 1024; i += 1) {
+		map.insert(i * 7, i);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&map] {
+		u64 found = 0;
+		for (u64 i = 0; i < 1024; i += 1) {
+			// Every other lookup misses
+			found += map.find(i * 7 + (i & 1)).is_set() ? 1 : 0;
+		}
+		return found;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -23,13 +23,13 @@ namespace Mach::Core {
 			requires Movable<Value>
 		{
 			m_buckets.push(Bucket{ .key = key, .value = Mach::forward<Value>(value) });
-			refresh_layout();
+			link_last();
 		}
 		void insert(const Key& key, const Value& value)
 			requires CopyConstructible<Value>
 		{
 			m_buckets.push(Bucket{ .key = key, .value = value });
-			refresh_layout();
+			link_last();
 		}
 
 		Option<Value> remove(const Key& key) {
@@ -97,7 +97,7 @@ namespace Mach::Core {
 				return nullopt;
 			}
 
-			const auto* bucket = &m_buckets[mapped];
+			const auto* bucket = &m_buckets[mapped.unwrap()];
 			while (true) {
 				if (bucket->key == key) return bucket->value;
 				if (!bucket->next.is_set()) break;
@@ -114,33 +114,45 @@ namespace Mach::Core {
 			return hasher.finish() % m_layout.len();
 		}
 
+		// Links the bucket that was just pushed. The layout keeps spare slots and is only rebuilt once they run out, so
+		// inserts stay amortized constant time.
+		void link_last() {
+			if (m_buckets.len() > m_layout.len()) {
+				refresh_layout();
+				return;
+			}
+			link(m_buckets.len() - 1);
+		}
+
 		void refresh_layout() {
 			m_layout.reset();
-			m_layout.set_len(m_buckets.len());
+			m_layout.set_len(m_buckets.len() * 2);
 
 			// Layout buckets by hash(key) & buckets.len() and build tree if collision
 			// detected
 			for (usize i = 0; i < m_buckets.len(); ++i) {
-				auto& bucket = m_buckets[i];
-
-				const auto layout_index = key_to_layout_index(bucket.key);
-				bucket.next = nullopt;
-
-				// Check what index lies in the layout array
-				auto& found = m_layout[layout_index];
-
-				// If its invalid then simply set the bucket index
-				if (!found.is_set()) {
-					found = i;
-				} else {
-					// If its valid then descend the bucket tree until an empty spot is
-					// found
-					auto* other = &m_buckets[found.unwrap()];
-					while (other->next.is_set()) {
-						other = &m_buckets[other->next.unwrap()];
-					}
-					other->next = i;
+				m_buckets[i].next = nullopt;
+				link(i);
+			}
+		}
+
+		void link(usize i) {
+			const auto layout_index = key_to_layout_index(m_buckets[i].key);
+
+			// Check what index lies in the layout array
+			auto& found = m_layout[layout_index];
+
+			// If its invalid then simply set the bucket index
+			if (!found.is_set()) {
+				found = i;
+			} else {
+				// If its valid then descend the bucket tree until an empty spot is
+				// found
+				auto* other = &m_buckets[found.unwrap()];
+				while (other->next.is_set()) {
+					other = &m_buckets[other->next.unwrap()];
 				}
+				other->next = i;
 			}
 		}
 
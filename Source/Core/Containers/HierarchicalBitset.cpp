@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/HierarchicalBitset.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach::Core;
+	MACH_TEST_CASE("HierarchicalBitset") {
+		MACH_SUBCASE("set and clear") {
+			HierarchicalBitset bits(10000);
+			MACH_CHECK(!bits.any());
+
+			bits.set(5);
+			bits.set(6);
+			MACH_CHECK(bits.get(5));
+			MACH_CHECK(bits.count_ones() == 2);
+
+			// Clearing one bit of a leaf must keep the summary bit for the other
+			bits.clear(5);
+			MACH_CHECK(bits.any());
+			MACH_CHECK(bits.find_first_set().unwrap() == 6);
+			bits.clear(6);
+			MACH_CHECK(!bits.any());
+			MACH_CHECK(!bits.find_first_set().is_set());
+		}
+
+		MACH_SUBCASE("scans across summary words") {
+			HierarchicalBitset bits(20000);
+			bits.set(1);
+			bits.set(4095);
+			bits.set(4096);
+			bits.set(19999);
+
+			MACH_CHECK(bits.find_next_set(0).unwrap() == 1);
+			MACH_CHECK(bits.find_next_set(2).unwrap() == 4095);
+			MACH_CHECK(bits.find_next_set(4096).unwrap() == 4096);
+			MACH_CHECK(bits.find_next_set(4097).unwrap() == 19999);
+			MACH_CHECK(!bits.find_next_set(20000).is_set());
+
+			Array<usize> visited;
+			bits.for_each_set([&](usize index) { visited.push(index); });
+			MACH_REQUIRE(visited.len() == 4);
+			MACH_CHECK(visited[1] == 4095);
+			MACH_CHECK(visited[3] == 19999);
+
+			bits.clear_all();
+			MACH_CHECK(!bits.any());
+			MACH_CHECK(bits.count_ones() == 0);
+		}
+
+		MACH_SUBCASE("pop_first as a free list") {
+			HierarchicalBitset free_slots(300);
+			free_slots.set(250);
+			free_slots.set(10);
+			free_slots.set(128);
+
+			MACH_CHECK(free_slots.pop_first().unwrap() == 10);
+			MACH_CHECK(free_slots.pop_first().unwrap() == 128);
+			MACH_CHECK(free_slots.pop_first().unwrap() == 250);
+			MACH_CHECK(!free_slots.pop_first().is_set());
+		}
+
+		MACH_SUBCASE("bulk operations keep the summary in sync") {
+			HierarchicalBitset a(9000);
+			HierarchicalBitset b(9000);
+			a.set(100);
+			a.set(5000);
+			b.set(5000);
+			b.set(8999);
+
+			HierarchicalBitset both = a;
+			both.and_with(b);
+			MACH_CHECK(both.find_first_set().unwrap() == 5000);
+			MACH_CHECK(!both.find_next_set(5001).is_set());
+
+			HierarchicalBitset either = a;
+			either.or_with(b);
+			MACH_CHECK(either.count_ones() == 3);
+			MACH_CHECK(either.find_next_set(5001).unwrap() == 8999);
+
+			HierarchicalBitset only_a = a;
+			only_a.and_not_with(b);
+			MACH_CHECK(only_a.find_first_set().unwrap() == 100);
+			MACH_CHECK(!only_a.find_next_set(101).is_set());
+		}
+
+		MACH_SUBCASE("set_len") {
+			HierarchicalBitset bits(100);
+			bits.set(99);
+			bits.set_len(99);
+			MACH_CHECK(!bits.any());
+			bits.set_len(5000);
+			MACH_CHECK(!bits.find_first_set().is_set());
+			bits.set(4999);
+			MACH_CHECK(bits.find_first_set().unwrap() == 4999);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("HierarchicalBitset scan sparse 1M") {
+	using namespace Mach::Core;
+
+	constexpr usize len = 1024 * 1024;
+	HierarchicalBitset bits(len);
+	for (usize index = 0; index < len; index += 4096) {
+		bits.set(index);
+	}
+
+	bencher.set_items(len);
+	bencher.iter([&] {
+		usize sum = 0;
+		for (auto index = bits.find_first_set(); index; index = bits.find_next_set(index.as_const_ref().unwrap() + 1)) {
+			sum += index.as_const_ref().unwrap();
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
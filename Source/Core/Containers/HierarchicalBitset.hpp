@@ -0,0 +1,185 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/BitArray.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Bitset with a summary word over every 64 leaf words. A summary bit is set exactly when its leaf word has any bit
+	 * set, so a scan skips 4096 clear bits per summary word and finding the next set bit in a sparse set stays cheap.
+	 *
+	 * Suited to sets that are mostly empty and scanned often, like free slots or dirty flags. Setting and clearing a
+	 * bit touches at most one leaf word and one summary word.
+	 */
+	class HierarchicalBitset {
+	public:
+		HierarchicalBitset() = default;
+		explicit HierarchicalBitset(usize len) { set_len(len); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_len; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_empty() const { return m_len == 0; }
+
+		// Grows with clear bits or drops the bits past len
+		void set_len(usize len) {
+			m_leaves.set_len(bit_word_count(len));
+			m_summary.set_len(bit_word_count(m_leaves.len()));
+			m_len = len;
+			if (len % bits_per_word != 0) {
+				m_leaves[m_leaves.len() - 1] &= ~bit_word_mask_from(len);
+			}
+			rebuild_summary();
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool get(usize index) const {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			return (m_leaves[index / bits_per_word] >> (index % bits_per_word) & 1) != 0;
+		}
+
+		MACH_ALWAYS_INLINE void set(usize index) {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			const usize leaf = index / bits_per_word;
+			m_leaves[leaf] |= 1ull << (index % bits_per_word);
+			m_summary[leaf / bits_per_word] |= 1ull << (leaf % bits_per_word);
+		}
+
+		MACH_ALWAYS_INLINE void clear(usize index) {
+			MACH_ASSERT(index < m_len, "Index out of bounds");
+			const usize leaf = index / bits_per_word;
+			u64& word = m_leaves[leaf];
+			word &= ~(1ull << (index % bits_per_word));
+			if (word == 0) {
+				m_summary[leaf / bits_per_word] &= ~(1ull << (leaf % bits_per_word));
+			}
+		}
+
+		MACH_ALWAYS_INLINE void assign(usize index, bool value) {
+			if (value) {
+				set(index);
+			} else {
+				clear(index);
+			}
+		}
+
+		// Only touches the leaf words that have bits set
+		void clear_all() {
+			for (usize summary = 0; summary < m_summary.len(); summary += 1) {
+				u64 bits = m_summary[summary];
+				while (bits != 0) {
+					m_leaves[summary * bits_per_word + static_cast<usize>(std::countr_zero(bits))] = 0;
+					bits &= bits - 1;
+				}
+				m_summary[summary] = 0;
+			}
+		}
+
+		MACH_NO_DISCARD usize count_ones() const { return bit_words_count_ones(m_leaves.begin(), m_leaves.len()); }
+
+		MACH_NO_DISCARD bool any() const {
+			for (const u64 word : m_summary) {
+				if (word != 0) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Option<usize> find_first_set() const { return find_next_set(0); }
+
+		// First set bit at or after from
+		MACH_NO_DISCARD Option<usize> find_next_set(usize from) const {
+			const usize leaf = from / bits_per_word;
+			if (leaf >= m_leaves.len()) {
+				return nullopt;
+			}
+
+			const u64 bits = m_leaves[leaf] & bit_word_mask_from(from);
+			if (bits != 0) {
+				return leaf * bits_per_word + static_cast<usize>(std::countr_zero(bits));
+			}
+
+			// The summary says which of the following leaves has the next set bit
+			const auto next_leaf = bit_words_find_next_set(m_summary.begin(), m_summary.len(), leaf + 1);
+			if (!next_leaf) {
+				return nullopt;
+			}
+			const usize next = next_leaf.as_const_ref().unwrap();
+			return next * bits_per_word + static_cast<usize>(std::countr_zero(m_leaves[next]));
+		}
+
+		// Clears and returns the lowest set bit. Handy as a free list of indices.
+		Option<usize> pop_first() {
+			auto result = find_first_set();
+			if (result) {
+				clear(result.as_const_ref().unwrap());
+			}
+			return result;
+		}
+
+		// Calls f with the index of every set bit in ascending order. f must not change this set.
+		template <typename F>
+		void for_each_set(F&& f) const {
+			for (usize summary = 0; summary < m_summary.len(); summary += 1) {
+				u64 leaves = m_summary[summary];
+				while (leaves != 0) {
+					const usize leaf = summary * bits_per_word + static_cast<usize>(std::countr_zero(leaves));
+					u64 bits = m_leaves[leaf];
+					while (bits != 0) {
+						f(leaf * bits_per_word + static_cast<usize>(std::countr_zero(bits)));
+						bits &= bits - 1;
+					}
+					leaves &= leaves - 1;
+				}
+			}
+		}
+
+		// Bulk operations require both sets to have the same len
+		void and_with(const HierarchicalBitset& other) {
+			MACH_ASSERT(m_len == other.m_len, "HierarchicalBitset length mismatch");
+			bit_words_and(m_leaves.begin(), other.m_leaves.begin(), m_leaves.len());
+			rebuild_summary();
+		}
+
+		void or_with(const HierarchicalBitset& other) {
+			MACH_ASSERT(m_len == other.m_len, "HierarchicalBitset length mismatch");
+			bit_words_or(m_leaves.begin(), other.m_leaves.begin(), m_leaves.len());
+			// A leaf is non zero after an or exactly when it was in either set
+			bit_words_or(m_summary.begin(), other.m_summary.begin(), m_summary.len());
+		}
+
+		// Clears every bit that is set in other
+		void and_not_with(const HierarchicalBitset& other) {
+			MACH_ASSERT(m_len == other.m_len, "HierarchicalBitset length mismatch");
+			bit_words_and_not(m_leaves.begin(), other.m_leaves.begin(), m_leaves.len());
+			rebuild_summary();
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<u64 const> as_words() const { return m_leaves.as_const_slice(); }
+
+	private:
+		void rebuild_summary() {
+			for (usize summary = 0; summary < m_summary.len(); summary += 1) {
+				const usize first = summary * bits_per_word;
+				const usize end = first + bits_per_word < m_leaves.len() ? first + bits_per_word : m_leaves.len();
+
+				u64 bits = 0;
+				for (usize leaf = first; leaf < end; leaf += 1) {
+					bits |= static_cast<u64>(m_leaves[leaf] != 0) << (leaf - first);
+				}
+				m_summary[summary] = bits;
+			}
+		}
+
+		Array<u64> m_leaves;
+		Array<u64> m_summary;
+		usize m_len = 0;
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::HierarchicalBitset;
+} // namespace Mach
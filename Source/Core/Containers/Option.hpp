@@ -27,8 +27,16 @@ namespace Mach::Core {
 	template <typename T>
 	class Option;
 
+	// Types with a bit pattern they never use can lend it to Option, which then marks itself unset with that pattern
+	// instead of a separate flag. Specializations set available and implement set_none and is_none on raw storage the
+	// size of T.
 	template <typename T>
-		requires(!is_trivially_copyable<T> && !is_reference<T>)
+	struct Niche {
+		static constexpr bool available = false;
+	};
+
+	template <typename T>
+		requires(!is_trivially_copyable<T> && !is_reference<T> && !Niche<T>::available)
 	class Option<T> {
 	public:
 		// Constructors
@@ -201,7 +209,7 @@ namespace Mach::Core {
 	};
 
 	template <typename T>
-		requires is_trivially_copyable<T>
+		requires(is_trivially_copyable<T> && !Niche<T>::available)
 	class Option<T> {
 	public:
 		Option() = default;
@@ -295,6 +303,134 @@ namespace Mach::Core {
 		alignas(T) u8 m_data[sizeof(T)] = {};
 	};
 
+	template <typename T>
+		requires(Niche<T>::available && !is_reference<T>)
+	class Option<T> {
+	public:
+		MACH_ALWAYS_INLINE Option() { Niche<T>::set_none(m_data); }
+		MACH_ALWAYS_INLINE Option(NullOpt) : Option() {}
+		MACH_ALWAYS_INLINE Option(T&& t)
+			requires MoveConstructible<T>
+		{
+			Memory::emplace<T>(m_data, Mach::forward<T>(t));
+		}
+		MACH_ALWAYS_INLINE Option(const T& t)
+			requires CopyConstructible<T>
+		{
+			Memory::emplace<T>(m_data, t);
+		}
+
+		MACH_ALWAYS_INLINE Option& operator=(T&& t)
+			requires MoveConstructible<T>
+		{
+			reset();
+			Memory::emplace<T>(m_data, Mach::forward<T>(t));
+			return *this;
+		}
+		MACH_ALWAYS_INLINE Option& operator=(const T& t)
+			requires CopyConstructible<T>
+		{
+			reset();
+			Memory::emplace<T>(m_data, t);
+			return *this;
+		}
+
+		MACH_ALWAYS_INLINE Option(const Option& copy)
+			requires CopyConstructible<T>
+		{
+			if (copy.is_set()) {
+				Memory::emplace<T>(m_data, *copy.ptr());
+			} else {
+				Niche<T>::set_none(m_data);
+			}
+		}
+		MACH_ALWAYS_INLINE Option& operator=(const Option& copy)
+			requires CopyConstructible<T>
+		{
+			if (this != &copy) {
+				reset();
+				if (copy.is_set()) {
+					Memory::emplace<T>(m_data, *copy.ptr());
+				}
+			}
+			return *this;
+		}
+
+		MACH_ALWAYS_INLINE Option(Option&& move) noexcept {
+			if (move.is_set()) {
+				Memory::emplace<T>(m_data, Mach::move(*move.ptr()));
+				move.reset();
+			} else {
+				Niche<T>::set_none(m_data);
+			}
+		}
+		MACH_ALWAYS_INLINE Option& operator=(Option&& move) noexcept {
+			if (this != &move) {
+				reset();
+				if (move.is_set()) {
+					Memory::emplace<T>(m_data, Mach::move(*move.ptr()));
+					move.reset();
+				}
+			}
+			return *this;
+		}
+
+		MACH_ALWAYS_INLINE ~Option() { reset(); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_set() const { return !Niche<T>::is_none(m_data); }
+		MACH_ALWAYS_INLINE explicit operator bool() const { return is_set(); }
+
+		MACH_ALWAYS_INLINE T unwrap() {
+			MACH_ASSERT(is_set(), "Value must be set to be unwrapped");
+			T result = Mach::move(*ptr());
+			reset();
+			return result;
+		}
+
+		MACH_ALWAYS_INLINE T unwrap_or_default()
+			requires is_default_constructible<T>
+		{
+			if (is_set()) {
+				return unwrap();
+			}
+			return T{};
+		}
+
+		MACH_ALWAYS_INLINE T unwrap_or(T&& t) {
+			if (is_set()) {
+				return unwrap();
+			}
+			return Mach::move(t);
+		}
+
+		MACH_ALWAYS_INLINE Option<T&> as_ref() {
+			if (is_set()) {
+				return Option<T&>{ *ptr() };
+			}
+			return nullopt;
+		}
+
+		MACH_ALWAYS_INLINE Option<T const&> as_const_ref() const {
+			if (is_set()) {
+				return Option<T const&>{ *ptr() };
+			}
+			return nullopt;
+		}
+
+	private:
+		MACH_ALWAYS_INLINE T* ptr() { return reinterpret_cast<T*>(&m_data[0]); }
+		MACH_ALWAYS_INLINE T const* ptr() const { return reinterpret_cast<T const*>(&m_data[0]); }
+
+		MACH_ALWAYS_INLINE void reset() {
+			if (is_set()) {
+				ptr()->~T();
+				Niche<T>::set_none(m_data);
+			}
+		}
+
+		alignas(T) u8 m_data[sizeof(T)];
+	};
+
 	template <typename T>
 		requires is_reference<T>
 	class Option<T> {
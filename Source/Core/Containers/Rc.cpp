@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Async/Thread.hpp>
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/Rc.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach;
+
+	class Counted : public RcCounted<Counted> {
+	public:
+		explicit Counted(int value, int& destroyed) : value(value), m_destroyed(&destroyed) {}
+		~Counted() { *m_destroyed += 1; }
+
+		int value;
+
+	private:
+		int* m_destroyed;
+	};
+
+	class SharedCounted : public ArcCounted<SharedCounted> {
+	public:
+		explicit SharedCounted(Core::Atomic<u32>& destroyed) : m_destroyed(&destroyed) {}
+		~SharedCounted() {
+			const auto unused = m_destroyed->fetch_add(1);
+			MACH_UNUSED(unused);
+		}
+
+	private:
+		Core::Atomic<u32>* m_destroyed;
+	};
+
+	MACH_TEST_CASE("Rc") {
+		MACH_SUBCASE("copy and destroy") {
+			int destroyed = 0;
+			{
+				const auto rc = Rc<Counted>::create(100, destroyed);
+				MACH_CHECK(rc->value == 100);
+				MACH_CHECK(rc.strong() == 1);
+				{
+					const auto copy = rc;
+					MACH_CHECK(rc.strong() == 2);
+					MACH_CHECK(&*copy == &*rc);
+				}
+				MACH_CHECK(rc.strong() == 1);
+				MACH_CHECK(destroyed == 0);
+			}
+			MACH_CHECK(destroyed == 1);
+		}
+
+		MACH_SUBCASE("assignment") {
+			int destroyed = 0;
+			auto a = Rc<Counted>::create(1, destroyed);
+			const auto b = Rc<Counted>::create(2, destroyed);
+			a = b;
+			MACH_CHECK(destroyed == 1);
+			MACH_CHECK(b.strong() == 2);
+			a = a;
+			MACH_CHECK(b.strong() == 2);
+
+			auto c = Mach::move(a);
+			MACH_CHECK(a.is_null());
+			MACH_CHECK(b.strong() == 2);
+			c = Rc<Counted>{};
+			MACH_CHECK(b.strong() == 1);
+		}
+
+		MACH_SUBCASE("ref borrows without counting") {
+			int destroyed = 0;
+			const auto rc = Rc<Counted>::create(5, destroyed);
+			const Ref<Counted> ref = rc;
+			MACH_CHECK(rc.strong() == 1);
+			MACH_CHECK(ref->value == 5);
+
+			// The count lives in the object, so a borrow can become an owner again
+			const auto owned = ref.to_rc();
+			MACH_CHECK(rc.strong() == 2);
+			MACH_CHECK(&*owned == &*rc);
+		}
+
+		MACH_SUBCASE("copied objects start with their own count") {
+			int destroyed = 0;
+			const auto rc = Rc<Counted>::create(7, destroyed);
+			const auto copy = Rc<Counted>::create(*rc);
+			MACH_CHECK(copy.strong() == 1);
+			MACH_CHECK(copy->value == 7);
+		}
+
+		MACH_SUBCASE("shared between threads") {
+			Core::Atomic<u32> destroyed{ 0 };
+			{
+				const auto arc = Arc<SharedCounted>::create(destroyed);
+				Core::Array<SharedPtr<Core::Thread>> threads;
+				for (u32 index = 0; index < 4; index += 1) {
+					threads.push(Core::Thread::spawn([arc] {
+						for (u32 i = 0; i < 10000; i += 1) {
+							const auto copy = arc;
+							MACH_UNUSED(copy);
+						}
+					}));
+				}
+				for (auto& thread : threads) {
+					thread.unsafe_get_mut().join();
+				}
+				threads = {};
+				MACH_CHECK(arc.strong() == 1);
+			}
+			MACH_CHECK(destroyed.load() == 1);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	class BenchCounted : public Mach::ArcCounted<BenchCounted> {
+	public:
+		Mach::u64 value = 0;
+	};
+
+	struct BenchShared {
+		Mach::u64 value = 0;
+	};
+
+	template <typename P>
+	void bench_contended_copies(Mach::Core::Bencher& bencher, const P& ptr) {
+		using namespace Mach::Core;
+
+		static constexpr u32 thread_count = 4;
+		static constexpr u32 per_thread = 4096;
+
+		bencher.set_items(thread_count * per_thread);
+		bencher.iter([&ptr] {
+			Array<Mach::SharedPtr<Thread>> threads;
+			for (u32 index = 0; index < thread_count; index += 1) {
+				threads.push(Thread::spawn([&ptr] {
+					for (u32 i = 0; i < per_thread; i += 1) {
+						const P copy = ptr;
+						MACH_UNUSED(copy);
+					}
+				}));
+			}
+			for (auto& thread : threads) {
+				thread.unsafe_get_mut().join();
+			}
+		});
+	}
+} // namespace
+
+MACH_BENCHMARK("SharedPtr copy") {
+	using namespace Mach;
+
+	const auto shared = SharedPtr<BenchShared>::create();
+	bencher.set_items(1024);
+	bencher.iter([&shared] {
+		u64 sum = 0;
+		for (u32 i = 0; i < 1024; i += 1) {
+			const auto copy = shared;
+			sum += copy->value;
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("Arc copy") {
+	using namespace Mach;
+
+	const auto arc = Arc<BenchCounted>::create();
+	bencher.set_items(1024);
+	bencher.iter([&arc] {
+		u64 sum = 0;
+		for (u32 i = 0; i < 1024; i += 1) {
+			const auto copy = arc;
+			sum += copy->value;
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("SharedPtr copy contended 4 threads") {
+	bench_contended_copies(bencher, Mach::SharedPtr<BenchShared>::create());
+}
+
+MACH_BENCHMARK("Arc copy contended 4 threads") { bench_contended_copies(bencher, Mach::Arc<BenchCounted>::create()); }
+#endif // MACH_ENABLE_BENCHMARK
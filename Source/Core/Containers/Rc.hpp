@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/SharedPtr.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Base for objects that carry their own reference count, shared by every Rc pointing at them. T must derive from
+	 * RefCounted<T, Type>. Unlike SharedPtr there is no separate counter allocation and no weak count, and since the
+	 * count is found through the object itself a plain T* or Ref<T> can be turned back into an owning Rc.
+	 *
+	 * SharedType::Atomic makes the count safe to share between threads. Copies only pay a relaxed increment and only
+	 * the final release synchronizes.
+	 */
+	template <typename T, SharedType Type>
+	class RefCounted {
+	public:
+		static constexpr SharedType shared_type = Type;
+
+		RefCounted() = default;
+
+		// Copying an object must not copy how many owners it has
+		RefCounted(const RefCounted&) : RefCounted() {}
+		RefCounted& operator=(const RefCounted&) { return *this; }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 strong() const { return m_counter.strong(); }
+
+	private:
+		template <typename>
+		friend class Rc;
+
+		template <typename>
+		friend class Ref;
+
+		SharedCounter<Type> m_counter;
+	};
+
+	template <typename T>
+	concept IntrusivelyCounted = DerivedFrom<T, RefCounted<T, T::shared_type>>;
+
+	template <typename T>
+	class Ref;
+
+	/**
+	 * Owning pointer to a RefCounted object. Objects shared between threads follow SharedPtr and only hand out const
+	 * access.
+	 */
+	template <typename T>
+	class Rc {
+	public:
+		static constexpr SharedType shared_type = T::shared_type;
+
+		explicit Rc() = default;
+
+		template <typename... Args>
+		static Rc create(Args&&... args)
+			requires ConstructibleFrom<T, Args...>
+		{
+			static_assert(IntrusivelyCounted<T>, "T must derive from RefCounted<T, Type>");
+
+			// The count starts at 1, which becomes the reference this Rc owns
+			auto memory = Memory::alloc(Memory::Layout::single<T>());
+			T* const ptr = static_cast<T*>(*memory);
+			Memory::emplace<T>(ptr, Mach::forward<Args>(args)...);
+			return Rc(ptr);
+		}
+
+		Rc(const Rc& copy) noexcept : m_ptr(copy.m_ptr) {
+			if (m_ptr) {
+				counter().add_strong();
+			}
+		}
+		Rc& operator=(const Rc& copy) noexcept {
+			// Read copy before releasing as it may be this
+			T* const ptr = copy.m_ptr;
+			if (ptr) {
+				ptr->RefCounted<T, shared_type>::m_counter.add_strong();
+			}
+			release();
+			m_ptr = ptr;
+			return *this;
+		}
+
+		Rc(Rc&& move) noexcept : m_ptr(move.m_ptr) { move.m_ptr = nullptr; }
+		Rc& operator=(Rc&& move) noexcept {
+			T* const ptr = move.m_ptr;
+			move.m_ptr = nullptr;
+			release();
+			m_ptr = ptr;
+			return *this;
+		}
+
+		~Rc() { release(); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_valid() const { return m_ptr != nullptr; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_null() const { return m_ptr == nullptr; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 strong() const { return m_ptr != nullptr ? counter().strong() : 0; }
+
+		// Borrows the object without touching the count. The Ref must not outlive this Rc.
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Ref<T> as_ref() const { return Ref<T>(*m_ptr); }
+
+		// Non Atomic Accessors
+		MACH_ALWAYS_INLINE T* operator->() const
+			requires(shared_type == SharedType::NonAtomic)
+		{
+			return m_ptr;
+		}
+		MACH_ALWAYS_INLINE T& operator*() const
+			requires(shared_type == SharedType::NonAtomic)
+		{
+			return *m_ptr;
+		}
+
+		// Atomic Accessors are const only
+		MACH_NO_DISCARD T& unsafe_get_mut() const
+			requires(shared_type == SharedType::Atomic)
+		{
+			return *m_ptr;
+		}
+		MACH_ALWAYS_INLINE T const* operator->() const
+			requires(shared_type == SharedType::Atomic)
+		{
+			return m_ptr;
+		}
+		MACH_ALWAYS_INLINE T const& operator*() const
+			requires(shared_type == SharedType::Atomic)
+		{
+			return *m_ptr;
+		}
+
+	private:
+		template <typename>
+		friend class Ref;
+
+		explicit Rc(T* ptr) : m_ptr(ptr) {}
+
+		MACH_ALWAYS_INLINE SharedCounter<shared_type> const& counter() const {
+			return m_ptr->RefCounted<T, shared_type>::m_counter;
+		}
+
+		void release() {
+			if (m_ptr == nullptr) {
+				return;
+			}
+			if (counter().remove_strong() == 1) {
+				shared_acquire_fence<shared_type>();
+				m_ptr->~T();
+				Memory::free(m_ptr);
+			}
+			m_ptr = nullptr;
+		}
+
+		T* m_ptr = nullptr;
+	};
+
+	// Reads better at use sites that cross threads. Only valid for objects counted with SharedType::Atomic.
+	template <typename T>
+		requires(T::shared_type == SharedType::Atomic)
+	using Arc = Rc<T>;
+
+	/**
+	 * Borrowed pointer to a RefCounted object. Passing a Ref costs nothing, as the count is only touched when to_rc is
+	 * called to keep the object around past the borrow.
+	 */
+	template <typename T>
+	class Ref {
+	public:
+		static constexpr SharedType shared_type = T::shared_type;
+
+		explicit Ref(T& value) : m_ptr(&value) {}
+		Ref(const Rc<T>& rc) : m_ptr(rc.m_ptr) { MACH_ASSERT(m_ptr != nullptr, "Can not borrow a null Rc"); }
+
+		MACH_NO_DISCARD Rc<T> to_rc() const {
+			m_ptr->RefCounted<T, shared_type>::m_counter.add_strong();
+			return Rc<T>(m_ptr);
+		}
+
+		// Non Atomic Accessors
+		MACH_ALWAYS_INLINE T* operator->() const
+			requires(shared_type == SharedType::NonAtomic)
+		{
+			return m_ptr;
+		}
+		MACH_ALWAYS_INLINE T& operator*() const
+			requires(shared_type == SharedType::NonAtomic)
+		{
+			return *m_ptr;
+		}
+
+		// Atomic Accessors are const only
+		MACH_ALWAYS_INLINE T const* operator->() const
+			requires(shared_type == SharedType::Atomic)
+		{
+			return m_ptr;
+		}
+		MACH_ALWAYS_INLINE T const& operator*() const
+			requires(shared_type == SharedType::Atomic)
+		{
+			return *m_ptr;
+		}
+
+	private:
+		T* m_ptr;
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::Arc;
+	using Core::Rc;
+	using Core::Ref;
+
+	// Base for objects owned through Rc on a single thread
+	template <typename T>
+	using RcCounted = Core::RefCounted<T, Core::SharedType::NonAtomic>;
+
+	// Base for objects owned through Arc from any thread
+	template <typename T>
+	using ArcCounted = Core::RefCounted<T, Core::SharedType::Atomic>;
+} // namespace Mach
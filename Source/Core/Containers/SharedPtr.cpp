@@ -120,6 +120,27 @@ MACH_TEST_SUITE("Containers") {
 			MACH_CHECK(shared.weak() == 0);
 		}
 
+		MACH_SUBCASE("weak outlives strong") {
+			auto shared = SharedPtr<int>::create(100);
+			const auto weak = shared.downgrade();
+			shared = SharedPtr<int>{};
+			MACH_CHECK(shared.is_null());
+			MACH_CHECK(weak.strong() == 0);
+			MACH_CHECK(weak.weak() == 1);
+			MACH_CHECK(!weak.upgrade().is_set());
+		}
+
+		MACH_SUBCASE("copy assignment releases the old value") {
+			auto a = SharedPtr<int>::create(1);
+			const auto b = SharedPtr<int>::create(2);
+			const auto weak = a.downgrade();
+			a = b;
+			MACH_CHECK(!weak.upgrade().is_set());
+			MACH_CHECK(b.strong() == 2);
+			a = a;
+			MACH_CHECK(b.strong() == 2);
+		}
+
 		MACH_SUBCASE("SharedPtrFromThis") {
 			class Test : public SharedPtrFromThis<Test> {
 			public:
@@ -22,6 +22,9 @@ namespace Mach::Core {
 	template <typename Base, SharedType Type>
 	class WeakPtr;
 
+	template <typename T, SharedType Type>
+	class SharedPtrFromThis;
+
 	template <>
 	class SharedCounter<SharedType::NonAtomic> {
 	public:
@@ -39,6 +42,14 @@ namespace Mach::Core {
 			return m_strong + 1;
 		}
 
+		MACH_ALWAYS_INLINE bool try_add_strong() const {
+			if (m_strong == 0) {
+				return false;
+			}
+			m_strong += 1;
+			return true;
+		}
+
 		MACH_ALWAYS_INLINE u32 add_weak() const {
 			m_weak += 1;
 			return m_weak - 1;
@@ -50,7 +61,8 @@ namespace Mach::Core {
 
 	private:
 		mutable u32 m_strong = 1;
-		mutable u32 m_weak = 0;
+		// Starts at 1 for the weak reference all strong references share. See SharedCounter<SharedType::Atomic>.
+		mutable u32 m_weak = 1;
 	};
 
 	template <>
@@ -61,17 +73,45 @@ namespace Mach::Core {
 		MACH_ALWAYS_INLINE u32 strong() const { return m_strong.load(Order::Acquire); }
 		MACH_ALWAYS_INLINE u32 weak() const { return m_weak.load(Order::Acquire); }
 
-		MACH_ALWAYS_INLINE u32 add_strong() const { return m_strong.fetch_add(1, Order::AcqRel); }
-		MACH_ALWAYS_INLINE u32 remove_strong() const { return m_strong.fetch_sub(1, Order::AcqRel); }
+		// A new reference can only be made from an existing one, which already keeps the object alive, so adding needs no
+		// ordering. Removing releases so that whoever drops the last reference can acquire every other owner's writes
+		// before destroying the object.
+		MACH_ALWAYS_INLINE u32 add_strong() const { return m_strong.fetch_add(1, Order::Relaxed); }
+		MACH_ALWAYS_INLINE u32 remove_strong() const { return m_strong.fetch_sub(1, Order::Release); }
+
+		// Used by WeakPtr::upgrade, which may race with the last strong reference going away
+		MACH_ALWAYS_INLINE bool try_add_strong() const {
+			u32 strong = m_strong.load(Order::Relaxed);
+			while (strong != 0) {
+				const auto exchanged = m_strong.compare_exchange_weak(strong, strong + 1, Order::Acquire);
+				if (exchanged.is_set()) {
+					return true;
+				}
+				strong = m_strong.load(Order::Relaxed);
+			}
+			return false;
+		}
 
-		MACH_ALWAYS_INLINE u32 add_weak() const { return m_weak.fetch_add(1, Order::AcqRel); }
-		MACH_ALWAYS_INLINE u32 remove_weak() const { return m_weak.fetch_sub(1, Order::AcqRel); }
+		MACH_ALWAYS_INLINE u32 add_weak() const { return m_weak.fetch_add(1, Order::Relaxed); }
+		MACH_ALWAYS_INLINE u32 remove_weak() const { return m_weak.fetch_sub(1, Order::Release); }
 
 	private:
 		Atomic<u32> m_strong{ 1 };
-		Atomic<u32> m_weak{ 0 };
+		// Every strong reference together holds one weak reference, dropped by the last of them once the object is
+		// destroyed. Whoever takes the weak count to zero frees the memory, so strong and weak owners never need to
+		// look at each other's count.
+		Atomic<u32> m_weak{ 1 };
 	};
 
+	// Called after the count that guards an object's lifetime drops to zero, so that the destruction that follows sees
+	// every write the other owners made before releasing their references
+	template <SharedType Type>
+	MACH_ALWAYS_INLINE inline void shared_acquire_fence() {
+		if constexpr (Type == SharedType::Atomic) {
+			atomic_fence(Order::Acquire);
+		}
+	}
+
 	template <typename Base, SharedType Type>
 	class SharedPtr {
 	public:
@@ -99,40 +139,50 @@ namespace Mach::Core {
 			auto* counter = &ptr->counter;
 			auto* base = &ptr->base;
 
-			const auto result = SharedPtr<Base, Type>(counter, base);
 			if constexpr (is_base_of<SharedPtrFromThisBase, Base>) {
-				base->m_this = result.downgrade();
+				base->m_counter = counter;
 			}
 
-			return result;
+			return SharedPtr<Base, Type>(counter, base);
 		}
 
 		SharedPtr(const SharedPtr& copy) noexcept : m_counter(copy.m_counter), m_base(copy.m_base) {
-			auto& c = counter();
-			c.add_strong();
+			if (m_counter) {
+				counter().add_strong();
+			}
 		}
 		template <typename Derived = Base>
 		SharedPtr(const SharedPtr<Derived, Type>& copy) noexcept : m_counter(copy.m_counter)
 																 , m_base(copy.m_base) {
-			auto& c = counter();
-			c.add_strong();
+			if (m_counter) {
+				counter().add_strong();
+			}
 		}
 		SharedPtr& operator=(const SharedPtr& copy) noexcept {
-			m_counter = copy.m_counter;
-			m_base = copy.m_base;
+			// Take the new reference before dropping the old one, and read copy first as it may be this
+			auto* new_counter = copy.m_counter;
+			auto* new_base = copy.m_base;
+			if (new_counter) {
+				new_counter->add_strong();
+			}
+			this->~SharedPtr();
 
-			auto& c = counter();
-			c.add_strong();
+			m_counter = new_counter;
+			m_base = new_base;
 
 			return *this;
 		}
 		template <typename Derived = Base>
 		SharedPtr& operator=(const SharedPtr<Derived, Type>& copy) noexcept {
-			m_counter = copy.m_counter;
-			m_base = copy.m_base;
+			auto* new_counter = copy.m_counter;
+			auto* new_base = copy.m_base;
+			if (new_counter) {
+				new_counter->add_strong();
+			}
+			this->~SharedPtr();
 
-			auto& c = counter();
-			c.add_strong();
+			m_counter = new_counter;
+			m_base = new_base;
 
 			return *this;
 		}
@@ -163,26 +213,15 @@ namespace Mach::Core {
 			if (m_counter) {
 				auto& c = counter();
 
-				// Decrement the strong count
-				const auto strong_count = c.remove_strong();
-				const auto weak_count = c.weak();
-
-				// If there are no strong references deconstruct the object
-				if (strong_count == 1) {
+				// If there are no strong references deconstruct the object, then drop the weak reference the strong
+				// references shared. The memory goes away with the last weak reference.
+				if (c.remove_strong() == 1) {
+					shared_acquire_fence<Type>();
 					m_base->~Base();
 
-					// Base that are derived from SharedFromThis will have a weak ptr to itself. Free when weak ptr is 1
-					// to account for this
-					if constexpr (is_base_of<SharedPtrFromThisBase, Base>) {
-						if (weak_count == 1) {
-							Memory::free(m_counter);
-						}
-					}
-					// Free the memory if we have no weak references
-					else {
-						if (weak_count == 0) {
-							Memory::free(m_counter);
-						}
+					if (c.remove_weak() == 1) {
+						shared_acquire_fence<Type>();
+						Memory::free(m_counter);
 					}
 				}
 
@@ -249,10 +288,11 @@ namespace Mach::Core {
 
 		MACH_ALWAYS_INLINE bool is_valid() const { return m_counter != nullptr; }
 
-		MACH_ALWAYS_INLINE bool is_null() const { return m_counter != nullptr; }
+		MACH_ALWAYS_INLINE bool is_null() const { return m_counter == nullptr; }
 
 		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 strong() const { return m_counter != nullptr ? counter().strong() : 0; }
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 weak() const { return m_counter != nullptr ? counter().weak() : 0; }
+		// Does not count the weak reference held on behalf of the strong references
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 weak() const { return m_counter != nullptr ? counter().weak() - 1 : 0; }
 
 	private:
 		explicit SharedPtr(Counter* counter, Base* base) : m_counter(counter), m_base(base) {}
@@ -263,6 +303,9 @@ namespace Mach::Core {
 		template <typename, SharedType>
 		friend class WeakPtr;
 
+		template <typename, SharedType>
+		friend class SharedPtrFromThis;
+
 		MACH_ALWAYS_INLINE Counter const& counter() const { return *m_counter; }
 		MACH_ALWAYS_INLINE Base& value() const { return *m_base; }
 
@@ -277,25 +320,48 @@ namespace Mach::Core {
 
 		WeakPtr() = default;
 
+		WeakPtr(const WeakPtr& copy) noexcept : m_counter(copy.m_counter), m_base(copy.m_base) {
+			if (m_counter) {
+				counter().add_weak();
+			}
+		}
+		WeakPtr& operator=(const WeakPtr& copy) noexcept {
+			// Take the new reference before dropping the old one, and read copy first as it may be this
+			auto* new_counter = copy.m_counter;
+			auto* new_base = copy.m_base;
+			if (new_counter) {
+				new_counter->add_weak();
+			}
+			this->~WeakPtr();
+
+			m_counter = new_counter;
+			m_base = new_base;
+
+			return *this;
+		}
+
 		template <typename Derived = Base>
 		WeakPtr(const WeakPtr<Derived, Type>& copy) noexcept
 			requires DerivedFrom<Derived, Base>
 			: m_counter(copy.m_counter)
 			, m_base(copy.m_base) {
-			auto& c = counter();
-			c.add_weak();
+			if (m_counter) {
+				counter().add_weak();
+			}
 		}
 		template <typename Derived = Base>
 		WeakPtr& operator=(const WeakPtr<Derived, Type>& copy) noexcept
 			requires DerivedFrom<Derived, Base>
 		{
+			auto* new_counter = copy.m_counter;
+			auto* new_base = copy.m_base;
+			if (new_counter) {
+				new_counter->add_weak();
+			}
 			this->~WeakPtr();
 
-			m_counter = copy.m_counter;
-			m_base = copy.m_base;
-
-			auto& c = counter();
-			c.add_weak();
+			m_counter = new_counter;
+			m_base = new_base;
 
 			return *this;
 		}
@@ -322,33 +388,35 @@ namespace Mach::Core {
 		}
 		~WeakPtr() {
 			if (m_counter) {
-				auto& c = counter();
-
-				const auto strong_count = c.strong();
-				const auto weak_count = c.remove_weak();
-
-				if (strong_count == 0 && weak_count == 0) {
+				if (counter().remove_weak() == 1) {
+					shared_acquire_fence<Type>();
 					Memory::free(m_counter);
-					m_counter = nullptr;
 				}
+				m_counter = nullptr;
+				m_base = nullptr;
 			}
 		}
 
 		MACH_NO_DISCARD Option<SharedPtr<Base, Type>> upgrade() const {
-			auto& c = counter();
-			const auto strong_count = c.strong();
-			if (strong_count > 0) {
-				c.add_strong();
+			if (m_counter && counter().try_add_strong()) {
 				return SharedPtr<Base, Type>{ m_counter, m_base };
 			}
 			return nullopt;
 		}
 
 		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 strong() const { return m_counter != nullptr ? counter().strong() : 0; }
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 weak() const { return m_counter != nullptr ? counter().weak() : 0; }
+		// Does not count the weak reference held on behalf of the strong references
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 weak() const {
+			if (m_counter == nullptr) {
+				return 0;
+			}
+			const u32 strong_count = counter().strong();
+			const u32 weak_count = counter().weak();
+			return strong_count > 0 ? weak_count - 1 : weak_count;
+		}
 
 		MACH_ALWAYS_INLINE bool is_valid() const { return m_counter != nullptr; }
-		MACH_ALWAYS_INLINE bool is_null() const { return m_counter != nullptr; }
+		MACH_ALWAYS_INLINE bool is_null() const { return m_counter == nullptr; }
 
 	private:
 		MACH_ALWAYS_INLINE Counter const& counter() const { return *m_counter; }
@@ -370,15 +438,18 @@ namespace Mach::Core {
 	public:
 		using Counter = SharedCounter<Type>;
 
+		// Whoever calls this already reaches the object through a strong reference, so the count can simply be bumped
 		MACH_NO_DISCARD MACH_ALWAYS_INLINE SharedPtr<T, Type> to_shared() const {
-			return m_this.as_const_ref().unwrap().upgrade().unwrap();
+			MACH_ASSERT(m_counter != nullptr, "Object was not created through SharedPtr::create");
+			m_counter->add_strong();
+			return SharedPtr<T, Type>{ m_counter, const_cast<T*>(static_cast<T const*>(this)) };
 		}
 
 	private:
 		template <typename Derived, SharedType>
 		friend class SharedPtr;
 
-		Option<WeakPtr<T, Type>> m_this = nullopt;
+		Counter* m_counter = nullptr;
 	};
 } // namespace Mach::Core
 
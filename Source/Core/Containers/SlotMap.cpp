@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/SlotMap.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach::Core;
+	MACH_TEST_CASE("SlotMap") {
+		MACH_SUBCASE("insert and get") {
+			SlotMap<u32> map;
+			const auto a = map.insert(1);
+			const auto b = map.insert(2);
+
+			MACH_CHECK(map.len() == 2);
+			MACH_CHECK(a != b);
+			MACH_CHECK(map.get(a).unwrap() == 1);
+			MACH_CHECK(map.get(b).unwrap() == 2);
+			MACH_CHECK(!map.get(SlotMap<u32>::Handle{}).is_set());
+		}
+
+		MACH_SUBCASE("remove keeps other handles valid") {
+			SlotMap<u32> map;
+			const auto a = map.insert(1);
+			const auto b = map.insert(2);
+			const auto c = map.insert(3);
+
+			MACH_CHECK(map.remove(a).unwrap() == 1);
+			MACH_CHECK(!map.remove(a).is_set());
+			MACH_CHECK(map.len() == 2);
+			MACH_CHECK(!map.contains(a));
+			MACH_CHECK(map.get(b).unwrap() == 2);
+			MACH_CHECK(map.get(c).unwrap() == 3);
+
+			// Values stay packed and every one maps back to its handle
+			u32 sum = 0;
+			for (const u32 value : map) {
+				sum += value;
+			}
+			MACH_CHECK(sum == 5);
+			for (usize i = 0; i < map.len(); i += 1) {
+				MACH_CHECK(map.get(map.handle_at(i)).unwrap() == map.as_slice()[i]);
+			}
+		}
+
+		MACH_SUBCASE("stale handles") {
+			SlotMap<u32> map;
+			const auto a = map.insert(1);
+			MACH_CHECK(map.remove(a).is_set());
+
+			// The slot is reused, but the old handle must not reach the new value
+			const auto b = map.insert(2);
+			MACH_CHECK(b.index() == a.index());
+			MACH_CHECK(b.generation() != a.generation());
+			MACH_CHECK(!map.get(a).is_set());
+			MACH_CHECK(!map.remove(a).is_set());
+			MACH_CHECK(map.get(b).unwrap() == 2);
+		}
+
+		MACH_SUBCASE("owning values") {
+			SlotMap<UniquePtr<u32>> map;
+			Array<SlotMap<UniquePtr<u32>>::Handle> handles;
+			for (u32 i = 0; i < 64; i += 1) {
+				handles.push(map.insert(UniquePtr<u32>::create(i)));
+			}
+			for (u32 i = 0; i < 64; i += 2) {
+				auto removed = map.remove(handles[i]);
+				MACH_CHECK(*removed.unwrap() == i);
+			}
+			MACH_CHECK(map.len() == 32);
+
+			bool all_found = true;
+			for (u32 i = 1; i < 64; i += 2) {
+				all_found &= *map.get(handles[i]).unwrap() == i;
+			}
+			MACH_CHECK(all_found);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("SlotMap::get") {
+	using namespace Mach::Core;
+
+	SlotMap<u64> map;
+	Array<SlotMap<u64>::Handle> handles;
+	for (u64 i = 0; i < 1024; i += 1) {
+		handles.push(map.insert(i));
+	}
+	// Punch holes so lookups go through a shuffled slot table
+	for (usize i = 0; i < 1024; i += 3) {
+		const auto unused = map.remove(handles[i]);
+		MACH_UNUSED(unused);
+		handles[i] = map.insert(i);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&] {
+		u64 sum = 0;
+		for (const auto handle : handles) {
+			sum += map.get(handle).unwrap();
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("SlotMap iterate") {
+	using namespace Mach::Core;
+
+	SlotMap<u64> map;
+	for (u64 i = 0; i < 1024; i += 1) {
+		const auto unused = map.insert(i);
+		MACH_UNUSED(unused);
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&map] {
+		u64 sum = 0;
+		for (const u64 value : map) {
+			sum += value;
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Container that hands out a Handle for every value it stores. Values are kept packed in a single Array so iterating
+	 * touches no holes, while handles go through a slot table so they stay valid as other values are removed.
+	 *
+	 * Insert, remove and get are all O(1). Each slot carries a generation that is bumped whenever it is filled or
+	 * emptied, so a handle to a removed value is detected instead of silently reaching whatever took its place.
+	 */
+	template <Movable T>
+	class SlotMap {
+	public:
+		class Handle {
+		public:
+			// A null handle never refers to a value
+			constexpr Handle() = default;
+
+			MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 index() const { return m_index; }
+			MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 generation() const { return m_generation; }
+			MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_null() const { return m_generation == 0; }
+
+			bool operator==(const Handle& other) const = default;
+
+		private:
+			friend class SlotMap;
+
+			constexpr Handle(u32 index, u32 generation) : m_index(index), m_generation(generation) {}
+
+			u32 m_index = 0;
+			u32 m_generation = 0;
+		};
+
+		SlotMap() = default;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_values.len(); }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_empty() const { return m_values.is_empty(); }
+
+		// Iterates the live values in no particular order. Removing a value moves the last one into its place.
+		MACH_ALWAYS_INLINE T* begin() { return m_values.begin(); }
+		MACH_ALWAYS_INLINE T* end() { return m_values.end(); }
+		MACH_ALWAYS_INLINE const T* begin() const { return m_values.begin(); }
+		MACH_ALWAYS_INLINE const T* end() const { return m_values.end(); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<T> as_slice() { return m_values.as_slice(); }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<const T> as_const_slice() const { return m_values.as_const_slice(); }
+
+		// Handle of the value at index in iteration order
+		MACH_NO_DISCARD Handle handle_at(usize index) const {
+			const u32 slot = m_dense_to_slot[index];
+			return Handle(slot, m_slots[slot].generation);
+		}
+
+		Handle insert(T&& value) {
+			u32 slot_index;
+			if (m_free_head != no_slot) {
+				slot_index = m_free_head;
+				m_free_head = m_slots[slot_index].index;
+			} else {
+				MACH_ASSERT(m_slots.len() < no_slot, "SlotMap is out of slots");
+				slot_index = static_cast<u32>(m_slots.push(Slot{}));
+			}
+
+			Slot& slot = m_slots[slot_index];
+			slot.generation += 1;
+			slot.index = static_cast<u32>(m_values.push(Mach::forward<T>(value)));
+			m_dense_to_slot.push(slot_index);
+			return Handle(slot_index, slot.generation);
+		}
+
+		Handle insert(const T& value)
+			requires Copyable<T>
+		{
+			T copy = value;
+			return insert(Mach::move(copy));
+		}
+
+		Option<T> remove(Handle handle) {
+			if (!contains(handle)) {
+				return nullopt;
+			}
+
+			Slot& slot = m_slots[handle.m_index];
+			const u32 dense = slot.index;
+			slot.generation += 1;
+			slot.index = m_free_head;
+			m_free_head = handle.m_index;
+
+			// Fill the hole with the last value so the values stay packed
+			T result = Mach::move(m_values[dense]);
+			const usize last = m_values.len() - 1;
+			if (dense != last) {
+				m_values[dense] = Mach::move(m_values[last]);
+				const u32 moved = m_dense_to_slot[last];
+				m_dense_to_slot[dense] = moved;
+				m_slots[moved].index = dense;
+			}
+			const auto unused_value = m_values.pop();
+			const auto unused_slot = m_dense_to_slot.pop();
+			MACH_UNUSED(unused_value);
+			MACH_UNUSED(unused_slot);
+
+			return result;
+		}
+
+		MACH_NO_DISCARD bool contains(Handle handle) const {
+			return handle.m_index < m_slots.len() && m_slots[handle.m_index].generation == handle.m_generation &&
+				   (handle.m_generation & 1) != 0;
+		}
+
+		MACH_NO_DISCARD Option<T&> get(Handle handle) {
+			if (!contains(handle)) {
+				return nullopt;
+			}
+			return m_values[m_slots[handle.m_index].index];
+		}
+
+		MACH_NO_DISCARD Option<T const&> get(Handle handle) const {
+			if (!contains(handle)) {
+				return nullopt;
+			}
+			return m_values[m_slots[handle.m_index].index];
+		}
+
+	private:
+		static constexpr u32 no_slot = 0xFFFFFFFF;
+
+		struct Slot {
+			// Odd while the slot holds a value. Starts at 0 so a null Handle never matches.
+			u32 generation = 0;
+			// Index into m_values while occupied, otherwise the next free slot
+			u32 index = no_slot;
+		};
+
+		Array<T> m_values;
+		Array<u32> m_dense_to_slot;
+		Array<Slot> m_slots;
+		u32 m_free_head = no_slot;
+	};
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::SlotMap;
+} // namespace Mach
@@ -92,8 +92,8 @@ namespace Mach::Core {
 	template <typename T>
 	class UniquePtr<T[]> {
 	public:
-		explicit UniquePtr() : m_ptr(nullptr) {}
-		explicit UniquePtr(NullPtr) : m_ptr(nullptr) {}
+		explicit UniquePtr() : m_ptr(nullptr), m_len(0) {}
+		explicit UniquePtr(NullPtr) : m_ptr(nullptr), m_len(0) {}
 
 		static MACH_ALWAYS_INLINE UniquePtr create(usize len)
 			requires DefaultInitializable<T>
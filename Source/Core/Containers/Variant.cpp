@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/Variant.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Containers") {
+	using namespace Mach::Core;
+
+	struct Circle {
+		f32 radius;
+	};
+
+	struct Square {
+		f32 side;
+	};
+
+	// Counts how many live instances there are so copies, moves and destruction can be checked
+	struct Tracked {
+		explicit Tracked(int& live) : live(&live) { *this->live += 1; }
+		Tracked(const Tracked& copy) : live(copy.live) { *live += 1; }
+		Tracked(Tracked&& move) noexcept : live(move.live) { *live += 1; }
+		~Tracked() { *live -= 1; }
+
+		int* live;
+	};
+
+	using Shape = Variant<Circle, Square>;
+
+	MACH_TEST_CASE("Variant") {
+		MACH_SUBCASE("is and get") {
+			const Shape shape = Square{ .side = 2.f };
+			MACH_CHECK(shape.is<Square>());
+			MACH_CHECK(!shape.is<Circle>());
+			MACH_CHECK(shape.index() == 1);
+			MACH_CHECK(shape.get<Square>()->side == 2.f);
+			MACH_CHECK(!shape.get<Circle>().is_set());
+		}
+
+		MACH_SUBCASE("visit") {
+			const Shape circle = Circle{ .radius = 1.f };
+			const Shape square = Square{ .side = 2.f };
+
+			const auto area = Overloaded{
+				[](const Circle& c) { return 3.f * c.radius * c.radius; },
+				[](const Square& s) { return s.side * s.side; },
+			};
+			MACH_CHECK(circle.visit(area) == 3.f);
+			MACH_CHECK(square.visit(area) == 4.f);
+
+			Shape mutable_shape = Circle{ .radius = 1.f };
+			mutable_shape.visit(Overloaded{
+				[](Circle& c) { c.radius = 5.f; },
+				[](Square&) {},
+			});
+			MACH_CHECK(mutable_shape.get<Circle>()->radius == 5.f);
+		}
+
+		MACH_SUBCASE("visit several variants") {
+			const Shape circle = Circle{ .radius = 1.f };
+			const Shape square = Square{ .side = 2.f };
+			const Variant<u32, f32, bool> scalar = true;
+
+			const auto describe = Overloaded{
+				[](const Circle&, const Square&, bool) { return 1; },
+				[](const Square&, const Circle&, bool) { return 2; },
+				[](const auto&, const auto&, const auto&) { return 0; },
+			};
+			MACH_CHECK(visit(describe, circle, square, scalar) == 1);
+			MACH_CHECK(visit(describe, square, circle, scalar) == 2);
+			MACH_CHECK(visit(describe, circle, circle, scalar) == 0);
+		}
+
+		MACH_SUBCASE("copy move and destroy") {
+			int live = 0;
+			{
+				Variant<u32, Tracked> a = Tracked{ live };
+				MACH_CHECK(live == 1);
+				auto b = a;
+				MACH_CHECK(live == 2);
+				auto c = Mach::move(b);
+				// The moved from variant still holds a (moved from) Tracked
+				MACH_CHECK(live == 3);
+				MACH_CHECK(b.is<Tracked>());
+				c = Variant<u32, Tracked>{ 5u };
+				MACH_CHECK(live == 2);
+				MACH_CHECK(c.get<u32>().unwrap() == 5);
+			}
+			MACH_CHECK(live == 0);
+		}
+
+		MACH_SUBCASE("smallest tag and niche") {
+			static_assert(sizeof(Variant<u8, bool>) == 2);
+			static_assert(sizeof(Shape) == 8);
+			static_assert(sizeof(Option<Shape>) == sizeof(Shape));
+
+			Option<Shape> none;
+			MACH_CHECK(!none.is_set());
+
+			Option<Shape> some = Shape{ Square{ .side = 3.f } };
+			MACH_REQUIRE(some.is_set());
+			MACH_CHECK(some.as_const_ref()->get<Square>()->side == 3.f);
+
+			const auto shape = some.unwrap();
+			MACH_CHECK(!some.is_set());
+			MACH_CHECK(shape.is<Square>());
+
+			int live = 0;
+			{
+				Option<Variant<u32, Tracked>> tracked = Variant<u32, Tracked>{ Tracked{ live } };
+				auto copy = tracked;
+				MACH_CHECK(live == 2);
+				copy = nullopt;
+				MACH_CHECK(live == 1);
+			}
+			MACH_CHECK(live == 0);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Variant visit") {
+	using namespace Mach::Core;
+
+	struct A {
+		u32 value;
+	};
+	struct B {
+		u32 value;
+	};
+	struct C {
+		u32 value;
+	};
+	struct D {
+		u32 value;
+	};
+	using V = Variant<A, B, C, D>;
+
+	Array<V> values;
+	for (u32 i = 0; i < 1024; i += 1) {
+		// Mix the alternatives so the branch predictor can not learn the order
+		const u32 pick = (i * 2654435761u) >> 30;
+		switch (pick) {
+		case 0:
+			values.push(V{ A{ i } });
+			break;
+		case 1:
+			values.push(V{ B{ i } });
+			break;
+		case 2:
+			values.push(V{ C{ i } });
+			break;
+		default:
+			values.push(V{ D{ i } });
+			break;
+		}
+	}
+
+	bencher.set_items(1024);
+	bencher.iter([&values] {
+		u64 sum = 0;
+		for (const auto& value : values) {
+			sum += value.visit(Overloaded{
+				[](const A& a) { return a.value; },
+				[](const B& b) { return b.value * 2; },
+				[](const C& c) { return c.value * 3; },
+				[](const D& d) { return d.value * 4; },
+			});
+		}
+		return sum;
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
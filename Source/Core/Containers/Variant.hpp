@@ -9,6 +9,9 @@
 #include <Core/Concepts.hpp>
 #include <Core/Containers/Option.hpp>
 #include <Core/Memory.hpp>
+#include <Core/TypeTraits.hpp>
+
+#include <utility>
 
 namespace Mach::Core {
 	template <typename T, typename... Ts>
@@ -59,13 +62,39 @@ namespace Mach::Core {
 	template <typename T, typename... Ts>
 	concept Contains = (Core::is_same<T, Ts> || ...);
 
+	template <typename... Ts>
+	class Variant;
+
+	// Calls f with the value held by each variant and returns what f returns. Dispatch is a single indirect call
+	// through a table with one entry per combination of alternatives, however many types or variants there are.
+	template <typename F, typename... Vs>
+	decltype(auto) visit(F&& f, Vs&&... variants);
+
+	// Builds a single callable out of several lambdas, one per alternative, to hand to visit
+	//
+	// variant.visit(Overloaded{
+	// 	[](const Rect& rect) { ... },
+	// 	[](const Line& line) { ... },
+	// });
+	template <typename... Fs>
+	struct Overloaded : Fs... {
+		using Fs::operator()...;
+	};
+	template <typename... Fs>
+	Overloaded(Fs...) -> Overloaded<Fs...>;
+
 	template <typename... Ts>
 	class Variant {
 	public:
-		using Tag = u8;
 		static constexpr usize Count = sizeof...(Ts);
 		static constexpr usize MaxSizeOf = Core::max_sizeof<Ts...>();
 
+		// Count itself is never a valid tag, which is what lets Option<Variant> go without a separate flag
+		using Tag = Conditional<(Count < 256), u8, u16>;
+
+		template <usize Index>
+		using Alternative = Nth<Index, Ts...>;
+
 		template <typename T>
 			requires Contains<T, Ts...>
 		Variant(T&& value) {
@@ -74,31 +103,31 @@ namespace Mach::Core {
 			m_tag = static_cast<Tag>(type_index<T, Ts...>);
 		}
 
-		Variant(const Variant& other) { copy_by_index(other); }
+		Variant(const Variant& other) { copy_from(other); }
 
 		Variant& operator=(const Variant& other) {
 			if (this != &other) {
-				destroy_by_index();
-				copy_by_index(other);
+				destroy();
+				copy_from(other);
 			}
 			return *this;
 		}
 
-		Variant(Variant&& other) noexcept {
-			move_by_index(Mach::move(other));
-			other.m_tag = 0;
-		}
+		// The moved from variant keeps its alternative, now holding a moved from value
+		Variant(Variant&& other) noexcept { move_from(Mach::move(other)); }
 
 		Variant& operator=(Variant&& other) noexcept {
 			if (this != &other) {
-				destroy_by_index();
-				move_by_index(Mach::move(other));
-				other.m_tag = 0;
+				destroy();
+				move_from(Mach::move(other));
 			}
 			return *this;
 		}
 
-		~Variant() { destroy_by_index(); }
+		~Variant() { destroy(); }
+
+		// Position of the held type in Ts
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize index() const { return m_tag; }
 
 		template <typename T>
 			requires Contains<T, Ts...>
@@ -132,55 +161,119 @@ namespace Mach::Core {
 			return *reinterpret_cast<const T*>(m_data);
 		}
 
+		template <typename F>
+		decltype(auto) visit(F&& f) {
+			return Core::visit(Mach::forward<F>(f), *this);
+		}
+
+		template <typename F>
+		decltype(auto) visit(F&& f) const {
+			return Core::visit(Mach::forward<F>(f), *this);
+		}
+
 	private:
-		alignas(u64) u8 m_data[MaxSizeOf];
+		template <typename>
+		friend struct Niche;
+
+		void destroy() {
+			visit([](auto& value) {
+				using T = RemoveCvref<decltype(value)>;
+				value.~T();
+			});
+		}
+
+		void copy_from(const Variant& other) {
+			other.visit([this](const auto& value) {
+				using T = RemoveCvref<decltype(value)>;
+				Memory::emplace<T>(m_data, T(value));
+			});
+			m_tag = other.m_tag;
+		}
+
+		void move_from(Variant&& other) {
+			other.visit([this](auto& value) {
+				using T = RemoveCvref<decltype(value)>;
+				Memory::emplace<T>(m_data, T(Mach::move(value)));
+			});
+			m_tag = other.m_tag;
+		}
+
+		alignas(Ts...) u8 m_data[MaxSizeOf];
 		Tag m_tag = 0;
+	};
 
-		// --- Indexed Dispatch ---
-
-		template <usize Index = 0>
-		void destroy_by_index() {
-			if constexpr (Index < Count) {
-				if (m_tag == Index) {
-					using T = Nth<Index, Ts...>;
-					reinterpret_cast<T*>(m_data)->~T();
-				} else {
-					destroy_by_index<Index + 1>();
-				}
-			}
+	template <typename... Ts>
+	struct Niche<Variant<Ts...>> {
+		static constexpr bool available = true;
+
+		static void set_none(void* storage) {
+			using V = Variant<Ts...>;
+			static_cast<V*>(storage)->m_tag = static_cast<typename V::Tag>(V::Count);
 		}
 
-		template <usize Index = 0>
-		void copy_by_index(const Variant& other) {
-			if constexpr (Index < Count) {
-				if (other.m_tag == Index) {
-					using T = Nth<Index, Ts...>;
-					auto* from = reinterpret_cast<const T*>(other.m_data);
-					Memory::emplace<T>(m_data, T(*from));
-					m_tag = other.m_tag;
-				} else {
-					copy_by_index<Index + 1>(other);
-				}
-			}
+		static bool is_none(const void* storage) {
+			using V = Variant<Ts...>;
+			return static_cast<const V*>(storage)->m_tag == V::Count;
 		}
+	};
 
-		template <usize Index = 0>
-		void move_by_index(Variant&& other) {
-			if constexpr (Index < Count) {
-				if (other.m_tag == Index) {
-					using T = Nth<Index, Ts...>;
-					auto* from = reinterpret_cast<T*>(other.m_data);
-					Memory::emplace<T>(m_data, T(Mach::move(*from)));
-					m_tag = other.m_tag;
-				} else {
-					move_by_index<Index + 1>(Mach::move(other));
-				}
-			}
+	// Reference to alternative Index of a variant, keeping the variant's constness
+	template <typename V, usize Index>
+	using VariantAlternativeRef =
+		decltype(std::declval<V&>().template get_unchecked<typename RemoveCvref<V>::template Alternative<Index>>());
+
+	// Which alternative argument Arg holds in table entry Flat. The last variant varies fastest.
+	template <usize Flat, usize Arg, typename... Vs>
+	constexpr usize variant_table_index() {
+		constexpr usize counts[] = { RemoveCvref<Vs>::Count... };
+		usize stride = 1;
+		for (usize index = Arg + 1; index < sizeof...(Vs); index += 1) {
+			stride *= counts[index];
 		}
+		return (Flat / stride) % counts[Arg];
+	}
+
+	template <typename R, usize Flat, usize... Args, typename F, typename... Vs>
+	R variant_visit_entry_impl(std::index_sequence<Args...>, F& f, Vs&... variants) {
+		return f(variants.template get_unchecked<
+				 typename RemoveCvref<Vs>::template Alternative<variant_table_index<Flat, Args, Vs...>()>>()...);
+	}
+
+	template <typename R, usize Flat, typename F, typename... Vs>
+	R variant_visit_entry(F& f, Vs&... variants) {
+		return variant_visit_entry_impl<R, Flat>(std::index_sequence_for<Vs...>{}, f, variants...);
+	}
+
+	template <typename Entry, usize Size>
+	struct VariantVisitTable {
+		Entry entries[Size];
 	};
 
+	template <typename R, typename F, typename... Vs, usize... Flats>
+	constexpr auto variant_visit_table(std::index_sequence<Flats...>) {
+		using Entry = R (*)(F&, Vs&...);
+		return VariantVisitTable<Entry, sizeof...(Flats)>{ { &variant_visit_entry<R, Flats, F, Vs...>... } };
+	}
+
+	template <typename F, typename... Vs>
+	decltype(auto) visit(F&& f, Vs&&... variants) {
+		static_assert(sizeof...(Vs) > 0, "visit needs at least one variant");
+
+		// Every combination has to return something convertible to what the first one returns
+		using R = InvokeResult<RemoveReference<F>&, VariantAlternativeRef<RemoveReference<Vs>, 0>...>;
+		static constexpr usize combinations = (RemoveCvref<Vs>::Count * ... * 1);
+		static constexpr auto table = variant_visit_table<R, RemoveReference<F>, RemoveReference<Vs>...>(
+			std::make_index_sequence<combinations>{});
+
+		usize flat = 0;
+		((flat = flat * RemoveCvref<Vs>::Count + variants.index()), ...);
+		return table.entries[flat](f, variants...);
+	}
+
 } // namespace Mach::Core
 
 namespace Mach {
+	using Core::Overloaded;
 	using Core::Variant;
-}
+	using Core::visit;
+} // namespace Mach
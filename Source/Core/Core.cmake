@@ -15,65 +15,119 @@ set(CORE_SRC_FILES
         ${CORE_ROOT}/Memory.hpp
         ${CORE_ROOT}/Memory.cpp
         ${CORE_ROOT}/Primitives.hpp
+        ${CORE_ROOT}/Sort.hpp
+        ${CORE_ROOT}/Sort.cpp
         ${CORE_ROOT}/Time.hpp
         ${CORE_ROOT}/Time.cpp
         ${CORE_ROOT}/TypeTraits.hpp
 		${CORE_ROOT}/Windows.hpp
 
+        ${CORE_ROOT}/Async/AsyncIO.hpp
+        ${CORE_ROOT}/Async/AsyncIO.cpp
+		${CORE_ROOT}/Async/ConcurrentHashMap.hpp
+		${CORE_ROOT}/Async/ConcurrentHashMap.cpp
+		${CORE_ROOT}/Async/Epoch.hpp
+		${CORE_ROOT}/Async/Epoch.cpp
         ${CORE_ROOT}/Async/Fiber.hpp
         ${CORE_ROOT}/Async/Fiber.cpp
+		${CORE_ROOT}/Async/FreeList.hpp
+		${CORE_ROOT}/Async/FreeList.cpp
 		${CORE_ROOT}/Async/MPMC.hpp
+		${CORE_ROOT}/Async/MPMC.cpp
 		${CORE_ROOT}/Async/Mutex.hpp
 		${CORE_ROOT}/Async/Mutex.cpp
+		${CORE_ROOT}/Async/ParallelSort.hpp
+		${CORE_ROOT}/Async/ParallelSort.cpp
 		${CORE_ROOT}/Async/Scheduler.hpp
 		${CORE_ROOT}/Async/Scheduler.cpp
+		${CORE_ROOT}/Async/SPSC.hpp
+		${CORE_ROOT}/Async/SPSC.cpp
         ${CORE_ROOT}/Async/Thread.hpp
         ${CORE_ROOT}/Async/Thread.cpp
+		${CORE_ROOT}/Async/UnboundedMPMC.hpp
+		${CORE_ROOT}/Async/UnboundedMPMC.cpp
+
+        ${CORE_ROOT}/Compression/LZ4.hpp
+        ${CORE_ROOT}/Compression/LZ4.cpp
+        ${CORE_ROOT}/Compression/Stream.hpp
+        ${CORE_ROOT}/Compression/Stream.cpp
 
         ${CORE_ROOT}/Containers/Array.hpp
         ${CORE_ROOT}/Containers/Array.cpp
+        ${CORE_ROOT}/Containers/BitArray.hpp
+        ${CORE_ROOT}/Containers/BitArray.cpp
+        ${CORE_ROOT}/Containers/BTreeMap.hpp
+        ${CORE_ROOT}/Containers/BTreeMap.cpp
         ${CORE_ROOT}/Containers/Function.hpp
         ${CORE_ROOT}/Containers/Function.cpp
         ${CORE_ROOT}/Containers/HashMap.hpp
         ${CORE_ROOT}/Containers/HashMap.cpp
+        ${CORE_ROOT}/Containers/HierarchicalBitset.hpp
+        ${CORE_ROOT}/Containers/HierarchicalBitset.cpp
         ${CORE_ROOT}/Containers/NonNull.hpp
         ${CORE_ROOT}/Containers/NonNull.cpp
         ${CORE_ROOT}/Containers/Option.hpp
         ${CORE_ROOT}/Containers/Option.cpp
+        ${CORE_ROOT}/Containers/Rc.hpp
+        ${CORE_ROOT}/Containers/Rc.cpp
         ${CORE_ROOT}/Containers/SharedPtr.hpp
         ${CORE_ROOT}/Containers/SharedPtr.cpp
         ${CORE_ROOT}/Containers/Slice.hpp
         ${CORE_ROOT}/Containers/Slice.cpp
+        ${CORE_ROOT}/Containers/SlotMap.hpp
+        ${CORE_ROOT}/Containers/SlotMap.cpp
         ${CORE_ROOT}/Containers/String.hpp
         ${CORE_ROOT}/Containers/String.cpp
         ${CORE_ROOT}/Containers/StringView.hpp
         ${CORE_ROOT}/Containers/StringView.cpp
         ${CORE_ROOT}/Containers/UniquePtr.hpp
         ${CORE_ROOT}/Containers/UniquePtr.cpp
+        ${CORE_ROOT}/Containers/Variant.hpp
+        ${CORE_ROOT}/Containers/Variant.cpp
         ${CORE_ROOT}/Containers/WString.hpp
         ${CORE_ROOT}/Containers/WString.cpp
         ${CORE_ROOT}/Containers/WStringView.hpp
         ${CORE_ROOT}/Containers/WStringView.cpp
 
         ${CORE_ROOT}/Debug/Assertions.hpp
+		${CORE_ROOT}/Debug/Benchmark.hpp
+		${CORE_ROOT}/Debug/Benchmark.cpp
         ${CORE_ROOT}/Debug/Log.hpp
+		${CORE_ROOT}/Debug/Profiler.hpp
+		${CORE_ROOT}/Debug/Profiler.cpp
+		${CORE_ROOT}/Debug/Trace.hpp
+		${CORE_ROOT}/Debug/Trace.cpp
 		${CORE_ROOT}/Debug/StackTrace.hpp
 		${CORE_ROOT}/Debug/StackTrace.cpp
         ${CORE_ROOT}/Debug/Test.hpp
 
 		${CORE_ROOT}/FileSystem/File.hpp
 		${CORE_ROOT}/FileSystem/Directory.hpp
+		${CORE_ROOT}/FileSystem/FileWatcher.hpp
+		${CORE_ROOT}/FileSystem/FileWatcher.cpp
 		${CORE_ROOT}/FileSystem/Library.hpp
+		${CORE_ROOT}/FileSystem/MappedFile.hpp
+		${CORE_ROOT}/FileSystem/Pack.hpp
+		${CORE_ROOT}/FileSystem/Pack.cpp
+		${CORE_ROOT}/FileSystem/VirtualFileSystem.hpp
+		${CORE_ROOT}/FileSystem/VirtualFileSystem.cpp
+		${CORE_ROOT}/FileSystem/Walk.hpp
+		${CORE_ROOT}/FileSystem/Walk.cpp
 
 		${CORE_ROOT}/IO/Reader.hpp
 		${CORE_ROOT}/IO/Writer.hpp
 
+        ${CORE_ROOT}/Math/Batch.hpp
+        ${CORE_ROOT}/Math/Batch.cpp
+        ${CORE_ROOT}/Math/FastMath.hpp
+        ${CORE_ROOT}/Math/FastMath.cpp
         ${CORE_ROOT}/Math/Math.hpp
         ${CORE_ROOT}/Math/Math.cpp
         ${CORE_ROOT}/Math/Matrix4.hpp
         ${CORE_ROOT}/Math/Matrix4.cpp
         ${CORE_ROOT}/Math/Quaternion.hpp
         ${CORE_ROOT}/Math/Quaternion.cpp
+        ${CORE_ROOT}/Math/SIMD.hpp
         ${CORE_ROOT}/Math/Vector2.hpp
         ${CORE_ROOT}/Math/Vector2.cpp
         ${CORE_ROOT}/Math/Vector3.hpp
@@ -97,6 +151,20 @@ if (OS_SUPPORTS_POSIX)
 		${CORE_ROOT}/FileSystem/Posix/File.cpp
 		${CORE_ROOT}/FileSystem/Posix/Directory.hpp
 		${CORE_ROOT}/FileSystem/Posix/Directory.cpp
+		${CORE_ROOT}/FileSystem/Posix/MappedFile.cpp
+	)
+endif()
+
+# Append Linux files if using Linux
+if(OS_LINUX)
+	set(CORE_SRC_FILES
+		${CORE_SRC_FILES}
+
+		${CORE_ROOT}/Async/Linux/IOUring.hpp
+		${CORE_ROOT}/Async/Linux/IOUring.cpp
+
+		${CORE_ROOT}/FileSystem/Linux/InotifyWatch.hpp
+		${CORE_ROOT}/FileSystem/Linux/InotifyWatch.cpp
 	)
 endif()
 
@@ -114,8 +182,11 @@ if(OS_WINDOWS)
 		${CORE_ROOT}/FileSystem/Win32/File.cpp
 		${CORE_ROOT}/FileSystem/Win32/Directory.hpp
 		${CORE_ROOT}/FileSystem/Win32/Directory.cpp
+		${CORE_ROOT}/FileSystem/Win32/DirectoryWatch.hpp
+		${CORE_ROOT}/FileSystem/Win32/DirectoryWatch.cpp
 		${CORE_ROOT}/FileSystem/Win32/Library.hpp
 		${CORE_ROOT}/FileSystem/Win32/Library.cpp
+		${CORE_ROOT}/FileSystem/Win32/MappedFile.cpp
 	)
 endif()
 
@@ -129,8 +200,15 @@ if(ARCH_AARCH64)
 	)
 endif()
 
+# Helpers only built into the test executable
+set(CORE_TEST_FILES
+		${CORE_ROOT}/Debug/TempDirectory.hpp
+		${CORE_ROOT}/Debug/TempDirectory.cpp
+)
+
 add_machina_library(Core ${CORE_ROOT} ${CORE_SRC_FILES})
-test_machina_library(Core ${CORE_SRC_FILES})
+test_machina_library(Core ${CORE_SRC_FILES} ${CORE_TEST_FILES})
+bench_machina_library(Core ${CORE_SRC_FILES})
 
 if (OS_WINDOWS)
 	# Link dbghelp for call stack symbol loading
@@ -21,6 +21,8 @@
 	#define MACH_OS MACH_OS_WINDOWS
 #elif __APPLE__
 	#define MACH_OS MACH_OS_MACOS
+#elif __linux__
+	#define MACH_OS MACH_OS_LINUX
 #endif
 
 #ifndef MACH_OS
@@ -79,7 +81,7 @@
 	#if !defined(__x86_64__) && !defined(_M_X64)
 		#error Only support 64 bit architecture
 	#endif
-#elif __arm64__
+#elif __arm64__ || __aarch64__
 	#define MACH_CPU MACH_CPU_ARM
 #endif
 
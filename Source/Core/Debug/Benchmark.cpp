@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Benchmark.hpp>
+
+#include <Core/FileSystem/File.hpp>
+#include <Core/Format.hpp>
+
+#include <cmath>
+
+namespace Mach::Core {
+	struct RegisteredBenchmark {
+		const char* name;
+		BenchmarkFunction function;
+	};
+
+	// Function local so registration does not depend on static initialization order between translation units
+	static Array<RegisteredBenchmark>& registered_benchmarks() {
+		static Array<RegisteredBenchmark> benchmarks;
+		return benchmarks;
+	}
+
+	BenchmarkRegistrar::BenchmarkRegistrar(const char* name, BenchmarkFunction function) {
+		registered_benchmarks().push(RegisteredBenchmark{ .name = name, .function = function });
+	}
+
+	static BenchmarkStats compute_stats(Array<f64>& samples) {
+		// Few enough samples that an insertion sort is plenty
+		for (usize i = 1; i < samples.len(); i += 1) {
+			const f64 value = samples[i];
+			usize j = i;
+			while (j > 0 && samples[j - 1] > value) {
+				samples[j] = samples[j - 1];
+				j -= 1;
+			}
+			samples[j] = value;
+		}
+
+		const usize count = samples.len();
+		f64 sum = 0.0;
+		for (const f64 sample : samples) {
+			sum += sample;
+		}
+		const f64 mean = sum / static_cast<f64>(count);
+
+		f64 variance = 0.0;
+		for (const f64 sample : samples) {
+			variance += (sample - mean) * (sample - mean);
+		}
+		variance /= static_cast<f64>(count > 1 ? count - 1 : 1);
+
+		// Nearest rank percentile
+		auto percentile = [&](f64 p) {
+			const usize rank = static_cast<usize>(std::ceil(p * static_cast<f64>(count)));
+			return samples[rank > 0 ? rank - 1 : 0];
+		};
+
+		return BenchmarkStats{
+			.min = samples[0],
+			.median = count % 2 == 1 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) * 0.5,
+			.p99 = percentile(0.99),
+			.mean = mean,
+			.stddev = std::sqrt(variance),
+		};
+	}
+
+	void Bencher::run(FunctionRef<void(u64)> batch) {
+		MACH_ASSERT(!m_ran, "Bencher::iter may only be called once per benchmark");
+		m_ran = true;
+
+		const u64 sample_nanos = m_options.sample_time.as_nanos();
+
+		// Warm caches, branch predictors and clocks while growing the batch until it is long enough to time reliably
+		u64 iterations = 1;
+		const Instant warmup_start = Instant::now();
+		while (true) {
+			const Instant start = Instant::now();
+			batch(iterations);
+			const u64 elapsed = start.elapsed().as_nanos();
+
+			const bool warm = warmup_start.elapsed() >= m_options.warmup;
+			if (elapsed >= sample_nanos) {
+				if (warm) break;
+				continue;
+			}
+
+			// Jump close to the target right away for slow bodies, but never grow by more than 10x at once in case the
+			// first batches were dominated by cold caches
+			u64 grow = 2;
+			if (elapsed > 0) {
+				const u64 estimate = sample_nanos / elapsed + 1;
+				grow = estimate < 2 ? 2 : (estimate > 10 ? 10 : estimate);
+			}
+			iterations *= grow;
+		}
+
+		const u32 sample_count = m_options.samples > 0 ? m_options.samples : 1;
+		Array<f64> nanos;
+		Array<f64> cycles;
+		nanos.reserve(sample_count);
+		cycles.reserve(sample_count);
+		for (u32 sample = 0; sample < sample_count; sample += 1) {
+			const u64 start_cycles = CycleCounter::now();
+			const Instant start = Instant::now();
+			batch(iterations);
+			const u64 elapsed = start.elapsed().as_nanos();
+			const u64 elapsed_cycles = CycleCounter::now() - start_cycles;
+
+			nanos.push(static_cast<f64>(elapsed) / static_cast<f64>(iterations));
+			cycles.push(static_cast<f64>(elapsed_cycles) / static_cast<f64>(iterations));
+		}
+
+		m_result.iterations_per_sample = iterations;
+		m_result.samples = sample_count;
+		m_result.nanos = compute_stats(nanos);
+		m_result.cycles = compute_stats(cycles);
+	}
+
+	Option<BenchmarkResult> Bencher::result() const {
+		if (!m_ran) {
+			return nullopt;
+		}
+		return m_result;
+	}
+
+	static bool contains(StringView haystack, StringView needle) {
+		if (needle.len() == 0) {
+			return true;
+		}
+		for (usize start = 0; start + needle.len() <= haystack.len(); start += 1) {
+			if (haystack.substring(start, start + needle.len()) == needle) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Array<BenchmarkResult> Benchmark::run_all(BenchmarkOptions const& options) {
+		Formatter formatter{ File::stdout };
+
+		Array<BenchmarkResult> results;
+		for (auto const& benchmark : registered_benchmarks()) {
+			const StringView name = StringView::from_cstring(benchmark.name);
+			if (!contains(name, options.filter)) {
+				continue;
+			}
+
+			Bencher bencher{ options };
+			benchmark.function(bencher);
+
+			auto result = bencher.result();
+			if (!result.is_set()) {
+				formatter.format(u8"{yellow}{}{default}: never called Bencher::iter\n"_sv, name);
+				continue;
+			}
+
+			auto& pushed = results[results.push(result.unwrap())];
+			pushed.name = name;
+
+			formatter.format(
+				u8"{green}{}{default}\n    median {} ns  p99 {} ns  stddev {} ns  ({} cycles)  {} x {} iterations\n"_sv,
+				name,
+				pushed.nanos.median,
+				pushed.nanos.p99,
+				pushed.nanos.stddev,
+				pushed.cycles.median,
+				pushed.samples,
+				pushed.iterations_per_sample);
+			if (pushed.items > 0 && pushed.nanos.median > 0.0) {
+				const f64 per_second = static_cast<f64>(pushed.items) * 1000000000.0 / pushed.nanos.median;
+				formatter.format(u8"    {} items/s\n"_sv, per_second);
+			}
+		}
+
+		return results;
+	}
+
+	static void write_string(Writer& writer, StringView string) {
+		writer.write(u8"\""_sv);
+		for (const u8 byte : static_cast<Slice<UTF8Char const>>(string)) {
+			if (byte == '"' || byte == '\\') {
+				const u8 escaped[] = { '\\', byte };
+				writer.write(Slice<u8 const>{ escaped, 2 });
+			} else if (byte >= 0x20) {
+				writer.write(Slice<u8 const>{ &byte, 1 });
+			}
+		}
+		writer.write(u8"\""_sv);
+	}
+
+	static void write_stats(Writer& writer, StringView name, BenchmarkStats const& stats) {
+		write_string(writer, name);
+		writer.write(u8":{\"min\":"_sv);
+		print_double(writer, stats.min);
+		writer.write(u8",\"median\":"_sv);
+		print_double(writer, stats.median);
+		writer.write(u8",\"p99\":"_sv);
+		print_double(writer, stats.p99);
+		writer.write(u8",\"mean\":"_sv);
+		print_double(writer, stats.mean);
+		writer.write(u8",\"stddev\":"_sv);
+		print_double(writer, stats.stddev);
+		writer.write(u8"}"_sv);
+	}
+
+	void Benchmark::write_json(Writer& writer, Slice<BenchmarkResult const> results) {
+		writer.write(u8"{\"benchmarks\":["_sv);
+		for (usize index = 0; index < results.len(); index += 1) {
+			auto const& result = results[index];
+			writer.write(index == 0 ? u8"\n{\"name\":"_sv : u8",\n{\"name\":"_sv);
+			write_string(writer, result.name);
+			writer.write(u8",\"iterations_per_sample\":"_sv);
+			print_unsigned_integer(writer, result.iterations_per_sample);
+			writer.write(u8",\"samples\":"_sv);
+			print_unsigned_integer(writer, result.samples);
+			writer.write(u8",\"items\":"_sv);
+			print_unsigned_integer(writer, result.items);
+			writer.write(u8","_sv);
+			write_stats(writer, u8"ns"_sv, result.nanos);
+			writer.write(u8","_sv);
+			write_stats(writer, u8"cycles"_sv, result.cycles);
+			writer.write(u8"}"_sv);
+		}
+		writer.write(u8"\n]}\n"_sv);
+	}
+} // namespace Mach::Core
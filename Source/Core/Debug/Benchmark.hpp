@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/Function.hpp>
+#include <Core/Containers/StringView.hpp>
+#include <Core/IO/Writer.hpp>
+#include <Core/Time.hpp>
+
+#if MACH_COMPILER == MACH_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
+// Check if MACH_ENABLE_BENCHMARK is defined to determine if we should compile the benchmark code.
+#ifndef MACH_ENABLE_BENCHMARK
+	#define MACH_ENABLE_BENCHMARK 0
+#else
+	#define MACH_ENABLE_BENCHMARK 1
+#endif
+
+namespace Mach::Core {
+	// Forces value to be computed and kept, so work feeding a benchmark result is not removed as dead code
+	template <typename T>
+	MACH_ALWAYS_INLINE void do_not_optimize(T const& value) {
+#if MACH_COMPILER == MACH_COMPILER_MSVC
+		// MSVC has no inline asm on x64, reading through a volatile pointer is the closest equivalent
+		const volatile void* sink = &value;
+		MACH_UNUSED(sink);
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	// Like above but also assumes value was modified, which stops loop invariant inputs from being hoisted out of a
+	// benchmark body
+	template <typename T>
+	MACH_ALWAYS_INLINE void do_not_optimize(T& value) {
+#if MACH_COMPILER == MACH_COMPILER_MSVC
+		volatile void* sink = &value;
+		MACH_UNUSED(sink);
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : "+r,m"(value) : : "memory");
+#endif
+	}
+
+	// Forces all pending writes to memory to be treated as observable
+	MACH_ALWAYS_INLINE inline void clobber_memory() {
+#if MACH_COMPILER == MACH_COMPILER_MSVC
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+
+	struct BenchmarkStats {
+		f64 min;
+		f64 median;
+		f64 p99;
+		f64 mean;
+		f64 stddev;
+	};
+
+	struct BenchmarkResult {
+		StringView name;
+		u64 iterations_per_sample;
+		u32 samples;
+		// Per iteration
+		BenchmarkStats nanos;
+		BenchmarkStats cycles;
+		// Work items per iteration set through Bencher::set_items, zero when unset
+		u64 items;
+	};
+
+	struct BenchmarkOptions {
+		// Only benchmarks whose name contains filter are run
+		StringView filter;
+		// Time spent running before any sample is taken. Also used to calibrate the iteration count.
+		Duration warmup = Duration::from_millis(100);
+		// Each sample runs enough iterations to take at least this long, which keeps timer overhead out of the result
+		Duration sample_time = Duration::from_millis(10);
+		u32 samples = 50;
+	};
+
+	/**
+	 * Handed to every benchmark to time its body.
+	 *
+	 * The body passed to iter is run in batches. The batch size is doubled during warmup until a batch takes at least
+	 * BenchmarkOptions::sample_time, after which each batch is one sample. Return values of the body are passed through
+	 * do_not_optimize.
+	 */
+	class Bencher {
+	public:
+		explicit Bencher(BenchmarkOptions const& options) : m_options(options) {}
+		MACH_NO_COPY(Bencher);
+		MACH_NO_MOVE(Bencher);
+
+		template <typename F>
+		void iter(F&& f) {
+			run([&f](u64 iterations) {
+				for (u64 i = 0; i < iterations; i += 1) {
+					if constexpr (is_void<decltype(f())>) {
+						f();
+					} else {
+						do_not_optimize(f());
+					}
+				}
+			});
+		}
+
+		// Amount of work items one iteration processes. Reported as throughput.
+		MACH_ALWAYS_INLINE void set_items(u64 items) { m_result.items = items; }
+
+		// Only valid after iter was called
+		MACH_NO_DISCARD Option<BenchmarkResult> result() const;
+
+	private:
+		void run(FunctionRef<void(u64)> batch);
+
+		BenchmarkOptions const& m_options;
+		BenchmarkResult m_result = {};
+		bool m_ran = false;
+	};
+
+	using BenchmarkFunction = void (*)(Bencher& bencher);
+
+	// Registers a benchmark at static initialization. Used by MACH_BENCHMARK.
+	class BenchmarkRegistrar {
+	public:
+		explicit BenchmarkRegistrar(const char* name, BenchmarkFunction function);
+	};
+
+	class Benchmark {
+	public:
+		// Runs every registered benchmark matching the options in registration order, printing each to stdout as it
+		// completes
+		MACH_NO_DISCARD static Array<BenchmarkResult> run_all(BenchmarkOptions const& options);
+
+		// Writes results as a JSON document meant to be diffed between commits
+		static void write_json(Writer& writer, Slice<BenchmarkResult const> results);
+	};
+} // namespace Mach::Core
+
+#define _MACH_BENCHMARK_1(name, function, registrar)                                                                   \
+	static void function(Mach::Core::Bencher& bencher);                                                                \
+	static const Mach::Core::BenchmarkRegistrar registrar{ name, &function };                                          \
+	static void function(Mach::Core::Bencher& bencher)
+#define _MACH_BENCHMARK_2(name, counter)                                                                               \
+	_MACH_BENCHMARK_1(name, _MACH_DEFER_1(_benchmark_, counter), _MACH_DEFER_1(_benchmark_registrar_, counter))
+// Declares a benchmark. The body that follows receives a Bencher named bencher and must call bencher.iter once.
+#define MACH_BENCHMARK(name) _MACH_BENCHMARK_2(name, __COUNTER__)
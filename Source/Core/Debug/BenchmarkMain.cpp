@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/FileSystem/File.hpp>
+#include <Core/Format.hpp>
+
+using namespace Mach::Core;
+
+/**
+ * This file is the main.cpp for every library benchmark executable. It is included in all libraries that have
+ * benchmarks enabled when building their benchmark executable.
+ *
+ * Usage: <Library>Bench [--filter=<substring>] [--json=<path>] [--samples=<count>] [--warmup-ms=<ms>] [--sample-ms=<ms>]
+ *
+ * @see Source/Source.cmake for how to enable benchmarks on libraries.
+ */
+
+static Option<StringView> parse_flag(StringView arg, StringView flag) {
+	if (arg.len() < flag.len() || arg.substring(0, flag.len()) != flag) {
+		return nullopt;
+	}
+	return arg.substring(flag.len(), arg.len());
+}
+
+static Option<u64> parse_number(StringView string) {
+	if (string.len() == 0) {
+		return nullopt;
+	}
+	u64 result = 0;
+	for (const u8 byte : static_cast<Slice<UTF8Char const>>(string)) {
+		if (byte < '0' || byte > '9') {
+			return nullopt;
+		}
+		result = result * 10 + (byte - '0');
+	}
+	return result;
+}
+
+int main(int argc, char** argv) {
+	Formatter formatter{ File::stderr };
+
+	BenchmarkOptions options;
+	Option<StringView> json_path = nullopt;
+	for (int index = 1; index < argc; index += 1) {
+		const StringView arg = StringView::from_cstring(argv[index]);
+
+		if (auto filter = parse_flag(arg, u8"--filter="_sv); filter.is_set()) {
+			options.filter = filter.unwrap();
+		} else if (auto path = parse_flag(arg, u8"--json="_sv); path.is_set()) {
+			json_path = path.unwrap();
+		} else if (auto samples = parse_flag(arg, u8"--samples="_sv); samples.is_set()) {
+			auto count = parse_number(samples.unwrap());
+			if (!count.is_set() || count.unwrap() == 0) {
+				formatter.format(u8"{red}Invalid sample count{default}\n"_sv);
+				return 1;
+			}
+			options.samples = static_cast<u32>(count.unwrap());
+		} else if (auto warmup = parse_flag(arg, u8"--warmup-ms="_sv); warmup.is_set()) {
+			auto ms = parse_number(warmup.unwrap());
+			if (!ms.is_set()) {
+				formatter.format(u8"{red}Invalid warmup time{default}\n"_sv);
+				return 1;
+			}
+			options.warmup = Duration::from_millis(ms.unwrap());
+		} else if (auto sample = parse_flag(arg, u8"--sample-ms="_sv); sample.is_set()) {
+			auto ms = parse_number(sample.unwrap());
+			if (!ms.is_set() || ms.unwrap() == 0) {
+				formatter.format(u8"{red}Invalid sample time{default}\n"_sv);
+				return 1;
+			}
+			options.sample_time = Duration::from_millis(ms.unwrap());
+		} else {
+			formatter.format(u8"{red}Unknown argument{default} {}\n"_sv, arg);
+			return 1;
+		}
+	}
+
+	const auto results = Benchmark::run_all(options);
+
+	if (json_path.is_set()) {
+		auto file = File::open(json_path.unwrap(), OpenFlags::Write | OpenFlags::Create);
+		if (!file.is_set()) {
+			formatter.format(u8"{red}Failed to open{default} {}\n"_sv, json_path.unwrap());
+			return 1;
+		}
+		BufferedWriter<4096> buffered{ file.as_ref().unwrap() };
+		Benchmark::write_json(buffered, results.as_const_slice());
+		buffered.flush();
+	}
+
+	return 0;
+}
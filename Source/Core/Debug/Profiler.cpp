@@ -0,0 +1,417 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Profiler.hpp>
+
+#include <Core/Async/Mutex.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+
+namespace Mach::Core {
+	struct ProfileBuffer {
+		static constexpr u64 capacity = 64 * 1024;
+		static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+		UniquePtr<ProfileEvent[]> events = UniquePtr<ProfileEvent[]>::create(capacity);
+		u16 thread = 0;
+		// Set by the owning thread as it exits, after its last event
+		Atomic<bool> retired{ false };
+
+		// Written by the owning thread
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<u64> head{ 0 };
+		Atomic<u64> dropped{ 0 };
+		// Written by the reader
+		alignas(MACH_CACHE_LINE_SIZE) Atomic<u64> tail{ 0 };
+	};
+
+	struct ProfileBuffers {
+		// Buffers of live threads and of exited threads whose events have not all been drained yet
+		Array<UniquePtr<ProfileBuffer>> active;
+		// Drained buffers of exited threads. The next thread to record takes one over along with its thread index, so
+		// programs that keep spawning threads stay bounded by how many run at once.
+		Array<UniquePtr<ProfileBuffer>> free;
+	};
+
+	static Atomic<bool> g_profile_enabled{ false };
+	static SpinlockMutex<ProfileBuffers> g_profile_buffers{ ProfileBuffers{} };
+
+	// Marks the thread's buffer as retired when the thread exits so drain can recycle it
+	struct ProfileBufferOwner {
+		ProfileBuffer* buffer = nullptr;
+
+		~ProfileBufferOwner() {
+			if (buffer != nullptr) {
+				buffer->retired.store(true, Order::Release);
+			}
+		}
+	};
+
+	thread_local ProfileBufferOwner g_profile_owner;
+	thread_local Option<u32> g_profile_fiber = nullopt;
+
+	static ProfileBuffer& current_buffer() {
+		if (g_profile_owner.buffer == nullptr) {
+			auto buffers = g_profile_buffers.lock();
+			auto recycled = buffers->free.pop();
+			UniquePtr<ProfileBuffer> buffer;
+			if (recycled.is_set()) {
+				buffer = recycled.unwrap();
+				buffer->retired.store(false, Order::Relaxed);
+			} else {
+				// Recycled buffers keep their index, so every index below the buffer count is taken
+				const usize index = buffers->active.len() + buffers->free.len();
+				MACH_ASSERT(index <= NumericLimits<u16>::max(), "Too many threads recording profile events at once");
+				buffer = UniquePtr<ProfileBuffer>::create();
+				buffer->thread = static_cast<u16>(index);
+			}
+			g_profile_owner.buffer = &*buffer;
+			buffers->active.push(Mach::move(buffer));
+		}
+		return *g_profile_owner.buffer;
+	}
+
+	// Space kept free for events that close what is already open, so a full buffer refuses new zones instead of
+	// losing the end of one that was recorded
+	static constexpr u64 g_closing_reserve = ProfileBuffer::capacity / 8;
+
+	static bool record(ProfileEventKind kind, ProfileSite const* site, u64 reserve) {
+		auto& buffer = current_buffer();
+		if (!g_profile_fiber.is_set()) {
+			g_profile_fiber = ProfileEvent::thread_fiber_bit | buffer.thread;
+		}
+
+		const u64 head = buffer.head.load(Order::Relaxed);
+		const u64 tail = buffer.tail.load(Order::Acquire);
+		if (head - tail + reserve >= ProfileBuffer::capacity) {
+			const auto unused = buffer.dropped.fetch_add(1, Order::Relaxed);
+			MACH_UNUSED(unused);
+			return false;
+		}
+
+		buffer.events[head & (ProfileBuffer::capacity - 1)] = ProfileEvent{
+			.cycles = CycleCounter::now(),
+			.site = site,
+			.fiber = g_profile_fiber.unwrap(),
+			.thread = buffer.thread,
+			.kind = kind,
+		};
+		buffer.head.store(head + 1, Order::Release);
+		return true;
+	}
+
+	void Profiler::set_enabled(bool enabled) { g_profile_enabled.store(enabled, Order::Release); }
+
+	bool Profiler::is_enabled() { return g_profile_enabled.load(Order::Relaxed); }
+
+	bool Profiler::begin_zone(ProfileSite const& site) {
+		return record(ProfileEventKind::ZoneBegin, &site, g_closing_reserve);
+	}
+
+	void Profiler::end_zone(ProfileSite const& site) {
+		const bool unused = record(ProfileEventKind::ZoneEnd, &site, 0);
+		MACH_UNUSED(unused);
+	}
+
+	void Profiler::mark(ProfileSite const& site) {
+		if (is_enabled()) {
+			const bool unused = record(ProfileEventKind::Mark, &site, g_closing_reserve);
+			MACH_UNUSED(unused);
+		}
+	}
+
+	void Profiler::switch_fiber(u32 fiber) {
+		// Always track the fiber so zones are tagged correctly if profiling is enabled later
+		g_profile_fiber = fiber;
+		if (is_enabled()) {
+			const bool unused = record(ProfileEventKind::FiberSwitch, nullptr, g_closing_reserve);
+			MACH_UNUSED(unused);
+		}
+	}
+
+	void Profiler::mark_frame() {
+		if (is_enabled()) {
+			const bool unused = record(ProfileEventKind::FrameMark, nullptr, 0);
+			MACH_UNUSED(unused);
+		}
+	}
+
+	u64 Profiler::drain(Array<ProfileEvent>& events) {
+		struct Range {
+			usize at;
+			usize end;
+		};
+
+		// Copy out of every buffer first so the ring space is handed back as soon as possible
+		Array<ProfileEvent> pending;
+		Array<Range> ranges;
+		u64 dropped = 0;
+		{
+			auto buffers = g_profile_buffers.lock();
+			usize buffer_index = 0;
+			while (buffer_index < buffers->active.len()) {
+				auto& buffer = buffers->active[buffer_index];
+				// Read before head so a retired buffer is known to have nothing past it
+				const bool retired = buffer->retired.load(Order::Acquire);
+				const u64 head = buffer->head.load(Order::Acquire);
+				const u64 tail = buffer->tail.load(Order::Relaxed);
+				if (head != tail) {
+					const usize start = pending.len();
+					for (u64 index = tail; index < head; index += 1) {
+						pending.push(buffer->events[index & (ProfileBuffer::capacity - 1)]);
+					}
+					ranges.push(Range{ .at = start, .end = pending.len() });
+
+					buffer->tail.store(head, Order::Release);
+				}
+				dropped += buffer->dropped.exchange(0, Order::Relaxed);
+
+				if (retired) {
+					buffers->free.push(buffers->active.remove(buffer_index));
+				} else {
+					buffer_index += 1;
+				}
+			}
+		}
+
+		// Every buffer is already in order as it only has a single writer, so merge them by timestamp
+		// Array::reserve asks for additional space, the caller usually hands back an array that already has some
+		const usize available = events.cap() - events.len();
+		if (available < pending.len()) {
+			events.reserve(pending.len() - available);
+		}
+		while (true) {
+			Option<usize> next = nullopt;
+			for (usize index = 0; index < ranges.len(); index += 1) {
+				auto const& range = ranges[index];
+				if (range.at == range.end) {
+					continue;
+				}
+				if (!next.is_set() || pending[range.at].cycles < pending[ranges[next.unwrap()].at].cycles) {
+					next = index;
+				}
+			}
+			if (!next.is_set()) {
+				break;
+			}
+
+			auto& range = ranges[next.unwrap()];
+			events.push(pending[range.at]);
+			range.at += 1;
+		}
+
+		return dropped;
+	}
+
+	ProfileCollector::ProfileCollector() : m_frame{ .index = 0 } { Profiler::set_enabled(true); }
+
+	ProfileCollector::~ProfileCollector() { Profiler::set_enabled(false); }
+
+	Array<ProfileFrame> ProfileCollector::collect() {
+		m_events.reset();
+		m_frame.dropped_events += Profiler::drain(m_events);
+
+		Array<ProfileFrame> frames;
+		for (auto const& event : m_events) {
+			if (!m_frame_begin.is_set()) {
+				m_frame_begin = event.cycles;
+			}
+
+			switch (event.kind) {
+			case ProfileEventKind::ZoneBegin:
+				fiber_stack(event.fiber).zones.push(OpenZone{ .site = event.site, .begin = event.cycles, .children = 0 });
+				break;
+			case ProfileEventKind::ZoneEnd: {
+				// Zones whose end was lost are closed along with the zone that encloses them. An end without a matching
+				// begin was opened before profiling was enabled and is skipped.
+				auto& stack = fiber_stack(event.fiber);
+				for (usize index = stack.zones.len(); index > 0; index -= 1) {
+					if (stack.zones[index - 1].site == event.site) {
+						while (stack.zones.len() >= index) {
+							close_zone(stack, event.cycles);
+						}
+						break;
+					}
+				}
+			} break;
+			case ProfileEventKind::Mark:
+				break;
+			case ProfileEventKind::FiberSwitch:
+				m_frame.fiber_switches += 1;
+				break;
+			case ProfileEventKind::FrameMark: {
+				const u64 begin = m_frame_begin.unwrap();
+				m_frame.duration = CycleCounter::to_duration(event.cycles > begin ? event.cycles - begin : 0);
+
+				const u64 next_index = m_frame.index + 1;
+				frames.push(Mach::move(m_frame));
+				m_frame = ProfileFrame{ .index = next_index };
+				m_frame_begin = event.cycles;
+			} break;
+			}
+		}
+
+		return frames;
+	}
+
+	ProfileCollector::FiberStack& ProfileCollector::fiber_stack(u32 fiber) {
+		for (auto& stack : m_fibers) {
+			if (stack.fiber == fiber) {
+				return stack;
+			}
+		}
+		const usize index = m_fibers.push(FiberStack{ .fiber = fiber });
+		return m_fibers[index];
+	}
+
+	void ProfileCollector::close_zone(FiberStack& stack, u64 end) {
+		const auto zone = stack.zones.pop().unwrap();
+		const u64 total = end > zone.begin ? end - zone.begin : 0;
+		const u64 self = total > zone.children ? total - zone.children : 0;
+
+		// Walk the path of open zones down from the root, adding nodes for any part of it not seen this frame
+		auto& nodes = m_frame.nodes;
+		u32 parent = ProfileNode::no_parent;
+		const usize depth = stack.zones.len();
+		for (usize level = 0; level <= depth; level += 1) {
+			ProfileSite const* site = level < depth ? stack.zones[level].site : zone.site;
+
+			// Children always come after their parent
+			const usize first = parent == ProfileNode::no_parent ? 0 : parent + 1;
+			Option<u32> found = nullopt;
+			for (usize index = first; index < nodes.len(); index += 1) {
+				if (nodes[index].parent == parent && nodes[index].site == site) {
+					found = static_cast<u32>(index);
+					break;
+				}
+			}
+			if (!found.is_set()) {
+				found = static_cast<u32>(nodes.push(ProfileNode{
+					.site = site,
+					.parent = parent,
+					.depth = static_cast<u32>(level),
+					.calls = 0,
+					.total = Duration{},
+					.self = Duration{},
+				}));
+			}
+			parent = found.unwrap();
+		}
+
+		auto& node = nodes[parent];
+		node.calls += 1;
+		node.total += CycleCounter::to_duration(total);
+		node.self += CycleCounter::to_duration(self);
+
+		auto outer = stack.zones.last();
+		if (outer.is_set()) {
+			outer.unwrap().children += total;
+		}
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Async/Thread.hpp>
+	#include <Core/Debug/Test.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("Profiler") {
+		ProfileCollector collector;
+
+		static constexpr ProfileSite outer{ "outer", __FILE__, __LINE__ };
+		static constexpr ProfileSite inner{ "inner", __FILE__, __LINE__ };
+
+		auto spin = [](u64 cycles) {
+			const u64 start = CycleCounter::now();
+			while (CycleCounter::now() - start < cycles) {}
+		};
+
+		Profiler::mark_frame();
+		{
+			const ProfileScope a{ outer };
+			for (int i = 0; i < 3; i += 1) {
+				const ProfileScope b{ inner };
+				spin(1000);
+			}
+			spin(1000);
+		}
+		Profiler::mark_frame();
+
+		auto frames = collector.collect();
+		MACH_REQUIRE(frames.len() == 2);
+		MACH_CHECK(frames[0].nodes.len() == 0);
+
+		auto const& frame = frames[1];
+		MACH_CHECK(frame.index == 1);
+		MACH_CHECK(frame.dropped_events == 0);
+		MACH_REQUIRE(frame.nodes.len() == 2);
+
+		auto const& root = frame.nodes[0];
+		auto const& child = frame.nodes[1];
+		MACH_CHECK(root.site == &outer);
+		MACH_CHECK(root.parent == ProfileNode::no_parent);
+		MACH_CHECK(root.calls == 1);
+		MACH_CHECK(child.site == &inner);
+		MACH_CHECK(child.parent == 0);
+		MACH_CHECK(child.depth == 1);
+		MACH_CHECK(child.calls == 3);
+		MACH_CHECK(child.self == child.total);
+		MACH_CHECK(root.total >= root.self + child.total);
+		MACH_CHECK(frame.duration >= root.total);
+
+		MACH_SUBCASE("recycles buffers of exited threads") {
+			static constexpr ProfileSite on_thread{ "on_thread", __FILE__, __LINE__ };
+
+			// Returns the thread index the event was recorded with
+			auto record_on_thread = [] {
+				auto thread = Thread::spawn([] { Profiler::mark(on_thread); });
+				thread.unsafe_get_mut().join();
+
+				Array<ProfileEvent> events;
+				const u64 dropped = Profiler::drain(events);
+				MACH_UNUSED(dropped);
+
+				Option<u16> thread_index = nullopt;
+				for (auto const& event : events) {
+					if (event.site == &on_thread) {
+						thread_index = event.thread;
+					}
+				}
+				return thread_index;
+			};
+
+			const auto first = record_on_thread();
+			MACH_REQUIRE(first.is_set());
+			for (u32 i = 0; i < 8; i += 1) {
+				const auto next = record_on_thread();
+				MACH_REQUIRE(next.is_set());
+				MACH_CHECK(next.unwrap() == first.unwrap());
+			}
+		}
+
+		MACH_SUBCASE("zones follow fibers") {
+			// A zone that begins on one fiber is unaffected by zones recorded for another fiber in between
+			Profiler::switch_fiber(7);
+			MACH_CHECK(Profiler::begin_zone(outer));
+			Profiler::switch_fiber(8);
+			MACH_CHECK(Profiler::begin_zone(inner));
+			Profiler::switch_fiber(7);
+			Profiler::end_zone(outer);
+			Profiler::switch_fiber(8);
+			Profiler::end_zone(inner);
+			Profiler::mark_frame();
+
+			auto fiber_frames = collector.collect();
+			MACH_REQUIRE(fiber_frames.len() == 1);
+			auto const& nodes = fiber_frames[0].nodes;
+			MACH_REQUIRE(nodes.len() == 2);
+			MACH_CHECK(nodes[0].depth == 0);
+			MACH_CHECK(nodes[1].depth == 0);
+			MACH_CHECK(fiber_frames[0].fiber_switches == 4);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Time.hpp>
+
+// Zones compile away entirely when MACH_ENABLE_PROFILE is 0
+#ifndef MACH_ENABLE_PROFILE
+	#define MACH_ENABLE_PROFILE 1
+#endif
+
+namespace Mach::Core {
+	// Static description of where a zone lives in the source. Must outlive the profiler, which the macros guarantee.
+	struct ProfileSite {
+		const char* name;
+		const char* file;
+		u32 line;
+	};
+
+	enum class ProfileEventKind : u8 {
+		ZoneBegin,
+		ZoneEnd,
+		// Point in time without a duration such as a job being enqueued
+		Mark,
+		// The recording thread started running another fiber. ProfileEvent::fiber is the fiber switched to.
+		FiberSwitch,
+		FrameMark,
+	};
+
+	struct ProfileEvent {
+		// CycleCounter timestamp
+		u64 cycles;
+		// Set for zone events only
+		ProfileSite const* site;
+		// Scheduler fiber index, or thread_fiber_bit with the thread index for threads not running fibers
+		u32 fiber;
+		u16 thread;
+		ProfileEventKind kind;
+
+		static constexpr u32 thread_fiber_bit = 1u << 31;
+	};
+
+	/**
+	 * Records zones into per thread buffers that are drained by a single reader.
+	 *
+	 * Every thread that records gets its own single producer ring buffer on first use, so recording never takes a lock or
+	 * touches a cache line another thread writes. Events are tagged with the fiber running at the time, which lets a zone
+	 * begin on one thread and end on another after its fiber was moved by the Scheduler. When a buffer is nearly full
+	 * new zones are dropped and counted rather than blocking the thread, while ends of zones already recorded still fit.
+	 *
+	 * Nothing is recorded until enabled, ProfileCollector and TraceWriter do that for their lifetime.
+	 */
+	class Profiler {
+	public:
+		static void set_enabled(bool enabled);
+		MACH_NO_DISCARD static bool is_enabled();
+
+		// Returns false if the zone was dropped, in which case end_zone must not be called for it
+		static bool begin_zone(ProfileSite const& site);
+		static void end_zone(ProfileSite const& site);
+		static void mark(ProfileSite const& site);
+		// Called by the Scheduler right before it switches the current thread over to fiber
+		static void switch_fiber(u32 fiber);
+		// Marks the start of a new frame. Called once per frame by the main loop.
+		static void mark_frame();
+
+		// Appends every pending event from every thread to events in timestamp order and returns the amount of events
+		// dropped since the last drain. Must only be called by one thread at a time. Recording threads are not blocked.
+		static u64 drain(Array<ProfileEvent>& events);
+	};
+
+	class ProfileScope {
+	public:
+		MACH_ALWAYS_INLINE explicit ProfileScope(ProfileSite const& site)
+			: m_site(site)
+			, m_active(Profiler::is_enabled() && Profiler::begin_zone(site)) {}
+		MACH_NO_COPY(ProfileScope);
+		MACH_NO_MOVE(ProfileScope);
+		MACH_ALWAYS_INLINE ~ProfileScope() {
+			if (m_active) Profiler::end_zone(m_site);
+		}
+
+	private:
+		ProfileSite const& m_site;
+		bool m_active;
+	};
+
+	// Aggregated call tree entry. Zones with the same site under the same parent are merged.
+	struct ProfileNode {
+		static constexpr u32 no_parent = 0xFFFFFFFF;
+
+		ProfileSite const* site;
+		// Index of the parent in ProfileFrame::nodes. Parents always come before their children.
+		u32 parent;
+		u32 depth;
+		u32 calls;
+		Duration total;
+		// Total minus the time spent in child zones
+		Duration self;
+	};
+
+	struct ProfileFrame {
+		u64 index;
+		Duration duration;
+		u32 fiber_switches;
+		// Non zero when buffers overflowed, in which case zones in this frame may be missing or misattributed
+		u64 dropped_events;
+		Array<ProfileNode> nodes;
+	};
+
+	/**
+	 * Builds per frame call trees from the recorded zones.
+	 *
+	 * Zones on every thread and fiber are merged into a single tree per frame and are attributed to the frame they end
+	 * in. A frame is complete once the next frame has been marked. Only one collector or TraceWriter may exist at a
+	 * time as both drain the Profiler.
+	 */
+	class ProfileCollector {
+	public:
+		explicit ProfileCollector();
+		MACH_NO_COPY(ProfileCollector);
+		MACH_NO_MOVE(ProfileCollector);
+		~ProfileCollector();
+
+		// Drains the profiler and returns the frames completed since the last call
+		MACH_NO_DISCARD Array<ProfileFrame> collect();
+
+	private:
+		struct OpenZone {
+			ProfileSite const* site;
+			u64 begin;
+			u64 children;
+		};
+		struct FiberStack {
+			u32 fiber;
+			Array<OpenZone> zones;
+		};
+
+		FiberStack& fiber_stack(u32 fiber);
+		void close_zone(FiberStack& stack, u64 end);
+
+		Array<ProfileEvent> m_events;
+		Array<FiberStack> m_fibers;
+		ProfileFrame m_frame;
+		Option<u64> m_frame_begin;
+	};
+} // namespace Mach::Core
+
+#if MACH_ENABLE_PROFILE
+	#define _MACH_PROFILE_SCOPE_1(name, site, scope)                                                                   \
+		static constexpr Mach::Core::ProfileSite site{ name, __FILE__, __LINE__ };                                     \
+		const Mach::Core::ProfileScope scope{ site }
+	#define _MACH_PROFILE_SCOPE_2(name, counter)                                                                       \
+		_MACH_PROFILE_SCOPE_1(name, _MACH_DEFER_1(_profile_site_, counter), _MACH_DEFER_1(_profile_scope_, counter))
+	// Records a zone from here to the end of the enclosing scope. name must be a string literal.
+	#define MACH_PROFILE_SCOPE(name) _MACH_PROFILE_SCOPE_2(name, __COUNTER__)
+	#define MACH_PROFILE_FUNCTION()	 MACH_PROFILE_SCOPE(MACH_FUNCTION_NAME)
+	#define MACH_PROFILE_FRAME()	 Mach::Core::Profiler::mark_frame()
+	// Records a point in time. name must be a string literal.
+	#define MACH_PROFILE_MARK(name)                                                                                    \
+		do {                                                                                                           \
+			static constexpr Mach::Core::ProfileSite _profile_site_{ name, __FILE__, __LINE__ };                       \
+			Mach::Core::Profiler::mark(_profile_site_);                                                                \
+		} while (false)
+#else
+	#define MACH_PROFILE_SCOPE(name) ((void)0)
+	#define MACH_PROFILE_FUNCTION()	 ((void)0)
+	#define MACH_PROFILE_FRAME()	 ((void)0)
+	#define MACH_PROFILE_MARK(name)	 ((void)0)
+#endif
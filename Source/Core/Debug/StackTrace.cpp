@@ -13,8 +13,8 @@
 	#include <DbgHelp.h>
 
 namespace Mach::Core::StackTrace {
-	Array<Frame> capture() {
-		Array<Frame> result;
+	Frames capture() {
+		Frames result;
 
 	#if 1
 		constexpr int max_frames = 128;
@@ -28,7 +28,7 @@ namespace Mach::Core::StackTrace {
 		HANDLE process = ::GetCurrentProcess();
 		::SymInitialize(process, nullptr, TRUE);
 
-		result.reserve(max_frames);
+		result.reserve(static_cast<usize>(frame_count));
 
 		for (int i = 0; i < frame_count; ++i) {
 			::SymFromAddr(process, (DWORD64)(stack_frames[i]), 0, symbol);
@@ -49,16 +49,16 @@ namespace Mach::Core::StackTrace {
 	#include <execinfo.h>
 
 namespace Mach::Core::StackTrace {
-	Array<Frame> capture() {
+	Frames capture() {
 		constexpr int max_frames = 128;
-		Array<Frame> result;
+		Frames result;
 
 		void* stack_frames[max_frames];
 		const int frame_count = backtrace(stack_frames, max_frames);
 
 		char** symbols = backtrace_symbols(stack_frames, frame_count);
 		if (symbols) {
-			result.reserve(max_frames);
+			result.reserve(static_cast<usize>(frame_count));
 
 			for (int i = 0; i < frame_count; ++i) {
 				const StringView as((const UTF8Char*)symbols[i], strlen(symbols[i]));
@@ -12,5 +12,9 @@
 
 namespace Mach::Core::StackTrace {
 	using Frame = String;
-	Array<Frame> capture();
+
+	// Deep enough for most traces without touching the heap for the array itself
+	using Frames = Array<Frame, SmallAllocator<32>>;
+
+	Frames capture();
 } // namespace Mach::Core::StackTrace
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/TempDirectory.hpp>
+#include <Core/FileSystem/File.hpp>
+#include <Core/Time.hpp>
+
+#include <filesystem>
+
+namespace Mach::Core {
+	static std::filesystem::path to_std_path(StringView path) {
+		return std::filesystem::path{ std::u8string_view{ *path, path.len() } };
+	}
+
+	Option<TempDirectory> TempDirectory::create() {
+		std::error_code error;
+		const auto root = std::filesystem::temp_directory_path(error);
+		if (error) {
+			return nullopt;
+		}
+
+		// Retries on the rare collision with another process that picked the same name
+		for (u32 attempt = 0; attempt < 16; attempt += 1) {
+			const auto name = String::format(u8"machina-{}-{}"_sv, CycleCounter::now(), attempt);
+			const auto path = root / to_std_path(name);
+			if (std::filesystem::create_directory(path, error)) {
+				const auto generic = path.generic_u8string();
+				return TempDirectory{ String::from(StringView{ generic.data(), generic.size() }) };
+			}
+		}
+		return nullopt;
+	}
+
+	TempDirectory::~TempDirectory() {
+		if (m_path.len() == 0) {
+			return;
+		}
+		std::error_code error;
+		const auto removed = std::filesystem::remove_all(to_std_path(m_path), error);
+		MACH_UNUSED(removed);
+	}
+
+	String TempDirectory::join(StringView relative) const { return String::format(u8"{}/{}"_sv, m_path, relative); }
+
+	bool TempDirectory::create_directory(StringView relative) const {
+		std::error_code error;
+		const bool created = std::filesystem::create_directories(to_std_path(join(relative)), error);
+		MACH_UNUSED(created);
+		return !error;
+	}
+
+	bool TempDirectory::write_file(StringView relative, Slice<u8 const> bytes) const {
+		auto file = File::open(join(relative), OpenFlags::Write | OpenFlags::Create);
+		if (!file.is_set()) {
+			return false;
+		}
+		return file.unwrap().write(bytes) == bytes.len();
+	}
+} // namespace Mach::Core
@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Slice.hpp>
+#include <Core/Containers/String.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Uniquely named directory under the system temp directory that is removed, along with everything inside it, when
+	 * destroyed. Meant for tests that need real files on disk.
+	 */
+	class TempDirectory {
+	public:
+		MACH_NO_DISCARD static Option<TempDirectory> create();
+
+		MACH_NO_COPY(TempDirectory);
+		// String only copies, so clear the source to keep it from removing the directory as well
+		TempDirectory(TempDirectory&& move) noexcept : m_path(move.m_path) { move.m_path = String{}; }
+		TempDirectory& operator=(TempDirectory&& move) = delete;
+		~TempDirectory();
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE StringView path() const { return m_path; }
+
+		// Path of relative inside the directory. Uses forward slashes on every platform.
+		MACH_NO_DISCARD String join(StringView relative) const;
+
+		// Creates relative and any missing parents
+		bool create_directory(StringView relative) const;
+		bool write_file(StringView relative, Slice<u8 const> bytes) const;
+
+	private:
+		explicit TempDirectory(String&& path) : m_path(Mach::move(path)) {}
+
+		String m_path;
+	};
+} // namespace Mach::Core
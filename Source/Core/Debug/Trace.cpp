@@ -0,0 +1,257 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Trace.hpp>
+
+#include <Core/Format.hpp>
+
+namespace Mach::Core {
+	// Worker thread tracks are kept clear of fiber tracks, which use the fiber index as their id
+	static constexpr u64 thread_track_base = 1ull << 32;
+
+	TraceWriter::TraceWriter(Writer& dest, Options const& options)
+		: m_buffered(dest)
+		, m_flush_interval(options.flush_interval) {
+		write(u8"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"_sv);
+
+		Profiler::set_enabled(true);
+		m_thread = Thread::spawn([this]() { writer_main(); }, Thread::SpawnInfo{ .name = u8"Trace Writer"_sv });
+	}
+
+	TraceWriter::~TraceWriter() { finish(); }
+
+	void TraceWriter::finish() {
+		if (m_finished) {
+			return;
+		}
+		m_finished = true;
+
+		Profiler::set_enabled(false);
+		m_running.store(false, Order::Release);
+		m_thread.unsafe_get_mut().join();
+
+		write_pending();
+
+		// Close whatever each worker was running when capture stopped
+		for (auto& track : m_threads) {
+			close_thread_slice(track, m_last_cycles);
+		}
+		write(u8"\n]}\n"_sv);
+		m_buffered.flush();
+	}
+
+	void TraceWriter::writer_main() {
+		while (m_running.load(Order::Acquire)) {
+			Thread::sleep(m_flush_interval);
+			write_pending();
+			m_buffered.flush();
+		}
+	}
+
+	void TraceWriter::write_pending() {
+		m_events.reset();
+		const u64 dropped = Profiler::drain(m_events);
+		for (auto const& event : m_events) {
+			write_event(event);
+		}
+
+		if (dropped > 0 && m_events.len() > 0) {
+			// Flag the loss in the trace itself so gaps are not mistaken for idle time
+			begin_event(u8"i"_sv, m_events[m_events.len() - 1].fiber, m_events[m_events.len() - 1].cycles);
+			write(u8",\"s\":\"g\",\"name\":\"Profiler dropped events\",\"args\":{\"count\":"_sv);
+			print_unsigned_integer(m_buffered, dropped);
+			write(u8"}}"_sv);
+		}
+	}
+
+	void TraceWriter::write_event(ProfileEvent const& event) {
+		if (!m_base_cycles.is_set()) {
+			m_base_cycles = event.cycles;
+		}
+		if (event.cycles > m_last_cycles) {
+			m_last_cycles = event.cycles;
+		}
+
+		if (!(event.fiber & ProfileEvent::thread_fiber_bit)) {
+			name_track(event.fiber, u8"Fiber "_sv, event.fiber);
+		} else {
+			name_track(event.fiber, u8"Thread "_sv, event.thread);
+		}
+
+		switch (event.kind) {
+		case ProfileEventKind::ZoneBegin:
+			begin_event(u8"B"_sv, event.fiber, event.cycles);
+			write_name(event.site->name);
+			write(u8"}"_sv);
+			break;
+		case ProfileEventKind::ZoneEnd:
+			begin_event(u8"E"_sv, event.fiber, event.cycles);
+			write(u8"}"_sv);
+			break;
+		case ProfileEventKind::Mark:
+			begin_event(u8"i"_sv, event.fiber, event.cycles);
+			write(u8",\"s\":\"t\""_sv);
+			write_name(event.site->name);
+			write(u8"}"_sv);
+			break;
+		case ProfileEventKind::FrameMark:
+			begin_event(u8"i"_sv, event.fiber, event.cycles);
+			write(u8",\"s\":\"g\",\"name\":\"Frame\"}"_sv);
+			break;
+		case ProfileEventKind::FiberSwitch: {
+			const u64 tid = thread_track_base + event.thread;
+			name_track(tid, u8"Worker "_sv, event.thread);
+
+			Option<usize> found = nullopt;
+			for (usize index = 0; index < m_threads.len(); index += 1) {
+				if (m_threads[index].thread == event.thread) {
+					found = index;
+					break;
+				}
+			}
+
+			if (found.is_set()) {
+				auto& track = m_threads[found.unwrap()];
+				close_thread_slice(track, event.cycles);
+				track.fiber = event.fiber;
+				track.since = event.cycles;
+			} else {
+				m_threads.push(ThreadTrack{ .thread = event.thread, .fiber = event.fiber, .since = event.cycles });
+			}
+		} break;
+		}
+	}
+
+	void TraceWriter::close_thread_slice(ThreadTrack const& track, u64 end) {
+		// Emit what the thread ran since its last switch as a complete slice
+		begin_event(u8"X"_sv, thread_track_base + track.thread, track.since);
+		write(u8",\"dur\":"_sv);
+		write_micros(end > track.since ? CycleCounter::to_duration(end - track.since).as_nanos() : 0);
+		write(u8",\"name\":\""_sv);
+		if (track.fiber & ProfileEvent::thread_fiber_bit) {
+			write(u8"Thread\"}"_sv);
+		} else {
+			write(u8"Fiber "_sv);
+			print_unsigned_integer(m_buffered, track.fiber);
+			write(u8"\"}"_sv);
+		}
+	}
+
+	void TraceWriter::write(StringView string) {
+		// BufferedWriter hides the StringView overload of Writer
+		static_cast<Writer&>(m_buffered).write(string);
+	}
+
+	void TraceWriter::begin_event(StringView phase, u64 tid, u64 cycles) {
+		if (m_first_event) {
+			m_first_event = false;
+		} else {
+			write(u8",\n"_sv);
+		}
+		write(u8"{\"ph\":\""_sv);
+		write(phase);
+		write(u8"\",\"pid\":0,\"tid\":"_sv);
+		print_unsigned_integer(m_buffered, tid);
+		write(u8",\"ts\":"_sv);
+		write_timestamp(cycles);
+	}
+
+	void TraceWriter::write_name(const char* name) {
+		write(u8",\"name\":\""_sv);
+		for (const char* c = name; *c != 0; c += 1) {
+			const u8 byte = static_cast<u8>(*c);
+			if (byte == '"' || byte == '\\') {
+				const u8 escaped[] = { '\\', byte };
+				m_buffered.write(Slice<u8 const>{ escaped, 2 });
+			} else if (byte >= 0x20) {
+				m_buffered.write(Slice<u8 const>{ &byte, 1 });
+			}
+		}
+		write(u8"\""_sv);
+	}
+
+	void TraceWriter::write_timestamp(u64 cycles) {
+		// Relative to the first event so the numbers stay small
+		const u64 base = m_base_cycles.is_set() ? m_base_cycles.unwrap() : cycles;
+		write_micros(cycles > base ? CycleCounter::to_duration(cycles - base).as_nanos() : 0);
+	}
+
+	void TraceWriter::write_micros(u64 nanos) {
+		// Trace event times are in microseconds, keep the nanoseconds as a fraction
+		print_unsigned_integer(m_buffered, nanos / nanos_per_micro);
+
+		const u64 fraction = nanos % nanos_per_micro;
+		const u8 digits[] = {
+			'.',
+			static_cast<u8>('0' + fraction / 100),
+			static_cast<u8>('0' + fraction / 10 % 10),
+			static_cast<u8>('0' + fraction % 10),
+		};
+		m_buffered.write(Slice<u8 const>{ digits, 4 });
+	}
+
+	void TraceWriter::name_track(u64 tid, StringView prefix, u64 number) {
+		for (const u64 named : m_named_tracks) {
+			if (named == tid) {
+				return;
+			}
+		}
+		m_named_tracks.push(tid);
+
+		if (m_first_event) {
+			m_first_event = false;
+		} else {
+			write(u8",\n"_sv);
+		}
+		write(u8"{\"ph\":\"M\",\"pid\":0,\"name\":\"thread_name\",\"tid\":"_sv);
+		print_unsigned_integer(m_buffered, tid);
+		write(u8",\"args\":{\"name\":\""_sv);
+		write(prefix);
+		print_unsigned_integer(m_buffered, number);
+		write(u8"\"}}"_sv);
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/Test.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("TraceWriter") {
+		Array<u8> output;
+		ArrayWriter writer{ output };
+
+		static constexpr ProfileSite zone{ "trace \"zone\"", __FILE__, __LINE__ };
+		{
+			TraceWriter trace{ writer, TraceWriter::Options{ .flush_interval = Duration::from_millis(1) } };
+			Profiler::switch_fiber(3);
+			{
+				const ProfileScope scope{ zone };
+			}
+			Profiler::mark_frame();
+		}
+
+		const StringView json{ reinterpret_cast<const UTF8Char*>(output.begin()), output.len() };
+		auto contains = [&](StringView needle) {
+			for (usize start = 0; start + needle.len() <= json.len(); start += 1) {
+				if (json.substring(start, start + needle.len()) == needle) {
+					return true;
+				}
+			}
+			return false;
+		};
+
+		MACH_CHECK(json.substring(0, 15) == u8"{\"displayTimeUn"_sv);
+		MACH_CHECK(json.substring(json.len() - 3, json.len()) == u8"]}\n"_sv);
+		MACH_CHECK(contains(u8"\"name\":\"trace \\\"zone\\\"\""_sv));
+		MACH_CHECK(contains(u8"\"ph\":\"B\""_sv));
+		MACH_CHECK(contains(u8"\"ph\":\"E\""_sv));
+		MACH_CHECK(contains(u8"\"name\":\"Frame\""_sv));
+		MACH_CHECK(contains(u8"\"args\":{\"name\":\"Fiber 3\"}"_sv));
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Thread.hpp>
+#include <Core/Atomic.hpp>
+#include <Core/Debug/Profiler.hpp>
+#include <Core/IO/Writer.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Streams everything the Profiler records as Chrome Trace Event JSON, which loads in chrome://tracing, Perfetto and
+	 * Speedscope. https://docs.google.com/document/d/1CvAClvFfyA5R-PIpUu9lXGp2ZNmGMFAi84ZdnjKRoi4
+	 *
+	 * A background thread drains the Profiler on an interval and formats events into a buffered writer, so the only
+	 * cost on recording threads is the Profiler itself. Zones are placed on a track per fiber so they stay balanced when
+	 * a fiber moves between workers, and each worker thread gets a track showing which fiber it ran when. Gaps in a
+	 * worker track are scheduling bubbles.
+	 *
+	 * Enables the Profiler for its lifetime. Can not be used at the same time as a ProfileCollector.
+	 */
+	class TraceWriter {
+	public:
+		struct Options {
+			// How often the background thread drains the Profiler
+			Duration flush_interval = Duration::from_millis(10);
+		};
+
+		// The destination must outlive the trace writer
+		explicit TraceWriter(Writer& dest, Options const& options);
+		explicit TraceWriter(Writer& dest) : TraceWriter(dest, Options{}) {}
+
+		MACH_NO_COPY(TraceWriter);
+		MACH_NO_MOVE(TraceWriter);
+		// Finishes the trace if finish was not called
+		~TraceWriter();
+
+		// Stops capturing, writes out everything still pending and closes the JSON document
+		void finish();
+
+	private:
+		struct ThreadTrack {
+			u16 thread;
+			u32 fiber;
+			u64 since;
+		};
+
+		void writer_main();
+		void write_pending();
+		void write_event(ProfileEvent const& event);
+
+		void write(StringView string);
+		void close_thread_slice(ThreadTrack const& track, u64 end);
+		void begin_event(StringView phase, u64 tid, u64 cycles);
+		void write_name(const char* name);
+		void write_timestamp(u64 cycles);
+		void write_micros(u64 nanos);
+		void name_track(u64 tid, StringView prefix, u64 number);
+
+		BufferedWriter<16 * 1024> m_buffered;
+		Duration m_flush_interval;
+
+		// Only touched by the background thread until it is joined
+		Array<ProfileEvent> m_events;
+		Array<ThreadTrack> m_threads;
+		Array<u64> m_named_tracks;
+		Option<u64> m_base_cycles;
+		u64 m_last_cycles = 0;
+		bool m_first_event = true;
+
+		Mach::SharedPtr<Thread> m_thread;
+		Atomic<bool> m_running{ true };
+		bool m_finished = false;
+	};
+} // namespace Mach::Core
@@ -6,7 +6,33 @@
 
 #pragma once
 
+#include <Core/Containers/StringView.hpp>
 #include <Core/Core.hpp>
+#include <Core/Primitives.hpp>
+#include <Core/TypeTraits.hpp>
+
+namespace Mach::Core {
+	enum class EntryKind : u8 { File, Directory, Symlink, Other };
+
+	// Which attributes a directory listing should fill in. The kind is free on most file systems, size and modified
+	// time need a stat per entry so only ask for them when they are used.
+	enum class EntryFields : u8 {
+		Kind = (1 << 0),
+		Size = (1 << 1),
+		Modified = (1 << 2),
+		All = Kind | Size | Modified,
+	};
+	MACH_ENUM_CLASS_BITFIELD(EntryFields);
+
+	struct DirectoryEntry {
+		// Only valid for the duration of the callback
+		StringView name;
+		EntryKind kind = EntryKind::Other;
+		u64 size = 0;
+		// Nanoseconds since the unix epoch
+		u64 modified = 0;
+	};
+} // namespace Mach::Core
 
 #if MACH_OS == MACH_OS_WINDOWS
 
@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Test.hpp>
+#include <Core/FileSystem/Directory.hpp>
+#include <Core/FileSystem/FileWatcher.hpp>
+
+#if MACH_OS == MACH_OS_LINUX
+	#include <Core/FileSystem/Linux/InotifyWatch.hpp>
+#elif MACH_OS == MACH_OS_WINDOWS
+	#include <Core/FileSystem/Win32/DirectoryWatch.hpp>
+#endif
+
+namespace Mach::Core {
+	static u64 hash_path(StringView path) {
+		FNV1Hasher hasher;
+		hash(hasher, path);
+		return hasher.finish();
+	}
+
+	void FileEventDebouncer::add(Array<FileWatchBackend::Event>& events, Instant now) {
+		if (events.is_empty()) {
+			return;
+		}
+		if (m_pending.is_empty()) {
+			m_first_event = now;
+		}
+		m_last_event = now;
+
+		for (FileWatchBackend::Event& event : events) {
+			const u64 hash = hash_path(event.path);
+
+			Option<usize> found = nullopt;
+			auto first = m_by_hash.find(hash);
+			if (first.is_set()) {
+				usize index = first.unwrap();
+				while (true) {
+					if (m_pending[index].path == static_cast<StringView>(event.path)) {
+						found = index;
+						break;
+					}
+					if (!m_next_same_hash[index].is_set()) {
+						m_next_same_hash[index] = m_pending.len();
+						break;
+					}
+					index = m_next_same_hash[index].unwrap();
+				}
+			} else {
+				m_by_hash.insert(hash, m_pending.len());
+			}
+
+			if (found.is_set()) {
+				Pending& pending = m_pending[found.unwrap()];
+				pending.changes = pending.changes | event.change;
+				continue;
+			}
+			m_pending.push(Pending{ .path = Mach::move(event.path), .changes = event.change });
+			m_next_same_hash.push(nullopt);
+		}
+		// Dropped wholesale rather than reset, which copies each String out before discarding it
+		events = Array<FileWatchBackend::Event>{};
+	}
+
+	Option<u32> FileEventDebouncer::timeout_ms(Instant now) const {
+		if (m_pending.is_empty()) {
+			return nullopt;
+		}
+		// Rounded up so the wait does not return just short of the deadline and spin
+		const Duration remaining = ready_at().since(now);
+		return static_cast<u32>((remaining.as_micros() + 999) / 1000);
+	}
+
+	Option<Array<FileEventDebouncer::Pending>> FileEventDebouncer::take(Instant now) {
+		if (m_pending.is_empty() || now < ready_at()) {
+			return nullopt;
+		}
+
+		Array<Pending> batch = Mach::move(m_pending);
+		m_pending = Array<Pending>{};
+		m_by_hash = HashMap<u64, usize>{};
+		m_next_same_hash.reset();
+		return batch;
+	}
+
+	Instant FileEventDebouncer::ready_at() const {
+		const Instant quiet = m_last_event + m_debounce;
+		const Instant latest = m_first_event + m_max_latency;
+		return quiet < latest ? quiet : latest;
+	}
+
+	Option<UniquePtr<FileWatcher>> FileWatcher::create(
+		Scheduler const& scheduler,
+		CreateInfo const& info,
+		Callback&& callback) {
+		if (!Directory::open(info.root).is_set()) {
+			return nullopt;
+		}
+
+		UniquePtr<FileWatchBackend> backend;
+#if MACH_OS == MACH_OS_LINUX
+		auto inotify = InotifyWatch::create(info.root, info.recursive);
+		if (!inotify.is_set()) {
+			return nullopt;
+		}
+		backend = inotify.unwrap();
+#elif MACH_OS == MACH_OS_WINDOWS
+		auto directory_watch = Win32DirectoryWatch::create(info.root, info.recursive);
+		if (!directory_watch.is_set()) {
+			return nullopt;
+		}
+		backend = directory_watch.unwrap();
+#else
+		MACH_UNUSED(scheduler);
+		MACH_UNUSED(callback);
+		return nullopt;
+#endif
+
+		FileWatcher watcher{ scheduler, info, Mach::move(backend), Mach::move(callback) };
+		auto result = UniquePtr<FileWatcher>::create(Mach::move(watcher));
+		result->start();
+		return result;
+	}
+
+	FileWatcher::FileWatcher(
+		Scheduler const& scheduler,
+		CreateInfo const& info,
+		UniquePtr<FileWatchBackend>&& backend,
+		Callback&& callback)
+		: m_scheduler(scheduler)
+		, m_backend(Mach::move(backend))
+		, m_callback(Mach::SharedPtr<Callback>::create(Mach::move(callback)))
+		, m_debouncer(info.debounce_ms, info.max_latency_ms) {}
+
+	FileWatcher::FileWatcher(FileWatcher&& move) noexcept
+		: m_scheduler(move.m_scheduler)
+		, m_backend(Mach::move(move.m_backend))
+		, m_callback(Mach::move(move.m_callback))
+		, m_debouncer(Mach::move(move.m_debouncer))
+		, m_thread(Mach::move(move.m_thread)) {
+		MACH_ASSERT(!m_thread.is_valid(), "Can not move a FileWatcher once started");
+	}
+
+	FileWatcher::~FileWatcher() {
+		if (!m_thread.is_valid()) {
+			return;
+		}
+
+		m_running.store(false, Order::Release);
+		m_backend->wake();
+		m_thread.unsafe_get_mut().join();
+	}
+
+	void FileWatcher::start() {
+		m_thread = Thread::spawn([this]() { watcher_main(); }, Thread::SpawnInfo{ .name = u8"File Watcher"_sv });
+	}
+
+	void FileWatcher::watcher_main() {
+		Array<FileWatchBackend::Event> events;
+
+		while (m_running.load(Order::Acquire)) {
+			// Sleep until something happens. Once events are pending wake up again when they are due.
+			m_backend->wait(m_debouncer.timeout_ms(Instant::now()), events);
+			if (!m_running.load(Order::Acquire)) {
+				break;
+			}
+
+			const Instant now = Instant::now();
+			m_debouncer.add(events, now);
+			auto batch = m_debouncer.take(now);
+			if (batch.is_set()) {
+				dispatch(batch.unwrap());
+			}
+		}
+	}
+
+	void FileWatcher::dispatch(Array<FileEventDebouncer::Pending>&& batch) {
+		m_scheduler.enqueue([callback = m_callback, batch = Mach::move(batch)]() {
+			Array<FileEvent> events;
+			events.reserve(batch.len());
+			for (FileEventDebouncer::Pending const& pending : batch) {
+				events.push(FileEvent{ .path = pending.path, .changes = pending.changes });
+			}
+			(*callback)(events.as_const_slice());
+		});
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	void push_file_event(Array<FileWatchBackend::Event>& events, StringView path, FileChange change) {
+		events.push(FileWatchBackend::Event{ .path = String::from(path), .change = change });
+	}
+
+	MACH_TEST_CASE("FileEventDebouncer") {
+		const Instant start = Instant::now();
+		auto at = [start](u64 millis) { return start + Duration::from_millis(millis); };
+
+		FileEventDebouncer debouncer{ 50, 500 };
+		Array<FileWatchBackend::Event> events;
+
+		MACH_SUBCASE("coalesces per path") {
+			// Created then modified
+			push_file_event(events, u8"a.txt"_sv, FileChange::Created);
+			push_file_event(events, u8"a.txt"_sv, FileChange::Modified);
+			// Removed after being created
+			push_file_event(events, u8"b.txt"_sv, FileChange::Created);
+			push_file_event(events, u8"b.txt"_sv, FileChange::Removed);
+			// Modified over and over
+			for (u32 i = 0; i < 100; i += 1) {
+				push_file_event(events, u8"c.txt"_sv, FileChange::Modified);
+			}
+			debouncer.add(events, at(0));
+			MACH_CHECK(events.is_empty());
+
+			auto batch = debouncer.take(at(50));
+			MACH_REQUIRE(batch.is_set());
+			const auto pending = batch.unwrap();
+			MACH_REQUIRE(pending.len() == 3);
+			MACH_CHECK(pending[0].path == u8"a.txt"_sv);
+			MACH_CHECK(pending[0].changes == (FileChange::Created | FileChange::Modified));
+			MACH_CHECK(pending[1].path == u8"b.txt"_sv);
+			MACH_CHECK(pending[1].changes == (FileChange::Created | FileChange::Removed));
+			MACH_CHECK(pending[2].path == u8"c.txt"_sv);
+			MACH_CHECK(pending[2].changes == FileChange::Modified);
+			MACH_CHECK(debouncer.is_empty());
+		}
+
+		MACH_SUBCASE("waits for the tree to go quiet") {
+			MACH_CHECK(!debouncer.timeout_ms(at(0)).is_set());
+
+			push_file_event(events, u8"a.txt"_sv, FileChange::Modified);
+			debouncer.add(events, at(0));
+			MACH_CHECK(debouncer.timeout_ms(at(0)).unwrap() == 50);
+			MACH_CHECK(!debouncer.take(at(49)).is_set());
+
+			// A new event pushes the deadline back
+			push_file_event(events, u8"a.txt"_sv, FileChange::Modified);
+			debouncer.add(events, at(40));
+			MACH_CHECK(debouncer.timeout_ms(at(40)).unwrap() == 50);
+			MACH_CHECK(!debouncer.take(at(60)).is_set());
+
+			auto batch = debouncer.take(at(90));
+			MACH_REQUIRE(batch.is_set());
+			MACH_CHECK(batch.unwrap().len() == 1);
+			MACH_CHECK(!debouncer.timeout_ms(at(90)).is_set());
+			MACH_CHECK(!debouncer.take(at(1000)).is_set());
+		}
+
+		MACH_SUBCASE("does not hold events back forever") {
+			u64 now = 0;
+			for (; now < 500; now += 20) {
+				push_file_event(events, u8"a.txt"_sv, FileChange::Modified);
+				debouncer.add(events, at(now));
+				MACH_CHECK(!debouncer.take(at(now)).is_set());
+			}
+
+			push_file_event(events, u8"b.txt"_sv, FileChange::Modified);
+			debouncer.add(events, at(now));
+			MACH_CHECK(debouncer.timeout_ms(at(now)).unwrap() == 0);
+			auto batch = debouncer.take(at(now));
+			MACH_REQUIRE(batch.is_set());
+			MACH_CHECK(batch.unwrap().len() == 2);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Scheduler.hpp>
+#include <Core/Containers/HashMap.hpp>
+#include <Core/Containers/String.hpp>
+#include <Core/Time.hpp>
+
+namespace Mach::Core {
+	enum class FileChange : u8 {
+		Created = (1 << 0),
+		Modified = (1 << 1),
+		Removed = (1 << 2),
+		// The OS dropped events so anything under the root may have changed. Reported with an empty path.
+		Overflow = (1 << 3),
+	};
+	MACH_ENUM_CLASS_BITFIELD(FileChange);
+
+	struct FileEvent {
+		// Relative to the watched root using '/' separators. Only valid for the duration of the callback.
+		StringView path;
+		// Every change seen for the path since the last dispatch
+		FileChange changes;
+	};
+
+	// Platform source of raw change notifications consumed by FileWatcher
+	class FileWatchBackend {
+	public:
+		struct Event {
+			String path;
+			FileChange change;
+		};
+
+		// Blocks for up to timeout_ms, or forever when nullopt, appending any events that arrive. Returns early
+		// when woken.
+		virtual void wait(Option<u32> timeout_ms, Array<Event>& events) = 0;
+		// Wakes a thread blocked in wait. Safe to call from any thread.
+		virtual void wake() const = 0;
+
+		virtual ~FileWatchBackend() {}
+	};
+
+	/**
+	 * Merges raw backend events per path and decides when the merged batch is ready to go out. Kept apart from
+	 * FileWatcher and driven by explicit Instants so the timing does not depend on a real clock.
+	 *
+	 * A batch is ready once no event has arrived for debounce_ms, or once its oldest event has been held back for
+	 * max_latency_ms while changes keep streaming in.
+	 */
+	class FileEventDebouncer {
+	public:
+		struct Pending {
+			String path;
+			// Every change seen for the path since the last batch
+			FileChange changes;
+		};
+
+		explicit FileEventDebouncer(u32 debounce_ms, u32 max_latency_ms)
+			: m_debounce(Duration::from_millis(debounce_ms))
+			, m_max_latency(Duration::from_millis(max_latency_ms)) {}
+
+		// Consumes events that arrived at now
+		void add(Array<FileWatchBackend::Event>& events, Instant now);
+
+		// How long to wait for more events before calling take again. nullopt while nothing is pending.
+		MACH_NO_DISCARD Option<u32> timeout_ms(Instant now) const;
+
+		// Returns the pending batch, one entry per path in the order each was first seen, once it is ready
+		MACH_NO_DISCARD Option<Array<Pending>> take(Instant now);
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool is_empty() const { return m_pending.is_empty(); }
+
+	private:
+		MACH_NO_DISCARD Instant ready_at() const;
+
+		Duration m_debounce;
+		Duration m_max_latency;
+
+		Array<Pending> m_pending;
+		// First pending index per path hash. Paths that share a hash are chained through m_next_same_hash.
+		HashMap<u64, usize> m_by_hash;
+		Array<Option<usize>> m_next_same_hash;
+		Instant m_first_event = Instant::now();
+		Instant m_last_event = Instant::now();
+	};
+
+	/**
+	 * Observes a directory tree and reports changes to files in it.
+	 *
+	 * Editors and tools save files as a burst of create, write and rename events, so raw events are coalesced per path
+	 * and only dispatched once the tree has been quiet for the debounce period. Dispatch happens as a single
+	 * Scheduler job per batch. The callback may run on any worker and must not assume batches arrive in order.
+	 *
+	 * Backed by inotify on Linux and ReadDirectoryChangesW on Windows.
+	 */
+	class FileWatcher {
+	public:
+		using Callback = Function<void(Slice<FileEvent const> events)>;
+
+		struct CreateInfo {
+			StringView root;
+			bool recursive = true;
+			// How long the tree has to be quiet before pending events are dispatched
+			u32 debounce_ms = 50;
+			// Upper bound on how long events are held back while changes keep streaming in
+			u32 max_latency_ms = 500;
+		};
+
+		// Returns nullopt if root is not a directory or the platform has no way to observe it
+		MACH_NO_DISCARD static Option<UniquePtr<FileWatcher>> create(
+			Scheduler const& scheduler,
+			CreateInfo const& info,
+			Callback&& callback);
+
+		FileWatcher(FileWatcher&& move) noexcept;
+		FileWatcher& operator=(FileWatcher&&) = delete;
+		MACH_NO_COPY(FileWatcher);
+		// Stops watching. Batches already handed to the scheduler still run.
+		~FileWatcher();
+
+	private:
+		explicit FileWatcher(
+			Scheduler const& scheduler,
+			CreateInfo const& info,
+			UniquePtr<FileWatchBackend>&& backend,
+			Callback&& callback);
+
+		void start();
+		void watcher_main();
+		void dispatch(Array<FileEventDebouncer::Pending>&& batch);
+
+		Scheduler const& m_scheduler;
+		UniquePtr<FileWatchBackend> m_backend;
+		// Shared with dispatched jobs so they stay valid after the watcher is gone
+		Mach::SharedPtr<Callback> m_callback;
+
+		FileEventDebouncer m_debouncer;
+		Mach::SharedPtr<Thread> m_thread;
+		Atomic<bool> m_running{ true };
+	};
+} // namespace Mach::Core
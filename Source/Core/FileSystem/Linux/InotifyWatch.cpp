@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/Directory.hpp>
+#include <Core/FileSystem/Linux/InotifyWatch.hpp>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace Mach::Core {
+	static constexpr u32 watch_mask =
+		IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+
+	static String join_path(StringView directory, StringView name) {
+		if (directory.len() == 0) {
+			return String::from(name);
+		}
+		String result = String::from(directory);
+		result.push('/');
+		result.append(name);
+		return result;
+	}
+
+	Option<UniquePtr<InotifyWatch>> InotifyWatch::create(StringView root, bool recursive) {
+		const int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd < 0) {
+			return nullopt;
+		}
+		const int wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wake_fd < 0) {
+			::close(fd);
+			return nullopt;
+		}
+
+		InotifyWatch watch{ fd, wake_fd, String::from(root), recursive };
+		watch.add_watch(StringView{}, nullptr);
+		if (watch.m_directories.len() == 0) {
+			return nullopt;
+		}
+		return UniquePtr<InotifyWatch>::create(Mach::move(watch));
+	}
+
+	InotifyWatch::InotifyWatch(InotifyWatch&& move) noexcept
+		: m_fd(move.m_fd)
+		, m_wake_fd(move.m_wake_fd)
+		, m_root(Mach::move(move.m_root))
+		, m_recursive(move.m_recursive)
+		, m_directories(Mach::move(move.m_directories)) {
+		move.m_fd = -1;
+		move.m_wake_fd = -1;
+	}
+
+	void InotifyWatch::wait(Option<u32> timeout_ms, Array<Event>& events) {
+		pollfd fds[2] = {
+			{ .fd = m_fd, .events = POLLIN, .revents = 0 },
+			{ .fd = m_wake_fd, .events = POLLIN, .revents = 0 },
+		};
+		const int timeout = timeout_ms.is_set() ? static_cast<int>(timeout_ms.unwrap()) : -1;
+		if (::poll(fds, 2, timeout) <= 0) {
+			return;
+		}
+
+		if ((fds[1].revents & POLLIN) != 0) {
+			u64 value;
+			const auto result = ::read(m_wake_fd, &value, sizeof(value));
+			MACH_UNUSED(result);
+		}
+		if ((fds[0].revents & POLLIN) != 0) {
+			drain(events);
+		}
+	}
+
+	void InotifyWatch::wake() const {
+		const u64 value = 1;
+		const auto result = ::write(m_wake_fd, &value, sizeof(value));
+		MACH_UNUSED(result);
+	}
+
+	InotifyWatch::~InotifyWatch() {
+		if (m_fd != -1) {
+			::close(m_fd);
+			m_fd = -1;
+		}
+		if (m_wake_fd != -1) {
+			::close(m_wake_fd);
+			m_wake_fd = -1;
+		}
+	}
+
+	void InotifyWatch::add_watch(StringView relative, Array<Event>* events) {
+		const String full_path = relative.len() > 0 ? join_path(m_root, relative) : String::from(m_root);
+		const int wd = ::inotify_add_watch(m_fd, (const char*)*full_path, watch_mask);
+		if (wd < 0) {
+			return;
+		}
+
+		const usize index = static_cast<usize>(wd);
+		while (m_directories.len() <= index) {
+			m_directories.push(nullopt);
+		}
+		m_directories[index] = relative.len() > 0 ? String::from(relative) : String{};
+
+		if (!m_recursive) {
+			return;
+		}
+
+		auto directory = Directory::open(full_path);
+		if (!directory.is_set()) {
+			return;
+		}
+
+		Array<String> children;
+		const bool listed = directory.as_const_ref().unwrap().for_each(
+			[&](DirectoryEntry const& entry) {
+				const String path = join_path(relative, entry.name);
+				if (entry.kind == EntryKind::Directory) {
+					children.push(String::from(path));
+				} else if (events != nullptr) {
+					events->push(Event{ .path = String::from(path), .change = FileChange::Created });
+				}
+				return true;
+			},
+			EntryFields::Kind);
+		MACH_UNUSED(listed);
+
+		for (String const& child : children) {
+			if (events != nullptr) {
+				events->push(Event{ .path = String::from(child), .change = FileChange::Created });
+			}
+			add_watch(child, events);
+		}
+	}
+
+	void InotifyWatch::drain(Array<Event>& events) {
+		alignas(inotify_event) u8 buffer[16 * 1024];
+		while (true) {
+			const isize amount = ::read(m_fd, buffer, sizeof(buffer));
+			if (amount <= 0) {
+				// EAGAIN once the queue is empty
+				break;
+			}
+
+			for (isize offset = 0; offset < amount;) {
+				const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+				offset += static_cast<isize>(sizeof(inotify_event) + event->len);
+
+				if ((event->mask & IN_Q_OVERFLOW) != 0) {
+					events.push(Event{ .path = String{}, .change = FileChange::Overflow });
+					continue;
+				}
+
+				const usize index = static_cast<usize>(event->wd);
+				if (event->wd < 0 || index >= m_directories.len() || !m_directories[index].is_set()) {
+					continue;
+				}
+				if ((event->mask & IN_IGNORED) != 0) {
+					// The directory went away and the kernel dropped the watch
+					m_directories[index] = nullopt;
+					continue;
+				}
+				// Events about the watched directory itself are reported by its parent
+				if (event->len == 0) {
+					continue;
+				}
+
+				FileChange change;
+				if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+					change = FileChange::Created;
+				} else if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+					change = FileChange::Removed;
+				} else {
+					change = FileChange::Modified;
+				}
+
+				const StringView directory = m_directories[index].as_const_ref().unwrap();
+				String path = join_path(directory, StringView::from_cstring(event->name));
+
+				// New directories need their own watch. Anything written into them before it existed is reported now.
+				const bool is_directory = (event->mask & IN_ISDIR) != 0;
+				if (is_directory && change == FileChange::Created && m_recursive) {
+					events.push(Event{ .path = String::from(path), .change = change });
+					add_watch(path, &events);
+					continue;
+				}
+
+				events.push(Event{ .path = Mach::move(path), .change = change });
+			}
+		}
+	}
+} // namespace Mach::Core
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/FileSystem/FileWatcher.hpp>
+
+namespace Mach::Core {
+	// inotify only watches a single directory per watch descriptor, so recursive watches add one per subdirectory and
+	// keep adding them as directories are created.
+	class InotifyWatch final : public FileWatchBackend {
+	public:
+		MACH_NO_DISCARD static Option<UniquePtr<InotifyWatch>> create(StringView root, bool recursive);
+
+		InotifyWatch(InotifyWatch&& move) noexcept;
+		InotifyWatch& operator=(InotifyWatch&&) = delete;
+		MACH_NO_COPY(InotifyWatch);
+
+		void wait(Option<u32> timeout_ms, Array<Event>& events) final;
+		void wake() const final;
+
+		~InotifyWatch() final;
+
+	private:
+		explicit InotifyWatch(int fd, int wake_fd, String&& root, bool recursive)
+			: m_fd(fd)
+			, m_wake_fd(wake_fd)
+			, m_root(Mach::move(root))
+			, m_recursive(recursive) {}
+
+		// Watches root/relative and, when recursive, everything below it. Files found while walking are reported as
+		// created when events is set since they may have been written before the watch existed.
+		void add_watch(StringView relative, Array<Event>* events);
+		void drain(Array<Event>& events);
+
+		int m_fd;
+		int m_wake_fd;
+		String m_root;
+		bool m_recursive;
+		// Path relative to the root of every watched directory indexed by its watch descriptor
+		Array<Option<String>> m_directories;
+	};
+} // namespace Mach::Core
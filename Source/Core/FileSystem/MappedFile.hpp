@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Option.hpp>
+#include <Core/Containers/Slice.hpp>
+#include <Core/Containers/StringView.hpp>
+
+namespace Mach::Core {
+	// Read only view of a whole file mapped into the address space. Pages are faulted in by the OS on first touch.
+	class MappedFile {
+	public:
+		MACH_NO_DISCARD static Option<MappedFile> open(const StringView& path);
+
+		MACH_NO_COPY(MappedFile);
+		MappedFile(MappedFile&& move) : m_ptr(move.m_ptr), m_len(move.m_len) {
+			move.m_ptr = nullptr;
+			move.m_len = 0;
+		}
+		MappedFile& operator=(MappedFile&& move) {
+			auto to_destroy = Mach::move(*this);
+			MACH_UNUSED(to_destroy);
+
+			m_ptr = move.m_ptr;
+			m_len = move.m_len;
+			move.m_ptr = nullptr;
+			move.m_len = 0;
+
+			return *this;
+		}
+		~MappedFile();
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Slice<u8 const> bytes() const { return Slice<u8 const>{ m_ptr, m_len }; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_len; }
+
+	private:
+		explicit MappedFile(u8 const* ptr, usize len) : m_ptr(ptr), m_len(len) {}
+
+		u8 const* m_ptr;
+		usize m_len;
+	};
+} // namespace Mach::Core
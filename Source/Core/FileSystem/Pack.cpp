@@ -0,0 +1,519 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/Pack.hpp>
+
+#include <Core/Compression/LZ4.hpp>
+#include <Core/Debug/Test.hpp>
+#include <Core/Hash.hpp>
+#include <Core/Sort.hpp>
+
+namespace Mach::Core {
+	struct PackHeader {
+		u32 magic;
+		u32 version;
+		u32 entry_count;
+		u32 block_size;
+		u64 toc_offset;
+		u64 names_offset;
+		u64 names_size;
+		u64 reserved;
+	};
+	static_assert(sizeof(PackHeader) == 48);
+
+	struct Pack::TocEntry {
+		u64 hash;
+		u64 offset;
+		u64 size;
+		u64 stored_size;
+		u32 name_offset;
+		u32 name_len;
+		PackCompression compression;
+		u8 reserved[7];
+	};
+
+	// High bit of a block header marks a block that is stored as is
+	static constexpr u32 block_stored_flag = 0x80000000;
+
+	// Part of the file format so it must never change
+	static u64 hash_path(const StringView& path) {
+		FNV1Hasher hasher;
+		hash(hasher, path);
+		return hasher.finish();
+	}
+
+	static u32 read_u32_le(const u8* ptr) {
+		return static_cast<u32>(ptr[0]) | (static_cast<u32>(ptr[1]) << 8) | (static_cast<u32>(ptr[2]) << 16) |
+			   (static_cast<u32>(ptr[3]) << 24);
+	}
+
+	// Decodes the next block of a compressed payload. Returns the raw bytes of the block, which either point into the
+	// payload for stored blocks or into scratch for compressed ones.
+	static Option<Slice<u8 const>> decode_block(Slice<u8 const> stored, usize& cursor, Slice<u8> scratch) {
+		if (stored.len() - cursor < sizeof(u32)) {
+			return nullopt;
+		}
+		const u32 header = read_u32_le(stored.begin() + cursor);
+		cursor += sizeof(u32);
+
+		const usize len = header & ~block_stored_flag;
+		if (len > stored.len() - cursor) {
+			return nullopt;
+		}
+		const Slice<u8 const> block{ stored.begin() + cursor, len };
+		cursor += len;
+
+		if ((header & block_stored_flag) != 0) {
+			return block;
+		}
+
+		const auto decompressed = LZ4::decompress(block, scratch);
+		if (!decompressed.is_set()) {
+			return nullopt;
+		}
+		return Slice<u8 const>{ scratch.begin(), decompressed.unwrap() };
+	}
+
+	class PackEntryReader final : public Reader {
+	public:
+		explicit PackEntryReader(Slice<u8 const> stored, PackCompression compression)
+			: m_stored(stored)
+			, m_compression(compression) {
+			if (m_compression == PackCompression::LZ4) {
+				m_scratch.set_len_uninitialized(Pack::block_size);
+			}
+		}
+
+		usize read(Slice<u8> bytes) final {
+			if (m_compression == PackCompression::None) {
+				const usize remaining = m_stored.len() - m_cursor;
+				const usize amount = bytes.len() < remaining ? bytes.len() : remaining;
+				if (amount > 0) {
+					Memory::copy(bytes.begin(), m_stored.begin() + m_cursor, amount);
+					m_cursor += amount;
+				}
+				return amount;
+			}
+
+			usize written = 0;
+			while (written < bytes.len()) {
+				if (m_block_cursor == m_block.len()) {
+					if (m_cursor == m_stored.len()) {
+						break;
+					}
+					auto block = decode_block(m_stored, m_cursor, m_scratch.as_slice());
+					if (!block.is_set()) {
+						// Treat corrupt data as the end of the stream
+						m_cursor = m_stored.len();
+						break;
+					}
+					m_block = block.unwrap();
+					m_block_cursor = 0;
+					continue;
+				}
+
+				const usize remaining = m_block.len() - m_block_cursor;
+				const usize wanted = bytes.len() - written;
+				const usize amount = wanted < remaining ? wanted : remaining;
+				Memory::copy(bytes.begin() + written, m_block.begin() + m_block_cursor, amount);
+				m_block_cursor += amount;
+				written += amount;
+			}
+			return written;
+		}
+
+	private:
+		Slice<u8 const> m_stored;
+		PackCompression m_compression;
+		usize m_cursor = 0;
+
+		Array<u8> m_scratch;
+		Slice<u8 const> m_block;
+		usize m_block_cursor = 0;
+	};
+
+	Pack::Pack(Option<MappedFile>&& file, Slice<u8 const> bytes) : m_file(Mach::move(file)), m_bytes(bytes) {}
+
+	Option<Pack> Pack::open(const StringView& path) {
+		auto file = MappedFile::open(path);
+		if (!file.is_set()) {
+			return nullopt;
+		}
+
+		const Slice<u8 const> bytes = file.as_const_ref().unwrap().bytes();
+		auto result = from_bytes(bytes);
+		if (!result.is_set()) {
+			return nullopt;
+		}
+
+		Pack pack = result.unwrap();
+		pack.m_file = Mach::move(file);
+		return pack;
+	}
+
+	Option<Pack> Pack::from_bytes(Slice<u8 const> bytes) {
+		if (bytes.len() < sizeof(PackHeader)) {
+			return nullopt;
+		}
+
+		PackHeader header;
+		Memory::copy(&header, bytes.begin(), sizeof(header));
+		if (header.magic != magic || header.version != version || header.block_size != block_size) {
+			return nullopt;
+		}
+
+		// The TOC is read in place so it has to be in bounds and aligned
+		const u64 toc_size = static_cast<u64>(header.entry_count) * sizeof(TocEntry);
+		if (header.toc_offset > bytes.len() || toc_size > bytes.len() - header.toc_offset) {
+			return nullopt;
+		}
+		if ((reinterpret_cast<usize>(bytes.begin() + header.toc_offset) % alignof(TocEntry)) != 0) {
+			return nullopt;
+		}
+		if (header.names_offset > bytes.len() || header.names_size > bytes.len() - header.names_offset) {
+			return nullopt;
+		}
+
+		Pack pack{ nullopt, bytes };
+		pack.m_entry_count = header.entry_count;
+		pack.m_toc_offset = static_cast<usize>(header.toc_offset);
+		pack.m_names_offset = static_cast<usize>(header.names_offset);
+		pack.m_names_size = static_cast<usize>(header.names_size);
+		return pack;
+	}
+
+	Pack::TocEntry const& Pack::toc_entry(usize index) const {
+		static_assert(sizeof(TocEntry) == 48);
+		MACH_ASSERT(index < m_entry_count, "Index out of bounds");
+		return reinterpret_cast<TocEntry const*>(m_bytes.begin() + m_toc_offset)[index];
+	}
+
+	Slice<u8 const> Pack::stored_bytes(TocEntry const& entry) const {
+		if (entry.offset > m_bytes.len() || entry.stored_size > m_bytes.len() - entry.offset) {
+			return Slice<u8 const>{};
+		}
+		return Slice<u8 const>{ m_bytes.begin() + entry.offset, static_cast<usize>(entry.stored_size) };
+	}
+
+	Pack::Entry Pack::entry(usize index) const {
+		TocEntry const& toc = toc_entry(index);
+
+		StringView path;
+		if (toc.name_offset <= m_names_size && toc.name_len <= m_names_size - toc.name_offset) {
+			const auto* names = reinterpret_cast<const UTF8Char*>(m_bytes.begin() + m_names_offset);
+			path = StringView{ names + toc.name_offset, toc.name_len };
+		}
+
+		return Entry{ .path = path, .size = toc.size, .compression = toc.compression };
+	}
+
+	Option<usize> Pack::find(const StringView& path) const {
+		const u64 hash = hash_path(path);
+
+		// Lower bound on the hash
+		usize low = 0;
+		usize high = m_entry_count;
+		while (low < high) {
+			const usize mid = low + (high - low) / 2;
+			if (toc_entry(mid).hash < hash) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		for (usize index = low; index < m_entry_count && toc_entry(index).hash == hash; index += 1) {
+			if (entry(index).path == path) {
+				return index;
+			}
+		}
+		return nullopt;
+	}
+
+	UniquePtr<Reader> Pack::open_entry(usize index) const {
+		TocEntry const& toc = toc_entry(index);
+		return UniquePtr<PackEntryReader>::create(stored_bytes(toc), toc.compression);
+	}
+
+	bool Pack::read_entry(usize index, Slice<u8> dst) const {
+		TocEntry const& toc = toc_entry(index);
+		MACH_ASSERT(dst.len() == toc.size, "Destination must be exactly the size of the entry");
+
+		const Slice<u8 const> stored = stored_bytes(toc);
+		if (stored.len() != toc.stored_size) {
+			return false;
+		}
+
+		switch (toc.compression) {
+		case PackCompression::None:
+			if (stored.len() != dst.len()) return false;
+			if (dst.len() > 0) Memory::copy(dst.begin(), stored.begin(), dst.len());
+			return true;
+		case PackCompression::LZ4: {
+			// Decompress each block straight into place
+			usize cursor = 0;
+			usize written = 0;
+			while (cursor < stored.len()) {
+				const Slice<u8> remaining{ dst.begin() + written, dst.len() - written };
+				auto block = decode_block(stored, cursor, remaining);
+				if (!block.is_set()) {
+					return false;
+				}
+
+				const Slice<u8 const> bytes = block.unwrap();
+				if (bytes.len() > remaining.len()) {
+					return false;
+				}
+				// Stored blocks point back into the payload and still need copying
+				if (bytes.begin() != remaining.begin()) {
+					Memory::copy(remaining.begin(), bytes.begin(), bytes.len());
+				}
+				written += bytes.len();
+			}
+			return written == dst.len();
+		}
+		}
+		return false;
+	}
+
+	void PackBuilder::add(const StringView& path, Slice<u8 const> bytes, PackCompression compression) {
+		Pending pending{
+			.path = String::from(path),
+			.hash = hash_path(path),
+			.size = bytes.len(),
+			.compression = compression,
+			.stored = {},
+		};
+
+		if (compression == PackCompression::LZ4) {
+			Array<u8> scratch;
+			scratch.set_len_uninitialized(LZ4::compress_bound(Pack::block_size));
+
+			for (usize offset = 0; offset < bytes.len(); offset += Pack::block_size) {
+				const usize remaining = bytes.len() - offset;
+				const usize len = remaining < Pack::block_size ? remaining : Pack::block_size;
+				const Slice<u8 const> block{ bytes.begin() + offset, len };
+
+				const usize compressed_len = LZ4::compress(block, scratch.as_slice());
+				const bool store = compressed_len >= len;
+				const Slice<u8 const> payload = store ? block : Slice<u8 const>{ scratch.begin(), compressed_len };
+
+				u32 header = static_cast<u32>(payload.len());
+				if (store) header |= block_stored_flag;
+				const u8 header_bytes[] = {
+					static_cast<u8>(header),
+					static_cast<u8>(header >> 8),
+					static_cast<u8>(header >> 16),
+					static_cast<u8>(header >> 24),
+				};
+				ArrayWriter writer{ pending.stored };
+				writer.write(Slice<u8 const>{ header_bytes, sizeof(header_bytes) });
+				writer.write(payload);
+			}
+
+			// Not worth paying for decompression
+			if (pending.stored.len() >= bytes.len()) {
+				pending.compression = PackCompression::None;
+				pending.stored = Array<u8>{};
+			}
+		} else {
+			pending.compression = PackCompression::None;
+		}
+
+		if (pending.compression == PackCompression::None && bytes.len() > 0) {
+			pending.stored = Array<u8>{ bytes };
+		}
+
+		m_entries.push(Mach::move(pending));
+	}
+
+	static usize write_zeros(Writer& writer, usize amount) {
+		static const u8 zeros[4096] = {};
+		usize written = 0;
+		while (written < amount) {
+			const usize remaining = amount - written;
+			written += writer.write(Slice<u8 const>{ zeros, remaining < sizeof(zeros) ? remaining : sizeof(zeros) });
+		}
+		return written;
+	}
+
+	static constexpr u64 align_up(u64 value, u64 alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+	usize PackBuilder::finish(Writer& writer) const {
+		// Sort by hash, then path so lookups can binary search
+		Array<usize> order;
+		order.reserve(m_entries.len());
+		for (usize index = 0; index < m_entries.len(); index += 1) {
+			order.push(index);
+		}
+		auto less = [&](usize a, usize b) {
+			Pending const& left = m_entries[a];
+			Pending const& right = m_entries[b];
+			if (left.hash != right.hash) return left.hash < right.hash;
+
+			const auto left_bytes = static_cast<Slice<UTF8Char const>>(static_cast<StringView>(left.path));
+			const auto right_bytes = static_cast<Slice<UTF8Char const>>(static_cast<StringView>(right.path));
+			const usize len = left_bytes.len() < right_bytes.len() ? left_bytes.len() : right_bytes.len();
+			for (usize index = 0; index < len; index += 1) {
+				if (left_bytes[index] != right_bytes[index]) return left_bytes[index] < right_bytes[index];
+			}
+			return left_bytes.len() < right_bytes.len();
+		};
+		sort_by(order.as_slice(), less);
+
+		// Lay out the payloads so small entries never straddle a block boundary
+		Array<u64> offsets;
+		offsets.reserve(order.len());
+		u64 cursor = sizeof(PackHeader);
+		for (const usize index : order) {
+			const u64 stored_size = m_entries[index].stored.len();
+			if (stored_size > 0) {
+				const bool straddles = cursor / Pack::block_size != (cursor + stored_size - 1) / Pack::block_size;
+				if (stored_size > Pack::block_size || straddles) {
+					cursor = align_up(cursor, Pack::block_size);
+				}
+			}
+			offsets.push(cursor);
+			cursor += stored_size;
+		}
+
+		const u64 toc_offset = align_up(cursor, alignof(Pack::TocEntry));
+		const u64 names_offset = toc_offset + order.len() * sizeof(Pack::TocEntry);
+		u64 names_size = 0;
+		for (const usize index : order) {
+			names_size += m_entries[index].path.len();
+		}
+
+		const PackHeader header{
+			.magic = Pack::magic,
+			.version = Pack::version,
+			.entry_count = static_cast<u32>(order.len()),
+			.block_size = Pack::block_size,
+			.toc_offset = toc_offset,
+			.names_offset = names_offset,
+			.names_size = names_size,
+			.reserved = 0,
+		};
+
+		usize written = writer.write(as_slice_of_bytes(header));
+		for (usize index = 0; index < order.len(); index += 1) {
+			written += write_zeros(writer, static_cast<usize>(offsets[index]) - written);
+			written += writer.write(m_entries[order[index]].stored.as_const_slice());
+		}
+		written += write_zeros(writer, static_cast<usize>(toc_offset) - written);
+
+		u32 name_offset = 0;
+		for (usize index = 0; index < order.len(); index += 1) {
+			Pending const& pending = m_entries[order[index]];
+			const Pack::TocEntry toc{
+				.hash = pending.hash,
+				.offset = offsets[index],
+				.size = pending.size,
+				.stored_size = pending.stored.len(),
+				.name_offset = name_offset,
+				.name_len = static_cast<u32>(pending.path.len()),
+				.compression = pending.compression,
+				.reserved = {},
+			};
+			written += writer.write(as_slice_of_bytes(toc));
+			name_offset += static_cast<u32>(pending.path.len());
+		}
+
+		for (const usize index : order) {
+			written += writer.write(static_cast<StringView>(m_entries[index].path));
+		}
+
+		return written;
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("Pack") {
+		Array<u8> text;
+		for (usize index = 0; index < 200000; index += 1) {
+			text.push(static_cast<u8>("hello pack "[index % 11]));
+		}
+		Array<u8> noise;
+		u32 state = 42;
+		for (usize index = 0; index < 100000; index += 1) {
+			state = state * 1664525 + 1013904223;
+			noise.push(static_cast<u8>(state >> 24));
+		}
+		const u8 small[] = { 1, 2, 3, 4, 5 };
+
+		PackBuilder builder;
+		builder.add(u8"textures/text.bin"_sv, text.as_const_slice());
+		builder.add(u8"textures/noise.bin"_sv, noise.as_const_slice());
+		builder.add(u8"small.bin"_sv, Slice<u8 const>{ small, sizeof(small) }, PackCompression::None);
+		builder.add(u8"empty.bin"_sv, Slice<u8 const>{});
+
+		Array<u8> bytes;
+		ArrayWriter writer{ bytes };
+		const usize written = builder.finish(writer);
+		MACH_CHECK(written == bytes.len());
+
+		auto maybe_pack = Pack::from_bytes(bytes.as_const_slice());
+		MACH_REQUIRE(maybe_pack.is_set());
+		const Pack pack = maybe_pack.unwrap();
+		MACH_CHECK(pack.len() == 4);
+
+		auto check_entry = [&](StringView path, Slice<u8 const> expected) {
+			const auto index = pack.find(path);
+			if (!index.is_set()) return false;
+
+			const auto entry = pack.entry(index.unwrap());
+			if (entry.path != path || entry.size != expected.len()) return false;
+
+			Array<u8> whole;
+			whole.set_len(expected.len());
+			if (!pack.read_entry(index.unwrap(), whole.as_slice())) return false;
+
+			// Stream in odd sized chunks to cross block boundaries
+			Array<u8> streamed;
+			auto reader = pack.open_entry(index.unwrap());
+			u8 chunk[1000];
+			while (true) {
+				const usize amount = reader->read(Slice<u8>{ chunk, sizeof(chunk) });
+				if (amount == 0) break;
+				ArrayWriter{ streamed }.write(Slice<u8 const>{ chunk, amount });
+			}
+			if (streamed.len() != expected.len()) return false;
+
+			for (usize index = 0; index < expected.len(); index += 1) {
+				if (whole[index] != expected[index] || streamed[index] != expected[index]) return false;
+			}
+			return true;
+		};
+
+		MACH_SUBCASE("lookup and read") {
+			MACH_CHECK(check_entry(u8"textures/text.bin"_sv, text.as_const_slice()));
+			MACH_CHECK(check_entry(u8"textures/noise.bin"_sv, noise.as_const_slice()));
+			MACH_CHECK(check_entry(u8"small.bin"_sv, Slice<u8 const>{ small, sizeof(small) }));
+			MACH_CHECK(check_entry(u8"empty.bin"_sv, Slice<u8 const>{}));
+			MACH_CHECK(!pack.find(u8"missing.bin"_sv).is_set());
+		}
+
+		MACH_SUBCASE("compression") {
+			const auto text_entry = pack.entry(pack.find(u8"textures/text.bin"_sv).unwrap());
+			MACH_CHECK(text_entry.compression == PackCompression::LZ4);
+			// Noise does not compress so it is stored as is
+			const auto noise_entry = pack.entry(pack.find(u8"textures/noise.bin"_sv).unwrap());
+			MACH_CHECK(noise_entry.compression == PackCompression::None);
+			MACH_CHECK(bytes.len() < text.len());
+		}
+
+		MACH_SUBCASE("rejects garbage") {
+			Array<u8> garbage = bytes;
+			garbage[0] = 0;
+			MACH_CHECK(!Pack::from_bytes(garbage.as_const_slice()).is_set());
+			MACH_CHECK(!Pack::from_bytes(Slice<u8 const>{ small, sizeof(small) }).is_set());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
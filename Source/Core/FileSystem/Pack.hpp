@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/String.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+#include <Core/FileSystem/MappedFile.hpp>
+#include <Core/IO/Reader.hpp>
+#include <Core/IO/Writer.hpp>
+
+namespace Mach::Core {
+	enum class PackCompression : u8 { None, LZ4 };
+
+	/**
+	 * Read only archive of many files in a single file.
+	 *
+	 * Layout, all values little endian:
+	 *   Header      magic, version, entry count, block size and the location of the table of contents
+	 *   Data        entry payloads. An entry never straddles a 64 KiB block boundary unless it is larger than a block,
+	 *               in which case it starts on one, so small entries are always a single aligned read.
+	 *   TOC         fixed size entries sorted by path hash, looked up with a binary search straight out of the map
+	 *   Names       utf8 paths referenced by the TOC to resolve hash collisions
+	 *
+	 * Compressed payloads are a sequence of blocks that each decompress to at most one 64 KiB block. Every block is
+	 * prefixed by its stored size as a u32, with the high bit set when the block was stored uncompressed.
+	 */
+	class Pack {
+	public:
+		static constexpr u32 magic = 0x4B41504D; // "MPAK"
+		static constexpr u32 version = 1;
+		static constexpr u32 block_size = 64 * 1024;
+
+		struct Entry {
+			StringView path;
+			u64 size;
+			PackCompression compression;
+		};
+
+		// Maps the pack at path. Only the header is validated up front, the rest is paged in on demand.
+		MACH_NO_DISCARD static Option<Pack> open(const StringView& path);
+		// Views a pack already in memory. The bytes must outlive the Pack and every Reader created from it.
+		MACH_NO_DISCARD static Option<Pack> from_bytes(Slice<u8 const> bytes);
+
+		MACH_NO_COPY(Pack);
+		Pack(Pack&& move) = default;
+		Pack& operator=(Pack&& move) = default;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const { return m_entry_count; }
+		MACH_NO_DISCARD Entry entry(usize index) const;
+		MACH_NO_DISCARD Option<usize> find(const StringView& path) const;
+
+		// Streams the entry. The reader borrows the pack so the pack must outlive it.
+		MACH_NO_DISCARD UniquePtr<Reader> open_entry(usize index) const;
+		// Reads the whole entry into dst, which must be exactly the entry size. Returns false on corrupt data.
+		MACH_NO_DISCARD bool read_entry(usize index, Slice<u8> dst) const;
+
+	private:
+		friend class PackBuilder;
+		struct TocEntry;
+
+		explicit Pack(Option<MappedFile>&& file, Slice<u8 const> bytes);
+		MACH_NO_DISCARD TocEntry const& toc_entry(usize index) const;
+		MACH_NO_DISCARD Slice<u8 const> stored_bytes(TocEntry const& entry) const;
+
+		Option<MappedFile> m_file;
+		Slice<u8 const> m_bytes;
+		usize m_entry_count = 0;
+		usize m_toc_offset = 0;
+		usize m_names_offset = 0;
+		usize m_names_size = 0;
+	};
+
+	// Collects files in memory and writes them out as a Pack
+	class PackBuilder {
+	public:
+		// Copies bytes. Compressed entries fall back to being stored when compression does not pay off.
+		void add(const StringView& path, Slice<u8 const> bytes, PackCompression compression = PackCompression::LZ4);
+
+		// Writes the pack and returns the amount of bytes written
+		usize finish(Writer& writer) const;
+
+	private:
+		struct Pending {
+			String path;
+			u64 hash;
+			u64 size;
+			PackCompression compression;
+			Array<u8> stored;
+		};
+		Array<Pending> m_entries;
+	};
+} // namespace Mach::Core
@@ -4,25 +4,129 @@
  * This software is released under the MIT License.
  */
 
-#include <Core/FileSystem/Posix/Directory.hpp>
+#include <Core/FileSystem/Directory.hpp>
 
 #include <Core/Debug/Assertions.hpp>
 #include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Mach::Core {
-	Option<PosixDirectory> PosixDirectory::open(const StringView& path) { return PosixDirectory{ String::from(path) }; }
+	Option<PosixDirectory> PosixDirectory::open(const StringView& path) {
+		String owned = String::from(path);
 
-	void PosixDirectory::for_each(FunctionRef<bool()> f) {
+		struct stat info;
+		if (::stat((const char*)*owned, &info) != 0 || !S_ISDIR(info.st_mode)) {
+			return nullopt;
+		}
+		return PosixDirectory{ Mach::move(owned) };
+	}
+
+	PosixDirectory PosixDirectory::cwd() {
+		char buffer[PATH_MAX];
+		const char* const result = ::getcwd(buffer, sizeof(buffer));
+		MACH_ASSERT(result != nullptr);
+		return PosixDirectory{ String::from(StringView::from_cstring(result)) };
+	}
+
+	static EntryKind kind_from_mode(mode_t mode) {
+		if (S_ISREG(mode)) return EntryKind::File;
+		if (S_ISDIR(mode)) return EntryKind::Directory;
+		if (S_ISLNK(mode)) return EntryKind::Symlink;
+		return EntryKind::Other;
+	}
+
+	// Fills in whatever d_type could not tell us. Uses statx on Linux so only the requested fields are fetched.
+	static bool stat_entry(int dir_fd, const char* name, bool needs_kind, EntryFields fields, DirectoryEntry& entry) {
+#if MACH_OS == MACH_OS_LINUX
+		unsigned int mask = 0;
+		if (needs_kind) mask |= STATX_TYPE;
+		if ((fields & EntryFields::Size) == EntryFields::Size) mask |= STATX_SIZE;
+		if ((fields & EntryFields::Modified) == EntryFields::Modified) mask |= STATX_MTIME;
+
+		struct statx stx;
+		if (::statx(dir_fd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, mask, &stx) != 0) {
+			return false;
+		}
+		if (needs_kind) entry.kind = kind_from_mode(stx.stx_mode);
+		entry.size = stx.stx_size;
+		entry.modified = static_cast<u64>(stx.stx_mtime.tv_sec) * 1'000'000'000 + stx.stx_mtime.tv_nsec;
+#else
+		struct stat st;
+		if (::fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+			return false;
+		}
+		if (needs_kind) entry.kind = kind_from_mode(st.st_mode);
+		entry.size = static_cast<u64>(st.st_size);
+	#if MACH_OS == MACH_OS_MACOS
+		const timespec mtime = st.st_mtimespec;
+	#else
+		const timespec mtime = st.st_mtim;
+	#endif
+		entry.modified = static_cast<u64>(mtime.tv_sec) * 1'000'000'000 + static_cast<u64>(mtime.tv_nsec);
+#endif
+		return true;
+	}
+
+	bool PosixDirectory::for_each(FunctionRef<bool(DirectoryEntry const&)> f) const {
+		return for_each(Mach::move(f), EntryFields::All);
+	}
+
+	bool PosixDirectory::for_each(FunctionRef<bool(DirectoryEntry const&)> f, EntryFields fields) const {
 		DIR* const dir = ::opendir((const char*)*m_path);
-		MACH_ASSERT(dir != nullptr);
+		if (dir == nullptr) {
+			return false;
+		}
+		const int dir_fd = ::dirfd(dir);
+
+		const bool wants_kind = (fields & EntryFields::Kind) == EntryFields::Kind;
+		const bool wants_stat = (fields & (EntryFields::Size | EntryFields::Modified)) != (EntryFields)0;
+
+		dirent* raw = nullptr;
+		while ((raw = ::readdir(dir)) != nullptr) {
+			const char* const name = raw->d_name;
+			if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0))) {
+				continue;
+			}
+
+			DirectoryEntry entry;
+			entry.name = StringView::from_cstring(name);
+
+			// d_type saves a stat per entry on file systems that fill it in
+			bool needs_kind = false;
+			switch (raw->d_type) {
+			case DT_REG:
+				entry.kind = EntryKind::File;
+				break;
+			case DT_DIR:
+				entry.kind = EntryKind::Directory;
+				break;
+			case DT_LNK:
+				entry.kind = EntryKind::Symlink;
+				break;
+			case DT_UNKNOWN:
+				needs_kind = wants_kind;
+				break;
+			default:
+				entry.kind = EntryKind::Other;
+				break;
+			}
+
+			if (needs_kind || wants_stat) {
+				// The entry may have been removed since readdir saw it
+				if (!stat_entry(dir_fd, name, needs_kind, fields, entry)) {
+					continue;
+				}
+			}
 
-		dirent* entry = nullptr;
-		while ((entry = ::readdir(dir)) != nullptr) {
-			if (!f()) {
+			if (!f(entry)) {
 				break;
 			}
 		}
 
 		::closedir(dir);
+		return true;
 	}
 } // namespace Mach::Core
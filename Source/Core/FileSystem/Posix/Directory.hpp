@@ -10,6 +10,9 @@
 #include <Core/Containers/String.hpp>
 
 namespace Mach::Core {
+	struct DirectoryEntry;
+	enum class EntryFields : u8;
+
 	class PosixDirectory {
 	public:
 		static Option<PosixDirectory> open(const StringView& path);
@@ -19,7 +22,12 @@ namespace Mach::Core {
 		PosixDirectory(PosixDirectory&& move) = default;
 		PosixDirectory& operator=(PosixDirectory&& move) = default;
 
-		void for_each(FunctionRef<bool()> f);
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE StringView path() const { return m_path; }
+
+		// Calls f for every entry in the directory, skipping "." and "..". Iteration stops once f returns false.
+		// Returns false if the directory could not be read.
+		bool for_each(FunctionRef<bool(DirectoryEntry const&)> f, EntryFields fields) const;
+		bool for_each(FunctionRef<bool(DirectoryEntry const&)> f) const;
 
 	private:
 		explicit PosixDirectory(String&& path) : m_path(Mach::move(path)) {}
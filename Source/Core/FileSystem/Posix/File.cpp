@@ -15,12 +15,20 @@ namespace Mach::Core {
 	PosixFile PosixFile::stderr{ 2 };
 
 	Option<PosixFile> PosixFile::open(const StringView& path, OpenFlags flags) {
+		const bool read = (flags & OpenFlags::Read) == OpenFlags::Read;
+		const bool write = (flags & OpenFlags::Write) == OpenFlags::Write;
+
 		int open_flags = 0;
-		if ((flags & OpenFlags::Read) == OpenFlags::Read) {
+		if (read && write) {
+			open_flags |= O_RDWR;
+		} else if (write) {
+			open_flags |= O_WRONLY;
+		} else {
 			open_flags |= O_RDONLY;
 		}
-		if ((flags & OpenFlags::Write) == OpenFlags::Write) {
-			open_flags |= O_WRONLY;
+		// Matches CREATE_ALWAYS on Windows
+		if ((flags & OpenFlags::Create) == OpenFlags::Create) {
+			open_flags |= O_CREAT | O_TRUNC;
 		}
 		int fd = ::open((const char*)*path, open_flags, 0644);
 		if (fd == -1) {
@@ -49,6 +57,16 @@ namespace Mach::Core {
 		return static_cast<usize>(::write(m_fd, bytes.begin(), bytes.len()));
 	}
 
+	usize PosixFile::read_at(u64 offset, Slice<u8> bytes) const {
+		MACH_ASSERT(m_fd != -1);
+		return static_cast<usize>(::pread(m_fd, bytes.begin(), bytes.len(), static_cast<off_t>(offset)));
+	}
+
+	usize PosixFile::write_at(u64 offset, Slice<u8 const> bytes) const {
+		MACH_ASSERT(m_fd != -1);
+		return static_cast<usize>(::pwrite(m_fd, bytes.begin(), bytes.len(), static_cast<off_t>(offset)));
+	}
+
 	PosixFile::~PosixFile() {
 		// Only close the file descriptor if it's greater than 2 (stdin, stdout, stderr). Invalid is also -1.
 		if (m_fd > 2) {
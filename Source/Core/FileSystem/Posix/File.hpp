@@ -29,6 +29,12 @@ namespace Mach::Core {
 		MACH_NO_DISCARD usize read(Slice<u8> bytes) final;
 		usize write(Slice<u8 const> bytes) final;
 
+		// Positional IO. Does not move the file cursor so it is safe to call from multiple threads at once.
+		MACH_NO_DISCARD usize read_at(u64 offset, Slice<u8> bytes) const;
+		usize write_at(u64 offset, Slice<u8 const> bytes) const;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE int fd() const { return m_fd; }
+
 	private:
 		explicit PosixFile(int fd) : m_fd(fd) {}
 		int m_fd; // File descriptor
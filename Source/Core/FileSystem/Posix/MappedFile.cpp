@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/MappedFile.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Mach::Core {
+	Option<MappedFile> MappedFile::open(const StringView& path) {
+		const int fd = ::open((const char*)*path, O_RDONLY);
+		if (fd == -1) {
+			return nullopt;
+		}
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0) {
+			::close(fd);
+			return nullopt;
+		}
+
+		// mmap rejects empty ranges but an empty file is still a valid file
+		const usize len = static_cast<usize>(st.st_size);
+		if (len == 0) {
+			::close(fd);
+			return MappedFile{ nullptr, 0 };
+		}
+
+		void* const ptr = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+		// The mapping holds its own reference to the file
+		::close(fd);
+		if (ptr == MAP_FAILED) {
+			return nullopt;
+		}
+
+		return MappedFile{ static_cast<u8 const*>(ptr), len };
+	}
+
+	MappedFile::~MappedFile() {
+		if (m_ptr != nullptr) {
+			::munmap(const_cast<u8*>(m_ptr), m_len);
+			m_ptr = nullptr;
+			m_len = 0;
+		}
+	}
+} // namespace Mach::Core
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Test.hpp>
+#include <Core/FileSystem/Directory.hpp>
+#include <Core/FileSystem/File.hpp>
+#include <Core/FileSystem/VirtualFileSystem.hpp>
+
+namespace Mach::Core {
+	bool VirtualFileSystem::mount_pack(const StringView& path, i32 priority) {
+		auto pack = Pack::open(path);
+		if (!pack.is_set()) {
+			return false;
+		}
+
+		insert(Mount{ .priority = priority, .pack = Mach::move(pack), .directory = String{} });
+		return true;
+	}
+
+	bool VirtualFileSystem::mount_directory(const StringView& path, i32 priority) {
+		if (!Directory::open(path).is_set()) {
+			return false;
+		}
+
+		insert(Mount{ .priority = priority, .pack = nullopt, .directory = String::from(path) });
+		return true;
+	}
+
+	Option<UniquePtr<Reader>> VirtualFileSystem::open(const StringView& path) const {
+		for (Mount const& mount : m_mounts) {
+			if (mount.pack.is_set()) {
+				Pack const& pack = mount.pack.as_const_ref().unwrap();
+				const auto index = pack.find(path);
+				if (index.is_set()) {
+					return pack.open_entry(index.unwrap());
+				}
+				continue;
+			}
+
+			const String full_path = join(mount.directory, path);
+			auto file = File::open(full_path, OpenFlags::Read);
+			if (file.is_set()) {
+				UniquePtr<Reader> reader = UniquePtr<File>::create(file.unwrap());
+				return reader;
+			}
+		}
+		return nullopt;
+	}
+
+	bool VirtualFileSystem::exists(const StringView& path) const {
+		for (Mount const& mount : m_mounts) {
+			if (mount.pack.is_set()) {
+				if (mount.pack.as_const_ref().unwrap().find(path).is_set()) {
+					return true;
+				}
+				continue;
+			}
+
+			const String full_path = join(mount.directory, path);
+			if (File::open(full_path, OpenFlags::Read).is_set()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void VirtualFileSystem::insert(Mount&& mount) {
+		// Keep mounts sorted highest priority first. Ties go in front so the latest mount wins.
+		usize index = 0;
+		while (index < m_mounts.len() && m_mounts[index].priority > mount.priority) {
+			index += 1;
+		}
+		m_mounts.insert(index, Mach::move(mount));
+	}
+
+	String VirtualFileSystem::join(const StringView& directory, const StringView& path) {
+		String result = String::from(directory);
+		if (result.len() > 0) {
+			result.push('/');
+		}
+		result.append(path);
+		return result;
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/TempDirectory.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	Slice<u8 const> vfs_bytes(StringView text) { return static_cast<Slice<UTF8Char const>>(text).as_bytes(); }
+
+	bool write_vfs_pack(TempDirectory const& temp, StringView name, StringView shared, StringView only) {
+		PackBuilder builder;
+		builder.add(u8"shared.txt"_sv, vfs_bytes(shared));
+		builder.add(only, vfs_bytes(only));
+
+		Array<u8> bytes;
+		ArrayWriter writer{ bytes };
+		const usize written = builder.finish(writer);
+		MACH_UNUSED(written);
+		return temp.write_file(name, bytes.as_const_slice());
+	}
+
+	// Returns the whole file as a String or an empty one if nothing is mounted at path
+	String read_vfs(VirtualFileSystem const& vfs, StringView path) {
+		String result;
+		auto reader = vfs.open(path);
+		if (!reader.is_set()) {
+			return result;
+		}
+
+		u8 chunk[64];
+		while (true) {
+			const usize amount = reader.as_ref().unwrap()->read(Slice<u8>{ chunk, sizeof(chunk) });
+			if (amount == 0) break;
+			result.append(StringView{ reinterpret_cast<const UTF8Char*>(chunk), amount });
+		}
+		return result;
+	}
+
+	MACH_TEST_CASE("VirtualFileSystem") {
+		auto maybe_temp = TempDirectory::create();
+		MACH_REQUIRE(maybe_temp.is_set());
+		TempDirectory const& temp = maybe_temp.as_const_ref().unwrap();
+
+		MACH_REQUIRE(write_vfs_pack(temp, u8"a.pack"_sv, u8"pack a"_sv, u8"only_a.txt"_sv));
+		MACH_REQUIRE(write_vfs_pack(temp, u8"b.pack"_sv, u8"pack b"_sv, u8"only_b.txt"_sv));
+		MACH_REQUIRE(temp.create_directory(u8"loose"_sv));
+		MACH_REQUIRE(temp.write_file(u8"loose/shared.txt"_sv, vfs_bytes(u8"loose"_sv)));
+		MACH_REQUIRE(temp.write_file(u8"loose/only_loose.txt"_sv, vfs_bytes(u8"only_loose.txt"_sv)));
+
+		const String a = temp.join(u8"a.pack"_sv);
+		const String b = temp.join(u8"b.pack"_sv);
+		const String loose = temp.join(u8"loose"_sv);
+
+		MACH_SUBCASE("higher priority shadows lower") {
+			VirtualFileSystem vfs;
+			MACH_REQUIRE(vfs.mount_directory(loose, 10));
+			MACH_REQUIRE(vfs.mount_pack(a, 0));
+			MACH_REQUIRE(vfs.mount_pack(b, -10));
+
+			MACH_CHECK(read_vfs(vfs, u8"shared.txt"_sv) == u8"loose"_sv);
+			// Paths only one mount has fall through to it
+			MACH_CHECK(read_vfs(vfs, u8"only_loose.txt"_sv) == u8"only_loose.txt"_sv);
+			MACH_CHECK(read_vfs(vfs, u8"only_a.txt"_sv) == u8"only_a.txt"_sv);
+			MACH_CHECK(read_vfs(vfs, u8"only_b.txt"_sv) == u8"only_b.txt"_sv);
+			MACH_CHECK(vfs.exists(u8"only_b.txt"_sv));
+		}
+
+		MACH_SUBCASE("later mount wins a priority tie") {
+			VirtualFileSystem vfs;
+			MACH_REQUIRE(vfs.mount_pack(a));
+			MACH_REQUIRE(vfs.mount_pack(b));
+			MACH_CHECK(read_vfs(vfs, u8"shared.txt"_sv) == u8"pack b"_sv);
+
+			MACH_REQUIRE(vfs.mount_directory(loose));
+			MACH_CHECK(read_vfs(vfs, u8"shared.txt"_sv) == u8"loose"_sv);
+		}
+
+		MACH_SUBCASE("missing paths") {
+			VirtualFileSystem vfs;
+			MACH_CHECK(!vfs.mount_pack(temp.join(u8"missing.pack"_sv)));
+			MACH_CHECK(!vfs.mount_directory(temp.join(u8"missing"_sv)));
+			// A loose file is not a valid pack
+			MACH_CHECK(!vfs.mount_pack(temp.join(u8"loose/shared.txt"_sv)));
+
+			MACH_REQUIRE(vfs.mount_pack(a));
+			MACH_REQUIRE(vfs.mount_directory(loose));
+			MACH_CHECK(!vfs.open(u8"missing.txt"_sv).is_set());
+			MACH_CHECK(!vfs.exists(u8"missing.txt"_sv));
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/FileSystem/Pack.hpp>
+
+namespace Mach::Core {
+	/**
+	 * Layers packs and loose directories into a single read only namespace. Lookups walk the mounts from the highest
+	 * priority down and the first one that has the path wins, so patches and loose files on disk can override what
+	 * shipped in a pack. Mounts of equal priority prefer whichever was mounted last.
+	 */
+	class VirtualFileSystem {
+	public:
+		VirtualFileSystem() = default;
+		MACH_NO_COPY(VirtualFileSystem);
+		VirtualFileSystem(VirtualFileSystem&& move) = default;
+		VirtualFileSystem& operator=(VirtualFileSystem&& move) = default;
+
+		// Returns false if the pack could not be opened or is not a valid pack
+		bool mount_pack(const StringView& path, i32 priority = 0);
+		// Paths are resolved relative to the directory at open time so files added later are still found
+		bool mount_directory(const StringView& path, i32 priority = 0);
+
+		MACH_NO_DISCARD Option<UniquePtr<Reader>> open(const StringView& path) const;
+		MACH_NO_DISCARD bool exists(const StringView& path) const;
+
+	private:
+		struct Mount {
+			i32 priority;
+			Option<Pack> pack;
+			String directory;
+		};
+
+		void insert(Mount&& mount);
+		MACH_NO_DISCARD static String join(const StringView& directory, const StringView& path);
+
+		Array<Mount> m_mounts;
+	};
+} // namespace Mach::Core
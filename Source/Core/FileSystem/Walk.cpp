@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/Walk.hpp>
+
+#include <Core/Async/Mutex.hpp>
+#include <Core/Debug/Test.hpp>
+
+namespace Mach::Core {
+	class WalkTask final : public Task {
+	public:
+		explicit WalkTask(Scheduler const& scheduler, WalkFunction&& f, EntryFields fields)
+			: m_scheduler(scheduler)
+			, m_f(Mach::move(f))
+			, m_fields(fields) {}
+
+		MACH_NO_DISCARD Status status() const final {
+			return m_pending.load(Order::Acquire) == 0 ? Status::Complete : Status::InProgress;
+		}
+
+		void walk(String const& path) const {
+			auto directory = Directory::open(path);
+			if (directory.is_set()) {
+				const auto& to_walk = directory.as_const_ref().unwrap();
+				const bool readable = to_walk.for_each(
+					[&](DirectoryEntry const& entry) {
+						String child = String::from(path);
+						child.push('/');
+						child.append(entry.name);
+
+						m_f(child, entry);
+
+						if (entry.kind == EntryKind::Directory) {
+							const auto unused = m_pending.fetch_add(1, Order::Relaxed);
+							MACH_UNUSED(unused);
+							m_scheduler.enqueue([this, child]() { walk(child); });
+						}
+						return true;
+					},
+					m_fields | EntryFields::Kind);
+				MACH_UNUSED(readable);
+			}
+
+			// Release so the waiting fiber observes everything f did on this thread
+			const auto unused = m_pending.fetch_sub(1, Order::Release);
+			MACH_UNUSED(unused);
+		}
+
+	private:
+		Scheduler const& m_scheduler;
+		WalkFunction m_f;
+		EntryFields m_fields;
+		// The root counts as the first pending directory
+		Atomic<usize> m_pending{ 1 };
+	};
+
+	void walk_directory(Scheduler const& scheduler, StringView root, WalkFunction f, EntryFields fields) {
+		WalkTask task{ scheduler, Mach::move(f), fields };
+		task.walk(String::from(root));
+		scheduler.wait_for(task);
+	}
+
+	void walk_directory(Scheduler const& scheduler, StringView root, WalkFunction f) {
+		walk_directory(scheduler, root, Mach::move(f), EntryFields::All);
+	}
+} // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/TempDirectory.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("walk_directory") {
+		auto maybe_temp = TempDirectory::create();
+		MACH_REQUIRE(maybe_temp.is_set());
+		TempDirectory const& temp = maybe_temp.as_const_ref().unwrap();
+
+		const u8 bytes[] = { 1, 2, 3 };
+		MACH_REQUIRE(temp.create_directory(u8"sub/deeper/empty"_sv));
+		MACH_REQUIRE(temp.create_directory(u8"other"_sv));
+		MACH_REQUIRE(temp.write_file(u8"a.bin"_sv, Slice<u8 const>{ bytes, 3 }));
+		MACH_REQUIRE(temp.write_file(u8"sub/b.bin"_sv, Slice<u8 const>{ bytes, 2 }));
+		MACH_REQUIRE(temp.write_file(u8"sub/deeper/c.bin"_sv, Slice<u8 const>{ bytes, 1 }));
+		MACH_REQUIRE(temp.write_file(u8"other/d.bin"_sv, Slice<u8 const>{}));
+
+		struct Expected {
+			StringView path;
+			EntryKind kind;
+		};
+		const Expected expected[] = {
+			{ u8"a.bin"_sv, EntryKind::File },
+			{ u8"sub"_sv, EntryKind::Directory },
+			{ u8"sub/b.bin"_sv, EntryKind::File },
+			{ u8"sub/deeper"_sv, EntryKind::Directory },
+			{ u8"sub/deeper/c.bin"_sv, EntryKind::File },
+			{ u8"sub/deeper/empty"_sv, EntryKind::Directory },
+			{ u8"other"_sv, EntryKind::Directory },
+			{ u8"other/d.bin"_sv, EntryKind::File },
+		};
+
+		MACH_SUBCASE("listing fills in the requested fields") {
+			auto directory = Directory::open(temp.join(u8"sub"_sv));
+			MACH_REQUIRE(directory.is_set());
+
+			usize count = 0;
+			bool correct = true;
+			const bool readable = directory.as_const_ref().unwrap().for_each(
+				[&](DirectoryEntry const& entry) {
+					count += 1;
+					if (entry.name == u8"b.bin"_sv) {
+						correct &= entry.kind == EntryKind::File && entry.size == 2 && entry.modified != 0;
+					} else {
+						correct &= entry.name == u8"deeper"_sv && entry.kind == EntryKind::Directory;
+					}
+					return true;
+				},
+				EntryFields::All);
+			MACH_CHECK(readable);
+			MACH_CHECK(count == 2);
+			MACH_CHECK(correct);
+		}
+
+		MACH_SUBCASE("visits every entry once") {
+			// A single worker keeps the Scheduler from leaving threads behind, the walk still goes through its queue
+			Scheduler scheduler;
+			scheduler.init({
+				.thread_count = 1,
+				.fiber_count = 4,
+				.waiting_count = 4,
+			});
+
+			struct Visited {
+				String path;
+				EntryKind kind;
+			};
+			const Mutex<Array<Visited>> visited{ Array<Visited>{} };
+			const usize prefix = temp.path().len() + 1;
+			walk_directory(
+				scheduler,
+				temp.path(),
+				[&](StringView path, DirectoryEntry const& entry) {
+					const StringView relative{ *path + prefix, path.len() - prefix };
+					visited.lock()->push(Visited{ .path = String::from(relative), .kind = entry.kind });
+				},
+				EntryFields::Kind);
+
+			auto result = visited.lock();
+			MACH_CHECK(result->len() == sizeof(expected) / sizeof(expected[0]));
+			for (Expected const& entry : expected) {
+				usize matches = 0;
+				for (Visited const& visit : *result) {
+					if (visit.path == entry.path && visit.kind == entry.kind) {
+						matches += 1;
+					}
+				}
+				MACH_CHECK(matches == 1);
+			}
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
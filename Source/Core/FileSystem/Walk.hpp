@@ -0,0 +1,24 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Async/Scheduler.hpp>
+#include <Core/FileSystem/Directory.hpp>
+
+namespace Mach::Core {
+	using WalkFunction = FunctionRef<void(StringView path, DirectoryEntry const& entry)>;
+
+	/**
+	 * Visits every entry below root. Each subdirectory is listed on its own Scheduler job so large trees are walked by
+	 * all workers at once, which means f is called concurrently and in no particular order. Symlinks are reported but
+	 * never followed.
+	 *
+	 * Suspends the calling fiber until the whole tree has been visited so it must be called from a Scheduler worker.
+	 */
+	void walk_directory(Scheduler const& scheduler, StringView root, WalkFunction f, EntryFields fields);
+	void walk_directory(Scheduler const& scheduler, StringView root, WalkFunction f);
+} // namespace Mach::Core
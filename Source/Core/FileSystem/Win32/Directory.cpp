@@ -10,6 +10,15 @@
 #include <Core/Windows.hpp>
 
 namespace Mach::Core {
+	Option<Win32Directory> Win32Directory::open(const StringView& path) {
+		const auto wpath = WString::from(path);
+		const DWORD attributes = ::GetFileAttributesW(*wpath);
+		if (attributes == INVALID_FILE_ATTRIBUTES || (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+			return nullopt;
+		}
+		return Win32Directory{ String::from(path) };
+	}
+
 	Win32Directory Win32Directory::cwd() {
 		// Query the length of the path
 		const auto len = (usize)::GetCurrentDirectoryW(0, nullptr);
@@ -29,4 +38,66 @@ namespace Mach::Core {
 		}
 		return Win32Directory(Mach::move(result));
 	}
+
+	bool Win32Directory::for_each(FunctionRef<bool(DirectoryEntry const&)> f) const {
+		return for_each(Mach::move(f), EntryFields::All);
+	}
+
+	bool Win32Directory::for_each(FunctionRef<bool(DirectoryEntry const&)> f, EntryFields fields) const {
+		MACH_UNUSED(fields);
+
+		String pattern = String::from(m_path);
+		pattern.append(u8"\\*"_sv);
+		const auto wpattern = WString::from(pattern);
+
+		// FindFirstFileEx hands back size and write time with the name so no field needs an extra query
+		WIN32_FIND_DATAW data;
+		HANDLE find = ::FindFirstFileExW(
+			*wpattern,
+			FindExInfoBasic,
+			&data,
+			FindExSearchNameMatch,
+			nullptr,
+			FIND_FIRST_EX_LARGE_FETCH);
+		if (find == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		String name;
+		do {
+			const WChar* const file_name = data.cFileName;
+			if (file_name[0] == L'.' && (file_name[1] == 0 || (file_name[1] == L'.' && file_name[2] == 0))) {
+				continue;
+			}
+
+			name = String{};
+			for (usize index = 0; file_name[index] != 0; index += 1) {
+				name.push(utf16_to_utf32(file_name[index]));
+			}
+
+			DirectoryEntry entry;
+			entry.name = name;
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0) {
+				entry.kind = EntryKind::Symlink;
+			} else if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+				entry.kind = EntryKind::Directory;
+			} else {
+				entry.kind = EntryKind::File;
+			}
+			entry.size = (static_cast<u64>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+
+			// FILETIME counts 100ns intervals since 1601
+			constexpr u64 unix_epoch_in_filetime = 116444736000000000;
+			const u64 filetime =
+				(static_cast<u64>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+			entry.modified = filetime > unix_epoch_in_filetime ? (filetime - unix_epoch_in_filetime) * 100 : 0;
+
+			if (!f(entry)) {
+				break;
+			}
+		} while (::FindNextFileW(find, &data));
+
+		::FindClose(find);
+		return true;
+	}
 } // namespace Mach::Core
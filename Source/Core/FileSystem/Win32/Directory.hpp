@@ -10,6 +10,9 @@
 #include <Core/Containers/String.hpp>
 
 namespace Mach::Core {
+	struct DirectoryEntry;
+	enum class EntryFields : u8;
+
 	class Win32Directory {
 	public:
 		static Option<Win32Directory> open(const StringView& path);
@@ -19,7 +22,12 @@ namespace Mach::Core {
 		Win32Directory(Win32Directory&& move) = default;
 		Win32Directory& operator=(Win32Directory&& move) = default;
 
-		void for_each(FunctionRef<bool()> f);
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE StringView path() const { return m_path; }
+
+		// Calls f for every entry in the directory, skipping "." and "..". Iteration stops once f returns false.
+		// Returns false if the directory could not be read.
+		bool for_each(FunctionRef<bool(DirectoryEntry const&)> f, EntryFields fields) const;
+		bool for_each(FunctionRef<bool(DirectoryEntry const&)> f) const;
 
 	private:
 		explicit Win32Directory(String&& path) : m_path(Mach::move(path)) {}
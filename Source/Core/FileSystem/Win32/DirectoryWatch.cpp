@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/Win32/DirectoryWatch.hpp>
+
+#include <Core/Containers/WString.hpp>
+#include <Core/Windows.hpp>
+
+namespace Mach::Core {
+	static constexpr DWORD notify_filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+										   FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+	struct Win32DirectoryWatch::Request {
+		OVERLAPPED overlapped;
+		// FILE_NOTIFY_INFORMATION records are DWORD aligned. 64 KiB is the most a network share will hand back.
+		alignas(DWORD) u8 buffer[64 * 1024];
+	};
+
+	Option<UniquePtr<Win32DirectoryWatch>> Win32DirectoryWatch::create(StringView root, bool recursive) {
+		const auto wpath = WString::from(root);
+		HANDLE directory = ::CreateFileW(
+			*wpath,
+			FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+			nullptr);
+		if (directory == INVALID_HANDLE_VALUE) {
+			return nullopt;
+		}
+
+		// Manual reset as required for an OVERLAPPED that is waited on directly
+		HANDLE completion_event = ::CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		HANDLE wake_event = ::CreateEventW(nullptr, FALSE, FALSE, nullptr);
+		if (completion_event == nullptr || wake_event == nullptr) {
+			if (completion_event != nullptr) ::CloseHandle(completion_event);
+			if (wake_event != nullptr) ::CloseHandle(wake_event);
+			::CloseHandle(directory);
+			return nullopt;
+		}
+
+		Request request = {};
+		request.overlapped.hEvent = completion_event;
+
+		Win32DirectoryWatch watch{ directory, wake_event, UniquePtr<Request>::create(request), recursive };
+		if (!watch.issue_read()) {
+			return nullopt;
+		}
+		return UniquePtr<Win32DirectoryWatch>::create(Mach::move(watch));
+	}
+
+	Win32DirectoryWatch::Win32DirectoryWatch(
+		void* directory,
+		void* wake_event,
+		UniquePtr<Request>&& request,
+		bool recursive)
+		: m_directory(directory)
+		, m_wake_event(wake_event)
+		, m_request(Mach::move(request))
+		, m_recursive(recursive) {}
+
+	Win32DirectoryWatch::Win32DirectoryWatch(Win32DirectoryWatch&& move) noexcept
+		: m_directory(move.m_directory)
+		, m_wake_event(move.m_wake_event)
+		, m_request(Mach::move(move.m_request))
+		, m_recursive(move.m_recursive) {
+		move.m_directory = nullptr;
+		move.m_wake_event = nullptr;
+	}
+
+	bool Win32DirectoryWatch::issue_read() {
+		::ResetEvent(m_request->overlapped.hEvent);
+		return ::ReadDirectoryChangesW(
+			m_directory,
+			m_request->buffer,
+			sizeof(m_request->buffer),
+			m_recursive ? TRUE : FALSE,
+			notify_filter,
+			nullptr,
+			&m_request->overlapped,
+			nullptr);
+	}
+
+	void Win32DirectoryWatch::wait(Option<u32> timeout_ms, Array<Event>& events) {
+		HANDLE handles[] = { m_request->overlapped.hEvent, m_wake_event };
+		const DWORD timeout = timeout_ms.is_set() ? static_cast<DWORD>(timeout_ms.unwrap()) : INFINITE;
+		const DWORD result = ::WaitForMultipleObjects(2, handles, FALSE, timeout);
+		if (result != WAIT_OBJECT_0) {
+			return;
+		}
+
+		DWORD amount = 0;
+		if (!::GetOverlappedResult(m_directory, &m_request->overlapped, &amount, FALSE) || amount == 0) {
+			// The buffer overflowed and the kernel threw the changes away
+			events.push(Event{ .path = String{}, .change = FileChange::Overflow });
+		} else {
+			usize offset = 0;
+			while (true) {
+				const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(m_request->buffer + offset);
+
+				FileChange change;
+				switch (info->Action) {
+				case FILE_ACTION_ADDED:
+				case FILE_ACTION_RENAMED_NEW_NAME:
+					change = FileChange::Created;
+					break;
+				case FILE_ACTION_REMOVED:
+				case FILE_ACTION_RENAMED_OLD_NAME:
+					change = FileChange::Removed;
+					break;
+				default:
+					change = FileChange::Modified;
+					break;
+				}
+
+				String path;
+				const usize name_len = info->FileNameLength / sizeof(WCHAR);
+				for (usize index = 0; index < name_len; index += 1) {
+					const WChar c = info->FileName[index];
+					path.push(c == L'\\' ? '/' : utf16_to_utf32(c));
+				}
+				events.push(Event{ .path = Mach::move(path), .change = change });
+
+				if (info->NextEntryOffset == 0) {
+					break;
+				}
+				offset += info->NextEntryOffset;
+			}
+		}
+
+		if (!issue_read()) {
+			// The directory is gone. Report it once and stop producing events.
+			events.push(Event{ .path = String{}, .change = FileChange::Overflow });
+		}
+	}
+
+	void Win32DirectoryWatch::wake() const { ::SetEvent(m_wake_event); }
+
+	Win32DirectoryWatch::~Win32DirectoryWatch() {
+		if (m_directory != nullptr) {
+			// The read has to be finished before the request it writes into is freed
+			::CancelIoEx(m_directory, &m_request->overlapped);
+			DWORD amount = 0;
+			::GetOverlappedResult(m_directory, &m_request->overlapped, &amount, TRUE);
+			::CloseHandle(m_request->overlapped.hEvent);
+			::CloseHandle(m_directory);
+			m_directory = nullptr;
+		}
+		if (m_wake_event != nullptr) {
+			::CloseHandle(m_wake_event);
+			m_wake_event = nullptr;
+		}
+	}
+} // namespace Mach::Core
@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/FileSystem/FileWatcher.hpp>
+
+namespace Mach::Core {
+	// Keeps a single overlapped ReadDirectoryChangesW in flight on the root, which covers the whole tree when recursive
+	class Win32DirectoryWatch final : public FileWatchBackend {
+	public:
+		MACH_NO_DISCARD static Option<UniquePtr<Win32DirectoryWatch>> create(StringView root, bool recursive);
+
+		Win32DirectoryWatch(Win32DirectoryWatch&& move) noexcept;
+		Win32DirectoryWatch& operator=(Win32DirectoryWatch&&) = delete;
+		MACH_NO_COPY(Win32DirectoryWatch);
+
+		void wait(Option<u32> timeout_ms, Array<Event>& events) final;
+		void wake() const final;
+
+		~Win32DirectoryWatch() final;
+
+	private:
+		// The kernel writes into the request while it is in flight so it lives on the heap where moves can not touch it
+		struct Request;
+
+		explicit Win32DirectoryWatch(void* directory, void* wake_event, UniquePtr<Request>&& request, bool recursive);
+
+		bool issue_read();
+
+		void* m_directory;
+		void* m_wake_event;
+		UniquePtr<Request> m_request;
+		bool m_recursive;
+	};
+} // namespace Mach::Core
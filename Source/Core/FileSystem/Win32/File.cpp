@@ -86,4 +86,34 @@ namespace Mach::Core {
 
 		return amount_written;
 	}
+
+	usize Win32File::read_at(u64 offset, Slice<u8> bytes) const {
+		MACH_ASSERT(m_handle != nullptr);
+		MACH_ASSERT((m_flags & OpenFlags::Read) == OpenFlags::Read);
+
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(offset);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+		DWORD amount_read = 0;
+		if (!::ReadFile(m_handle, bytes.begin(), static_cast<DWORD>(bytes.len()), &amount_read, &overlapped)) {
+			return 0;
+		}
+		return amount_read;
+	}
+
+	usize Win32File::write_at(u64 offset, Slice<u8 const> bytes) const {
+		MACH_ASSERT(m_handle != nullptr);
+		MACH_ASSERT((m_flags & OpenFlags::Write) == OpenFlags::Write);
+
+		OVERLAPPED overlapped = {};
+		overlapped.Offset = static_cast<DWORD>(offset);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+		DWORD amount_written = 0;
+		if (!::WriteFile(m_handle, bytes.begin(), static_cast<DWORD>(bytes.len()), &amount_written, &overlapped)) {
+			return 0;
+		}
+		return amount_written;
+	}
 } // namespace Mach::Core
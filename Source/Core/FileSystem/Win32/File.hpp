@@ -34,6 +34,12 @@ namespace Mach::Core {
 		usize write(Slice<u8 const> bytes) final;
 		// ~Writer interface
 
+		// Positional IO at an explicit offset. Safe to call from multiple threads at once.
+		MACH_NO_DISCARD usize read_at(u64 offset, Slice<u8> bytes) const;
+		usize write_at(u64 offset, Slice<u8 const> bytes) const;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE void* handle() const { return m_handle; }
+
 	private:
 		explicit Win32File(void* handle, OpenFlags flags) : m_handle(handle), m_flags(flags) {}
 
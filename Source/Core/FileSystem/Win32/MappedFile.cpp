@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/FileSystem/MappedFile.hpp>
+
+#include <Core/Containers/WString.hpp>
+#include <Core/Windows.hpp>
+
+namespace Mach::Core {
+	Option<MappedFile> MappedFile::open(const StringView& path) {
+		const auto wpath = WString::from(path);
+		HANDLE file = ::CreateFileW(
+			*wpath,
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return nullopt;
+		}
+		MACH_DEFER(::CloseHandle(file));
+
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(file, &size)) {
+			return nullopt;
+		}
+
+		// CreateFileMapping rejects empty files but an empty file is still a valid file
+		const usize len = static_cast<usize>(size.QuadPart);
+		if (len == 0) {
+			return MappedFile{ nullptr, 0 };
+		}
+
+		HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			return nullopt;
+		}
+		// The view holds its own reference to the mapping
+		MACH_DEFER(::CloseHandle(mapping));
+
+		void* const ptr = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (ptr == nullptr) {
+			return nullopt;
+		}
+
+		return MappedFile{ static_cast<u8 const*>(ptr), len };
+	}
+
+	MappedFile::~MappedFile() {
+		if (m_ptr != nullptr) {
+			::UnmapViewOfFile(m_ptr);
+			m_ptr = nullptr;
+			m_len = 0;
+		}
+	}
+} // namespace Mach::Core
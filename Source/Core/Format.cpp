@@ -7,6 +7,8 @@
 #include <Core/Format.hpp>
 #include <cstdio>
 
+#include <Core/Debug/Benchmark.hpp>
+
 namespace Mach::Core {
 	// https://en.wikipedia.org/wiki/ANSI_escape_code#Colors
 	struct ANSIIdentifier {
@@ -214,3 +216,20 @@ namespace Mach::Core {
 		return writer.write(Slice<u8 const>{ (const u8*)buffer, static_cast<usize>(written) });
 	}
 } // namespace Mach::Core
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Formatter::format") {
+	using namespace Mach::Core;
+
+	Array<u8> output;
+	output.reserve(256);
+	ArrayWriter writer{ output };
+	const StringView name = u8"Formatter"_sv;
+	bencher.iter([&] {
+		output.set_len_uninitialized(0);
+		Formatter formatter{ writer, false };
+		formatter.format(u8"{} took {} ms over {} frames\n"_sv, name, 12.5, 1234567u);
+		return output.len();
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
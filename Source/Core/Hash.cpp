@@ -4,7 +4,9 @@
  * This software is released under the MIT License.
  */
 
+#include <Core/Debug/Test.hpp>
 #include <Core/Hash.hpp>
+#include <Core/Memory.hpp>
 
 namespace Mach::Core {
 	const u64 FNV1Hasher::offset_basic = 0xcbf29ce484222325ULL;
@@ -20,4 +22,143 @@ namespace Mach::Core {
 		}
 		m_result |= hash;
 	}
+
+	static constexpr u32 xxh32_prime1 = 0x9E3779B1U;
+	static constexpr u32 xxh32_prime2 = 0x85EBCA77U;
+	static constexpr u32 xxh32_prime3 = 0xC2B2AE3DU;
+	static constexpr u32 xxh32_prime4 = 0x27D4EB2FU;
+	static constexpr u32 xxh32_prime5 = 0x165667B1U;
+
+	static MACH_ALWAYS_INLINE u32 rotate_left(u32 value, u32 amount) {
+		return (value << amount) | (value >> (32 - amount));
+	}
+
+	static MACH_ALWAYS_INLINE u32 read_u32_le(const u8* ptr) {
+		return static_cast<u32>(ptr[0]) | (static_cast<u32>(ptr[1]) << 8) | (static_cast<u32>(ptr[2]) << 16) |
+			   (static_cast<u32>(ptr[3]) << 24);
+	}
+
+	static MACH_ALWAYS_INLINE u32 xxh32_round(u32 lane, u32 input) {
+		lane += input * xxh32_prime2;
+		lane = rotate_left(lane, 13);
+		return lane * xxh32_prime1;
+	}
+
+	XXH32Hasher::XXH32Hasher(u32 seed) : m_seed(seed) {
+		m_lanes[0] = seed + xxh32_prime1 + xxh32_prime2;
+		m_lanes[1] = seed + xxh32_prime2;
+		m_lanes[2] = seed;
+		m_lanes[3] = seed - xxh32_prime1;
+	}
+
+	void XXH32Hasher::write(Slice<u8 const> bytes) {
+		m_total_len += bytes.len();
+
+		const u8* ptr = bytes.begin();
+		const u8* const end = bytes.end();
+
+		// Top up a partial stripe from a previous write first
+		if (m_buffered > 0) {
+			const usize wanted = sizeof(m_buffer) - m_buffered;
+			const usize available = static_cast<usize>(end - ptr);
+			const usize amount = wanted < available ? wanted : available;
+			if (amount > 0) {
+				Memory::copy(m_buffer + m_buffered, ptr, amount);
+			}
+			m_buffered += amount;
+			ptr += amount;
+			if (m_buffered < sizeof(m_buffer)) {
+				return;
+			}
+
+			for (usize lane = 0; lane < 4; lane += 1) {
+				m_lanes[lane] = xxh32_round(m_lanes[lane], read_u32_le(m_buffer + lane * 4));
+			}
+			m_buffered = 0;
+		}
+
+		while (end - ptr >= 16) {
+			m_lanes[0] = xxh32_round(m_lanes[0], read_u32_le(ptr));
+			m_lanes[1] = xxh32_round(m_lanes[1], read_u32_le(ptr + 4));
+			m_lanes[2] = xxh32_round(m_lanes[2], read_u32_le(ptr + 8));
+			m_lanes[3] = xxh32_round(m_lanes[3], read_u32_le(ptr + 12));
+			ptr += 16;
+		}
+
+		m_buffered = static_cast<usize>(end - ptr);
+		if (m_buffered > 0) {
+			Memory::copy(m_buffer, ptr, m_buffered);
+		}
+	}
+
+	u64 XXH32Hasher::finish() {
+		u32 hash;
+		if (m_total_len >= 16) {
+			hash = rotate_left(m_lanes[0], 1) + rotate_left(m_lanes[1], 7) + rotate_left(m_lanes[2], 12) +
+				   rotate_left(m_lanes[3], 18);
+		} else {
+			hash = m_seed + xxh32_prime5;
+		}
+		hash += static_cast<u32>(m_total_len);
+
+		const u8* ptr = m_buffer;
+		const u8* const end = m_buffer + m_buffered;
+		while (end - ptr >= 4) {
+			hash += read_u32_le(ptr) * xxh32_prime3;
+			hash = rotate_left(hash, 17) * xxh32_prime4;
+			ptr += 4;
+		}
+		while (ptr < end) {
+			hash += static_cast<u32>(*ptr) * xxh32_prime5;
+			hash = rotate_left(hash, 11) * xxh32_prime1;
+			ptr += 1;
+		}
+
+		hash ^= hash >> 15;
+		hash *= xxh32_prime2;
+		hash ^= hash >> 13;
+		hash *= xxh32_prime3;
+		hash ^= hash >> 16;
+		return hash;
+	}
 } // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("XXH32") {
+		auto hash = [](auto const& string, u32 seed) {
+			XXH32Hasher hasher{ seed };
+			hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(string), sizeof(string) - 1 });
+			return hasher.finish();
+		};
+
+		MACH_SUBCASE("reference values") {
+			MACH_CHECK(hash("", 0) == 0x02CC5D05);
+			MACH_CHECK(hash("a", 0) == 0x550D7456);
+			MACH_CHECK(hash("abc", 0) == 0x32D153FF);
+			MACH_CHECK(hash("Nobody inspects the spammish repetition", 0) == 0xE2293B2F);
+		}
+
+		MACH_SUBCASE("streaming matches one shot") {
+			u8 bytes[100];
+			for (usize index = 0; index < sizeof(bytes); index += 1) {
+				bytes[index] = static_cast<u8>(index * 7);
+			}
+
+			XXH32Hasher whole;
+			whole.write(Slice<u8 const>{ bytes, sizeof(bytes) });
+
+			XXH32Hasher pieces;
+			usize offset = 0;
+			for (usize len = 1; offset < sizeof(bytes); len += 1) {
+				const usize amount = len < sizeof(bytes) - offset ? len : sizeof(bytes) - offset;
+				pieces.write(Slice<u8 const>{ bytes + offset, amount });
+				offset += amount;
+			}
+			MACH_CHECK(whole.finish() == pieces.finish());
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
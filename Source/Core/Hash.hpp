@@ -31,16 +31,36 @@ namespace Mach::Core {
 	private:
 		u64 m_result = 0;
 	};
+
+	// xxHash 32 bit. Used for checksums by formats like the LZ4 frame format, so it has to match the reference exactly.
+	// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+	class XXH32Hasher final : public Hasher {
+	public:
+		XXH32Hasher() : XXH32Hasher(0) {}
+		explicit XXH32Hasher(u32 seed);
+
+		// Hasher
+		u64 finish() final;
+		void write(Slice<u8 const> bytes) final;
+		// ~Hasher
+
+	private:
+		u32 m_seed;
+		u32 m_lanes[4];
+		u8 m_buffer[16];
+		usize m_buffered = 0;
+		u64 m_total_len = 0;
+	};
 } // namespace Mach::Core
 
 namespace Mach {
 	template <typename Hasher>
 	void hash(Hasher& hasher, const u8& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(u8) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(u8) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const u16& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(u16) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(u16) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const u32& value) {
@@ -48,30 +68,30 @@ namespace Mach {
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const u64& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(u64) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(u64) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const i8& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(i8) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(i8) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const i16& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(i16) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(i16) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const i32& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(i32) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(i32) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const i64& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(i64) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(i64) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const f32& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(f32) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(f32) });
 	}
 	template <typename Hasher>
 	void hash(Hasher& hasher, const f64& value) {
-		hasher.write({ reinterpret_cast<const u8*>(&value), sizeof(f64) });
+		hasher.write(Slice<u8 const>{ reinterpret_cast<const u8*>(&value), sizeof(f64) });
 	}
 } // namespace Mach
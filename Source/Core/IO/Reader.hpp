@@ -7,6 +7,7 @@
 #pragma once
 
 #include <Core/Containers/Slice.hpp>
+#include <Core/Memory.hpp>
 
 namespace Mach::Core {
 	class Reader {
@@ -14,4 +15,24 @@ namespace Mach::Core {
 		virtual ~Reader() {}
 		virtual usize read(Slice<u8> bytes) = 0;
 	};
+
+	// Reads out of memory owned by someone else
+	class SliceReader final : public Reader {
+	public:
+		explicit SliceReader(Slice<u8 const> bytes) : m_bytes(bytes) {}
+
+		usize read(Slice<u8> bytes) final {
+			const usize remaining = m_bytes.len() - m_cursor;
+			const usize amount = bytes.len() < remaining ? bytes.len() : remaining;
+			if (amount > 0) {
+				Memory::copy(bytes.begin(), m_bytes.begin() + m_cursor, amount);
+				m_cursor += amount;
+			}
+			return amount;
+		}
+
+	private:
+		Slice<u8 const> m_bytes;
+		usize m_cursor = 0;
+	};
 } // namespace Mach::Core
@@ -24,6 +24,24 @@ namespace Mach::Core {
 		usize write(Slice<u8 const> bytes) final { return bytes.len(); }
 	};
 
+	// Appends everything written to an Array
+	class ArrayWriter final : public Writer {
+	public:
+		explicit ArrayWriter(Array<u8>& array) : m_array(array) {}
+
+		usize write(Slice<u8 const> bytes) final {
+			const usize start = m_array.len();
+			m_array.set_len_uninitialized(start + bytes.len());
+			if (bytes.len() > 0) {
+				Memory::copy(m_array.begin() + start, bytes.begin(), bytes.len());
+			}
+			return bytes.len();
+		}
+
+	private:
+		Array<u8>& m_array;
+	};
+
 	template <usize Size = 4096>
 	class BufferedWriter final : public Writer {
 	public:
@@ -0,0 +1,452 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+#include <Core/Math/Batch.hpp>
+
+namespace Mach::Core::Math {
+	Frustum Frustum::from_matrix(Matrix4<f32> const& view_projection) {
+		// https://www.gamedevs.org/uploads/fast-extraction-viewing-frustum-planes-from-world-view-projection-matrix.pdf
+		const auto r0 = view_projection.row(0);
+		const auto r1 = view_projection.row(1);
+		const auto r2 = view_projection.row(2);
+		const auto r3 = view_projection.row(3);
+
+		Frustum result;
+		result.planes[0] = r3 + r0;
+		result.planes[1] = r3 - r0;
+		result.planes[2] = r3 + r1;
+		result.planes[3] = r3 - r1;
+		result.planes[4] = r2;
+		result.planes[5] = r3 - r2;
+
+		// Normalize so distances to the planes are in world units
+		for (auto& plane : result.planes) {
+			const f32 len = plane.xyz().len();
+			if (len > small_number<f32>) {
+				plane = plane / Vector4<f32>{ len };
+			}
+		}
+		return result;
+	}
+
+	void transform_points(Matrix4<f32> const& matrix, Slice<Vector3<f32> const> in, Slice<Vector3<f32>> out) {
+		MACH_ASSERT(in.len() == out.len());
+
+		const auto m00 = f32x4::splat(matrix.x.x);
+		const auto m01 = f32x4::splat(matrix.x.y);
+		const auto m02 = f32x4::splat(matrix.x.z);
+		const auto m10 = f32x4::splat(matrix.y.x);
+		const auto m11 = f32x4::splat(matrix.y.y);
+		const auto m12 = f32x4::splat(matrix.y.z);
+		const auto m20 = f32x4::splat(matrix.z.x);
+		const auto m21 = f32x4::splat(matrix.z.y);
+		const auto m22 = f32x4::splat(matrix.z.z);
+		const auto m30 = f32x4::splat(matrix.w.x);
+		const auto m31 = f32x4::splat(matrix.w.y);
+		const auto m32 = f32x4::splat(matrix.w.z);
+
+		usize index = 0;
+		for (; index + 4 <= in.len(); index += 4) {
+			// Gather four points into one register per component so a single instruction works on all of them
+			const Vector3<f32>* p = &in[index];
+			const auto x = f32x4::set(p[0].x, p[1].x, p[2].x, p[3].x);
+			const auto y = f32x4::set(p[0].y, p[1].y, p[2].y, p[3].y);
+			const auto z = f32x4::set(p[0].z, p[1].z, p[2].z, p[3].z);
+
+			alignas(16) f32 ox[4];
+			alignas(16) f32 oy[4];
+			alignas(16) f32 oz[4];
+			f32x4::mul_add(m20, z, f32x4::mul_add(m10, y, f32x4::mul_add(m00, x, m30))).store(ox);
+			f32x4::mul_add(m21, z, f32x4::mul_add(m11, y, f32x4::mul_add(m01, x, m31))).store(oy);
+			f32x4::mul_add(m22, z, f32x4::mul_add(m12, y, f32x4::mul_add(m02, x, m32))).store(oz);
+
+			for (usize lane = 0; lane < 4; lane += 1) {
+				out[index + lane] = Vector3<f32>{ ox[lane], oy[lane], oz[lane] };
+			}
+		}
+		for (; index < in.len(); index += 1) {
+			out[index] = matrix.transform_point(in[index]);
+		}
+	}
+
+	void transform_points(Matrix4<f32> const& matrix, Vector3SoA<f32 const> in, Vector3SoA<f32> out) {
+		const usize len = in.len();
+		MACH_ASSERT(len == out.len());
+
+		const auto m00 = f32x4::splat(matrix.x.x);
+		const auto m01 = f32x4::splat(matrix.x.y);
+		const auto m02 = f32x4::splat(matrix.x.z);
+		const auto m10 = f32x4::splat(matrix.y.x);
+		const auto m11 = f32x4::splat(matrix.y.y);
+		const auto m12 = f32x4::splat(matrix.y.z);
+		const auto m20 = f32x4::splat(matrix.z.x);
+		const auto m21 = f32x4::splat(matrix.z.y);
+		const auto m22 = f32x4::splat(matrix.z.z);
+		const auto m30 = f32x4::splat(matrix.w.x);
+		const auto m31 = f32x4::splat(matrix.w.y);
+		const auto m32 = f32x4::splat(matrix.w.z);
+
+		usize index = 0;
+		for (; index + 4 <= len; index += 4) {
+			const auto x = f32x4::load_unaligned(&in.x[index]);
+			const auto y = f32x4::load_unaligned(&in.y[index]);
+			const auto z = f32x4::load_unaligned(&in.z[index]);
+
+			f32x4::mul_add(m20, z, f32x4::mul_add(m10, y, f32x4::mul_add(m00, x, m30))).store_unaligned(&out.x[index]);
+			f32x4::mul_add(m21, z, f32x4::mul_add(m11, y, f32x4::mul_add(m01, x, m31))).store_unaligned(&out.y[index]);
+			f32x4::mul_add(m22, z, f32x4::mul_add(m12, y, f32x4::mul_add(m02, x, m32))).store_unaligned(&out.z[index]);
+		}
+		for (; index < len; index += 1) {
+			const auto p = matrix.transform_point({ in.x[index], in.y[index], in.z[index] });
+			out.x[index] = p.x;
+			out.y[index] = p.y;
+			out.z[index] = p.z;
+		}
+	}
+
+	void slerp(
+		Slice<Quaternion<f32> const> from,
+		Slice<Quaternion<f32> const> to,
+		Slice<f32 const> t,
+		Slice<Quaternion<f32>> out) {
+		MACH_ASSERT(from.len() == to.len() && to.len() == t.len() && t.len() == out.len());
+
+		usize index = 0;
+		for (; index + 4 <= from.len(); index += 4) {
+			// Quaternion<f32> is always 16 byte aligned. Transpose four of them into one register per component.
+			auto fx = f32x4::load(&from[index].x);
+			auto fy = f32x4::load(&from[index + 1].x);
+			auto fz = f32x4::load(&from[index + 2].x);
+			auto fw = f32x4::load(&from[index + 3].x);
+			f32x4::transpose(fx, fy, fz, fw);
+			auto tx = f32x4::load(&to[index].x);
+			auto ty = f32x4::load(&to[index + 1].x);
+			auto tz = f32x4::load(&to[index + 2].x);
+			auto tw = f32x4::load(&to[index + 3].x);
+			f32x4::transpose(tx, ty, tz, tw);
+
+			alignas(16) f32 cos_theta[4];
+			(fx * tx + fy * ty + fz * tz + fw * tw).store(cos_theta);
+
+			// Trigonometry has no vector form here, so only the weights are computed per lane. Matches
+			// Quaternion::slerp.
+			alignas(16) f32 from_weights[4];
+			alignas(16) f32 to_weights[4];
+			for (usize lane = 0; lane < 4; lane += 1) {
+				f32 cos = cos_theta[lane];
+				f32 sign = 1.f;
+				if (cos < 0.f) {
+					cos = -cos;
+					sign = -1.f;
+				}
+
+				const f32 lane_t = t[index + lane];
+				f32 from_weight = 1.f - lane_t;
+				f32 to_weight = lane_t;
+				if (cos < 1.f - kinda_small_number<f32>) {
+					const f32 theta = Math::acos(cos);
+					const f32 inv_sin_theta = 1.f / Math::sin(theta);
+					from_weight = Math::sin((1.f - lane_t) * theta) * inv_sin_theta;
+					to_weight = Math::sin(lane_t * theta) * inv_sin_theta;
+				}
+				from_weights[lane] = from_weight;
+				to_weights[lane] = to_weight * sign;
+			}
+
+			const auto from_weight = f32x4::load(from_weights);
+			const auto to_weight = f32x4::load(to_weights);
+			auto x = f32x4::mul_add(tx, to_weight, fx * from_weight);
+			auto y = f32x4::mul_add(ty, to_weight, fy * from_weight);
+			auto z = f32x4::mul_add(tz, to_weight, fz * from_weight);
+			auto w = f32x4::mul_add(tw, to_weight, fw * from_weight);
+			f32x4::transpose(x, y, z, w);
+			x.store(&out[index].x);
+			y.store(&out[index + 1].x);
+			z.store(&out[index + 2].x);
+			w.store(&out[index + 3].x);
+		}
+		for (; index < from.len(); index += 1) {
+			out[index] = Quaternion<f32>::slerp(from[index], to[index], t[index]);
+		}
+	}
+
+	void intersects(AABB const& box, AABBSoA boxes, Slice<bool> out) {
+		const usize len = boxes.len();
+		MACH_ASSERT(len == out.len());
+
+		const auto cx = f32x4::splat(box.center.x);
+		const auto cy = f32x4::splat(box.center.y);
+		const auto cz = f32x4::splat(box.center.z);
+		const auto ex = f32x4::splat(box.extent.x);
+		const auto ey = f32x4::splat(box.extent.y);
+		const auto ez = f32x4::splat(box.extent.z);
+
+		usize index = 0;
+		for (; index + 4 <= len; index += 4) {
+			// Separated on an axis when the distance between centers is more than both half sizes combined
+			const auto dx = (f32x4::load_unaligned(&boxes.center.x[index]) - cx).abs();
+			const auto dy = (f32x4::load_unaligned(&boxes.center.y[index]) - cy).abs();
+			const auto dz = (f32x4::load_unaligned(&boxes.center.z[index]) - cz).abs();
+			const auto sx = f32x4::load_unaligned(&boxes.extent.x[index]) + ex;
+			const auto sy = f32x4::load_unaligned(&boxes.extent.y[index]) + ey;
+			const auto sz = f32x4::load_unaligned(&boxes.extent.z[index]) + ez;
+
+			const u32 separated = sx.less_mask(dx) | sy.less_mask(dy) | sz.less_mask(dz);
+			for (usize lane = 0; lane < 4; lane += 1) {
+				out[index + lane] = (separated & (1u << lane)) == 0;
+			}
+		}
+		for (; index < len; index += 1) {
+			const bool separated =
+				Math::abs(boxes.center.x[index] - box.center.x) > boxes.extent.x[index] + box.extent.x ||
+				Math::abs(boxes.center.y[index] - box.center.y) > boxes.extent.y[index] + box.extent.y ||
+				Math::abs(boxes.center.z[index] - box.center.z) > boxes.extent.z[index] + box.extent.z;
+			out[index] = !separated;
+		}
+	}
+
+	void intersects(Frustum const& frustum, AABBSoA boxes, Slice<bool> out) {
+		const usize len = boxes.len();
+		MACH_ASSERT(len == out.len());
+
+		const auto zero = f32x4::splat(0.f);
+
+		usize index = 0;
+		for (; index + 4 <= len; index += 4) {
+			const auto cx = f32x4::load_unaligned(&boxes.center.x[index]);
+			const auto cy = f32x4::load_unaligned(&boxes.center.y[index]);
+			const auto cz = f32x4::load_unaligned(&boxes.center.z[index]);
+			const auto ex = f32x4::load_unaligned(&boxes.extent.x[index]);
+			const auto ey = f32x4::load_unaligned(&boxes.extent.y[index]);
+			const auto ez = f32x4::load_unaligned(&boxes.extent.z[index]);
+
+			// A box is outside when its center is further behind a plane than the box reaches towards it
+			u32 outside = 0;
+			for (auto const& plane : frustum.planes) {
+				auto distance = f32x4::mul_add(f32x4::splat(plane.x), cx, f32x4::splat(plane.w));
+				distance = f32x4::mul_add(f32x4::splat(plane.y), cy, distance);
+				distance = f32x4::mul_add(f32x4::splat(plane.z), cz, distance);
+				auto reach = f32x4::splat(Math::abs(plane.x)) * ex;
+				reach = f32x4::mul_add(f32x4::splat(Math::abs(plane.y)), ey, reach);
+				reach = f32x4::mul_add(f32x4::splat(Math::abs(plane.z)), ez, reach);
+				outside |= (distance + reach).less_mask(zero);
+			}
+
+			for (usize lane = 0; lane < 4; lane += 1) {
+				out[index + lane] = (outside & (1u << lane)) == 0;
+			}
+		}
+		for (; index < len; index += 1) {
+			bool outside = false;
+			for (auto const& plane : frustum.planes) {
+				const f32 distance = plane.x * boxes.center.x[index] + plane.y * boxes.center.y[index] +
+									 plane.z * boxes.center.z[index] + plane.w;
+				const f32 reach = Math::abs(plane.x) * boxes.extent.x[index] +
+								  Math::abs(plane.y) * boxes.extent.y[index] +
+								  Math::abs(plane.z) * boxes.extent.z[index];
+				outside |= distance + reach < 0.f;
+			}
+			out[index] = !outside;
+		}
+	}
+} // namespace Mach::Core::Math
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Math") {
+	using namespace Mach;
+
+	MACH_TEST_CASE("Batch") {
+		const auto matrix = Matrix4<f32>::from_columns(
+			Vector4<f32>{ 1, 2, 0, 0 },
+			Vector4<f32>{ -2, 1, 0.5f, 0 },
+			Vector4<f32>{ 0, 0.5f, 3, 0 },
+			Vector4<f32>{ 1, -2, 3, 1 });
+		auto quaternion_equals = [](Quaternion<f32> const& a, Quaternion<f32> const& b) {
+			return Math::equals(a.x, b.x) && Math::equals(a.y, b.y) && Math::equals(a.z, b.z) && Math::equals(a.w, b.w);
+		};
+
+		MACH_SUBCASE("transform_points") {
+			// 7 covers one full group of four and a scalar tail
+			Vector3<f32> points[7];
+			for (usize i = 0; i < 7; i += 1) {
+				points[i] = Vector3<f32>{ static_cast<f32>(i), static_cast<f32>(i) * -0.5f, 2.f - static_cast<f32>(i) };
+			}
+
+			Vector3<f32> result[7];
+			transform_points(matrix, Slice<Vector3<f32> const>{ points, 7 }, Slice<Vector3<f32>>{ result, 7 });
+			for (usize i = 0; i < 7; i += 1) {
+				MACH_CHECK(result[i].equals(matrix.transform_point(points[i])));
+			}
+
+			// Transforming in place
+			transform_points(matrix, Slice<Vector3<f32> const>{ points, 7 }, Slice<Vector3<f32>>{ points, 7 });
+			for (usize i = 0; i < 7; i += 1) {
+				MACH_CHECK(points[i].equals(result[i]));
+			}
+		}
+
+		MACH_SUBCASE("transform_points SoA") {
+			f32 xs[6] = { 0, 1, 2, 3, 4, 5 };
+			f32 ys[6] = { 5, 4, 3, 2, 1, 0 };
+			f32 zs[6] = { -1, 1, -1, 1, -1, 1 };
+			f32 out_x[6];
+			f32 out_y[6];
+			f32 out_z[6];
+
+			const Vector3SoA<f32 const> in{ Slice<f32 const>{ xs, 6 },
+											Slice<f32 const>{ ys, 6 },
+											Slice<f32 const>{ zs, 6 } };
+			const Vector3SoA<f32> out{ Slice<f32>{ out_x, 6 }, Slice<f32>{ out_y, 6 }, Slice<f32>{ out_z, 6 } };
+			transform_points(matrix, in, out);
+			for (usize i = 0; i < 6; i += 1) {
+				const auto expected = matrix.transform_point({ xs[i], ys[i], zs[i] });
+				MACH_CHECK(Vector3<f32>{ out_x[i], out_y[i], out_z[i] }.equals(expected));
+			}
+		}
+
+		MACH_SUBCASE("slerp") {
+			Quaternion<f32> from[5];
+			Quaternion<f32> to[5];
+			f32 t[5] = { 0.f, 1.f, 0.5f, 0.25f, 0.5f };
+			for (usize i = 0; i < 5; i += 1) {
+				from[i] = Quaternion<f32>::from_axis_angle(Vector3<f32>{ 0, 1, 0 }, 0.f);
+				to[i] = Quaternion<f32>::from_axis_angle(Vector3<f32>{ 0, 1, 0 }, 90.f * Math::deg_to_rad<f32>);
+			}
+			// Same rotation with the opposite sign, which should still take the short way
+			to[3] = Quaternion<f32>{ -to[3].x, -to[3].y, -to[3].z, -to[3].w };
+
+			Quaternion<f32> result[5];
+			slerp(
+				Slice<Quaternion<f32> const>{ from, 5 },
+				Slice<Quaternion<f32> const>{ to, 5 },
+				Slice<f32 const>{ t, 5 },
+				Slice<Quaternion<f32>>{ result, 5 });
+
+			MACH_CHECK(quaternion_equals(result[0], from[0]));
+			MACH_CHECK(quaternion_equals(result[1], to[1]));
+			const auto halfway =
+				Quaternion<f32>::from_axis_angle(Vector3<f32>{ 0, 1, 0 }, 45.f * Math::deg_to_rad<f32>);
+			MACH_CHECK(quaternion_equals(result[2], halfway));
+			MACH_CHECK(quaternion_equals(result[4], halfway));
+			for (usize i = 0; i < 5; i += 1) {
+				MACH_CHECK(quaternion_equals(result[i], Quaternion<f32>::slerp(from[i], to[i], t[i])));
+			}
+		}
+
+		MACH_SUBCASE("intersects AABB") {
+			const AABB box{ .center = { 0, 0, 0 }, .extent = { 1, 1, 1 } };
+
+			// Overlapping, touching, separated on x, separated on y, separated on z, containing
+			f32 cx[6] = { 0.5f, 2.f, 3.f, 0.f, 0.f, 0.f };
+			f32 cy[6] = { 0.5f, 0.f, 0.f, -3.f, 0.f, 0.f };
+			f32 cz[6] = { 0.5f, 0.f, 0.f, 0.f, 2.5f, 0.f };
+			f32 ex[6] = { 1.f, 1.f, 1.f, 1.f, 1.f, 10.f };
+			f32 ey[6] = { 1.f, 1.f, 1.f, 1.f, 1.f, 10.f };
+			f32 ez[6] = { 1.f, 1.f, 1.f, 1.f, 1.f, 10.f };
+			const AABBSoA boxes{
+				.center = { Slice<f32 const>{ cx, 6 }, Slice<f32 const>{ cy, 6 }, Slice<f32 const>{ cz, 6 } },
+				.extent = { Slice<f32 const>{ ex, 6 }, Slice<f32 const>{ ey, 6 }, Slice<f32 const>{ ez, 6 } },
+			};
+
+			bool result[6];
+			intersects(box, boxes, Slice<bool>{ result, 6 });
+			MACH_CHECK(result[0]);
+			MACH_CHECK(result[1]);
+			MACH_CHECK(!result[2]);
+			MACH_CHECK(!result[3]);
+			MACH_CHECK(!result[4]);
+			MACH_CHECK(result[5]);
+		}
+
+		MACH_SUBCASE("intersects Frustum") {
+			// Looks down -z
+			const auto frustum = Frustum::from_matrix(Matrix4<f32>::perspective(90.f, 1.f, 0.1f, 100.f));
+
+			// In front, behind, far to the side, past the far plane, straddling the near plane
+			f32 cx[5] = { 0.f, 0.f, 50.f, 0.f, 0.f };
+			f32 cy[5] = { 0.f, 0.f, 0.f, 0.f, 0.f };
+			f32 cz[5] = { -10.f, 10.f, -10.f, -200.f, 0.f };
+			f32 e[5] = { 1.f, 1.f, 1.f, 1.f, 1.f };
+			const AABBSoA boxes{
+				.center = { Slice<f32 const>{ cx, 5 }, Slice<f32 const>{ cy, 5 }, Slice<f32 const>{ cz, 5 } },
+				.extent = { Slice<f32 const>{ e, 5 }, Slice<f32 const>{ e, 5 }, Slice<f32 const>{ e, 5 } },
+			};
+
+			bool result[5];
+			intersects(frustum, boxes, Slice<bool>{ result, 5 });
+			MACH_CHECK(result[0]);
+			MACH_CHECK(!result[1]);
+			MACH_CHECK(!result[2]);
+			MACH_CHECK(!result[3]);
+			MACH_CHECK(result[4]);
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("transform_points 4096") {
+	using namespace Mach;
+
+	const auto matrix = Matrix4<f32>::translate(Vector3<f32>{ 1, 2, 3 });
+	Array<Vector3<f32>> points;
+	for (usize i = 0; i < 4096; i += 1) {
+		points.push(Vector3<f32>{ static_cast<f32>(i), 1, 2 });
+	}
+
+	bencher.set_items(points.len());
+	bencher.iter([&] { transform_points(matrix, points.as_const_slice(), points.as_slice()); });
+}
+
+MACH_BENCHMARK("Matrix4::transform_point 4096") {
+	using namespace Mach;
+
+	const auto matrix = Matrix4<f32>::translate(Vector3<f32>{ 1, 2, 3 });
+	Array<Vector3<f32>> points;
+	for (usize i = 0; i < 4096; i += 1) {
+		points.push(Vector3<f32>{ static_cast<f32>(i), 1, 2 });
+	}
+
+	bencher.set_items(points.len());
+	bencher.iter([&] {
+		for (auto& point : points) {
+			point = matrix.transform_point(point);
+		}
+		Core::clobber_memory();
+	});
+}
+
+MACH_BENCHMARK("intersects Frustum 4096") {
+	using namespace Mach;
+
+	const auto frustum = Frustum::from_matrix(Matrix4<f32>::perspective(90.f, 16.f / 9.f, 0.1f, 1000.f));
+	Array<f32> x;
+	Array<f32> y;
+	Array<f32> z;
+	Array<f32> extent;
+	for (usize i = 0; i < 4096; i += 1) {
+		x.push(static_cast<f32>(i % 64) - 32.f);
+		y.push(static_cast<f32>(i / 64) - 32.f);
+		z.push(-static_cast<f32>(i % 100));
+		extent.push(1.f);
+	}
+	Array<bool> visible;
+	for (usize i = 0; i < 4096; i += 1) {
+		visible.push(false);
+	}
+
+	const AABBSoA boxes{ .center = { x.as_const_slice(), y.as_const_slice(), z.as_const_slice() },
+						 .extent = { extent.as_const_slice(), extent.as_const_slice(), extent.as_const_slice() } };
+	bencher.set_items(boxes.len());
+	bencher.iter([&] {
+		intersects(frustum, boxes, visible.as_slice());
+		Core::clobber_memory();
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Containers/Slice.hpp>
+#include <Core/Math/Matrix4.hpp>
+
+/**
+ * Kernels that run one operation over many values at once, four lanes per instruction through f32x4.
+ *
+ * None of these allocate or touch shared state, so large inputs can be split across workers by handing each
+ * Scheduler::parallel_for range a sub slice of the inputs and outputs.
+ */
+namespace Mach::Core::Math {
+	// Structure of arrays view over 3D vectors. Every component slice must have the same length.
+	template <typename T>
+	struct Vector3SoA {
+		Slice<T> x;
+		Slice<T> y;
+		Slice<T> z;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const {
+			MACH_ASSERT(x.len() == y.len() && y.len() == z.len());
+			return x.len();
+		}
+	};
+
+	// Axis aligned box stored as its center and half size
+	struct AABB {
+		Vector3<f32> center;
+		Vector3<f32> extent;
+	};
+
+	// Structure of arrays view over axis aligned boxes
+	struct AABBSoA {
+		Vector3SoA<f32 const> center;
+		Vector3SoA<f32 const> extent;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE usize len() const {
+			MACH_ASSERT(center.len() == extent.len());
+			return center.len();
+		}
+	};
+
+	// Six planes with normals pointing inwards, stored as (normal, distance) so a point p is inside a plane when
+	// dot(normal, p) + distance >= 0
+	struct Frustum {
+		Vector4<f32> planes[6];
+
+		// Extracts the planes from a projection or view projection matrix with a 0 to 1 depth range, which is what
+		// Matrix4::perspective and Matrix4::orthographic produce
+		MACH_NO_DISCARD static Frustum from_matrix(Matrix4<f32> const& view_projection);
+	};
+
+	// Applies matrix to each point as if it had a w of 1. in and out must be the same length and may be the same
+	// memory.
+	void transform_points(Matrix4<f32> const& matrix, Slice<Vector3<f32> const> in, Slice<Vector3<f32>> out);
+	void transform_points(Matrix4<f32> const& matrix, Vector3SoA<f32 const> in, Vector3SoA<f32> out);
+
+	// Interpolates from[i] towards to[i] by t[i] with Quaternion::slerp. Every slice must be the same length.
+	void slerp(
+		Slice<Quaternion<f32> const> from,
+		Slice<Quaternion<f32> const> to,
+		Slice<f32 const> t,
+		Slice<Quaternion<f32>> out);
+
+	// Sets out[i] to whether boxes[i] intersects box. Touching boxes count as intersecting.
+	void intersects(AABB const& box, AABBSoA boxes, Slice<bool> out);
+
+	// Sets out[i] to whether boxes[i] is at least partly inside frustum. Boxes near the corners of the frustum may be
+	// reported as visible while being outside, which is the usual trade off for culling.
+	void intersects(Frustum const& frustum, AABBSoA boxes, Slice<bool> out);
+} // namespace Mach::Core::Math
+
+namespace Mach {
+	using Core::Math::AABB;
+	using Core::Math::AABBSoA;
+	using Core::Math::Frustum;
+	using Core::Math::Vector3SoA;
+} // namespace Mach
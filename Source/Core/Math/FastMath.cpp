@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+#include <Core/Math/FastMath.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Math") {
+	using namespace Mach;
+	using Core::Math::f32x4;
+
+	struct SweepError {
+		f64 scalar = 0.0;
+		f64 lanes = 0.0;
+	};
+
+	// Largest error of approx against exact over count evenly spaced inputs in [start, end], checking both the scalar
+	// and the f32x4 version of approx
+	template <typename Approx, typename Exact>
+	SweepError sweep(f32 start, f32 end, u32 count, bool relative, Approx&& approx, Exact&& exact) {
+		auto error = [&](f32 input, f32 result) {
+			const f64 expected = exact(static_cast<f64>(input));
+			const f64 difference = Math::abs(static_cast<f64>(result) - expected);
+			return relative ? difference / Math::abs(expected) : difference;
+		};
+
+		SweepError result;
+		const f32 step = (end - start) / static_cast<f32>(count - 1);
+		for (u32 i = 0; i + 4 <= count; i += 4) {
+			alignas(16) f32 inputs[4];
+			for (u32 lane = 0; lane < 4; lane += 1) {
+				inputs[lane] = start + step * static_cast<f32>(i + lane);
+			}
+
+			alignas(16) f32 lanes[4];
+			approx(f32x4::load(inputs)).store(lanes);
+			for (u32 lane = 0; lane < 4; lane += 1) {
+				result.scalar = Math::max(result.scalar, error(inputs[lane], approx(inputs[lane])));
+				result.lanes = Math::max(result.lanes, error(inputs[lane], lanes[lane]));
+			}
+		}
+		return result;
+	}
+
+	MACH_TEST_CASE("fast_sin") {
+		auto approx = [](auto x) { return Math::fast_sin(x); };
+		auto exact = [](f64 x) { return Math::sin(x); };
+
+		const auto near = sweep(-2.f * Math::pi<f32>, 2.f * Math::pi<f32>, 100000, false, approx, exact);
+		MACH_CHECK_LT(near.scalar, 5e-7);
+		MACH_CHECK_LT(near.lanes, 5e-7);
+
+		const auto far = sweep(-8192.f, 8192.f, 100000, false, approx, exact);
+		MACH_CHECK_LT(far.scalar, 5e-7);
+		MACH_CHECK_LT(far.lanes, 5e-7);
+
+		MACH_CHECK(Math::fast_sin(0.f) == 0.f);
+	}
+
+	MACH_TEST_CASE("fast_cos") {
+		auto approx = [](auto x) { return Math::fast_cos(x); };
+		auto exact = [](f64 x) { return Math::cos(x); };
+
+		const auto near = sweep(-2.f * Math::pi<f32>, 2.f * Math::pi<f32>, 100000, false, approx, exact);
+		MACH_CHECK_LT(near.scalar, 5e-7);
+		MACH_CHECK_LT(near.lanes, 5e-7);
+
+		const auto far = sweep(-8192.f, 8192.f, 100000, false, approx, exact);
+		MACH_CHECK_LT(far.scalar, 5e-7);
+		MACH_CHECK_LT(far.lanes, 5e-7);
+	}
+
+	MACH_TEST_CASE("sincos") {
+		for (f32 x = -10.f; x < 10.f; x += 0.01f) {
+			f32 s;
+			f32 c;
+			Math::sincos(x, s, c);
+			MACH_CHECK(s == Math::fast_sin(x));
+			MACH_CHECK(c == Math::fast_cos(x));
+		}
+	}
+
+	MACH_TEST_CASE("fast_rsqrt") {
+		auto approx = [](auto x) { return Math::fast_rsqrt(x); };
+		auto exact = [](f64 x) { return 1.0 / Math::sqrt(x); };
+
+		const auto small = sweep(1e-6f, 1.f, 100000, true, approx, exact);
+		MACH_CHECK_LT(small.scalar, 5e-6);
+		MACH_CHECK_LT(small.lanes, 5e-6);
+
+		const auto large = sweep(1.f, 1e6f, 100000, true, approx, exact);
+		MACH_CHECK_LT(large.scalar, 5e-6);
+		MACH_CHECK_LT(large.lanes, 5e-6);
+	}
+
+	MACH_TEST_CASE("fast_atan2") {
+		// Walk around circles of a few sizes so every octant and the axes are covered
+		f64 scalar_error = 0.0;
+		f64 lanes_error = 0.0;
+		for (const f32 radius : { 1e-3f, 1.f, 1e4f }) {
+			for (u32 i = 0; i < 4096; i += 1) {
+				alignas(16) f32 ys[4];
+				alignas(16) f32 xs[4];
+				for (u32 lane = 0; lane < 4; lane += 1) {
+					const f32 angle = static_cast<f32>(i * 4 + lane) * (Math::tau<f32> / 16384.f);
+					ys[lane] = radius * Math::sin(angle);
+					xs[lane] = radius * Math::cos(angle);
+				}
+
+				alignas(16) f32 lanes[4];
+				Math::fast_atan2(f32x4::load(ys), f32x4::load(xs)).store(lanes);
+				for (u32 lane = 0; lane < 4; lane += 1) {
+					const f64 expected = Math::atan2(static_cast<f64>(ys[lane]), static_cast<f64>(xs[lane]));
+					const f64 scalar = Math::fast_atan2(ys[lane], xs[lane]);
+					scalar_error = Math::max(scalar_error, Math::abs(scalar - expected));
+					lanes_error = Math::max(lanes_error, Math::abs(static_cast<f64>(lanes[lane]) - expected));
+				}
+			}
+		}
+		MACH_CHECK_LT(scalar_error, 2e-5);
+		MACH_CHECK_LT(lanes_error, 2e-5);
+
+		MACH_CHECK(Math::fast_atan2(0.f, 0.f) == 0.f);
+		MACH_CHECK(Math::equals(Math::fast_atan2(1.f, 0.f), Math::pi<f32> / 2.f));
+		MACH_CHECK(Math::equals(Math::fast_atan2(0.f, -1.f), Math::pi<f32>));
+	}
+
+	MACH_TEST_CASE("fast_exp") {
+		auto approx = [](auto x) { return Math::fast_exp(x); };
+		auto exact = [](f64 x) { return Core::Math::pow(2.718281828459045, x); };
+
+		const auto error = sweep(-87.f, 88.f, 100000, true, approx, exact);
+		MACH_CHECK_LT(error.scalar, 5e-7);
+		MACH_CHECK_LT(error.lanes, 5e-7);
+
+		MACH_CHECK(Math::fast_exp(0.f) == 1.f);
+		MACH_CHECK(Math::fast_exp(-1000.f) > 0.f);
+		MACH_CHECK(Math::fast_exp(1000.f) < Math::infinity<f32>);
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	struct SinInputs {
+		Mach::f32 values[1024];
+
+		SinInputs() {
+			for (Mach::usize i = 0; i < 1024; i += 1) {
+				values[i] = static_cast<Mach::f32>(i) * 0.01f - 5.f;
+			}
+		}
+	};
+} // namespace
+
+MACH_BENCHMARK("Math::sin 1024") {
+	using namespace Mach;
+
+	SinInputs inputs;
+	bencher.set_items(1024);
+	bencher.iter([&] {
+		f32 sum = 0.f;
+		for (const f32 x : inputs.values) {
+			sum += Math::sin(x);
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("fast_sin 1024") {
+	using namespace Mach;
+
+	SinInputs inputs;
+	bencher.set_items(1024);
+	bencher.iter([&] {
+		f32 sum = 0.f;
+		for (const f32 x : inputs.values) {
+			sum += Math::fast_sin(x);
+		}
+		return sum;
+	});
+}
+
+MACH_BENCHMARK("fast_sin f32x4 1024") {
+	using namespace Mach;
+	using Core::Math::f32x4;
+
+	alignas(16) SinInputs inputs;
+	bencher.set_items(1024);
+	bencher.iter([&] {
+		auto sum = f32x4::splat(0.f);
+		for (usize i = 0; i < 1024; i += 4) {
+			sum = sum + Math::fast_sin(f32x4::load(&inputs.values[i]));
+		}
+		return sum.sum().x();
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
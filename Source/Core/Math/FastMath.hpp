@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Math/Math.hpp>
+#include <Core/Math/SIMD.hpp>
+
+/**
+ * Polynomial approximations of transcendental functions for hot loops that can afford a few ulps of error.
+ *
+ * Every function takes either a single f32 or an f32x4 and uses the same approximation for both, with results within
+ * the documented bound. They are not bit identical: rsqrt_estimate uses the hardware estimate on lanes but a bit trick
+ * on scalars, and mul_add is only fused on NEON. They are picked per call site over Math::sin and friends, which stay
+ * exact.
+ * Error bounds are measured against libm by the tests in FastMath.cpp. NaN and infinite inputs are not handled.
+ */
+namespace Mach::Core::Math {
+	template <typename T>
+	concept FastMathLane = is_same<T, f32> || is_same<T, f32x4>;
+
+	// The handful of operations the approximations need, spelled the same way for scalars and lanes
+	template <FastMathLane T>
+	struct FastMathOps;
+
+	template <>
+	struct FastMathOps<f32> {
+		using Mask = bool;
+
+		MACH_ALWAYS_INLINE static f32 splat(f32 value) { return value; }
+		MACH_ALWAYS_INLINE static f32 mul_add(f32 a, f32 b, f32 c) { return a * b + c; }
+		MACH_ALWAYS_INLINE static f32 min(f32 a, f32 b) { return a < b ? a : b; }
+		MACH_ALWAYS_INLINE static f32 max(f32 a, f32 b) { return a > b ? a : b; }
+		MACH_ALWAYS_INLINE static f32 abs(f32 x) { return Math::abs(x); }
+		MACH_ALWAYS_INLINE static bool less(f32 a, f32 b) { return a < b; }
+		MACH_ALWAYS_INLINE static f32 select(bool mask, f32 a, f32 b) { return mask ? a : b; }
+
+		// Adding 1.5 * 2^23 pushes the fraction out of the mantissa. Valid for |x| below 2^22.
+		MACH_ALWAYS_INLINE static f32 round(f32 x) { return (x + 12582912.f) - 12582912.f; }
+
+		MACH_ALWAYS_INLINE static f32 pow2(f32 n) {
+			return std::bit_cast<f32>(static_cast<u32>(static_cast<i32>(n) + 127) << 23);
+		}
+
+		MACH_ALWAYS_INLINE static f32 rsqrt_estimate(f32 x) {
+			return std::bit_cast<f32>(0x5f375a86u - (std::bit_cast<u32>(x) >> 1));
+		}
+	};
+
+	template <>
+	struct FastMathOps<f32x4> {
+		using Mask = f32x4;
+
+		MACH_ALWAYS_INLINE static f32x4 splat(f32 value) { return f32x4::splat(value); }
+		MACH_ALWAYS_INLINE static f32x4 mul_add(f32x4 a, f32x4 b, f32x4 c) { return f32x4::mul_add(a, b, c); }
+		MACH_ALWAYS_INLINE static f32x4 min(f32x4 a, f32x4 b) { return f32x4::min(a, b); }
+		MACH_ALWAYS_INLINE static f32x4 max(f32x4 a, f32x4 b) { return f32x4::max(a, b); }
+		MACH_ALWAYS_INLINE static f32x4 abs(f32x4 x) { return x.abs(); }
+		MACH_ALWAYS_INLINE static f32x4 less(f32x4 a, f32x4 b) { return a.less(b); }
+		MACH_ALWAYS_INLINE static f32x4 select(f32x4 mask, f32x4 a, f32x4 b) { return f32x4::select(mask, a, b); }
+		MACH_ALWAYS_INLINE static f32x4 round(f32x4 x) { return x.round(); }
+		MACH_ALWAYS_INLINE static f32x4 pow2(f32x4 n) { return n.pow2(); }
+		MACH_ALWAYS_INLINE static f32x4 rsqrt_estimate(f32x4 x) { return x.rsqrt_estimate(); }
+	};
+
+	/**
+	 * Wraps an angle into [-pi, pi]. Tau is split into a high part with few enough mantissa bits that multiplying by
+	 * the turn count is exact, which keeps the result accurate for |x| up to 8192.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T wrap_angle(T x) {
+		using Ops = FastMathOps<T>;
+		const T turns = Ops::round(x * Ops::splat(1.f / tau<f32>));
+		const T high = Ops::mul_add(turns, Ops::splat(-6.28125f), x);
+		return Ops::mul_add(turns, Ops::splat(-1.9353071795864769e-3f), high);
+	}
+
+	// Sine of an angle in [-pi / 2, pi / 2] from its Taylor series up to x^11
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T sin_half_pi(T x) {
+		using Ops = FastMathOps<T>;
+		const T x2 = x * x;
+		T p = Ops::splat(-2.5052108385e-8f);
+		p = Ops::mul_add(p, x2, Ops::splat(2.7557319224e-6f));
+		p = Ops::mul_add(p, x2, Ops::splat(-1.9841269841e-4f));
+		p = Ops::mul_add(p, x2, Ops::splat(8.3333333333e-3f));
+		p = Ops::mul_add(p, x2, Ops::splat(-1.6666666667e-1f));
+		return Ops::mul_add(p * x2, x, x);
+	}
+
+	/**
+	 * @brief Approximates sin(x).
+	 * @return sin(x) within 5e-7 absolute error for |x| <= 8192.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T fast_sin(T x) {
+		using Ops = FastMathOps<T>;
+		// Reflect [pi / 2, pi] and [-pi, -pi / 2] onto the range the polynomial covers
+		const T angle = wrap_angle(x);
+		const T pi_ = Ops::splat(pi<f32>);
+		const T reflected = Ops::max(Ops::min(angle, pi_ - angle), Ops::splat(-pi<f32>) - angle);
+		return sin_half_pi(reflected);
+	}
+
+	/**
+	 * @brief Approximates cos(x).
+	 * @return cos(x) within 5e-7 absolute error for |x| <= 8192.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T fast_cos(T x) {
+		using Ops = FastMathOps<T>;
+		// cos(x) = sin(pi / 2 - |x|), which lands in [-pi / 2, pi / 2] for x in [-pi, pi]
+		return sin_half_pi(Ops::splat(pi<f32> / 2.f) - Ops::abs(wrap_angle(x)));
+	}
+
+	/**
+	 * @brief Approximates sin(x) and cos(x) together, sharing the range reduction.
+	 *
+	 * Same error bounds as fast_sin and fast_cos.
+	 */
+	template <FastMathLane T>
+	MACH_ALWAYS_INLINE void sincos(T x, T& out_sin, T& out_cos) {
+		using Ops = FastMathOps<T>;
+		const T angle = wrap_angle(x);
+		const T pi_ = Ops::splat(pi<f32>);
+		out_sin = sin_half_pi(Ops::max(Ops::min(angle, pi_ - angle), Ops::splat(-pi<f32>) - angle));
+		out_cos = sin_half_pi(Ops::splat(pi<f32> / 2.f) - Ops::abs(angle));
+	}
+
+	/**
+	 * @brief Approximates 1 / sqrt(x) from a hardware or bit trick estimate refined with two Newton-Raphson steps.
+	 * @return 1 / sqrt(x) within 5e-6 relative error for positive normal x.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T fast_rsqrt(T x) {
+		using Ops = FastMathOps<T>;
+		const T half = x * Ops::splat(0.5f);
+		const T three_halves = Ops::splat(1.5f);
+		T y = Ops::rsqrt_estimate(x);
+		y = y * Ops::mul_add(half * y, Ops::splat(0.f) - y, three_halves);
+		y = y * Ops::mul_add(half * y, Ops::splat(0.f) - y, three_halves);
+		return y;
+	}
+
+	/**
+	 * @brief Approximates atan2(y, x) with the Abramowitz and Stegun 4.4.49 polynomial.
+	 * @return atan2(y, x) within 2e-5 radians. atan2(0, 0) is 0.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T fast_atan2(T y, T x) {
+		using Ops = FastMathOps<T>;
+		const T zero = Ops::splat(0.f);
+		const T abs_x = Ops::abs(x);
+		const T abs_y = Ops::abs(y);
+
+		// atan of the smaller over the larger keeps the polynomial input in [0, 1]
+		const T ratio = Ops::min(abs_x, abs_y) / Ops::max(Ops::max(abs_x, abs_y), Ops::splat(small_number<f32>));
+		const T ratio2 = ratio * ratio;
+		T p = Ops::splat(0.0208351f);
+		p = Ops::mul_add(p, ratio2, Ops::splat(-0.0851330f));
+		p = Ops::mul_add(p, ratio2, Ops::splat(0.1801410f));
+		p = Ops::mul_add(p, ratio2, Ops::splat(-0.3302995f));
+		p = Ops::mul_add(p, ratio2, Ops::splat(0.9998660f));
+		T angle = p * ratio;
+
+		// Unfold back into the right octant and quadrant
+		angle = Ops::select(Ops::less(abs_x, abs_y), Ops::splat(pi<f32> / 2.f) - angle, angle);
+		angle = Ops::select(Ops::less(x, zero), Ops::splat(pi<f32>) - angle, angle);
+		return Ops::select(Ops::less(y, zero), zero - angle, angle);
+	}
+
+	/**
+	 * @brief Approximates e^x by splitting off a power of two and evaluating the remainder with a polynomial.
+	 * @return e^x within 5e-7 relative error. x is clamped to [-87.3, 88.3] so the result stays a normal f32.
+	 */
+	template <FastMathLane T>
+	MACH_NO_DISCARD MACH_ALWAYS_INLINE T fast_exp(T x) {
+		using Ops = FastMathOps<T>;
+		x = Ops::min(Ops::max(x, Ops::splat(-87.3f)), Ops::splat(88.3f));
+
+		// e^x = 2^n * e^r with r in [-ln(2) / 2, ln(2) / 2]. ln(2) is split like tau in wrap_angle.
+		const T n = Ops::round(x * Ops::splat(1.44269504089f));
+		T r = Ops::mul_add(n, Ops::splat(-0.693359375f), x);
+		r = Ops::mul_add(n, Ops::splat(2.12194440e-4f), r);
+
+		T p = Ops::splat(1.9875691500e-4f);
+		p = Ops::mul_add(p, r, Ops::splat(1.3981999507e-3f));
+		p = Ops::mul_add(p, r, Ops::splat(8.3334519073e-3f));
+		p = Ops::mul_add(p, r, Ops::splat(4.1665795894e-2f));
+		p = Ops::mul_add(p, r, Ops::splat(1.6666665459e-1f));
+		p = Ops::mul_add(p, r, Ops::splat(5.0000001201e-1f));
+		const T e_r = Ops::mul_add(p * r, r, r) + Ops::splat(1.f);
+		return e_r * Ops::pow2(n);
+	}
+} // namespace Mach::Core::Math
+
+namespace Mach::Math {
+	using Core::Math::fast_atan2;
+	using Core::Math::fast_cos;
+	using Core::Math::fast_exp;
+	using Core::Math::fast_rsqrt;
+	using Core::Math::fast_sin;
+	using Core::Math::sincos;
+} // namespace Mach::Math
@@ -8,14 +8,14 @@
 #include <cmath>
 
 namespace Mach::Core::Math {
-	f32 cos(f32 x) { return std::cos(x); }
-	f64 cos(f64 x) { return std::cos(x); }
+	f32 Libm::cos(f32 x) { return std::cos(x); }
+	f64 Libm::cos(f64 x) { return std::cos(x); }
 
-	f32 sin(f32 x) { return std::sin(x); }
-	f64 sin(f64 x) { return std::sin(x); }
+	f32 Libm::sin(f32 x) { return std::sin(x); }
+	f64 Libm::sin(f64 x) { return std::sin(x); }
 
-	f32 tan(f32 x) { return std::tan(x); }
-	f64 tan(f64 x) { return std::tan(x); }
+	f32 Libm::tan(f32 x) { return std::tan(x); }
+	f64 Libm::tan(f64 x) { return std::tan(x); }
 
 	f32 acos(f32 x) { return std::acos(x); }
 	f64 acos(f64 x) { return std::acos(x); }
@@ -29,11 +29,11 @@ namespace Mach::Core::Math {
 	f32 atan2(f32 y, f32 x) { return std::atan2(y, x); }
 	f64 atan2(f64 y, f64 x) { return std::atan2(y, x); }
 
-	f32 sqrt(f32 x) { return std::sqrt(x); }
-	f64 sqrt(f64 x) { return std::sqrt(x); }
+	f32 Libm::sqrt(f32 x) { return std::sqrt(x); }
+	f64 Libm::sqrt(f64 x) { return std::sqrt(x); }
 
-	f32 fmod(f32 numerator, f32 denominator) { return std::fmod(numerator, denominator); }
-	f64 fmod(f64 numerator, f64 denominator) { return std::fmod(numerator, denominator); }
+	f32 Libm::fmod(f32 numerator, f32 denominator) { return std::fmod(numerator, denominator); }
+	f64 Libm::fmod(f64 numerator, f64 denominator) { return std::fmod(numerator, denominator); }
 
 	f32 powf(f32 x, f32 y) { return std::powf(x, y); }
 	f64 pow(f64 x, f64 y) { return std::pow(x, y); }
@@ -80,4 +80,31 @@ MACH_TEST_SUITE("Math") {
 		MACH_CHECK(Math::equals(1.f, 1.f));
 		MACH_CHECK(Math::equals(2.f, 2.f));
 	}
+
+	MACH_TEST_CASE("constexpr") {
+		static_assert(Math::sqrt(4.0) == 2.0);
+		static_assert(Math::sqrt(2.f) * Math::sqrt(2.f) - 2.f < 1e-6f);
+		static_assert(Math::sqrt(0.0) == 0.0);
+		static_assert(Math::equals(Math::sin(Math::pi<f64> / 2.0), 1.0));
+		static_assert(Math::equals(Math::cos(Math::pi<f64>), -1.0));
+		static_assert(Math::equals(Math::tan(Math::pi<f32> / 4.f), 1.f));
+		static_assert(Math::equals(Math::fmod(370.f, 360.f), 10.f));
+
+		// sin^2 + cos^2 = 1 across several turns
+		static_assert([] {
+			for (f64 x = -20.0; x < 20.0; x += 0.1) {
+				if (!Math::equals(Math::square(Math::sin(x)) + Math::square(Math::cos(x)), 1.0, 1e-12)) {
+					return false;
+				}
+			}
+			return true;
+		}());
+
+		// The constant evaluation path should agree with libm
+		for (f64 x = -100.0; x < 100.0; x += 0.01) {
+			MACH_CHECK(Math::equals(Core::Math::Constexpr::sin(x), Core::Math::Libm::sin(x), 1e-12));
+			MACH_CHECK(Math::equals(Core::Math::Constexpr::cos(x), Core::Math::Libm::cos(x), 1e-12));
+			MACH_CHECK(Math::equals(Core::Math::Constexpr::sqrt(x + 100.0), Core::Math::Libm::sqrt(x + 100.0), 1e-12));
+		}
+	}
 }
@@ -11,6 +11,7 @@
 #include <Core/Primitives.hpp>
 
 #include <limits>
+#include <type_traits>
 
 namespace Mach::Core::Math {
 	template <typename T>
@@ -76,14 +77,106 @@ namespace Mach::Core::Math {
 	template <FloatingPoint T>
 	inline constexpr T nan = std::numeric_limits<T>::signaling_NaN();
 
-	MACH_NO_DISCARD f32 cos(f32 x);
-	MACH_NO_DISCARD f64 cos(f64 x);
-
-	MACH_NO_DISCARD f32 sin(f32 x);
-	MACH_NO_DISCARD f64 sin(f64 x);
-
-	MACH_NO_DISCARD f32 tan(f32 x);
-	MACH_NO_DISCARD f64 tan(f64 x);
+	// Thin wrappers over libm, used by the functions below outside of constant evaluation
+	namespace Libm {
+		MACH_NO_DISCARD f32 cos(f32 x);
+		MACH_NO_DISCARD f64 cos(f64 x);
+
+		MACH_NO_DISCARD f32 sin(f32 x);
+		MACH_NO_DISCARD f64 sin(f64 x);
+
+		MACH_NO_DISCARD f32 tan(f32 x);
+		MACH_NO_DISCARD f64 tan(f64 x);
+
+		MACH_NO_DISCARD f32 sqrt(f32 x);
+		MACH_NO_DISCARD f64 sqrt(f64 x);
+
+		MACH_NO_DISCARD f32 fmod(f32 numerator, f32 denominator);
+		MACH_NO_DISCARD f64 fmod(f64 numerator, f64 denominator);
+	} // namespace Libm
+
+	/**
+	 * Plain arithmetic versions of the libm functions that work in constant expressions, evaluated in f64 and rounded
+	 * to T. The functions below switch to these automatically during constant evaluation. They are much slower than
+	 * libm, so there is no reason to call them directly at runtime.
+	 */
+	namespace Constexpr {
+		template <FloatingPoint T>
+		MACH_NO_DISCARD constexpr T sqrt(T x) {
+			if (x != x || x < T{ 0 }) {
+				return std::numeric_limits<T>::quiet_NaN();
+			}
+			if (x == T{ 0 } || x == std::numeric_limits<T>::infinity()) {
+				return x;
+			}
+
+			// Newton's method from above only ever decreases, so stop once it no longer does
+			const f64 value = static_cast<f64>(x);
+			f64 guess = value > 1.0 ? value : 1.0;
+			while (true) {
+				const f64 next = (guess + value / guess) * 0.5;
+				if (next >= guess) {
+					return static_cast<T>(guess);
+				}
+				guess = next;
+			}
+		}
+
+		template <FloatingPoint T>
+		MACH_NO_DISCARD constexpr T fmod(T numerator, T denominator) {
+			// Only exact while numerator / denominator fits in an i64, which constant inputs are expected to
+			const f64 quotient = static_cast<f64>(numerator) / static_cast<f64>(denominator);
+			const f64 whole = static_cast<f64>(static_cast<i64>(quotient));
+			return static_cast<T>(static_cast<f64>(numerator) - whole * static_cast<f64>(denominator));
+		}
+
+		// Brings x into [-pi, pi] so the series below converge quickly
+		MACH_NO_DISCARD constexpr f64 wrap_angle(f64 x) {
+			constexpr f64 precise_pi = 3.141592653589793;
+			const f64 turns = x / (2.0 * precise_pi);
+			const f64 whole = static_cast<f64>(static_cast<i64>(turns < 0.0 ? turns - 0.5 : turns + 0.5));
+			return x - whole * (2.0 * precise_pi);
+		}
+
+		template <FloatingPoint T>
+		MACH_NO_DISCARD constexpr T sin(T x) {
+			// Taylor series, adding terms until they stop changing the sum
+			const f64 angle = wrap_angle(static_cast<f64>(x));
+			f64 term = angle;
+			f64 sum = angle;
+			for (i32 n = 1; sum + term != sum; n += 1) {
+				term *= -angle * angle / static_cast<f64>((2 * n) * (2 * n + 1));
+				sum += term;
+			}
+			return static_cast<T>(sum);
+		}
+
+		template <FloatingPoint T>
+		MACH_NO_DISCARD constexpr T cos(T x) {
+			const f64 angle = wrap_angle(static_cast<f64>(x));
+			f64 term = 1.0;
+			f64 sum = 1.0;
+			for (i32 n = 1; sum + term != sum; n += 1) {
+				term *= -angle * angle / static_cast<f64>((2 * n - 1) * (2 * n));
+				sum += term;
+			}
+			return static_cast<T>(sum);
+		}
+
+		template <FloatingPoint T>
+		MACH_NO_DISCARD constexpr T tan(T x) {
+			return static_cast<T>(Constexpr::sin(static_cast<f64>(x)) / Constexpr::cos(static_cast<f64>(x)));
+		}
+	} // namespace Constexpr
+
+	MACH_NO_DISCARD constexpr f32 cos(f32 x) { return std::is_constant_evaluated() ? Constexpr::cos(x) : Libm::cos(x); }
+	MACH_NO_DISCARD constexpr f64 cos(f64 x) { return std::is_constant_evaluated() ? Constexpr::cos(x) : Libm::cos(x); }
+
+	MACH_NO_DISCARD constexpr f32 sin(f32 x) { return std::is_constant_evaluated() ? Constexpr::sin(x) : Libm::sin(x); }
+	MACH_NO_DISCARD constexpr f64 sin(f64 x) { return std::is_constant_evaluated() ? Constexpr::sin(x) : Libm::sin(x); }
+
+	MACH_NO_DISCARD constexpr f32 tan(f32 x) { return std::is_constant_evaluated() ? Constexpr::tan(x) : Libm::tan(x); }
+	MACH_NO_DISCARD constexpr f64 tan(f64 x) { return std::is_constant_evaluated() ? Constexpr::tan(x) : Libm::tan(x); }
 
 	MACH_NO_DISCARD f32 acos(f32 x);
 	MACH_NO_DISCARD f64 acos(f64 x);
@@ -97,11 +190,21 @@ namespace Mach::Core::Math {
 	MACH_NO_DISCARD f32 atan2(f32 y, f32 x);
 	MACH_NO_DISCARD f64 atan2(f64 y, f64 x);
 
-	MACH_NO_DISCARD f32 sqrt(f32 x);
-	MACH_NO_DISCARD f64 sqrt(f64 x);
+	MACH_NO_DISCARD constexpr f32 sqrt(f32 x) {
+		return std::is_constant_evaluated() ? Constexpr::sqrt(x) : Libm::sqrt(x);
+	}
+	MACH_NO_DISCARD constexpr f64 sqrt(f64 x) {
+		return std::is_constant_evaluated() ? Constexpr::sqrt(x) : Libm::sqrt(x);
+	}
 
-	MACH_NO_DISCARD f32 fmod(f32 numerator, f32 denominator);
-	MACH_NO_DISCARD f64 fmod(f64 numerator, f64 denominator);
+	MACH_NO_DISCARD constexpr f32 fmod(f32 numerator, f32 denominator) {
+		return std::is_constant_evaluated() ? Constexpr::fmod(numerator, denominator)
+											: Libm::fmod(numerator, denominator);
+	}
+	MACH_NO_DISCARD constexpr f64 fmod(f64 numerator, f64 denominator) {
+		return std::is_constant_evaluated() ? Constexpr::fmod(numerator, denominator)
+											: Libm::fmod(numerator, denominator);
+	}
 
 	MACH_NO_DISCARD f32 powf(f32 x, f32 y);
 	MACH_NO_DISCARD f64 pow(f64 x, f64 y);
@@ -4,6 +4,7 @@
  * This software is released under the MIT License.
  */
 
+#include <Core/Debug/Benchmark.hpp>
 #include <Core/Debug/Test.hpp>
 #include <Core/Math/Matrix4.hpp>
 
@@ -110,6 +111,118 @@ MACH_TEST_SUITE("Math") {
 
 			MACH_CHECK(o.equals(v));
 		}
+
+		// f64 matrices always take the scalar path, so they check the SIMD path taken by f32
+		const auto a = Matrix4<f64>::from_columns(
+			Vector4<f64>{ 2, 1, 0, 0 },
+			Vector4<f64>{ 0, 3, 1, 0 },
+			Vector4<f64>{ 1, 0, 4, 0 },
+			Vector4<f64>{ 5, -2, 7, 1 });
+		const auto b = Matrix4<f64>::from_columns(
+			Vector4<f64>{ 1, 2, 3, 4 },
+			Vector4<f64>{ -1, 0.5, 2, 0 },
+			Vector4<f64>{ 0, 1, -3, 2 },
+			Vector4<f64>{ 6, 5, 4, 3 });
+		auto as_f32 = [](Matrix4<f64> const& m) {
+			return Matrix4<f32>::from_columns(m.x.as<f32>(), m.y.as<f32>(), m.z.as<f32>(), m.w.as<f32>());
+		};
+		auto equals = [](Matrix4<f32> const& lhs, Matrix4<f64> const& rhs) {
+			return lhs.x.equals(rhs.x.as<f32>()) && lhs.y.equals(rhs.y.as<f32>()) && lhs.z.equals(rhs.z.as<f32>()) &&
+				   lhs.w.equals(rhs.w.as<f32>());
+		};
+
+		MACH_SUBCASE("operator* matches scalar") {
+			MACH_CHECK(equals(as_f32(a) * as_f32(b), a * b));
+
+			const Vector4<f64> v{ 1, -2, 3, 1 };
+			MACH_CHECK((as_f32(a) * v.as<f32>()).equals((a * v).as<f32>()));
+		}
+
+		MACH_SUBCASE("transpose") {
+			MACH_CHECK(equals(as_f32(b).transpose(), b.transpose()));
+			MACH_CHECK(as_f32(b).transpose().row(1).equals(b.y.as<f32>()));
+		}
+
+		MACH_SUBCASE("transform_point") {
+			const auto p = Matrix4<f32>::translate({ 1, 2, 3 }).transform_point({ 4, 5, 6 });
+			MACH_CHECK(p.x == 5.f);
+			MACH_CHECK(p.y == 7.f);
+			MACH_CHECK(p.z == 9.f);
+		}
+
+		MACH_SUBCASE("inverse matches scalar") {
+			const auto inv = as_f32(a).inverse();
+			MACH_CHECK(inv.is_set());
+			MACH_CHECK(equals(inv.unwrap(), a.inverse().unwrap()));
+
+			const auto round_trip = as_f32(a) * as_f32(a).inverse().unwrap();
+			MACH_CHECK(equals(round_trip, Matrix4<f64>::identity()));
+
+			const auto singular = Matrix4<f32>::from_columns(
+				Vector4<f32>{ 1, 2, 3, 4 },
+				Vector4<f32>{ 2, 4, 6, 8 },
+				Vector4<f32>{ 0, 1, 0, 1 },
+				Vector4<f32>{ 1, 0, 1, 0 });
+			MACH_CHECK(!singular.inverse().is_set());
+		}
+
+		MACH_SUBCASE("constexpr") {
+			constexpr auto projection = Matrix4<f32>::perspective(90.f, 2.f, 1.f, 101.f);
+			static_assert(Math::equals(projection.y.y, 1.f));
+			static_assert(Math::equals(projection.x.x, 0.5f));
+			static_assert(projection.z.w == -1.f);
+
+			constexpr auto translation = Matrix4<f32>::translate({ 1, 2, 3 });
+			static_assert(translation.transform_point({ 4, 5, 6 }).equals({ 5, 7, 9 }));
+			static_assert((translation * Matrix4<f32>::identity()).w.equals({ 1, 2, 3, 1 }));
+
+			constexpr auto rotation = Quaternion<f32>::from_axis_angle({ 0, 0, 1 }, Math::pi<f32> / 2.f);
+			constexpr auto transform = Matrix4<f32>::transform({ 1, 2, 3 }, rotation, { 2, 2, 2 });
+			static_assert(transform.transform_point({ 1, 0, 0 }).equals({ 1, 4, 3 }));
+
+			// Baked at compile time and evaluated at runtime should agree
+			const auto runtime = Matrix4<f32>::transform({ 1, 2, 3 }, rotation, { 2, 2, 2 });
+			MACH_CHECK(transform.x.equals(runtime.x));
+			MACH_CHECK(transform.y.equals(runtime.y));
+			MACH_CHECK(transform.z.equals(runtime.z));
+			MACH_CHECK(transform.w.equals(runtime.w));
+		}
 	}
 }
 #endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+MACH_BENCHMARK("Matrix4::operator*") {
+	using namespace Mach;
+
+	auto a = Matrix4<f32>::perspective(1.2f, 16.f / 9.f, 0.1f, 1000.f);
+	auto b = Matrix4<f32>::translate(Vector3<f32>{ 1, 2, 3 });
+	bencher.iter([&] {
+		Core::do_not_optimize(a);
+		Core::do_not_optimize(b);
+		return a * b;
+	});
+}
+
+MACH_BENCHMARK("Matrix4::operator* Vector4") {
+	using namespace Mach;
+
+	auto m = Matrix4<f32>::translate(Vector3<f32>{ 1, 2, 3 });
+	auto v = Vector4<f32>{ 1, 2, 3, 1 };
+	bencher.iter([&] {
+		Core::do_not_optimize(m);
+		Core::do_not_optimize(v);
+		return m * v;
+	});
+}
+
+MACH_BENCHMARK("Matrix4::inverse") {
+	using namespace Mach;
+
+	auto m = Matrix4<f32>::perspective(1.2f, 16.f / 9.f, 0.1f, 1000.f);
+	bencher.iter([&] {
+		Core::do_not_optimize(m);
+		return m.inverse().is_set();
+	});
+}
+#endif // MACH_ENABLE_BENCHMARK
@@ -71,7 +71,7 @@ namespace Mach::Core::Math {
 		 * @param far Far clipping plane distance.
 		 * @return A perspective projection matrix.
 		 */
-		static Matrix4 perspective(T fov, T aspect_ratio, T near, T far);
+		static constexpr Matrix4 perspective(T fov, T aspect_ratio, T near, T far);
 
 		/**
 		 * @brief Creates a transformation matrix from position, rotation, and scale.
@@ -80,14 +80,15 @@ namespace Mach::Core::Math {
 		 * @param scale The scale vector.
 		 * @return A transformation matrix.
 		 */
-		static Matrix4 transform(const Vector3<T>& position, const Quaternion<T>& rotation, const Vector3<T>& scale);
+		static constexpr Matrix4
+		transform(const Vector3<T>& position, const Quaternion<T>& rotation, const Vector3<T>& scale);
 
 		/**
 		 * @brief Creates a translation matrix given a translation.
 		 * @param translation The translation vector.
 		 * @return A translation matrix.
 		 */
-		static Matrix4 translate(const Vector3<T>& translation);
+		static constexpr Matrix4 translate(const Vector3<T>& translation);
 
 		/**
 		 * @brief Attempts to calculate the inverse of the matrix.
@@ -95,26 +96,39 @@ namespace Mach::Core::Math {
 		 */
 		MACH_NO_DISCARD Option<Matrix4> inverse() const;
 
+		/**
+		 * @brief Swaps the rows and columns of the matrix.
+		 * @return The transposed matrix.
+		 */
+		MACH_NO_DISCARD constexpr Matrix4 transpose() const;
+
+		/**
+		 * @brief Transforms a point, treating it as having a w of 1. No perspective divide is applied.
+		 * @param point The point to transform.
+		 * @return The transformed point.
+		 */
+		MACH_NO_DISCARD constexpr Vector3<T> transform_point(const Vector3<T>& point) const;
+
 		/**
 		 * @brief Retrieves a row of the matrix as a Vector4.
 		 * @param index Index of the row to retrieve.
 		 * @return The requested row as a Vector4.
 		 */
-		MACH_NO_DISCARD Vector4<T> row(usize index) const;
+		MACH_NO_DISCARD constexpr Vector4<T> row(usize index) const;
 
 		/**
 		 * @brief Multiplies this matrix by another matrix.
 		 * @param rhs The right-hand side matrix to multiply with.
 		 * @return The result of the matrix multiplication.
 		 */
-		Matrix4 operator*(const Matrix4& rhs) const;
+		constexpr Matrix4 operator*(const Matrix4& rhs) const;
 
 		/**
 		 * @brief Multiplies this matrix by a vector.
 		 * @param rhs The vector to multiply with.
 		 * @return The result of the multiplication as a Vector4.
 		 */
-		Vector4<T> operator*(const Vector4<T>& rhs) const;
+		constexpr Vector4<T> operator*(const Vector4<T>& rhs) const;
 
 	private:
 		MACH_ALWAYS_INLINE constexpr explicit Matrix4(
@@ -166,10 +180,10 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	Matrix4<T> Matrix4<T>::perspective(T fov, T aspect_ratio, T near, T far) {
+	constexpr Matrix4<T> Matrix4<T>::perspective(T fov, T aspect_ratio, T near, T far) {
 		const auto cotan = (T)1 / Math::tan((fov * Math::deg_to_rad<T>) / (T)2);
 
-		auto result = Matrix4::identity;
+		auto result = Matrix4::identity();
 		result.x.x = cotan / aspect_ratio;
 		result.y.y = cotan;
 		result.z.w = -1;
@@ -183,18 +197,18 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	Matrix4<T>
+	constexpr Matrix4<T>
 	Matrix4<T>::transform(const Vector3<T>& position, const Quaternion<T>& rotation, const Vector3<T>& scale) {
 		Matrix4 result;
-		result.x = { rotation.rotate(Vector3<T>::forward) * scale.x, T{ 0 } };
-		result.y = { rotation.rotate(Vector3<T>::right) * scale.y, T{ 0 } };
-		result.z = { rotation.rotate(Vector3<T>::up) * scale.z, T{ 0 } };
+		result.x = { rotation.rotate(Vector3<T>{ 1, 0, 0 }) * scale.x, T{ 0 } };
+		result.y = { rotation.rotate(Vector3<T>{ 0, 1, 0 }) * scale.y, T{ 0 } };
+		result.z = { rotation.rotate(Vector3<T>{ 0, 0, 1 }) * scale.z, T{ 0 } };
 		result.w = { position, T{ 1 } };
 		return result;
 	}
 
 	template <FloatingPoint T>
-	Matrix4<T> Matrix4<T>::translate(const Vector3<T>& translation) {
+	constexpr Matrix4<T> Matrix4<T>::translate(const Vector3<T>& translation) {
 		auto result = Matrix4::identity();
 		result.w = { translation, T{ 1 } };
 		return result;
@@ -202,6 +216,68 @@ namespace Mach::Core::Math {
 
 	template <FloatingPoint T>
 	Option<Matrix4<T>> Matrix4<T>::inverse() const {
+		if constexpr (use_simd<T>) {
+			// Block matrix inverse treating the matrix as four 2x2 matrices. Written for rows, but the inverse of the
+			// transpose is the transpose of the inverse so it works on columns as well.
+			// https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+			const f32x4 c0 = x.simd();
+			const f32x4 c1 = y.simd();
+			const f32x4 c2 = z.simd();
+			const f32x4 c3 = w.simd();
+
+			// 2x2 matrix multiply a * b
+			auto mul_2x2 = [](f32x4 a, f32x4 b) {
+				return a * b.swizzle<0, 3, 0, 3>() + a.swizzle<1, 0, 3, 2>() * b.swizzle<2, 1, 2, 1>();
+			};
+			// 2x2 adjugate of a multiplied by b
+			auto adj_mul_2x2 = [](f32x4 a, f32x4 b) {
+				return a.swizzle<3, 3, 0, 0>() * b - a.swizzle<1, 1, 2, 2>() * b.swizzle<2, 3, 0, 1>();
+			};
+			// a multiplied by the 2x2 adjugate of b
+			auto mul_adj_2x2 = [](f32x4 a, f32x4 b) {
+				return a * b.swizzle<3, 0, 3, 0>() - a.swizzle<1, 0, 3, 2>() * b.swizzle<2, 1, 2, 1>();
+			};
+
+			const f32x4 a = f32x4::shuffle<0, 1, 0, 1>(c0, c1);
+			const f32x4 b = f32x4::shuffle<2, 3, 2, 3>(c0, c1);
+			const f32x4 c = f32x4::shuffle<0, 1, 0, 1>(c2, c3);
+			const f32x4 d = f32x4::shuffle<2, 3, 2, 3>(c2, c3);
+
+			// Determinants of the sub matrices as (|A| |B| |C| |D|)
+			const f32x4 det_sub = f32x4::shuffle<0, 2, 0, 2>(c0, c2) * f32x4::shuffle<1, 3, 1, 3>(c1, c3) -
+								 f32x4::shuffle<1, 3, 1, 3>(c0, c2) * f32x4::shuffle<0, 2, 0, 2>(c1, c3);
+			const f32x4 det_a = det_sub.lane<0>();
+			const f32x4 det_b = det_sub.lane<1>();
+			const f32x4 det_c = det_sub.lane<2>();
+			const f32x4 det_d = det_sub.lane<3>();
+
+			const f32x4 d_c = adj_mul_2x2(d, c);
+			const f32x4 a_b = adj_mul_2x2(a, b);
+			f32x4 x_ = det_d * a - mul_2x2(b, d_c);
+			f32x4 w_ = det_a * d - mul_2x2(c, a_b);
+			f32x4 y_ = det_b * c - mul_adj_2x2(d, a_b);
+			f32x4 z_ = det_c * b - mul_adj_2x2(a, d_c);
+
+			const f32x4 trace = (a_b * d_c.swizzle<0, 2, 1, 3>()).sum();
+			const f32x4 det = det_a * det_d + det_b * det_c - trace;
+			if (Math::equals(det.x(), 0.f)) {
+				return nullopt;
+			}
+
+			const f32x4 inv_det = f32x4::set(1.f, -1.f, -1.f, 1.f) / det;
+			x_ = x_ * inv_det;
+			y_ = y_ * inv_det;
+			z_ = z_ * inv_det;
+			w_ = w_ * inv_det;
+
+			// Undo the adjugate while putting the blocks back together
+			return Matrix4::from_columns(
+				Vector4<T>::from_simd(f32x4::shuffle<3, 1, 3, 1>(x_, y_)),
+				Vector4<T>::from_simd(f32x4::shuffle<2, 0, 2, 0>(x_, y_)),
+				Vector4<T>::from_simd(f32x4::shuffle<3, 1, 3, 1>(z_, w_)),
+				Vector4<T>::from_simd(f32x4::shuffle<2, 0, 2, 0>(z_, w_)));
+		}
+
 		const auto a = x.x;
 		const auto b = x.y;
 		const auto c = x.z;
@@ -232,11 +308,11 @@ namespace Mach::Core::Math {
 		const auto a14 = -(e * jo_kn - f * io_km + g * in_jm);
 
 		const auto det = a * a11 + b * a12 + c * a13 + d * a14;
-		if (Math::equals(det, 0.f)) {
+		if (Math::equals(det, T{ 0 })) {
 			return nullopt;
 		}
 
-		const auto inv_det = 1.f / det;
+		const auto inv_det = T{ 1 } / det;
 
 		const auto a21 = -(b * kp_lo - c * jp_ln + d * jo_kn) * inv_det;
 		const auto a22 = +(a * kp_lo - c * ip_lm + d * io_km) * inv_det;
@@ -270,14 +346,38 @@ namespace Mach::Core::Math {
 		const auto a44 = +(a * fk_gj - b * ek_gi + c * ej_fi) * inv_det;
 
 		return Matrix4::from_columns(
-			Vector4<T>{ a11, a21, a31, a41 },
-			Vector4<T>{ a12, a22, a32, a42 },
-			Vector4<T>{ a13, a23, a33, a43 },
-			Vector4<T>{ a14, a24, a34, a44 });
+			Vector4<T>{ a11 * inv_det, a21, a31, a41 },
+			Vector4<T>{ a12 * inv_det, a22, a32, a42 },
+			Vector4<T>{ a13 * inv_det, a23, a33, a43 },
+			Vector4<T>{ a14 * inv_det, a24, a34, a44 });
 	}
 
 	template <FloatingPoint T>
-	Vector4<T> Matrix4<T>::row(usize index) const {
+	constexpr Matrix4<T> Matrix4<T>::transpose() const {
+		if constexpr (use_simd<T>) {
+			if (!std::is_constant_evaluated()) {
+				f32x4 c0 = x.simd();
+				f32x4 c1 = y.simd();
+				f32x4 c2 = z.simd();
+				f32x4 c3 = w.simd();
+				f32x4::transpose(c0, c1, c2, c3);
+				return Matrix4::from_columns(
+					Vector4<T>::from_simd(c0),
+					Vector4<T>::from_simd(c1),
+					Vector4<T>::from_simd(c2),
+					Vector4<T>::from_simd(c3));
+			}
+		}
+		return Matrix4::from_rows(x, y, z, w);
+	}
+
+	template <FloatingPoint T>
+	constexpr Vector3<T> Matrix4<T>::transform_point(const Vector3<T>& point) const {
+		return (*this * Vector4<T>{ point, T{ 1 } }).xyz();
+	}
+
+	template <FloatingPoint T>
+	constexpr Vector4<T> Matrix4<T>::row(usize index) const {
 		MACH_ASSERT(index < 4);
 		switch (index) {
 		case 0:
@@ -293,7 +393,26 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	Matrix4<T> Matrix4<T>::operator*(const Matrix4<T>& rhs) const {
+	constexpr Matrix4<T> Matrix4<T>::operator*(const Matrix4<T>& rhs) const {
+		if constexpr (use_simd<T>) {
+			if (!std::is_constant_evaluated()) {
+				// Each result column is the columns of this matrix weighted by the matching rhs column
+				const f32x4 c0 = x.simd();
+				const f32x4 c1 = y.simd();
+				const f32x4 c2 = z.simd();
+				const f32x4 c3 = w.simd();
+				auto column = [&](const Vector4<T>& weights) {
+					const f32x4 v = weights.simd();
+					const f32x4 result = f32x4::mul_add(c1, v.lane<1>(), c0 * v.lane<0>());
+					return Vector4<T>::from_simd(f32x4::mul_add(
+						c3,
+						v.lane<3>(),
+						f32x4::mul_add(c2, v.lane<2>(), result)));
+				};
+				return Matrix4::from_columns(column(rhs.x), column(rhs.y), column(rhs.z), column(rhs.w));
+			}
+		}
+
 		Vector4<T> row_x = {};
 		const auto row0 = row(0);
 		row_x.x = row0.dot(rhs.x);
@@ -326,7 +445,18 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	Vector4<T> Matrix4<T>::operator*(const Vector4<T>& rhs) const {
+	constexpr Vector4<T> Matrix4<T>::operator*(const Vector4<T>& rhs) const {
+		if constexpr (use_simd<T>) {
+			if (!std::is_constant_evaluated()) {
+				const f32x4 v = rhs.simd();
+				const f32x4 result = f32x4::mul_add(y.simd(), v.lane<1>(), x.simd() * v.lane<0>());
+				return Vector4<T>::from_simd(f32x4::mul_add(
+					w.simd(),
+					v.lane<3>(),
+					f32x4::mul_add(z.simd(), v.lane<2>(), result)));
+			}
+		}
+
 		const auto _x = row(0).dot(rhs);
 		const auto _y = row(1).dot(rhs);
 		const auto _z = row(2).dot(rhs);
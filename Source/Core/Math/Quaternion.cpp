@@ -98,6 +98,20 @@ MACH_TEST_SUITE("Math") {
 			MACH_CHECK(q3.z == 48.f);
 			MACH_CHECK(q3.w == -6.f);
 		}
+
+		MACH_SUBCASE("constexpr") {
+			constexpr auto q = Quaternion<f32>::from_axis_angle({ 1.f, 0.f, 0.f }, Math::deg_to_rad<f32> * 90.f);
+			static_assert(Math::equals(q.len(), 1.f));
+			static_assert(q.rotate({ 0.f, 1.f, 0.f }).equals({ 0.f, 0.f, 1.f }));
+			static_assert(Math::equals((q * q.inverse()).w, 1.f));
+
+			constexpr auto euler = Quaternion<f32>::from_euler(0.f, 450.f, 0.f);
+			const auto runtime_euler = Quaternion<f32>::from_euler(0.f, 450.f, 0.f);
+			MACH_CHECK(Math::equals(euler.x, runtime_euler.x));
+			MACH_CHECK(Math::equals(euler.y, runtime_euler.y));
+			MACH_CHECK(Math::equals(euler.z, runtime_euler.z));
+			MACH_CHECK(Math::equals(euler.w, runtime_euler.w));
+		}
 	}
 }
 #endif // MACH_ENABLE_TEST
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <Core/Math/SIMD.hpp>
 #include <Core/Math/Vector3.hpp>
 
 namespace Mach::Core::Math {
@@ -16,7 +17,7 @@ namespace Mach::Core::Math {
 	 * @tparam T A floating-point type specifying the precision of the quaternion components.
 	 */
 	template <FloatingPoint T>
-	struct Quaternion {
+	struct alignas(is_same<T, f32> ? 16 : alignof(T)) Quaternion {
 		T x, y, z, w;
 
 		/**
@@ -31,7 +32,7 @@ namespace Mach::Core::Math {
 		 * @param _z The z component of the quaternion.
 		 * @param _w The w component of the quaternion (real part).
 		 */
-		MACH_ALWAYS_INLINE explicit Quaternion(T _x, T _y, T _z, T _w) : x(_x), y(_y), z(_z), w(_w) {}
+		MACH_ALWAYS_INLINE constexpr explicit Quaternion(T _x, T _y, T _z, T _w) : x(_x), y(_y), z(_z), w(_w) {}
 
 		/**
 		 * @brief Creates a quaternion from an axis and an angle.
@@ -39,7 +40,7 @@ namespace Mach::Core::Math {
 		 * @param theta The angle of rotation in radians.
 		 * @return A quaternion representing the specified rotation.
 		 */
-		static Quaternion from_axis_angle(const Vector3<T>& axis, T theta);
+		static constexpr Quaternion from_axis_angle(const Vector3<T>& axis, T theta);
 
 		/**
 		 * @brief Creates a quaternion from Euler angles.
@@ -48,7 +49,7 @@ namespace Mach::Core::Math {
 		 * @param roll The roll angle in degrees.
 		 * @return A quaternion representing the specified rotation.
 		 */
-		static Quaternion from_euler(T pitch, T yaw, T roll);
+		static constexpr Quaternion from_euler(T pitch, T yaw, T roll);
 
 		/**
 		 * @brief Returns the identity quaternion (no rotation).
@@ -60,13 +61,13 @@ namespace Mach::Core::Math {
 		 * @brief Calculates the squared length of the quaternion.
 		 * @return The squared length of the quaternion.
 		 */
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE T len_sq() const;
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE T len_sq() const;
 
 		/**
 		 * @brief Calculates the length of the quaternion.
 		 * @return The length of the quaternion.
 		 */
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE T len() const;
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE T len() const;
 
 		/**
 		 * @brief Normalizes the quaternion.
@@ -79,25 +80,47 @@ namespace Mach::Core::Math {
 		 * @brief Calculates the inverse of the quaternion.
 		 * @return The inverse of the quaternion.
 		 */
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Quaternion inverse() const;
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Quaternion inverse() const;
+
+		/**
+		 * @brief Spherically interpolates between two rotations along the shortest path.
+		 * @param from The rotation at t = 0.
+		 * @param to The rotation at t = 1.
+		 * @param t The interpolation factor.
+		 * @return The interpolated rotation.
+		 */
+		static Quaternion slerp(const Quaternion& from, const Quaternion& to, T t);
 
 		/**
 		 * @brief Rotates a vector by the quaternion.
 		 * @param xyz The vector to rotate.
 		 * @return The rotated vector.
 		 */
-		MACH_NO_DISCARD Vector3<T> rotate(const Vector3<T>& xyz) const;
+		MACH_NO_DISCARD constexpr Vector3<T> rotate(const Vector3<T>& xyz) const;
 
 		/**
 		 * @brief Multiplies this quaternion by another quaternion.
 		 * @param rhs The right-hand side quaternion to multiply with.
 		 * @return The result of the quaternion multiplication.
 		 */
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Quaternion operator*(const Quaternion& rhs) const;
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Quaternion operator*(const Quaternion& rhs) const;
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 simd() const
+			requires use_simd<T>
+		{
+			return f32x4::load(&x);
+		}
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static Quaternion from_simd(f32x4 value)
+			requires use_simd<T>
+		{
+			Quaternion result;
+			value.store(&result.x);
+			return result;
+		}
 	};
 
 	template <FloatingPoint T>
-	Quaternion<T> Quaternion<T>::from_axis_angle(const Vector3<T>& axis, T theta) {
+	constexpr Quaternion<T> Quaternion<T>::from_axis_angle(const Vector3<T>& axis, T theta) {
 		const auto half_theta = theta / 2;
 		const auto s = Math::sin(half_theta);
 		const auto c = Math::cos(half_theta);
@@ -105,7 +128,7 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	Quaternion<T> Quaternion<T>::from_euler(T pitch, T yaw, T roll) {
+	constexpr Quaternion<T> Quaternion<T>::from_euler(T pitch, T yaw, T roll) {
 		const auto rads_div_by_2 = Math::deg_to_rad<T> / T{ 2 };
 
 		const auto pitch1 = Math::fmod(pitch, T{ 360 });
@@ -133,12 +156,12 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	MACH_NO_DISCARD MACH_ALWAYS_INLINE T Quaternion<T>::len_sq() const {
+	MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE T Quaternion<T>::len_sq() const {
 		return x * x + y * y + z * z + w * w;
 	}
 
 	template <FloatingPoint T>
-	MACH_NO_DISCARD MACH_ALWAYS_INLINE T Quaternion<T>::len() const {
+	MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE T Quaternion<T>::len() const {
 		return Math::sqrt(len_sq());
 	}
 
@@ -152,19 +175,79 @@ namespace Mach::Core::Math {
 	}
 
 	template <FloatingPoint T>
-	MACH_NO_DISCARD MACH_ALWAYS_INLINE Quaternion<T> Quaternion<T>::inverse() const {
+	MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Quaternion<T> Quaternion<T>::inverse() const {
 		return Quaternion{ -x, -y, -z, w };
 	}
 
 	template <FloatingPoint T>
-	MACH_NO_DISCARD Vector3<T> Quaternion<T>::rotate(const Vector3<T>& xyz) const {
+	Quaternion<T> Quaternion<T>::slerp(const Quaternion& from, const Quaternion& to, T t) {
+		T cos_theta = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+
+		// q and -q are the same rotation, flip to take the short way around
+		T sign = T{ 1 };
+		if (cos_theta < T{ 0 }) {
+			cos_theta = -cos_theta;
+			sign = T{ -1 };
+		}
+
+		T from_weight = T{ 1 } - t;
+		T to_weight = t;
+		// Nearly parallel rotations divide by a sine close to zero, where a linear blend is just as accurate
+		if (cos_theta < T{ 1 } - kinda_small_number<T>) {
+			const T theta = Math::acos(cos_theta);
+			const T inv_sin_theta = T{ 1 } / Math::sin(theta);
+			from_weight = Math::sin((T{ 1 } - t) * theta) * inv_sin_theta;
+			to_weight = Math::sin(t * theta) * inv_sin_theta;
+		}
+		to_weight *= sign;
+
+		return Quaternion{ from.x * from_weight + to.x * to_weight,
+						   from.y * from_weight + to.y * to_weight,
+						   from.z * from_weight + to.z * to_weight,
+						   from.w * from_weight + to.w * to_weight };
+	}
+
+	template <FloatingPoint T>
+	MACH_NO_DISCARD constexpr Vector3<T> Quaternion<T>::rotate(const Vector3<T>& xyz) const {
+		if constexpr (use_simd<T>) {
+			if (!std::is_constant_evaluated()) {
+				auto cross = [](f32x4 a, f32x4 b) {
+					return a.swizzle<1, 2, 0, 3>() * b.swizzle<2, 0, 1, 3>() -
+						   a.swizzle<2, 0, 1, 3>() * b.swizzle<1, 2, 0, 3>();
+				};
+				const f32x4 q = simd();
+				const f32x4 v = f32x4::set(xyz.x, xyz.y, xyz.z, 0.f);
+				const f32x4 t = cross(q, v) * f32x4::splat(2.f);
+				const f32x4 result = f32x4::mul_add(t, q.lane<3>(), v) + cross(q, t);
+
+				alignas(16) f32 lanes[4];
+				result.store(lanes);
+				return { lanes[0], lanes[1], lanes[2] };
+			}
+		}
+
 		const Vector3<T> this_xyz = { x, y, z };
 		const auto t = this_xyz.cross(xyz) * T{ 2 };
 		return xyz + (t * w) + this_xyz.cross(t);
 	}
 
 	template <FloatingPoint T>
-	MACH_NO_DISCARD MACH_ALWAYS_INLINE Quaternion<T> Quaternion<T>::operator*(const Quaternion<T>& rhs) const {
+	MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Quaternion<T>
+	Quaternion<T>::operator*(const Quaternion<T>& rhs) const {
+		if constexpr (use_simd<T>) {
+			if (!std::is_constant_evaluated()) {
+				const f32x4 a = simd();
+				const f32x4 b = rhs.simd();
+				// The w lane subtracts the products the other lanes add
+				const f32x4 sign = f32x4::set(1.f, 1.f, 1.f, -1.f);
+				const f32x4 t0 = a.lane<3>() * b;
+				const f32x4 t1 = a.swizzle<0, 1, 2, 0>() * b.swizzle<3, 3, 3, 0>();
+				const f32x4 t2 = a.swizzle<1, 2, 0, 1>() * b.swizzle<2, 0, 1, 1>();
+				const f32x4 t3 = a.swizzle<2, 0, 1, 2>() * b.swizzle<1, 2, 0, 2>();
+				return from_simd(f32x4::mul_add(t1 + t2, sign, t0) - t3);
+			}
+		}
+
 		return Quaternion{ w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
 						   w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z,
 						   w * rhs.z + z * rhs.w + x * rhs.y - y * rhs.x,
@@ -0,0 +1,439 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Core.hpp>
+#include <Core/Primitives.hpp>
+#include <Core/TypeTraits.hpp>
+
+#include <bit>
+
+// Define supported SIMD instruction sets
+#define MACH_SIMD_NONE 0
+#define MACH_SIMD_SSE  1
+#define MACH_SIMD_NEON 2
+
+// Pick the instruction set from the CPU. Define MACH_SIMD as MACH_SIMD_NONE to force the scalar fallback.
+#ifndef MACH_SIMD
+	#if MACH_CPU == MACH_CPU_X86
+		// SSE2 is part of the x86-64 baseline so no extra compiler flags are needed
+		#define MACH_SIMD MACH_SIMD_SSE
+	#elif MACH_CPU == MACH_CPU_ARM
+		#define MACH_SIMD MACH_SIMD_NEON
+	#else
+		#define MACH_SIMD MACH_SIMD_NONE
+	#endif
+#endif
+
+#if MACH_SIMD == MACH_SIMD_SSE
+	#include <emmintrin.h>
+#elif MACH_SIMD == MACH_SIMD_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace Mach::Core::Math {
+	// True when math types with T components should go through f32x4 rather than their scalar code
+	template <typename T>
+	inline constexpr bool use_simd = MACH_SIMD != MACH_SIMD_NONE && is_same<T, f32>;
+
+	/**
+	 * Four f32 lanes in a single register.
+	 *
+	 * Thin wrapper over __m128 and float32x4_t with a scalar fallback so the math types can share one code path. Only
+	 * what the math types need is exposed. Loads and stores require 16 byte alignment.
+	 */
+	struct f32x4 {
+#if MACH_SIMD == MACH_SIMD_SSE
+		__m128 v;
+#elif MACH_SIMD == MACH_SIMD_NEON
+		float32x4_t v;
+#else
+		alignas(16) f32 v[4];
+#endif
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 load(const f32* aligned) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_load_ps(aligned) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vld1q_f32(aligned) };
+#else
+			return { { aligned[0], aligned[1], aligned[2], aligned[3] } };
+#endif
+		}
+
+		MACH_ALWAYS_INLINE void store(f32* aligned) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			_mm_store_ps(aligned, v);
+#elif MACH_SIMD == MACH_SIMD_NEON
+			vst1q_f32(aligned, v);
+#else
+			for (usize i = 0; i < 4; i += 1) {
+				aligned[i] = v[i];
+			}
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 load_unaligned(const f32* ptr) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_loadu_ps(ptr) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vld1q_f32(ptr) };
+#else
+			return { { ptr[0], ptr[1], ptr[2], ptr[3] } };
+#endif
+		}
+
+		MACH_ALWAYS_INLINE void store_unaligned(f32* ptr) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			_mm_storeu_ps(ptr, v);
+#elif MACH_SIMD == MACH_SIMD_NEON
+			vst1q_f32(ptr, v);
+#else
+			for (usize i = 0; i < 4; i += 1) {
+				ptr[i] = v[i];
+			}
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 set(f32 x, f32 y, f32 z, f32 w) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_setr_ps(x, y, z, w) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			alignas(16) const f32 lanes[4] = { x, y, z, w };
+			return { vld1q_f32(lanes) };
+#else
+			return { { x, y, z, w } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 splat(f32 value) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_set1_ps(value) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vdupq_n_f32(value) };
+#else
+			return { { value, value, value, value } };
+#endif
+		}
+
+		// The first lane
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32 x() const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return _mm_cvtss_f32(v);
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return vgetq_lane_f32(v, 0);
+#else
+			return v[0];
+#endif
+		}
+
+		/**
+		 * Picks lanes A and B from left and lanes C and D from right, matching _mm_shuffle_ps. Passing the same vector
+		 * twice reorders the lanes of a single vector.
+		 */
+		template <u32 A, u32 B, u32 C, u32 D>
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 shuffle(f32x4 left, f32x4 right) {
+			static_assert(A < 4 && B < 4 && C < 4 && D < 4);
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_shuffle_ps(left.v, right.v, _MM_SHUFFLE(D, C, B, A)) };
+#elif MACH_SIMD == MACH_SIMD_NEON && MACH_COMPILER != MACH_COMPILER_MSVC
+			return { __builtin_shufflevector(left.v, right.v, A, B, C + 4, D + 4) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			float32x4_t result = vdupq_n_f32(vgetq_lane_f32(left.v, A));
+			result = vsetq_lane_f32(vgetq_lane_f32(left.v, B), result, 1);
+			result = vsetq_lane_f32(vgetq_lane_f32(right.v, C), result, 2);
+			result = vsetq_lane_f32(vgetq_lane_f32(right.v, D), result, 3);
+			return { result };
+#else
+			return { { left.v[A], left.v[B], right.v[C], right.v[D] } };
+#endif
+		}
+
+		template <u32 A, u32 B, u32 C, u32 D>
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 swizzle() const {
+			return shuffle<A, B, C, D>(*this, *this);
+		}
+
+		// Broadcasts a single lane to every lane
+		template <u32 Lane>
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 lane() const {
+#if MACH_SIMD == MACH_SIMD_NEON
+			return { vdupq_laneq_f32(v, Lane) };
+#else
+			return swizzle<Lane, Lane, Lane, Lane>();
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 operator+(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_add_ps(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vaddq_f32(v, rhs.v) };
+#else
+			return { { v[0] + rhs.v[0], v[1] + rhs.v[1], v[2] + rhs.v[2], v[3] + rhs.v[3] } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 operator-(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_sub_ps(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vsubq_f32(v, rhs.v) };
+#else
+			return { { v[0] - rhs.v[0], v[1] - rhs.v[1], v[2] - rhs.v[2], v[3] - rhs.v[3] } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 operator*(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_mul_ps(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vmulq_f32(v, rhs.v) };
+#else
+			return { { v[0] * rhs.v[0], v[1] * rhs.v[1], v[2] * rhs.v[2], v[3] * rhs.v[3] } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 operator/(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_div_ps(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vdivq_f32(v, rhs.v) };
+#else
+			return { { v[0] / rhs.v[0], v[1] / rhs.v[1], v[2] / rhs.v[2], v[3] / rhs.v[3] } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 abs() const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_andnot_ps(_mm_set1_ps(-0.f), v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vabsq_f32(v) };
+#else
+			return { { v[0] < 0.f ? -v[0] : v[0],
+					   v[1] < 0.f ? -v[1] : v[1],
+					   v[2] < 0.f ? -v[2] : v[2],
+					   v[3] < 0.f ? -v[3] : v[3] } };
+#endif
+		}
+
+		// Bit n is set when lane n of this is less than lane n of rhs
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u32 less_mask(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return static_cast<u32>(_mm_movemask_ps(_mm_cmplt_ps(v, rhs.v)));
+#elif MACH_SIMD == MACH_SIMD_NEON
+			alignas(16) static constexpr u32 bits[4] = { 1, 2, 4, 8 };
+			return vaddvq_u32(vandq_u32(vcltq_f32(v, rhs.v), vld1q_u32(bits)));
+#else
+			u32 mask = 0;
+			for (u32 i = 0; i < 4; i += 1) {
+				mask |= (v[i] < rhs.v[i] ? 1u : 0u) << i;
+			}
+			return mask;
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 min(f32x4 a, f32x4 b) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_min_ps(a.v, b.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vminq_f32(a.v, b.v) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+			}
+			return result;
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 max(f32x4 a, f32x4 b) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_max_ps(a.v, b.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vmaxq_f32(a.v, b.v) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+			}
+			return result;
+#endif
+		}
+
+		// Rounds each lane to the nearest integer, ties to even. Lanes must be within the range of an i32.
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 round() const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_cvtepi32_ps(_mm_cvtps_epi32(v)) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vrndnq_f32(v) };
+#else
+			// Adding 1.5 * 2^23 pushes the fraction out of the mantissa. Valid for lanes below 2^22.
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = (v[i] + 12582912.f) - 12582912.f;
+			}
+			return result;
+#endif
+		}
+
+		// 2^n for lanes holding whole numbers in [-126, 127]
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 pow2() const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(v), _mm_set1_epi32(127)), 23)) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtnq_s32_f32(v), vdupq_n_s32(127)), 23)) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = std::bit_cast<f32>(static_cast<u32>(static_cast<i32>(v[i]) + 127) << 23);
+			}
+			return result;
+#endif
+		}
+
+		// Low precision 1 / sqrt(x). Around 12 bits on SSE and 8 bits on NEON, refine with Newton-Raphson steps.
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 rsqrt_estimate() const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_rsqrt_ps(v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vrsqrteq_f32(v) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = std::bit_cast<f32>(0x5f375a86u - (std::bit_cast<u32>(v[i]) >> 1));
+			}
+			return result;
+#endif
+		}
+
+		// Every bit of lane n is set when lane n of this is less than lane n of rhs. Use with select.
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 less(f32x4 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_cmplt_ps(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vreinterpretq_f32_u32(vcltq_f32(v, rhs.v)) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = std::bit_cast<f32>(v[i] < rhs.v[i] ? 0xffffffffu : 0u);
+			}
+			return result;
+#endif
+		}
+
+		// Lanes of a where mask is set and lanes of b everywhere else
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 select(f32x4 mask, f32x4 a, f32x4 b) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+#else
+			f32x4 result;
+			for (usize i = 0; i < 4; i += 1) {
+				result.v[i] = std::bit_cast<u32>(mask.v[i]) != 0 ? a.v[i] : b.v[i];
+			}
+			return result;
+#endif
+		}
+
+		// a * b + c. Fused on NEON, SSE2 has no fused multiply add.
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 mul_add(f32x4 a, f32x4 b, f32x4 c) {
+#if MACH_SIMD == MACH_SIMD_NEON
+			return { vfmaq_f32(c.v, a.v, b.v) };
+#else
+			return a * b + c;
+#endif
+		}
+
+		// Sum of all lanes, broadcast to every lane
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 sum() const {
+			const f32x4 pairs = *this + swizzle<2, 3, 0, 1>();
+			return pairs + pairs.swizzle<1, 0, 3, 2>();
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static f32x4 dot(f32x4 a, f32x4 b) { return (a * b).sum(); }
+
+		// Transposes the 4x4 matrix held in the four vectors in place
+		MACH_ALWAYS_INLINE static void transpose(f32x4& a, f32x4& b, f32x4& c, f32x4& d) {
+			const f32x4 ab_low = shuffle<0, 1, 0, 1>(a, b);
+			const f32x4 ab_high = shuffle<2, 3, 2, 3>(a, b);
+			const f32x4 cd_low = shuffle<0, 1, 0, 1>(c, d);
+			const f32x4 cd_high = shuffle<2, 3, 2, 3>(c, d);
+			a = shuffle<0, 2, 0, 2>(ab_low, cd_low);
+			b = shuffle<1, 3, 1, 3>(ab_low, cd_low);
+			c = shuffle<0, 2, 0, 2>(ab_high, cd_high);
+			d = shuffle<1, 3, 1, 3>(ab_high, cd_high);
+		}
+	};
+
+	/**
+	 * Two u64 lanes in a single register, for bulk bitwise work over word arrays such as BitArray. Only the bitwise
+	 * operations are exposed. Loads and stores do not require alignment.
+	 */
+	struct u64x2 {
+#if MACH_SIMD == MACH_SIMD_SSE
+		__m128i v;
+#elif MACH_SIMD == MACH_SIMD_NEON
+		uint64x2_t v;
+#else
+		u64 v[2];
+#endif
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static u64x2 load_unaligned(const u64* ptr) {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr)) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vld1q_u64(ptr) };
+#else
+			return { { ptr[0], ptr[1] } };
+#endif
+		}
+
+		MACH_ALWAYS_INLINE void store_unaligned(u64* ptr) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v);
+#elif MACH_SIMD == MACH_SIMD_NEON
+			vst1q_u64(ptr, v);
+#else
+			ptr[0] = v[0];
+			ptr[1] = v[1];
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u64x2 operator&(u64x2 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_and_si128(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vandq_u64(v, rhs.v) };
+#else
+			return { { v[0] & rhs.v[0], v[1] & rhs.v[1] } };
+#endif
+		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u64x2 operator|(u64x2 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_or_si128(v, rhs.v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vorrq_u64(v, rhs.v) };
+#else
+			return { { v[0] | rhs.v[0], v[1] | rhs.v[1] } };
+#endif
+		}
+
+		// this & ~rhs
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE u64x2 and_not(u64x2 rhs) const {
+#if MACH_SIMD == MACH_SIMD_SSE
+			return { _mm_andnot_si128(rhs.v, v) };
+#elif MACH_SIMD == MACH_SIMD_NEON
+			return { vbicq_u64(v, rhs.v) };
+#else
+			return { { v[0] & ~rhs.v[0], v[1] & ~rhs.v[1] } };
+#endif
+		}
+	};
+} // namespace Mach::Core::Math
@@ -108,14 +108,14 @@ MACH_TEST_SUITE("Math") {
 
 		MACH_SUBCASE("len") {
 			const Vector3<f32> foo = 1.f;
-			MACH_CHECK(Math::equals(foo.len(), Math::sqrt(2.f)));
+			MACH_CHECK(Math::equals(foo.len(), Math::sqrt(3.f)));
 		}
 
 		MACH_SUBCASE("normalized") {
 			const Vector3<f32> a = 1.f;
 			const auto a_normalized = a.normalized();
 			MACH_CHECK(a_normalized.is_set());
-			MACH_CHECK(a.normalized().unwrap().equals(Math::sqrt(2.f) * 0.5f));
+			MACH_CHECK(a.normalized().unwrap().equals(1.f / Math::sqrt(3.f)));
 
 			const Vector3<f32> b = 0.f;
 			MACH_CHECK(!b.normalized().is_set());
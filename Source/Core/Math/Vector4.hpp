@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <Core/Math/SIMD.hpp>
 #include <Core/Math/Vector3.hpp>
 
 namespace Mach::Core::Math {
+	// f32 vectors are 16 byte aligned so they can be loaded straight into a SIMD register
 	template <typename T>
-	struct Vector4 {
+	struct alignas(is_same<T, f32> ? 16 : alignof(T)) Vector4 {
 		T x, y, z, w;
 
 		constexpr MACH_ALWAYS_INLINE Vector4() : x{ 0 }, y{ 0 }, z{ 0 }, w{ 0 } {}
@@ -22,38 +24,65 @@ namespace Mach::Core::Math {
 			, z{ xyz.z }
 			, w{ _w } {}
 
-		MACH_ALWAYS_INLINE Vector4 operator+(const Vector4& rhs) const {
+		constexpr MACH_ALWAYS_INLINE Vector4 operator+(const Vector4& rhs) const {
+			if constexpr (use_simd<T>) {
+				if (!std::is_constant_evaluated()) {
+					return from_simd(simd() + rhs.simd());
+				}
+			}
 			return { x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w };
 		}
-		MACH_ALWAYS_INLINE Vector4 operator-(const Vector4& rhs) const {
+		constexpr MACH_ALWAYS_INLINE Vector4 operator-(const Vector4& rhs) const {
+			if constexpr (use_simd<T>) {
+				if (!std::is_constant_evaluated()) {
+					return from_simd(simd() - rhs.simd());
+				}
+			}
 			return { x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w };
 		}
-		MACH_ALWAYS_INLINE Vector4 operator*(const Vector4& rhs) const {
+		constexpr MACH_ALWAYS_INLINE Vector4 operator*(const Vector4& rhs) const {
+			if constexpr (use_simd<T>) {
+				if (!std::is_constant_evaluated()) {
+					return from_simd(simd() * rhs.simd());
+				}
+			}
 			return { x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w };
 		}
-		MACH_ALWAYS_INLINE Vector4 operator/(const Vector4& rhs) const {
+		constexpr MACH_ALWAYS_INLINE Vector4 operator/(const Vector4& rhs) const {
+			if constexpr (use_simd<T>) {
+				if (!std::is_constant_evaluated()) {
+					return from_simd(simd() / rhs.simd());
+				}
+			}
 			return { x / rhs.x, y / rhs.y, z / rhs.z, w / rhs.w };
 		}
-		MACH_ALWAYS_INLINE void operator+=(const Vector4& rhs) { *this = *this + rhs; }
-		MACH_ALWAYS_INLINE void operator-=(const Vector4& rhs) { *this = *this - rhs; }
-		MACH_ALWAYS_INLINE void operator*=(const Vector4& rhs) { *this = *this * rhs; }
-		MACH_ALWAYS_INLINE void operator/=(const Vector4& rhs) { *this = *this / rhs; }
-		MACH_ALWAYS_INLINE Vector4 operator-() const { return { -x, -y, -z, -w }; }
+		constexpr MACH_ALWAYS_INLINE void operator+=(const Vector4& rhs) { *this = *this + rhs; }
+		constexpr MACH_ALWAYS_INLINE void operator-=(const Vector4& rhs) { *this = *this - rhs; }
+		constexpr MACH_ALWAYS_INLINE void operator*=(const Vector4& rhs) { *this = *this * rhs; }
+		constexpr MACH_ALWAYS_INLINE void operator/=(const Vector4& rhs) { *this = *this / rhs; }
+		constexpr MACH_ALWAYS_INLINE Vector4 operator-() const { return { -x, -y, -z, -w }; }
 
 		/**
 		 * @returns the cos of the angle between the two vectors.
 		 */
-		MACH_ALWAYS_INLINE T dot(const Vector4& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
+		constexpr MACH_ALWAYS_INLINE T dot(const Vector4& rhs) const {
+			if constexpr (use_simd<T>) {
+				if (!std::is_constant_evaluated()) {
+					return f32x4::dot(simd(), rhs.simd()).x();
+				}
+			}
+			return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
+		}
 
 		/**
 		 * @returns the length of the vector squared.
 		 */
-		MACH_ALWAYS_INLINE T len_sq() const { return dot(*this); }
+		constexpr MACH_ALWAYS_INLINE T len_sq() const { return dot(*this); }
 
 		/**
 		 * @returns the length of the vector.
 		 */
-		MACH_ALWAYS_INLINE T len() const { return sqrt(len_sq()); }
+		constexpr MACH_ALWAYS_INLINE T len() const { return sqrt(len_sq()); }
 
 		/**
 		 * @returns an option containing the normalized vector if the length is not zero.
@@ -67,23 +96,24 @@ namespace Mach::Core::Math {
 			return nullopt;
 		}
 
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool contains(T value) const {
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE bool contains(T value) const {
 			return x == value || y == value || z == value || w == value;
 		}
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool equals(const Vector4& rhs, T tolerance = kinda_small_number<T>) const {
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE bool
+		equals(const Vector4& rhs, T tolerance = kinda_small_number<T>) const {
 			return Math::equals(x, rhs.x, tolerance) && Math::equals(y, rhs.y, tolerance) &&
 				   Math::equals(z, rhs.z, tolerance) && Math::equals(w, rhs.w, tolerance);
 		}
 
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Vector4 min(const Vector4& rhs) const {
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Vector4 min(const Vector4& rhs) const {
 			return { Math::min(x, rhs.x), Math::min(y, rhs.y), Math::min(z, rhs.z), Math::min(w, rhs.w) };
 		}
 
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Vector4 max(const Vector4& rhs) const {
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Vector4 max(const Vector4& rhs) const {
 			return { Math::max(x, rhs.x), Math::max(y, rhs.y), Math::max(z, rhs.z), Math::max(w, rhs.w) };
 		}
 
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Vector3<T> xyz() const { return { x, y, z }; }
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Vector3<T> xyz() const { return { x, y, z }; }
 
 		/**
 		 * Cast the vector to another type.
@@ -92,9 +122,22 @@ namespace Mach::Core::Math {
 		 * @return A new vector with the casted type.
 		 */
 		template <typename D>
-		MACH_NO_DISCARD MACH_ALWAYS_INLINE Vector4<D> as() const {
+		MACH_NO_DISCARD constexpr MACH_ALWAYS_INLINE Vector4<D> as() const {
 			return Vector4<D>{ static_cast<D>(x), static_cast<D>(y), static_cast<D>(z), static_cast<D>(w) };
 		}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE f32x4 simd() const
+			requires use_simd<T>
+		{
+			return f32x4::load(&x);
+		}
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static Vector4 from_simd(f32x4 value)
+			requires use_simd<T>
+		{
+			Vector4 result;
+			value.store(&result.x);
+			return result;
+		}
 	};
 } // namespace Mach::Core::Math
 
@@ -37,17 +37,4 @@ namespace Mach::Core::Memory {
 	NonNull<void> set(NonNull<void> ptr, u8 value, usize count) {
 		return std::memset(ptr, value, static_cast<std::size_t>(count));
 	}
-
-#define B2(n)	   n, n + 1, n + 1, n + 2
-#define B4(n)	   B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
-#define B6(n)	   B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
-#define COUNT_BITS B6(0), B6(1), B6(1), B6(2)
-
-	static u8 count_set_bits_table[256] = { COUNT_BITS };
-	u8 count_ones(u8 byte) { return count_set_bits_table[byte]; }
-
-#undef B2
-#undef B4
-#undef B6
-#undef COUNT_BITS
 } // namespace Mach::Core::Memory
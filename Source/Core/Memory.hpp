@@ -10,6 +10,7 @@
 #include <Core/Containers/Slice.hpp>
 #include <Core/TypeTraits.hpp>
 
+#include <bit>
 #include <new>
 #undef stdin
 #undef stdout
@@ -50,20 +51,22 @@ namespace Mach::Core::Memory {
 	NonNull<void> move(NonNull<void> dst, NonNull<void const> src, usize count);
 	NonNull<void> set(NonNull<void> ptr, u8 value, usize count);
 
-	u8 count_ones(u8 byte);
-
+	// Number of set bits in t. Integers go to popcount through the unsigned integer of the same size, as popcount
+	// rejects signed and character types. Anything else is counted a byte at a time.
 	template <typename T>
 	MACH_ALWAYS_INLINE u32 count_ones(T t) {
-		const usize size = sizeof(T);
-		void* ptr = &t;
-		u8 const* u8_casted = (u8 const*)ptr;
+		if constexpr (is_integral<T> && !is_same<T, bool>) {
+			return static_cast<u32>(std::popcount(static_cast<MakeUnsigned<T>>(t)));
+		} else {
+			u8 const* bytes = reinterpret_cast<u8 const*>(&t);
 
-		u32 result = 0;
-		for (usize i = 0; i < size; ++i) {
-			result += count_ones(u8_casted[i]);
-		}
+			u32 result = 0;
+			for (usize i = 0; i < sizeof(T); ++i) {
+				result += static_cast<u32>(std::popcount(bytes[i]));
+			}
 
-		return result;
+			return result;
+		}
 	}
 
 	template <typename T>
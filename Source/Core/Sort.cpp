@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#include <Core/Sort.hpp>
+
+#include <Core/Containers/Array.hpp>
+#include <Core/Containers/UniquePtr.hpp>
+#include <Core/Debug/Benchmark.hpp>
+#include <Core/Debug/Test.hpp>
+#include <Core/Math/Math.hpp>
+
+#if MACH_ENABLE_TEST
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	// xorshift so the inputs are the same on every run
+	struct SortRandom {
+		u64 state = 0x9E3779B97F4A7C15ULL;
+
+		u64 next() {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+	};
+
+	template <typename T, typename Less>
+	bool is_sorted_by(Slice<T> slice, Less less) {
+		for (usize index = 1; index < slice.len(); index += 1) {
+			if (less(slice[index], slice[index - 1])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	bool is_sorted(Slice<T> slice) {
+		return is_sorted_by(slice, [](T const& a, T const& b) { return a < b; });
+	}
+
+	// Inputs that each hit a different path through pdqsort
+	Array<Array<u32>> sort_inputs() {
+		SortRandom random;
+		Array<Array<u32>> result;
+		for (const usize len : { 0, 1, 2, 5, 23, 24, 100, 1000, 20000 }) {
+			Array<u32> random_values;
+			Array<u32> few_unique;
+			Array<u32> ascending;
+			Array<u32> descending;
+			Array<u32> equal;
+			Array<u32> organ_pipe;
+			for (usize index = 0; index < len; index += 1) {
+				random_values.push(static_cast<u32>(random.next()));
+				few_unique.push(static_cast<u32>(random.next() % 4));
+				ascending.push(static_cast<u32>(index));
+				descending.push(static_cast<u32>(len - index));
+				equal.push(7);
+				organ_pipe.push(static_cast<u32>(index < len / 2 ? index : len - index));
+			}
+			result.push(Mach::move(random_values));
+			result.push(Mach::move(few_unique));
+			result.push(Mach::move(ascending));
+			result.push(Mach::move(descending));
+			result.push(Mach::move(equal));
+			result.push(Mach::move(organ_pipe));
+		}
+		return result;
+	}
+
+	u64 sum_of(Slice<u32> slice) {
+		u64 result = 0;
+		for (const u32 value : slice) {
+			result += value;
+		}
+		return result;
+	}
+
+	MACH_TEST_CASE("sort") {
+		MACH_SUBCASE("sorts every pattern") {
+			for (auto& input : sort_inputs()) {
+				const u64 sum = sum_of(input.as_slice());
+				sort(input.as_slice());
+				MACH_CHECK(is_sorted(input.as_slice()));
+				MACH_CHECK(sum_of(input.as_slice()) == sum);
+			}
+		}
+
+		MACH_SUBCASE("comparator and key") {
+			SortRandom random;
+			Array<i32> values;
+			for (usize index = 0; index < 1000; index += 1) {
+				values.push(static_cast<i32>(random.next() % 2001) - 1000);
+			}
+
+			auto greater = [](i32 a, i32 b) { return a > b; };
+			sort_by(values.as_slice(), greater);
+			MACH_CHECK(is_sorted_by(values.as_slice(), greater));
+
+			auto magnitude = [](i32 value) { return value < 0 ? -value : value; };
+			sort_by_key(values.as_slice(), magnitude);
+			MACH_CHECK(is_sorted_by(values.as_slice(), [&](i32 a, i32 b) { return magnitude(a) < magnitude(b); }));
+		}
+
+		MACH_SUBCASE("owning values") {
+			SortRandom random;
+			Array<UniquePtr<u32>> values;
+			for (usize index = 0; index < 500; index += 1) {
+				values.push(UniquePtr<u32>::create(static_cast<u32>(random.next() % 100)));
+			}
+
+			auto less = [](UniquePtr<u32> const& a, UniquePtr<u32> const& b) { return *a < *b; };
+			sort_by(values.as_slice(), less);
+			MACH_CHECK(is_sorted_by(values.as_slice(), less));
+			stable_sort_by(values.as_slice(), less);
+			MACH_CHECK(is_sorted_by(values.as_slice(), less));
+		}
+	}
+
+	MACH_TEST_CASE("stable sort") {
+		MACH_SUBCASE("sorts every pattern") {
+			for (auto& input : sort_inputs()) {
+				const u64 sum = sum_of(input.as_slice());
+				stable_sort(input.as_slice());
+				MACH_CHECK(is_sorted(input.as_slice()));
+				MACH_CHECK(sum_of(input.as_slice()) == sum);
+			}
+		}
+
+		MACH_SUBCASE("keeps equal elements in order") {
+			struct Keyed {
+				u32 key;
+				u32 order;
+			};
+
+			SortRandom random;
+			Array<Keyed> values;
+			for (u32 index = 0; index < 5000; index += 1) {
+				values.push(Keyed{ .key = static_cast<u32>(random.next() % 16), .order = index });
+			}
+
+			stable_sort_by_key(values.as_slice(), [](Keyed const& keyed) { return keyed.key; });
+			MACH_CHECK(is_sorted_by(values.as_slice(), [](Keyed const& a, Keyed const& b) {
+				return a.key < b.key || (a.key == b.key && a.order < b.order);
+			}));
+		}
+	}
+
+	MACH_TEST_CASE("radix sort") {
+		MACH_SUBCASE("sorts every pattern") {
+			for (auto& input : sort_inputs()) {
+				const u64 sum = sum_of(input.as_slice());
+				radix_sort(input.as_slice());
+				MACH_CHECK(is_sorted(input.as_slice()));
+				MACH_CHECK(sum_of(input.as_slice()) == sum);
+			}
+		}
+
+		MACH_SUBCASE("signed keys") {
+			SortRandom random;
+			Array<i64> values;
+			for (usize index = 0; index < 3000; index += 1) {
+				values.push(static_cast<i64>(random.next()));
+			}
+			values.push(NumericLimits<i64>::min());
+			values.push(NumericLimits<i64>::max());
+			values.push(0);
+			values.push(-1);
+
+			radix_sort(values.as_slice());
+			MACH_CHECK(is_sorted(values.as_slice()));
+			MACH_CHECK(values[0] == NumericLimits<i64>::min());
+			MACH_CHECK(values[values.len() - 1] == NumericLimits<i64>::max());
+		}
+
+		MACH_SUBCASE("float keys") {
+			SortRandom random;
+			Array<f32> values;
+			for (usize index = 0; index < 3000; index += 1) {
+				values.push(static_cast<f32>(static_cast<i32>(random.next() % 20001) - 10000) * 0.125f);
+			}
+			values.push(-0.0f);
+			values.push(0.0f);
+			values.push(-Math::infinity<f32>);
+			values.push(Math::infinity<f32>);
+
+			radix_sort(values.as_slice());
+			MACH_CHECK(is_sorted(values.as_slice()));
+			MACH_CHECK(values[0] == -Math::infinity<f32>);
+			MACH_CHECK(values[values.len() - 1] == Math::infinity<f32>);
+		}
+
+		MACH_SUBCASE("key is stable") {
+			// Shaped like a draw call sorted by pipeline, then material
+			struct Draw {
+				u64 key;
+				u32 order;
+			};
+
+			SortRandom random;
+			Array<Draw> draws;
+			for (u32 index = 0; index < 5000; index += 1) {
+				const u64 pipeline = random.next() % 8;
+				const u64 material = random.next() % 8;
+				draws.push(Draw{ .key = pipeline << 48 | material << 32, .order = index });
+			}
+
+			radix_sort_by_key(draws.as_slice(), [](Draw const& draw) { return draw.key; });
+			MACH_CHECK(is_sorted_by(draws.as_slice(), [](Draw const& a, Draw const& b) {
+				return a.key < b.key || (a.key == b.key && a.order < b.order);
+			}));
+		}
+	}
+}
+#endif // MACH_ENABLE_TEST
+
+#if MACH_ENABLE_BENCHMARK
+namespace {
+	using namespace Mach::Core;
+
+	constexpr usize sort_bench_len = 1024 * 1024;
+
+	Array<u32> sort_bench_input() {
+		Array<u32> result;
+		result.reserve(sort_bench_len);
+		u64 state = 0x9E3779B97F4A7C15ULL;
+		for (usize index = 0; index < sort_bench_len; index += 1) {
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			result.push(static_cast<u32>(state));
+		}
+		return result;
+	}
+
+	// Every iteration copies the shuffled input back first, which is included in the time
+	template <typename F>
+	void sort_bench(Bencher& bencher, F&& f) {
+		const Array<u32> input = sort_bench_input();
+		Array<u32> values = input;
+		bencher.set_items(sort_bench_len);
+		bencher.iter([&] {
+			Memory::copy(values.begin(), input.begin(), sort_bench_len * sizeof(u32));
+			f(values.as_slice());
+			return values[0];
+		});
+	}
+} // namespace
+
+MACH_BENCHMARK("sort 1M u32") {
+	sort_bench(bencher, [](Slice<u32> values) { sort(values); });
+}
+
+MACH_BENCHMARK("stable_sort 1M u32") {
+	sort_bench(bencher, [](Slice<u32> values) { stable_sort(values); });
+}
+
+MACH_BENCHMARK("radix_sort 1M u32") {
+	sort_bench(bencher, [](Slice<u32> values) { radix_sort(values); });
+}
+#endif // MACH_ENABLE_BENCHMARK
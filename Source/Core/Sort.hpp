@@ -0,0 +1,517 @@
+/**
+ * Copyright (c) 2024-2025 Colby Hall <me@cobeh.com>
+ *
+ * This software is released under the MIT License.
+ */
+
+#pragma once
+
+#include <Core/Concepts.hpp>
+#include <Core/Containers/Slice.hpp>
+#include <Core/Memory.hpp>
+
+#include <bit>
+
+namespace Mach::Core {
+	// Returns true if a must come before b. Must be a strict weak ordering.
+	template <typename F, typename T>
+	concept SortLess = requires(F& f, T const& a, T const& b) {
+		{ f(a, b) } -> ConvertibleTo<bool>;
+	};
+
+	// Keys radix sort knows how to order by their bits
+	template <typename T>
+	concept RadixKey = (Integral<T> && !SameAs<T, bool>) || SameAs<T, f32> || SameAs<T, f64>;
+
+	template <typename F, typename T>
+	concept RadixKeyOf = RadixKey<InvokeResult<F&, T const&>>;
+
+	// Below this many elements insertion sort wins over everything else
+	inline constexpr usize sort_insertion_threshold = 24;
+
+	template <typename T>
+	MACH_ALWAYS_INLINE inline void sort_swap(T* a, T* b) {
+		T temp = Mach::move(*a);
+		*a = Mach::move(*b);
+		*b = Mach::move(temp);
+	}
+
+	template <typename T, typename Less>
+	void sort_insertion(T* begin, T* end, Less& less) {
+		if (begin == end) {
+			return;
+		}
+		for (T* cur = begin + 1; cur != end; cur += 1) {
+			T* sift = cur;
+			T* sift_1 = cur - 1;
+			if (less(*sift, *sift_1)) {
+				T temp = Mach::move(*sift);
+				do {
+					*sift = Mach::move(*sift_1);
+					sift -= 1;
+				} while (sift != begin && less(temp, *--sift_1));
+				*sift = Mach::move(temp);
+			}
+		}
+	}
+
+	// Same as sort_insertion but relies on *(begin - 1) not being greater than anything in [begin, end)
+	template <typename T, typename Less>
+	void sort_insertion_unguarded(T* begin, T* end, Less& less) {
+		if (begin == end) {
+			return;
+		}
+		for (T* cur = begin + 1; cur != end; cur += 1) {
+			T* sift = cur;
+			T* sift_1 = cur - 1;
+			if (less(*sift, *sift_1)) {
+				T temp = Mach::move(*sift);
+				do {
+					*sift = Mach::move(*sift_1);
+					sift -= 1;
+				} while (less(temp, *--sift_1));
+				*sift = Mach::move(temp);
+			}
+		}
+	}
+
+	// Insertion sort that gives up once it has moved more than a handful of elements. Returns true if it finished.
+	template <typename T, typename Less>
+	bool sort_insertion_partial(T* begin, T* end, Less& less) {
+		static constexpr usize limit = 8;
+		if (begin == end) {
+			return true;
+		}
+		usize moved = 0;
+		for (T* cur = begin + 1; cur != end; cur += 1) {
+			T* sift = cur;
+			T* sift_1 = cur - 1;
+			if (less(*sift, *sift_1)) {
+				T temp = Mach::move(*sift);
+				do {
+					*sift = Mach::move(*sift_1);
+					sift -= 1;
+				} while (sift != begin && less(temp, *--sift_1));
+				*sift = Mach::move(temp);
+				moved += static_cast<usize>(cur - sift);
+			}
+			if (moved > limit) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T, typename Less>
+	void sort_heap(T* begin, T* end, Less& less) {
+		const usize len = static_cast<usize>(end - begin);
+		auto sift_down = [&](usize root, usize last) {
+			while (true) {
+				usize child = root * 2 + 1;
+				if (child >= last) {
+					break;
+				}
+				if (child + 1 < last && less(begin[child], begin[child + 1])) {
+					child += 1;
+				}
+				if (!less(begin[root], begin[child])) {
+					break;
+				}
+				sort_swap(begin + root, begin + child);
+				root = child;
+			}
+		};
+		for (usize index = len / 2; index > 0; index -= 1) {
+			sift_down(index - 1, len);
+		}
+		for (usize last = len; last > 1; last -= 1) {
+			sort_swap(begin, begin + last - 1);
+			sift_down(0, last - 1);
+		}
+	}
+
+	template <typename T, typename Less>
+	MACH_ALWAYS_INLINE inline void sort_2(T* a, T* b, Less& less) {
+		if (less(*b, *a)) {
+			sort_swap(a, b);
+		}
+	}
+
+	template <typename T, typename Less>
+	MACH_ALWAYS_INLINE inline void sort_3(T* a, T* b, T* c, Less& less) {
+		sort_2(a, b, less);
+		sort_2(b, c, less);
+		sort_2(a, b, less);
+	}
+
+	template <typename T>
+	struct SortPartition {
+		T* pivot;
+		bool already_partitioned;
+	};
+
+	// Partitions around *begin, putting elements equal to the pivot on the right. Returns where the pivot ended up.
+	template <typename T, typename Less>
+	SortPartition<T> sort_partition_right(T* begin, T* end, Less& less) {
+		T pivot = Mach::move(*begin);
+		T* first = begin;
+		T* last = end;
+
+		// The median of 3 guarantees something not less than the pivot stops the first scan
+		while (less(*++first, pivot)) {}
+		if (first - 1 == begin) {
+			while (first < last && !less(*--last, pivot)) {}
+		} else {
+			while (!less(*--last, pivot)) {}
+		}
+
+		const bool already_partitioned = first >= last;
+		while (first < last) {
+			sort_swap(first, last);
+			while (less(*++first, pivot)) {}
+			while (!less(*--last, pivot)) {}
+		}
+
+		T* const pivot_position = first - 1;
+		*begin = Mach::move(*pivot_position);
+		*pivot_position = Mach::move(pivot);
+		return SortPartition<T>{ .pivot = pivot_position, .already_partitioned = already_partitioned };
+	}
+
+	// Partitions around *begin, putting elements equal to the pivot on the left. Used when the pivot equals the
+	// element before the range, so that a run of equal elements is swept up in linear time.
+	template <typename T, typename Less>
+	T* sort_partition_left(T* begin, T* end, Less& less) {
+		T pivot = Mach::move(*begin);
+		T* first = begin;
+		T* last = end;
+
+		while (less(pivot, *--last)) {}
+		if (last + 1 == end) {
+			while (first < last && !less(pivot, *++first)) {}
+		} else {
+			while (!less(pivot, *++first)) {}
+		}
+
+		while (first < last) {
+			sort_swap(first, last);
+			while (less(pivot, *--last)) {}
+			while (!less(pivot, *++first)) {}
+		}
+
+		T* const pivot_position = last;
+		*begin = Mach::move(*pivot_position);
+		*pivot_position = Mach::move(pivot);
+		return pivot_position;
+	}
+
+	template <typename T, typename Less>
+	void sort_pdq_loop(T* begin, T* end, Less& less, u32 bad_allowed, bool leftmost) {
+		static constexpr usize ninther_threshold = 128;
+
+		while (true) {
+			const usize len = static_cast<usize>(end - begin);
+			if (len < sort_insertion_threshold) {
+				if (leftmost) {
+					sort_insertion(begin, end, less);
+				} else {
+					sort_insertion_unguarded(begin, end, less);
+				}
+				return;
+			}
+
+			// Pivot on the median of 3, or the pseudo median of 9 for larger ranges, moved to begin
+			const usize half = len / 2;
+			if (len > ninther_threshold) {
+				sort_3(begin, begin + half, end - 1, less);
+				sort_3(begin + 1, begin + (half - 1), end - 2, less);
+				sort_3(begin + 2, begin + (half + 1), end - 3, less);
+				sort_3(begin + (half - 1), begin + half, begin + (half + 1), less);
+				sort_swap(begin, begin + half);
+			} else {
+				sort_3(begin + half, begin, end - 1, less);
+			}
+
+			// The pivot equals the element before this range, which is not greater than anything in it. Everything
+			// equal to the pivot can be put in place at once.
+			if (!leftmost && !less(*(begin - 1), *begin)) {
+				begin = sort_partition_left(begin, end, less) + 1;
+				continue;
+			}
+
+			const auto [pivot, already_partitioned] = sort_partition_right(begin, end, less);
+
+			const usize left_len = static_cast<usize>(pivot - begin);
+			const usize right_len = static_cast<usize>(end - (pivot + 1));
+			const bool highly_unbalanced = left_len < len / 8 || right_len < len / 8;
+
+			if (highly_unbalanced) {
+				// Too many bad pivots, fall back to heap sort to keep O(n log n)
+				bad_allowed -= 1;
+				if (bad_allowed == 0) {
+					sort_heap(begin, end, less);
+					return;
+				}
+
+				// Shuffle a few elements around to break up whatever pattern led to the bad pivot
+				if (left_len >= sort_insertion_threshold) {
+					sort_swap(begin, begin + left_len / 4);
+					sort_swap(pivot - 1, pivot - left_len / 4);
+					if (left_len > ninther_threshold) {
+						sort_swap(begin + 1, begin + (left_len / 4 + 1));
+						sort_swap(begin + 2, begin + (left_len / 4 + 2));
+						sort_swap(pivot - 2, pivot - (left_len / 4 + 1));
+						sort_swap(pivot - 3, pivot - (left_len / 4 + 2));
+					}
+				}
+				if (right_len >= sort_insertion_threshold) {
+					sort_swap(pivot + 1, pivot + (1 + right_len / 4));
+					sort_swap(end - 1, end - right_len / 4);
+					if (right_len > ninther_threshold) {
+						sort_swap(pivot + 2, pivot + (2 + right_len / 4));
+						sort_swap(pivot + 3, pivot + (3 + right_len / 4));
+						sort_swap(end - 2, end - (1 + right_len / 4));
+						sort_swap(end - 3, end - (2 + right_len / 4));
+					}
+				}
+			} else if (already_partitioned && sort_insertion_partial(begin, pivot, less) &&
+					   sort_insertion_partial(pivot + 1, end, less)) {
+				// Nothing had to move, so the range was most likely already sorted
+				return;
+			}
+
+			// Recurse into the left side and loop on the right
+			sort_pdq_loop(begin, pivot, less, bad_allowed, leftmost);
+			begin = pivot + 1;
+			leftmost = false;
+		}
+	}
+
+	/**
+	 * Sorts slice in place with a pattern defeating quicksort. O(n log n) worst case, linear on sorted, reversed and
+	 * all equal input, and never allocates. Not stable, use stable_sort_by if equal elements must keep their order.
+	 *
+	 * Source: Orson Peters' pdqsort
+	 * https://github.com/orlp/pdqsort
+	 */
+	template <typename T, typename Less>
+		requires SortLess<Less, T>
+	void sort_by(Slice<T> slice, Less&& less) {
+		if (slice.len() < 2) {
+			return;
+		}
+		const u32 bad_allowed = static_cast<u32>(std::bit_width(slice.len()));
+		sort_pdq_loop(slice.begin(), slice.end(), less, bad_allowed, true);
+	}
+
+	template <typename T>
+	void sort(Slice<T> slice) {
+		sort_by(slice, [](T const& a, T const& b) { return a < b; });
+	}
+
+	// Sorts by the value key returns for each element
+	template <typename T, typename F>
+	void sort_by_key(Slice<T> slice, F&& key) {
+		sort_by(slice, [&key](T const& a, T const& b) { return key(a) < key(b); });
+	}
+
+	/**
+	 * Merges the sorted runs [begin, middle) and [middle, end) in place, preferring the left run on ties. scratch must
+	 * have room for middle - begin uninitialized elements.
+	 */
+	template <typename T, typename Less>
+	void sort_merge(T* begin, T* middle, T* end, T* scratch, Less& less) {
+		// Already in order, which is common for partially sorted input
+		if (!less(*middle, *(middle - 1))) {
+			return;
+		}
+
+		const usize left_len = static_cast<usize>(middle - begin);
+		for (usize index = 0; index < left_len; index += 1) {
+			Memory::emplace<T>(scratch + index, Mach::move(begin[index]));
+		}
+
+		// The output can never catch up with the right run, so it is merged where it is
+		T* left = scratch;
+		T* const left_end = scratch + left_len;
+		T* right = middle;
+		T* out = begin;
+		while (left != left_end && right != end) {
+			if (less(*right, *left)) {
+				*out = Mach::move(*right);
+				right += 1;
+			} else {
+				*out = Mach::move(*left);
+				left += 1;
+			}
+			out += 1;
+		}
+		while (left != left_end) {
+			*out = Mach::move(*left);
+			left += 1;
+			out += 1;
+		}
+
+		for (usize index = 0; index < left_len; index += 1) {
+			scratch[index].~T();
+		}
+	}
+
+	template <typename T, typename Less>
+	void sort_merge_recursive(T* begin, T* end, T* scratch, Less& less) {
+		const usize len = static_cast<usize>(end - begin);
+		if (len < sort_insertion_threshold) {
+			sort_insertion(begin, end, less);
+			return;
+		}
+		T* const middle = begin + len / 2;
+		sort_merge_recursive(begin, middle, scratch, less);
+		sort_merge_recursive(middle, end, scratch, less);
+		sort_merge(begin, middle, end, scratch, less);
+	}
+
+	/**
+	 * Sorts slice in place with a merge sort, keeping equal elements in the order they were in. Allocates scratch space
+	 * for half of slice, unless it is small enough to insertion sort outright.
+	 */
+	template <typename T, typename Less>
+		requires SortLess<Less, T>
+	void stable_sort_by(Slice<T> slice, Less&& less) {
+		if (slice.len() < sort_insertion_threshold) {
+			sort_insertion(slice.begin(), slice.end(), less);
+			return;
+		}
+
+		auto memory = Memory::alloc(Memory::Layout::array<T>(slice.len() / 2));
+		T* const scratch = static_cast<T*>(*memory);
+		sort_merge_recursive(slice.begin(), slice.end(), scratch, less);
+		Memory::free(scratch);
+	}
+
+	template <typename T>
+	void stable_sort(Slice<T> slice) {
+		stable_sort_by(slice, [](T const& a, T const& b) { return a < b; });
+	}
+
+	template <typename T, typename F>
+	void stable_sort_by_key(Slice<T> slice, F&& key) {
+		stable_sort_by(slice, [&key](T const& a, T const& b) { return key(a) < key(b); });
+	}
+
+	template <usize Size>
+	using RadixBits = Conditional<Size == 1, u8, Conditional<Size == 2, u16, Conditional<Size == 4, u32, u64>>>;
+
+	// Maps key to an unsigned integer with the same ordering, so radix sort only ever compares bits
+	template <RadixKey K>
+	MACH_ALWAYS_INLINE inline RadixBits<sizeof(K)> radix_bits(K key) {
+		using U = RadixBits<sizeof(K)>;
+		static constexpr U sign = static_cast<U>(U{ 1 } << (sizeof(K) * 8 - 1));
+		if constexpr (FloatingPoint<K>) {
+			// Negative floats order backwards, so flip every bit of those and only the sign of the rest
+			const U bits = std::bit_cast<U>(key);
+			return (bits & sign) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+		} else if constexpr (SignedIntegral<K>) {
+			return static_cast<U>(static_cast<U>(key) ^ sign);
+		} else {
+			return static_cast<U>(key);
+		}
+	}
+
+	// Elements below this many are insertion sorted instead, as clearing and walking the histograms costs more
+	inline constexpr usize radix_sort_threshold = 64;
+
+	// Counts of every 8 bit digit of a key, one histogram per pass
+	template <RadixKey K>
+	struct RadixHistogram {
+		static constexpr usize passes = sizeof(K);
+		usize counts[passes][256];
+	};
+
+	template <RadixKey K>
+	MACH_ALWAYS_INLINE inline u8 radix_digit(RadixBits<sizeof(K)> bits, usize pass) {
+		return static_cast<u8>(bits >> (pass * 8));
+	}
+
+	/**
+	 * Sorts slice in place by the integer or float key returns for each element with an LSD radix sort. Runs in
+	 * O(n * sizeof(key)) without ever comparing elements and is stable. Allocates scratch space for all of slice.
+	 *
+	 * Elements are copied byte for byte between slice and the scratch space, so T must be trivially copyable. Sort
+	 * indices or handles into the real data if it is not.
+	 */
+	template <typename T, typename F>
+		requires RadixKeyOf<F, T>
+	void radix_sort_by_key(Slice<T> slice, F&& key) {
+		static_assert(is_trivially_copyable<T>, "radix sort copies elements as bytes");
+		using K = RemoveCvref<InvokeResult<F&, T const&>>;
+		using Histogram = RadixHistogram<K>;
+
+		const usize len = slice.len();
+		if (len < radix_sort_threshold) {
+			auto less = [&key](T const& a, T const& b) { return radix_bits<K>(key(a)) < radix_bits<K>(key(b)); };
+			sort_insertion(slice.begin(), slice.end(), less);
+			return;
+		}
+
+		// Counting every digit up front takes a single read of the keys
+		Histogram histogram{};
+		for (T const& element : slice) {
+			const auto bits = radix_bits<K>(key(element));
+			for (usize pass = 0; pass < Histogram::passes; pass += 1) {
+				histogram.counts[pass][radix_digit<K>(bits, pass)] += 1;
+			}
+		}
+
+		auto memory = Memory::alloc(Memory::Layout::array<T>(len));
+		T* from = slice.begin();
+		T* to = static_cast<T*>(*memory);
+
+		// A pass where every element has the same digit would not move anything, so keys that only use their low
+		// bits only pay for the passes they need
+		const auto first_bits = radix_bits<K>(key(*from));
+		for (usize pass = 0; pass < Histogram::passes; pass += 1) {
+			if (histogram.counts[pass][radix_digit<K>(first_bits, pass)] == len) {
+				continue;
+			}
+
+			usize offsets[256];
+			usize total = 0;
+			for (usize digit = 0; digit < 256; digit += 1) {
+				offsets[digit] = total;
+				total += histogram.counts[pass][digit];
+			}
+
+			for (usize index = 0; index < len; index += 1) {
+				const u8 digit = radix_digit<K>(radix_bits<K>(key(from[index])), pass);
+				to[offsets[digit]] = from[index];
+				offsets[digit] += 1;
+			}
+
+			T* const temp = from;
+			from = to;
+			to = temp;
+		}
+
+		// An odd number of passes leaves the result in scratch
+		if (from != slice.begin()) {
+			Memory::copy(slice.begin(), from, len * sizeof(T));
+		}
+		Memory::free(memory);
+	}
+
+	template <RadixKey T>
+	void radix_sort(Slice<T> slice) {
+		radix_sort_by_key(slice, [](T value) { return value; });
+	}
+} // namespace Mach::Core
+
+namespace Mach {
+	using Core::radix_sort;
+	using Core::radix_sort_by_key;
+	using Core::sort;
+	using Core::sort_by;
+	using Core::sort_by_key;
+	using Core::stable_sort;
+	using Core::stable_sort_by;
+	using Core::stable_sort_by_key;
+} // namespace Mach
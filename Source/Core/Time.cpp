@@ -15,6 +15,24 @@
 #endif
 
 namespace Mach::Core {
+	Duration Duration::from_secs_f64(f64 secs) {
+		MACH_ASSERT(secs >= 0.0, "Duration can not be negative");
+		const auto whole = static_cast<u64>(secs);
+		const auto nanos = static_cast<u32>((secs - static_cast<f64>(whole)) * static_cast<f64>(nanos_per_sec));
+		return Duration(whole, nanos);
+	}
+
+	// Converts ticks of a counter running at frequency without overflowing for any realistic frequency
+	static Duration ticks_to_duration(u64 ticks, u64 frequency) {
+		const u64 secs = ticks / frequency;
+		const u64 remainder = ticks - secs * frequency;
+		return Duration(secs, static_cast<u32>(remainder * nanos_per_sec / frequency));
+	}
+
+	static u64 duration_to_ticks(Duration duration, u64 frequency) {
+		return duration.as_secs() * frequency + static_cast<u64>(duration.subsec_nanos()) * frequency / nanos_per_sec;
+	}
+
 #if MACH_OS == MACH_OS_WINDOWS
 	static u64 acquire_frequency() {
 		LARGE_INTEGER freq;
@@ -24,29 +42,124 @@ namespace Mach::Core {
 	}
 	static const u64 g_timer_frequency = acquire_frequency();
 
-	Instant Instant::now() {
+	static u64 query_ticks() {
 		LARGE_INTEGER ticks;
-		const auto result = QueryPerformanceCounter(&ticks);
+		const auto result = ::QueryPerformanceCounter(&ticks);
 		MACH_ASSERT(result);
-		return Instant(static_cast<u64>(ticks.QuadPart));
-	}
-
-	Duration Instant::since(Instant earlier) const {
-		auto duration = m_ticks - earlier.m_ticks;
-		const auto secs = duration / g_timer_frequency;
-		duration -= secs * g_timer_frequency;
-		const auto nanos = (u32)(duration * (nanos_per_sec / g_timer_frequency));
-		return Duration(secs, nanos);
+		return static_cast<u64>(ticks.QuadPart);
 	}
 #else
-	Instant Instant::now() {
+	static constexpr u64 g_timer_frequency = nanos_per_sec;
+
+	static u64 query_ticks() {
 		timespec time;
-		clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
-		return Instant(time.tv_sec, time.tv_nsec);
+		const auto result = ::clock_gettime(CLOCK_MONOTONIC, &time);
+		MACH_ASSERT(result == 0);
+		return static_cast<u64>(time.tv_sec) * nanos_per_sec + static_cast<u64>(time.tv_nsec);
 	}
+#endif
+
+	Instant Instant::now() { return Instant(query_ticks()); }
 
 	Duration Instant::since(Instant earlier) const {
-		return Duration(m_secs - earlier.m_secs, m_nanos - earlier.m_nanos);
+		if (m_ticks <= earlier.m_ticks) return Duration{};
+		return ticks_to_duration(m_ticks - earlier.m_ticks, g_timer_frequency);
+	}
+
+	Instant Instant::operator+(Duration duration) const {
+		return Instant(m_ticks + duration_to_ticks(duration, g_timer_frequency));
+	}
+
+	Instant Instant::operator-(Duration duration) const {
+		const u64 ticks = duration_to_ticks(duration, g_timer_frequency);
+		MACH_ASSERT(ticks <= m_ticks, "Instant subtraction underflowed");
+		return Instant(m_ticks - ticks);
 	}
+
+	u64 CycleCounter::fallback_now() { return query_ticks(); }
+
+	static u64 acquire_cycle_frequency() {
+#if MACH_CPU == MACH_CPU_ARM && defined(__aarch64__)
+		// The generic timer reports its own rate
+		u64 result;
+		asm volatile("mrs %0, cntfrq_el0" : "=r"(result));
+		return result;
+#elif MACH_CPU == MACH_CPU_X86 || MACH_CPU == MACH_CPU_ARM
+		// The TSC rate is only exposed through model specific CPUID leaves that are often empty, so measure it
+		// against the OS clock. 10ms is enough for the result to be well within 0.1%.
+		const u64 start_ticks = query_ticks();
+		const u64 start_cycles = CycleCounter::now();
+		const u64 wanted = duration_to_ticks(Duration::from_millis(10), g_timer_frequency);
+		u64 end_ticks = start_ticks;
+		while (end_ticks - start_ticks < wanted) {
+			end_ticks = query_ticks();
+		}
+		const u64 end_cycles = CycleCounter::now();
+		const f64 elapsed = static_cast<f64>(end_ticks - start_ticks) / static_cast<f64>(g_timer_frequency);
+		return static_cast<u64>(static_cast<f64>(end_cycles - start_cycles) / elapsed);
+#else
+		return g_timer_frequency;
 #endif
+	}
+
+	u64 CycleCounter::frequency() {
+		static const u64 frequency = acquire_cycle_frequency();
+		return frequency;
+	}
+
+	Duration CycleCounter::to_duration(u64 cycles) { return ticks_to_duration(cycles, frequency()); }
 } // namespace Mach::Core
+
+#if MACH_ENABLE_TEST
+	#include <Core/Debug/Test.hpp>
+
+MACH_TEST_SUITE("Core") {
+	using namespace Mach::Core;
+
+	MACH_TEST_CASE("Duration") {
+		MACH_SUBCASE("conversions") {
+			MACH_CHECK(Duration::from_millis(1500) == Duration(1, 500000000));
+			MACH_CHECK(Duration::from_micros(2000001).as_micros() == 2000001);
+			MACH_CHECK(Duration::from_nanos(3000000007).subsec_nanos() == 7);
+			MACH_CHECK(Duration(0, 2500000000).as_secs() == 2);
+			MACH_CHECK(Duration::from_secs(3).as_millis() == 3000);
+		}
+
+		MACH_SUBCASE("arithmetic") {
+			const auto a = Duration(1, 900000000);
+			const auto b = Duration(0, 200000000);
+			MACH_CHECK(a + b == Duration(2, 100000000));
+			MACH_CHECK((a + b) - a == b);
+			MACH_CHECK(Duration(2, 100000000) - Duration(0, 900000000) == Duration(1, 200000000));
+			MACH_CHECK(b * 7 == Duration(1, 400000000));
+			MACH_CHECK(Duration::from_secs(3) / 2 == Duration::from_millis(1500));
+			MACH_CHECK(b.saturating_sub(a).is_zero());
+		}
+
+		MACH_SUBCASE("comparisons") {
+			MACH_CHECK(Duration(1, 0) > Duration(0, 999999999));
+			MACH_CHECK(Duration(1, 5) < Duration(1, 6));
+			MACH_CHECK(Duration(2, 0) >= Duration::from_secs(2));
+			MACH_CHECK(Duration(2, 0) != Duration(2, 1));
+		}
+	}
+
+	MACH_TEST_CASE("Instant") {
+		const auto start = Instant::now();
+		const auto cycles = CycleCounter::now();
+
+		// Spin rather than sleep so the test does not depend on the scheduler
+		while (start.elapsed() < Duration::from_millis(5)) {}
+
+		const auto end = Instant::now();
+		MACH_CHECK(end > start);
+		MACH_CHECK(end - start >= Duration::from_millis(5));
+		MACH_CHECK(start.since(end).is_zero());
+		MACH_CHECK(start + (end - start) <= end);
+
+		const auto cycle_elapsed = CycleCounter::since(cycles);
+		MACH_CHECK(cycle_elapsed >= Duration::from_millis(4));
+		MACH_CHECK(cycle_elapsed < Duration::from_secs(1));
+	}
+}
+#endif // MACH_ENABLE_TEST
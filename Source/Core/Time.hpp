@@ -7,8 +7,13 @@
 #pragma once
 
 #include <Core/Core.hpp>
+#include <Core/Debug/Assertions.hpp>
 #include <Core/Primitives.hpp>
 
+#if MACH_COMPILER == MACH_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
 namespace Mach::Core {
 	constexpr u64 nanos_per_sec = 1000000000;
 	constexpr u64 nanos_per_milli = 1000000;
@@ -16,36 +21,159 @@ namespace Mach::Core {
 	constexpr u64 millis_per_sec = 1000;
 	constexpr u64 micros_per_sec = 1000000;
 
+	// Span of time with nanosecond precision. Always positive, subtracting past zero asserts.
 	class Duration {
 	public:
-		constexpr explicit Duration(u64 secs, u32 nanos) : m_secs(secs), m_nanos(nanos) {}
-		MACH_ALWAYS_INLINE static Duration from_millis(u64 millis) {
-			return Duration(millis / millis_per_sec, static_cast<u32>(millis % millis_per_sec));
+		// Nanos past a whole second carry over into secs
+		constexpr explicit Duration(u64 secs, u32 nanos)
+			: m_secs(secs + nanos / nanos_per_sec)
+			, m_nanos(static_cast<u32>(nanos % nanos_per_sec)) {}
+		constexpr Duration() : m_secs(0), m_nanos(0) {}
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static constexpr Duration from_secs(u64 secs) { return Duration(secs, 0); }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static constexpr Duration from_millis(u64 millis) {
+			return Duration(millis / millis_per_sec, static_cast<u32>((millis % millis_per_sec) * nanos_per_milli));
+		}
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static constexpr Duration from_micros(u64 micros) {
+			return Duration(micros / micros_per_sec, static_cast<u32>((micros % micros_per_sec) * nanos_per_micro));
+		}
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static constexpr Duration from_nanos(u64 nanos) {
+			return Duration(nanos / nanos_per_sec, static_cast<u32>(nanos % nanos_per_sec));
+		}
+		MACH_NO_DISCARD static Duration from_secs_f64(f64 secs);
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr u64 as_secs() const { return m_secs; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr u32 subsec_nanos() const { return m_nanos; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr u64 as_millis() const {
+			return m_secs * millis_per_sec + m_nanos / nanos_per_milli;
+		}
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr u64 as_micros() const {
+			return m_secs * micros_per_sec + m_nanos / nanos_per_micro;
 		}
+		// Wraps for spans longer than ~584 years
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr u64 as_nanos() const { return m_secs * nanos_per_sec + m_nanos; }
 
 		MACH_ALWAYS_INLINE f32 as_secs_f32() const { return (f32)m_secs + ((f32)m_nanos / (f32)nanos_per_sec); }
 		MACH_ALWAYS_INLINE f64 as_secs_f64() const { return (f64)m_secs + ((f64)m_nanos / (f64)nanos_per_sec); }
 
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE constexpr bool is_zero() const { return m_secs == 0 && m_nanos == 0; }
+
+		// Returns zero instead of asserting when rhs is longer
+		MACH_NO_DISCARD constexpr Duration saturating_sub(Duration rhs) const {
+			if (*this <= rhs) return Duration{};
+			return *this - rhs;
+		}
+
+		MACH_NO_DISCARD constexpr Duration operator+(Duration rhs) const {
+			return Duration(m_secs + rhs.m_secs, m_nanos + rhs.m_nanos);
+		}
+		MACH_NO_DISCARD constexpr Duration operator-(Duration rhs) const {
+			MACH_ASSERT(*this >= rhs, "Duration subtraction underflowed");
+			u64 secs = m_secs - rhs.m_secs;
+			u32 nanos = m_nanos;
+			if (nanos < rhs.m_nanos) {
+				secs -= 1;
+				nanos += static_cast<u32>(nanos_per_sec);
+			}
+			return Duration(secs, nanos - rhs.m_nanos);
+		}
+		MACH_NO_DISCARD constexpr Duration operator*(u32 rhs) const {
+			const u64 nanos = static_cast<u64>(m_nanos) * rhs;
+			return Duration(m_secs * rhs + nanos / nanos_per_sec, static_cast<u32>(nanos % nanos_per_sec));
+		}
+		MACH_NO_DISCARD constexpr Duration operator/(u32 rhs) const {
+			MACH_ASSERT(rhs != 0, "Duration divided by zero");
+			const u64 secs = m_secs / rhs;
+			const u64 carry = m_secs - secs * rhs;
+			const u64 nanos = (carry * nanos_per_sec + m_nanos) / rhs;
+			return Duration(secs, static_cast<u32>(nanos));
+		}
+
+		constexpr Duration& operator+=(Duration rhs) { return *this = *this + rhs; }
+		constexpr Duration& operator-=(Duration rhs) { return *this = *this - rhs; }
+		constexpr Duration& operator*=(u32 rhs) { return *this = *this * rhs; }
+		constexpr Duration& operator/=(u32 rhs) { return *this = *this / rhs; }
+
+		MACH_NO_DISCARD constexpr bool operator==(Duration rhs) const {
+			return m_secs == rhs.m_secs && m_nanos == rhs.m_nanos;
+		}
+		MACH_NO_DISCARD constexpr bool operator!=(Duration rhs) const { return !(*this == rhs); }
+		MACH_NO_DISCARD constexpr bool operator<(Duration rhs) const {
+			return m_secs < rhs.m_secs || (m_secs == rhs.m_secs && m_nanos < rhs.m_nanos);
+		}
+		MACH_NO_DISCARD constexpr bool operator>(Duration rhs) const { return rhs < *this; }
+		MACH_NO_DISCARD constexpr bool operator<=(Duration rhs) const { return !(rhs < *this); }
+		MACH_NO_DISCARD constexpr bool operator>=(Duration rhs) const { return !(*this < rhs); }
+
 	private:
 		u64 m_secs;
 		u32 m_nanos;
 	};
 
+	// Point on a monotonic clock that keeps counting while the process sleeps or is descheduled. Only meaningful
+	// relative to other Instants taken in the same process.
 	class Instant {
 	public:
-		static Instant now();
+		MACH_NO_DISCARD static Instant now();
 
-		Duration since(Instant earlier) const;
-		MACH_ALWAYS_INLINE Duration elapsed() const { return Instant::now().since(*this); }
+		// Returns zero if earlier is actually later
+		MACH_NO_DISCARD Duration since(Instant earlier) const;
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Duration elapsed() const { return Instant::now().since(*this); }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE Duration operator-(Instant earlier) const { return since(earlier); }
+		MACH_NO_DISCARD Instant operator+(Duration duration) const;
+		MACH_NO_DISCARD Instant operator-(Duration duration) const;
+		Instant& operator+=(Duration duration) { return *this = *this + duration; }
+		Instant& operator-=(Duration duration) { return *this = *this - duration; }
+
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator==(Instant rhs) const { return m_ticks == rhs.m_ticks; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator!=(Instant rhs) const { return m_ticks != rhs.m_ticks; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator<(Instant rhs) const { return m_ticks < rhs.m_ticks; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator>(Instant rhs) const { return m_ticks > rhs.m_ticks; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator<=(Instant rhs) const { return m_ticks <= rhs.m_ticks; }
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE bool operator>=(Instant rhs) const { return m_ticks >= rhs.m_ticks; }
 
 	private:
-#if MACH_OS == MACH_OS_WINDOWS
+		// QueryPerformanceCounter ticks on Windows, CLOCK_MONOTONIC nanoseconds everywhere else
 		explicit Instant(u64 ticks) : m_ticks(ticks) {}
 		u64 m_ticks;
+	};
+
+	/**
+	 * Raw CPU timestamp counter for timing very short spans, where the cost of an Instant starts to show up in the
+	 * measurement. Reads rdtsc on x86 and cntvct_el0 on ARM64, both of which tick at a constant rate on any CPU from
+	 * the last decade and take a handful of nanoseconds.
+	 *
+	 * Counters are not guaranteed to be synchronized across sockets so only compare readings taken on the same thread
+	 * when exact ordering matters. Falls back to Instant on CPUs without a usable counter.
+	 */
+	class CycleCounter {
+	public:
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static u64 now() {
+#if MACH_CPU == MACH_CPU_X86
+	#if MACH_COMPILER == MACH_COMPILER_MSVC
+			return __rdtsc();
+	#else
+			return __builtin_ia32_rdtsc();
+	#endif
+#elif MACH_CPU == MACH_CPU_ARM && defined(__aarch64__)
+			u64 result;
+			asm volatile("mrs %0, cntvct_el0" : "=r"(result));
+			return result;
+#elif MACH_CPU == MACH_CPU_ARM && MACH_COMPILER == MACH_COMPILER_MSVC
+			return _ReadStatusReg(ARM64_CNTVCT);
 #else
-		explicit Instant(u64 secs, u32 nanos) : m_secs(secs), m_nanos(nanos) {}
-		u64 m_secs;
-		u32 m_nanos;
+			return fallback_now();
 #endif
+		}
+
+		// Counter ticks per second. Calibrated against Instant on first use where the CPU does not report it.
+		MACH_NO_DISCARD static u64 frequency();
+
+		MACH_NO_DISCARD static Duration to_duration(u64 cycles);
+		MACH_NO_DISCARD MACH_ALWAYS_INLINE static Duration since(u64 earlier) { return to_duration(now() - earlier); }
+
+	private:
+		static u64 fallback_now();
 	};
 } // namespace Mach::Core
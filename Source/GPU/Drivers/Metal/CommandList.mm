@@ -4,6 +4,7 @@
  * this software is released under the mit license.
  */
 
+#include <Core/Debug/Profiler.hpp>
 #include <GPU/Drivers/Metal/Buffer.hpp>
 #include <GPU/Drivers/Metal/CommandList.hpp>
 #include <GPU/Drivers/Metal/Conversion.hpp>
@@ -12,12 +13,14 @@
 
 namespace Mach::GPU {
 	void MetalReceipt::wait_until_complete() const {
+		MACH_PROFILE_SCOPE("Receipt::wait_until_complete");
 		@autoreleasepool {
 			[m_command_buffer waitUntilCompleted];
 		}
 	}
 
 	SharedPtr<Receipt> MetalCommandList::submit() const {
+		MACH_PROFILE_SCOPE("CommandList::submit");
 		@autoreleasepool {
 			[m_command_buffer commit];
 			return SharedPtr<MetalReceipt>::create(m_command_buffer);
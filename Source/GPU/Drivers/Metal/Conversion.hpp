@@ -137,33 +137,19 @@ namespace Mach::GPU {
 	}
 
 	inline MTLLoadAction load_action_to_mtl_load_action(const ColorLoadAction::Variant& action) {
-		if (action.is<ColorLoadAction::Clear>()) {
-			return MTLLoadActionClear;
-
-		} else if (action.is<ColorLoadAction::Load>()) {
-			return MTLLoadActionLoad;
-
-		} else if (action.is<ColorLoadAction::DontCare>()) {
-			return MTLLoadActionDontCare;
-		}
-
-		MACH_UNIMPLEMENTED;
-		return MTLLoadActionDontCare;
+		return action.visit(Core::Overloaded{
+			[](const ColorLoadAction::DontCare&) { return MTLLoadActionDontCare; },
+			[](const ColorLoadAction::Load&) { return MTLLoadActionLoad; },
+			[](const ColorLoadAction::Clear&) { return MTLLoadActionClear; },
+		});
 	}
 
 	inline MTLLoadAction load_action_to_mtl_load_action(const DepthLoadAction::Variant& action) {
-		if (action.is<DepthLoadAction::Clear>()) {
-			return MTLLoadActionClear;
-
-		} else if (action.is<DepthLoadAction::Load>()) {
-			return MTLLoadActionLoad;
-
-		} else if (action.is<DepthLoadAction::DontCare>()) {
-			return MTLLoadActionDontCare;
-		}
-
-		MACH_UNIMPLEMENTED;
-		return MTLLoadActionDontCare;
+		return action.visit(Core::Overloaded{
+			[](const DepthLoadAction::DontCare&) { return MTLLoadActionDontCare; },
+			[](const DepthLoadAction::Load&) { return MTLLoadActionLoad; },
+			[](const DepthLoadAction::Clear&) { return MTLLoadActionClear; },
+		});
 	}
 
 	inline MTLStoreAction store_action_to_mtl_store_action(StoreAction action) {
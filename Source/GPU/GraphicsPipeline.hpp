@@ -114,7 +114,7 @@ namespace Mach::GPU {
 			VertexShader const& vertex_shader;
 			FragmentShader const& fragment_shader;
 
-			Array<ColorAttachment, InlineAllocator<8>> color_attachments;
+			Array<ColorAttachment, SmallAllocator<4>> color_attachments;
 			Option<DepthAttachment> depth_attachment = nullopt;
 
 			DrawMode draw_mode = DrawMode::Fill;
@@ -147,7 +147,7 @@ namespace Mach::GPU {
 		SharedPtr<VertexShader> m_vertex_shader;
 		SharedPtr<FragmentShader> m_fragment_shader;
 
-		Array<ColorAttachment, InlineAllocator<8>> m_color_attachments;
+		Array<ColorAttachment, SmallAllocator<4>> m_color_attachments;
 		Option<DepthAttachment> m_depth_attachment;
 
 		DrawMode m_draw_mode;
@@ -6,6 +6,7 @@
 
 #include <GUI/Application.hpp>
 
+#include <Core/Debug/Profiler.hpp>
 #include <Core/Math/Matrix4.hpp>
 #include <Core/Time.hpp>
 #include <GPU/Device.hpp>
@@ -89,13 +90,18 @@ namespace Mach::GUI {
 		auto last = Core::Instant::now();
 		u64 frame_count = 0;
 		while (running.load()) {
+			MACH_PROFILE_FRAME();
+
 			const auto now = Core::Instant::now();
 			const auto delta_time = now.since(last).as_secs_f64();
 			last = now;
 
 			pump_events();
 			auto frame = Frame(frame_count, delta_time, m_state);
-			tick(frame);
+			{
+				MACH_PROFILE_SCOPE("Application::tick");
+				tick(frame);
+			}
 
 			frame_count += 1;
 		}
@@ -23,51 +23,89 @@ namespace Mach::GUI {
 			color);
 	}
 
-	void Shape::tesselate(Mesh& mesh, const Bounds& clip) const {
-		if (m_variant.is<Rect>()) {
-			// Insert the four corners of the rect into the vertex buffer
-			// and keep track of what index we inserted them in
-			const auto bottom_left = mesh.vertices.push(Mesh::Vertex{
-				.position = m_bounds.min,
-				.uv = {},
-				.texture = 0,
-				.color = m_color,
-				.clip = clip,
-			});
-			const auto bottom_right = mesh.vertices.push(Mesh::Vertex{
-				.position = Point(m_bounds.max.x, m_bounds.min.x),
-				.uv = {},
-				.texture = 0,
-				.color = m_color,
-				.clip = clip,
-			});
-			const auto top_left = mesh.vertices.push(Mesh::Vertex{
-				.position = Point(m_bounds.min.x, m_bounds.max.y),
-				.uv = {},
-				.texture = 0,
-				.color = m_color,
-				.clip = clip,
-			});
-			const auto top_right = mesh.vertices.push(Mesh::Vertex{
-				.position = m_bounds.max,
-				.uv = {},
-				.texture = 0,
-				.color = m_color,
-				.clip = clip,
-			});
+	// Pushes a quad with the given corners as two triangles
+	static void tesselate_quad(
+		Mesh& mesh,
+		const Point& bottom_left,
+		const Point& bottom_right,
+		const Point& top_left,
+		const Point& top_right,
+		Color color,
+		const Bounds& clip) {
+		// Insert the four corners of the quad into the vertex buffer
+		// and keep track of what index we inserted them in
+		const auto bottom_left_index = mesh.vertices.push(Mesh::Vertex{
+			.position = bottom_left,
+			.uv = {},
+			.texture = 0,
+			.color = color,
+			.clip = clip,
+		});
+		const auto bottom_right_index = mesh.vertices.push(Mesh::Vertex{
+			.position = bottom_right,
+			.uv = {},
+			.texture = 0,
+			.color = color,
+			.clip = clip,
+		});
+		const auto top_left_index = mesh.vertices.push(Mesh::Vertex{
+			.position = top_left,
+			.uv = {},
+			.texture = 0,
+			.color = color,
+			.clip = clip,
+		});
+		const auto top_right_index = mesh.vertices.push(Mesh::Vertex{
+			.position = top_right,
+			.uv = {},
+			.texture = 0,
+			.color = color,
+			.clip = clip,
+		});
 
-			// Define the first triangle based on the vertex indices
-			mesh.indices.push(static_cast<Mesh::Index>(bottom_left));
-			mesh.indices.push(static_cast<Mesh::Index>(top_left));
-			mesh.indices.push(static_cast<Mesh::Index>(top_right));
+		// Define the first triangle based on the vertex indices
+		mesh.indices.push(static_cast<Mesh::Index>(bottom_left_index));
+		mesh.indices.push(static_cast<Mesh::Index>(top_left_index));
+		mesh.indices.push(static_cast<Mesh::Index>(top_right_index));
 
-			// Define the second triangle based on the vertex indices
-			mesh.indices.push(static_cast<Mesh::Index>(bottom_left));
-			mesh.indices.push(static_cast<Mesh::Index>(top_right));
-			mesh.indices.push(static_cast<Mesh::Index>(bottom_right));
-		} else {
-			MACH_UNIMPLEMENTED;
-		}
+		// Define the second triangle based on the vertex indices
+		mesh.indices.push(static_cast<Mesh::Index>(bottom_left_index));
+		mesh.indices.push(static_cast<Mesh::Index>(top_right_index));
+		mesh.indices.push(static_cast<Mesh::Index>(bottom_right_index));
+	}
+
+	void Shape::tesselate(Mesh& mesh, const Bounds& clip) const {
+		m_variant.visit(Core::Overloaded{
+			[&](const Rect&) {
+				tesselate_quad(
+					mesh,
+					m_bounds.min,
+					Point(m_bounds.max.x, m_bounds.min.y),
+					Point(m_bounds.min.x, m_bounds.max.y),
+					m_bounds.max,
+					m_color,
+					clip);
+			},
+			// Text needs glyph atlases, which the canvas does not have yet
+			[](const Text&) { MACH_UNIMPLEMENTED; },
+			[&](const Line& line) {
+				// Lines keep their start in min and their end in max. A line with no length has no direction to give it
+				// width along, so it draws nothing.
+				const auto direction = (m_bounds.max - m_bounds.min).normalized();
+				if (!direction.is_set()) {
+					return;
+				}
+				const Point offset = direction.unwrap().perp() * (line.width * 0.5f);
+				tesselate_quad(
+					mesh,
+					m_bounds.min + offset,
+					m_bounds.max + offset,
+					m_bounds.min - offset,
+					m_bounds.max - offset,
+					m_color,
+					clip);
+			},
+		});
 	}
 
 	usize Canvas::push(const Shape& shape) {
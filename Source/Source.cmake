@@ -41,6 +41,24 @@ function(test_machina_library target)
     add_test(${target}Test ${target}Test)
 endfunction()
 
+# Creates a benchmark executable for the given library.
+#
+# Mirrors test_machina_library but builds with BenchmarkMain.cpp and turns on MACH_ENABLE_BENCHMARK so the
+# MACH_BENCHMARK blocks in the library are compiled. Benchmarks are not registered with ctest as their timings are
+# only meaningful in an optimized build on a quiet machine. Pass --json=<path> to save results for comparison.
+function(bench_machina_library target)
+    add_executable(${target}Bench ${ARGN} ${CORE_ROOT}/Debug/BenchmarkMain.cpp)
+	target_include_directories(${target}Bench PRIVATE ${SOURCE_ROOT})
+    set_target_properties(${target}Bench PROPERTIES LINKER_LANGUAGE CXX)
+    get_target_property(OUT ${target}Bench LINK_LIBRARIES)
+    target_compile_definitions(${target}Bench PRIVATE MACH_ENABLE_BENCHMARK)
+    if (NOT OUT)
+		target_link_libraries(${target}Bench Core)
+    else ()
+		target_link_libraries(${target}Bench Core ${OUT})
+    endif ()
+endfunction()
+
 include(${SOURCE_ROOT}/Core/Core.cmake)
 include(${SOURCE_ROOT}/Doctest/Doctest.cmake)
 include(${SOURCE_ROOT}/DXC/DXC.cmake)